@@ -0,0 +1,58 @@
+#include "crypto/Ecc.h"
+#include "crypto/Sha256.h"
+#include "crypto/Sha512.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace
+{
+// Returns a comma-separated list of the names of the available implementations
+template <typename Backend, typename IsAvailable, typename Name>
+std::string availableBackends(int n, IsAvailable isAvailable, Name name)
+{
+    std::string list;
+    for (int i = 0; i < n; ++i)
+    {
+        if (isAvailable((Backend)i))
+        {
+            if (!list.empty())
+                list += ",";
+            list += name((Backend)i);
+        }
+    }
+    return list;
+}
+} // anonymous namespace
+
+// Records the implementations that the results were produced with in the context of the output, so that results from
+// different builds and machines (for example, JSON output saved for each release) can be compared meaningfully.
+int main(int argc, char ** argv)
+{
+    using namespace Crypto;
+
+    benchmark::AddCustomContext("sha256.default", sha256BackendName(sha256Backend()));
+    benchmark::AddCustomContext("sha256.batch", sha256BackendName(sha256BatchBackend()));
+    benchmark::AddCustomContext("sha256.available",
+                                availableBackends<Sha256Backend>(NUM_SHA256_BACKENDS,
+                                                                 sha256BackendIsAvailable,
+                                                                 sha256BackendName));
+    benchmark::AddCustomContext("sha512.default", sha512BackendName(sha512Backend()));
+    benchmark::AddCustomContext("sha512.available",
+                                availableBackends<Sha512Backend>(NUM_SHA512_BACKENDS,
+                                                                 sha512BackendIsAvailable,
+                                                                 sha512BackendName));
+    benchmark::AddCustomContext("ecc.default", Ecc::backendName(Ecc::backend()));
+    benchmark::AddCustomContext("ecc.available",
+                                availableBackends<Ecc::Backend>(Ecc::NUM_BACKENDS,
+                                                                Ecc::backendIsAvailable,
+                                                                Ecc::backendName));
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
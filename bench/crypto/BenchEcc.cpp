@@ -0,0 +1,348 @@
+#include "crypto/Ecc.h"
+#include "utility/Utility.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace Crypto;
+
+namespace
+{
+// Signature of SHA-256("message 1") by the private key 1
+char const MESSAGE[]    = "message 1";
+char const PUBLIC_KEY[] = "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798";
+char const SIGNATURE[]  = "0d8b6e987bc4828126a32ddd07c4e86ac7d2540f8622c995df60568508a6ee97"
+                          "bc8668b91cd745c99d35d95bba6922ef5e6bc886c79cae2f508d6677f015e725";
+
+// Arguments: backend
+void eccArgs(benchmark::internal::Benchmark * b)
+{
+    b->ArgNames({ "backend" });
+    for (int backend = 0; backend < Ecc::NUM_BACKENDS; ++backend)
+    {
+        b->Args({ backend });
+    }
+}
+
+// Arguments: backend, message size
+void eccSizeArgs(benchmark::internal::Benchmark * b)
+{
+    b->ArgNames({ "backend", "size" });
+    for (int backend = 0; backend < Ecc::NUM_BACKENDS; ++backend)
+    {
+        for (int size : { 32, 250, 1024 })
+        {
+            b->Args({ backend, size });
+        }
+    }
+}
+
+// Selects the backend for the duration of a benchmark. Returns false if the backend is not available.
+bool selectBackend(benchmark::State & state)
+{
+    Ecc::Backend backend = (Ecc::Backend)state.range(0);
+    if (!Ecc::selectBackend(backend))
+    {
+        state.SkipWithError("not available");
+        return false;
+    }
+    state.SetLabel(Ecc::backendName(backend));
+    return true;
+}
+
+// Returns a distinct private key for each value of i
+Ecc::PrivateKey benchPrivateKey(size_t i)
+{
+    Ecc::PrivateKey prvKey;
+    prvKey.fill(0x5a);
+    prvKey[0] = (uint8_t)i;
+    prvKey[1] = (uint8_t)(i >> 8);
+    return prvKey;
+}
+
+// The public key is parsed once and then found in the cache
+void BM_verify(benchmark::State & state)
+{
+    Ecc::Backend original = Ecc::backend();
+    if (!selectBackend(state))
+        return;
+
+    Ecc::PublicKey pubKey    = Utility::fromHex(PUBLIC_KEY);
+    Ecc::Signature signature = Utility::fromHex(SIGNATURE);
+    std::string    message   = MESSAGE;
+    for (auto _ : state)
+    {
+        bool valid = Ecc::verify((uint8_t const *)message.data(), message.size(), pubKey, signature);
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations());
+
+    Ecc::selectBackend(original);
+}
+
+void BM_derivePublicKey(benchmark::State & state)
+{
+    Ecc::Backend original = Ecc::backend();
+    if (!selectBackend(state))
+        return;
+
+    Ecc::PrivateKey prvKey;
+    std::vector<uint8_t> bytes = Utility::fromHex("1234567890abcdef1234567890abcdef1234567890abcdef1234567890abcdef");
+    std::copy(bytes.begin(), bytes.end(), prvKey.begin());
+    Ecc::PublicKey pubKey;
+    for (auto _ : state)
+    {
+        bool valid = Ecc::derivePublicKey(prvKey, pubKey);
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations());
+
+    Ecc::selectBackend(original);
+}
+
+// Arguments: backend. Derives 1000 keys, as when refilling a key pool.
+void BM_derivePublicKeys(benchmark::State & state)
+{
+    Ecc::Backend original = Ecc::backend();
+    if (!selectBackend(state))
+        return;
+
+    std::vector<Ecc::PrivateKey> prvKeys;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        prvKeys.push_back(benchPrivateKey(i));
+    }
+    std::vector<Ecc::PublicKey> pubKeys;
+    for (auto _ : state)
+    {
+        bool valid = Ecc::derivePublicKeys(prvKeys, pubKeys);
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * (int64_t)prvKeys.size());
+
+    Ecc::selectBackend(original);
+}
+
+// Arguments: backend. Each signature is verified once when it enters the mempool and once when its block is connected.
+void BM_verifyHashCached(benchmark::State & state)
+{
+    Ecc::Backend original = Ecc::backend();
+    if (!selectBackend(state))
+        return;
+
+    Ecc::PublicKey     pubKey    = Utility::fromHex(PUBLIC_KEY);
+    Ecc::Signature     signature = Utility::fromHex(SIGNATURE);
+    std::string        message   = MESSAGE;
+    Crypto::Sha256Hash hash      = Crypto::sha256((uint8_t const *)message.data(), message.size());
+    Ecc::SignatureCache cache;
+    for (auto _ : state)
+    {
+        bool valid = Ecc::verifyHashCached(hash.data(), pubKey, signature, true, cache) &&
+                     Ecc::verifyHashCached(hash.data(), pubKey, signature, false, cache);
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * 2);
+
+    Ecc::selectBackend(original);
+}
+
+// Arguments: backend. Verifies 1000 signatures by different keys, none of which are cached, as when a block is first
+// seen.
+void BM_verifyBatch(benchmark::State & state)
+{
+    Ecc::Backend original = Ecc::backend();
+    if (!selectBackend(state))
+        return;
+
+    size_t constexpr COUNT = 1000;
+    std::vector<Ecc::PublicKey> pubKeys(COUNT);
+    std::vector<Ecc::Signature> signatures(COUNT);
+    std::vector<std::string> messages(COUNT);
+    std::vector<Ecc::VerifyJob> jobs;
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        Ecc::PrivateKey prvKey = benchPrivateKey(i);
+        messages[i] = "message " + std::to_string(i);
+        if (!Ecc::derivePublicKey(prvKey, pubKeys[i]) ||
+            !Ecc::sign((uint8_t const *)messages[i].data(), messages[i].size(), prvKey, signatures[i]))
+        {
+            state.SkipWithError("signing is not available");
+            Ecc::selectBackend(original);
+            return;
+        }
+        jobs.push_back(Ecc::VerifyJob{ (uint8_t const *)messages[i].data(), messages[i].size(), &pubKeys[i],
+                                       &signatures[i], false });
+    }
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        Ecc::PublicKeyCache::shared().clear();
+        state.ResumeTiming();
+        bool valid = Ecc::verifyBatch(jobs);
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * (int64_t)COUNT);
+
+    Ecc::selectBackend(original);
+}
+
+// Arguments: backend, message size. The message is hashed and signed.
+void BM_sign(benchmark::State & state)
+{
+    Ecc::Backend original = Ecc::backend();
+    if (!selectBackend(state))
+        return;
+
+    Ecc::PrivateKey prvKey = benchPrivateKey(0);
+    std::vector<uint8_t> message((size_t)state.range(1), 0xa5);
+    Ecc::Signature signature;
+    if (!Ecc::sign(message.data(), message.size(), prvKey, signature))
+    {
+        state.SkipWithError("signing is not available");
+        Ecc::selectBackend(original);
+        return;
+    }
+    for (auto _ : state)
+    {
+        bool valid = Ecc::sign(message.data(), message.size(), prvKey, signature);
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations());
+
+    Ecc::selectBackend(original);
+}
+
+void BM_signHash(benchmark::State & state)
+{
+    Ecc::Backend original = Ecc::backend();
+    if (!selectBackend(state))
+        return;
+
+    Ecc::PrivateKey prvKey = benchPrivateKey(0);
+    std::vector<uint8_t> hash(Ecc::SIGNATURE_HASH_SIZE, 0xa5);
+    Ecc::Signature signature;
+    for (auto _ : state)
+    {
+        bool valid = Ecc::signHash(hash.data(), prvKey, signature);
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations());
+
+    Ecc::selectBackend(original);
+}
+
+// Arguments: backend. Signs 1000 inputs with different keys, as in a payout batch.
+void BM_signBatch(benchmark::State & state)
+{
+    Ecc::Backend original = Ecc::backend();
+    if (!selectBackend(state))
+        return;
+
+    size_t constexpr COUNT = 1000;
+    std::vector<Ecc::PrivateKey> prvKeys;
+    std::vector<std::vector<uint8_t>> hashes;
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        prvKeys.push_back(benchPrivateKey(i));
+        hashes.push_back(std::vector<uint8_t>(Ecc::SIGNATURE_HASH_SIZE, (uint8_t)i));
+    }
+    std::vector<Ecc::SignJob> jobs;
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        jobs.push_back(Ecc::SignJob{ hashes[i].data(), &prvKeys[i], Ecc::Signature(), false });
+    }
+    for (auto _ : state)
+    {
+        bool valid = Ecc::signBatch(jobs);
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * (int64_t)COUNT);
+
+    Ecc::selectBackend(original);
+}
+
+// 1000 BIP 340 signatures by different keys, for comparing single and batch verification
+struct SchnorrSignatures
+{
+    static size_t constexpr COUNT = 1000;
+
+    // Constructor
+    SchnorrSignatures()
+        : messages(COUNT)
+        , pubKeys(COUNT)
+        , signatures(COUNT)
+        , valid(true)
+    {
+        for (size_t i = 0; i < COUNT; ++i)
+        {
+            Ecc::PrivateKey prvKey = benchPrivateKey(i);
+            messages[i] = "message " + std::to_string(i);
+            uint8_t const * message = (uint8_t const *)messages[i].data();
+            if (!Ecc::deriveXOnlyPublicKey(prvKey, pubKeys[i]) ||
+                !Ecc::schnorrSign(message, messages[i].size(), prvKey, signatures[i]))
+            {
+                valid = false;
+                return;
+            }
+            jobs.push_back(Ecc::SchnorrVerifyJob{ message, messages[i].size(), &pubKeys[i], &signatures[i], false });
+        }
+    }
+
+    std::vector<std::string> messages;
+    std::vector<Ecc::PublicKey> pubKeys;
+    std::vector<Ecc::Signature> signatures;
+    std::vector<Ecc::SchnorrVerifyJob> jobs;
+    bool valid;                             // False if Schnorr signatures are not available
+};
+
+// Verifies the signatures one at a time
+void BM_schnorrVerify(benchmark::State & state)
+{
+    SchnorrSignatures signatures;
+    if (!signatures.valid)
+    {
+        state.SkipWithError("not available");
+        return;
+    }
+    for (auto _ : state)
+    {
+        for (auto & job : signatures.jobs)
+        {
+            job.valid = Ecc::schnorrVerify(job.message, job.size, *job.pubKey, *job.signature);
+            benchmark::DoNotOptimize(job.valid);
+        }
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * (int64_t)SchnorrSignatures::COUNT);
+}
+
+// Arguments: threads. Verifies the signatures together.
+void BM_schnorrVerifyBatch(benchmark::State & state)
+{
+    SchnorrSignatures signatures;
+    if (!signatures.valid)
+    {
+        state.SkipWithError("not available");
+        return;
+    }
+    ThreadPool pool((unsigned)state.range(0));
+    for (auto _ : state)
+    {
+        bool valid = Ecc::schnorrVerifyBatch(signatures.jobs, pool);
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * (int64_t)SchnorrSignatures::COUNT);
+}
+} // anonymous namespace
+
+BENCHMARK(BM_verify)->Apply(eccArgs);
+BENCHMARK(BM_derivePublicKey)->Apply(eccArgs);
+BENCHMARK(BM_derivePublicKeys)->Apply(eccArgs);
+BENCHMARK(BM_verifyBatch)->Apply(eccArgs);
+BENCHMARK(BM_verifyHashCached)->Apply(eccArgs);
+BENCHMARK(BM_sign)->Apply(eccSizeArgs);
+BENCHMARK(BM_signHash)->Apply(eccArgs);
+BENCHMARK(BM_signBatch)->Apply(eccArgs);
+BENCHMARK(BM_schnorrVerify);
+BENCHMARK(BM_schnorrVerifyBatch)->ArgNames({ "threads" })->Arg(1)->Arg(4);
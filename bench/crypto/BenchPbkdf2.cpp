@@ -0,0 +1,97 @@
+#include "crypto/Pbkdf2.h"
+#include "crypto/Sha512.h"
+#include "crypto/ThreadPool.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace Crypto;
+
+namespace
+{
+// BIP-39 seed derivation: 2048 iterations, a 64-byte key
+int const ROUNDS       = 2048;
+size_t const SEED_SIZE = 64;
+
+// Arguments: backend, threads, number of passwords
+void batchArgs(benchmark::internal::Benchmark * b)
+{
+    b->ArgNames({ "backend", "threads", "n" });
+    for (int backend = 0; backend < NUM_SHA512_BACKENDS; ++backend)
+    {
+        for (int threads : { 1, 0 })
+        {
+            b->Args({ backend, threads, 64 });
+        }
+    }
+}
+
+// Selects the backend for the duration of a benchmark. Returns false if the backend is not available.
+bool selectBackend(benchmark::State & state)
+{
+    Sha512Backend backend = (Sha512Backend)state.range(0);
+    if (!selectSha512Backend(backend))
+    {
+        state.SkipWithError("not supported by this processor");
+        return false;
+    }
+    state.SetLabel(sha512BackendName(backend));
+    return true;
+}
+
+// Passwords that look like 12-word mnemonic sentences
+std::vector<std::vector<uint8_t>> passwords(size_t n)
+{
+    std::vector<std::vector<uint8_t>> result;
+    for (size_t i = 0; i < n; ++i)
+    {
+        std::string s = "legal winner thank year wave sausage worth useful legal winner thank " + std::to_string(i);
+        result.emplace_back(s.begin(), s.end());
+    }
+    return result;
+}
+
+void BM_pbkdf2HmacSha512(benchmark::State & state)
+{
+    Sha512Backend original = sha512Backend();
+    if (!selectBackend(state))
+        return;
+
+    std::vector<uint8_t> password = passwords(1).front();
+    std::vector<uint8_t> salt     = { 'm', 'n', 'e', 'm', 'o', 'n', 'i', 'c' };
+    for (auto _ : state)
+    {
+        std::vector<uint8_t> key = pbkdf2HmacSha512(password, salt, ROUNDS, SEED_SIZE);
+        benchmark::DoNotOptimize(key);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations());
+
+    selectSha512Backend(original);
+}
+
+void BM_pbkdf2HmacSha512Batch(benchmark::State & state)
+{
+    Sha512Backend original = sha512Backend();
+    if (!selectBackend(state))
+        return;
+
+    ThreadPool pool((unsigned)state.range(1));
+    size_t n = (size_t)state.range(2);
+    std::vector<std::vector<uint8_t>> salts(n, { 'm', 'n', 'e', 'm', 'o', 'n', 'i', 'c' });
+    std::vector<std::vector<uint8_t>> keys;
+    std::vector<std::vector<uint8_t>> p = passwords(n);
+    for (auto _ : state)
+    {
+        keys = pbkdf2HmacSha512Batch(p, salts, ROUNDS, SEED_SIZE, pool);
+        benchmark::DoNotOptimize(keys);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * (int64_t)n);
+
+    selectSha512Backend(original);
+}
+} // anonymous namespace
+
+BENCHMARK(BM_pbkdf2HmacSha512)->ArgName("backend")->DenseRange(0, NUM_SHA512_BACKENDS - 1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_pbkdf2HmacSha512Batch)->Apply(batchArgs)->Unit(benchmark::kMillisecond);
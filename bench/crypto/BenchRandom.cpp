@@ -0,0 +1,35 @@
+#include "crypto/Random.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace Crypto;
+
+namespace
+{
+// Arguments: number of bytes
+void BM_getBytes(benchmark::State & state)
+{
+    std::vector<uint8_t> buffer((size_t)state.range(0));
+    for (auto _ : state)
+    {
+        Random::getBytes(buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed((int64_t)state.iterations() * (int64_t)buffer.size());
+}
+
+void BM_getUint64(benchmark::State & state)
+{
+    for (auto _ : state)
+    {
+        uint64_t x = Random::getUint64();
+        benchmark::DoNotOptimize(x);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations());
+}
+} // anonymous namespace
+
+BENCHMARK(BM_getBytes)->ArgName("bytes")->Arg(8)->Arg(32)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_getUint64);
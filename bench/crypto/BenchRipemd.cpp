@@ -0,0 +1,94 @@
+#include "crypto/Ripemd.h"
+#include "crypto/Sha256.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace Crypto;
+
+namespace
+{
+size_t const PUBLIC_KEY_SIZE = 33;  // Size of a compressed public key
+size_t const BATCH_SIZE      = 4096;
+
+// Arguments: SHA-256 backend, input size (compressed and uncompressed public keys, and the largest script)
+void hash160Args(benchmark::internal::Benchmark * b)
+{
+    b->ArgNames({ "backend", "size" });
+    for (int backend = 0; backend < NUM_SHA256_BACKENDS; ++backend)
+    {
+        for (int size : { 33, 65, 520 })
+        {
+            b->Args({ backend, size });
+        }
+    }
+}
+
+void BM_ripemd160(benchmark::State & state)
+{
+    std::vector<uint8_t> input((size_t)state.range(0), 0xa5);
+    for (auto _ : state)
+    {
+        Ripemd160Hash hash = ripemd160(input.data(), input.size());
+        benchmark::DoNotOptimize(hash);
+    }
+    state.SetBytesProcessed((int64_t)state.iterations() * (int64_t)input.size());
+}
+
+void BM_hash160(benchmark::State & state)
+{
+    Sha256Backend original = sha256Backend();
+    Sha256Backend backend  = (Sha256Backend)state.range(0);
+    if (!selectSha256Backend(backend))
+    {
+        state.SkipWithError("not supported by this processor");
+        return;
+    }
+    state.SetLabel(sha256BackendName(backend));
+
+    std::vector<uint8_t> input((size_t)state.range(1), 0xa5);
+    for (auto _ : state)
+    {
+        Ripemd160Hash hash = hash160(input.data(), input.size());
+        benchmark::DoNotOptimize(hash);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations());
+
+    selectSha256Backend(original);
+}
+
+// Arguments: SHA-256 batch backend. Hashes 4096 compressed public keys.
+void BM_hash160Batch(benchmark::State & state)
+{
+    Sha256Backend original = sha256BatchBackend();
+    Sha256Backend backend  = (Sha256Backend)state.range(0);
+    if (!selectSha256BatchBackend(backend))
+    {
+        state.SkipWithError("not supported by this processor");
+        return;
+    }
+    state.SetLabel(sha256BackendName(backend));
+
+    std::vector<uint8_t> data(BATCH_SIZE * PUBLIC_KEY_SIZE, 0xa5);
+    std::vector<uint8_t const *> inputs;
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+        inputs.push_back(data.data() + i * PUBLIC_KEY_SIZE);
+    }
+    std::vector<size_t> lengths(BATCH_SIZE, PUBLIC_KEY_SIZE);
+    Ripemd160HashList hashes(BATCH_SIZE);
+    for (auto _ : state)
+    {
+        hash160Batch(inputs.data(), lengths.data(), BATCH_SIZE, hashes.data());
+        benchmark::DoNotOptimize(hashes.data());
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * (int64_t)BATCH_SIZE);
+
+    selectSha256BatchBackend(original);
+}
+} // anonymous namespace
+
+BENCHMARK(BM_ripemd160)->ArgName("size")->Arg(32)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK(BM_hash160)->Apply(hash160Args);
+BENCHMARK(BM_hash160Batch)->ArgName("backend")->DenseRange(0, NUM_SHA256_BACKENDS - 1);
@@ -0,0 +1,47 @@
+#include "crypto/Sha1.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace Crypto;
+
+namespace
+{
+// Arguments: backend, input size
+void sha1Args(benchmark::internal::Benchmark * b)
+{
+    b->ArgNames({ "backend", "size" });
+    for (int backend = 0; backend < NUM_SHA1_BACKENDS; ++backend)
+    {
+        for (int size : { 20, 64, 1024, 16384 })
+        {
+            b->Args({ backend, size });
+        }
+    }
+}
+
+void BM_sha1(benchmark::State & state)
+{
+    Sha1Backend original = sha1Backend();
+    Sha1Backend backend  = (Sha1Backend)state.range(0);
+    if (!selectSha1Backend(backend))
+    {
+        state.SkipWithError("not supported by this processor");
+        return;
+    }
+    state.SetLabel(sha1BackendName(backend));
+
+    std::vector<uint8_t> input((size_t)state.range(1), 0xa5);
+    for (auto _ : state)
+    {
+        Sha1Hash hash = sha1(input.data(), input.size());
+        benchmark::DoNotOptimize(hash);
+    }
+    state.SetBytesProcessed((int64_t)state.iterations() * (int64_t)input.size());
+
+    selectSha1Backend(original);
+}
+} // anonymous namespace
+
+BENCHMARK(BM_sha1)->Apply(sha1Args);
@@ -0,0 +1,152 @@
+#include "crypto/Sha256.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace Crypto;
+
+namespace
+{
+// Arguments: backend, input size
+void sha256Args(benchmark::internal::Benchmark * b)
+{
+    b->ArgNames({ "backend", "size" });
+    for (int backend = 0; backend < NUM_SHA256_BACKENDS; ++backend)
+    {
+        for (int size : { 32, 64, 256, 1024, 16384, 1 << 20 })
+        {
+            b->Args({ backend, size });
+        }
+    }
+}
+
+// Arguments: backend, size of each message. 3000 messages are hashed at a time, roughly the number of transactions in a
+// full block.
+void sha256BatchArgs(benchmark::internal::Benchmark * b)
+{
+    b->ArgNames({ "backend", "size" });
+    for (int backend = 0; backend < NUM_SHA256_BACKENDS; ++backend)
+    {
+        for (int size : { 64, 250, 1024 })
+        {
+            b->Args({ backend, size });
+        }
+    }
+}
+
+size_t const BATCH_SIZE = 3000;
+
+// Selects the backend for the duration of a benchmark. Returns false if the backend is not available.
+bool selectBackend(benchmark::State & state)
+{
+    Sha256Backend backend = (Sha256Backend)state.range(0);
+    if (!selectSha256Backend(backend))
+    {
+        state.SkipWithError("not supported by this processor");
+        return false;
+    }
+    state.SetLabel(sha256BackendName(backend));
+    return true;
+}
+
+// Selects the batch backend for the duration of a benchmark. Returns false if the backend is not available.
+bool selectBatchBackend(benchmark::State & state)
+{
+    Sha256Backend backend = (Sha256Backend)state.range(0);
+    if (!selectSha256BatchBackend(backend))
+    {
+        state.SkipWithError("not supported by this processor");
+        return false;
+    }
+    state.SetLabel(sha256BackendName(backend));
+    return true;
+}
+
+void BM_sha256(benchmark::State & state)
+{
+    Sha256Backend original = sha256Backend();
+    if (!selectBackend(state))
+        return;
+
+    std::vector<uint8_t> input((size_t)state.range(1), 0xa5);
+    for (auto _ : state)
+    {
+        Sha256Hash hash = sha256(input.data(), input.size());
+        benchmark::DoNotOptimize(hash);
+    }
+    state.SetBytesProcessed((int64_t)state.iterations() * (int64_t)input.size());
+
+    selectSha256Backend(original);
+}
+
+void BM_doubleSha256(benchmark::State & state)
+{
+    Sha256Backend original = sha256Backend();
+    if (!selectBackend(state))
+        return;
+
+    std::vector<uint8_t> input((size_t)state.range(1), 0xa5);
+    for (auto _ : state)
+    {
+        Sha256Hash hash = doubleSha256(input.data(), input.size());
+        benchmark::DoNotOptimize(hash);
+    }
+    state.SetBytesProcessed((int64_t)state.iterations() * (int64_t)input.size());
+
+    selectSha256Backend(original);
+}
+
+void BM_doubleSha256Batch(benchmark::State & state)
+{
+    Sha256Backend original = sha256BatchBackend();
+    if (!selectBatchBackend(state))
+        return;
+
+    size_t size = (size_t)state.range(1);
+    std::vector<uint8_t> data(BATCH_SIZE * size, 0xa5);
+    std::vector<uint8_t const *> inputs;
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+        inputs.push_back(data.data() + i * size);
+    }
+    std::vector<size_t> lengths(BATCH_SIZE, size);
+    Sha256HashList hashes(BATCH_SIZE);
+    for (auto _ : state)
+    {
+        doubleSha256Batch(inputs.data(), lengths.data(), BATCH_SIZE, hashes.data());
+        benchmark::DoNotOptimize(hashes.data());
+    }
+    state.SetBytesProcessed((int64_t)state.iterations() * (int64_t)data.size());
+
+    selectSha256BatchBackend(original);
+}
+
+// Arguments: backend. Hashes one level of a Merkle tree with 2048 nodes.
+void BM_doubleSha256_64(benchmark::State & state)
+{
+    Sha256Backend original      = sha256Backend();
+    Sha256Backend originalBatch = sha256BatchBackend();
+    if (!selectBatchBackend(state))
+        return;
+    selectSha256Backend((Sha256Backend)state.range(0));
+
+    size_t const N = 2048;
+    Sha256HashList children(2 * N, Sha256Hash{ 0xa5 });
+    Sha256HashList parents(N);
+    for (auto _ : state)
+    {
+        doubleSha256_64(children.data(), N, parents.data());
+        benchmark::DoNotOptimize(parents.data());
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * (int64_t)N);
+
+    selectSha256Backend(original);
+    selectSha256BatchBackend(originalBatch);
+}
+} // anonymous namespace
+
+BENCHMARK(BM_sha256)->Apply(sha256Args);
+BENCHMARK(BM_doubleSha256)->Apply(sha256Args);
+BENCHMARK(BM_doubleSha256Batch)->Apply(sha256BatchArgs);
+BENCHMARK(BM_doubleSha256_64)->ArgName("backend")->DenseRange(0, NUM_SHA256_BACKENDS - 1);
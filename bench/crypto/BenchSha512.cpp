@@ -0,0 +1,108 @@
+#include "crypto/Hmac.h"
+#include "crypto/Sha512.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace Crypto;
+
+namespace
+{
+// Arguments: backend, input size
+void sha512Args(benchmark::internal::Benchmark * b)
+{
+    b->ArgNames({ "backend", "size" });
+    for (int backend = 0; backend < NUM_SHA512_BACKENDS; ++backend)
+    {
+        for (int size : { 64, 128, 1024, 16384 })
+        {
+            b->Args({ backend, size });
+        }
+    }
+}
+
+// Arguments: backend, message size. 37 bytes is a BIP32 child derivation.
+void hmacSha512Args(benchmark::internal::Benchmark * b)
+{
+    b->ArgNames({ "backend", "size" });
+    for (int backend = 0; backend < NUM_SHA512_BACKENDS; ++backend)
+    {
+        for (int size : { 37, 128, 1024 })
+        {
+            b->Args({ backend, size });
+        }
+    }
+}
+
+// Selects the backend for the duration of a benchmark. Returns false if the backend is not available.
+bool selectBackend(benchmark::State & state)
+{
+    Sha512Backend backend = (Sha512Backend)state.range(0);
+    if (!selectSha512Backend(backend))
+    {
+        state.SkipWithError("not supported by this processor");
+        return false;
+    }
+    state.SetLabel(sha512BackendName(backend));
+    return true;
+}
+
+void BM_sha512(benchmark::State & state)
+{
+    Sha512Backend original = sha512Backend();
+    if (!selectBackend(state))
+        return;
+
+    std::vector<uint8_t> input((size_t)state.range(1), 0xa5);
+    for (auto _ : state)
+    {
+        Sha512Hash hash = sha512(input.data(), input.size());
+        benchmark::DoNotOptimize(hash);
+    }
+    state.SetBytesProcessed((int64_t)state.iterations() * (int64_t)input.size());
+
+    selectSha512Backend(original);
+}
+
+// MACs of messages with and without reusing the keyed state
+void BM_hmacSha512(benchmark::State & state)
+{
+    Sha512Backend original = sha512Backend();
+    if (!selectBackend(state))
+        return;
+
+    std::vector<uint8_t> key(32, 0x5a);
+    std::vector<uint8_t> message((size_t)state.range(1), 0xa5);
+    for (auto _ : state)
+    {
+        Sha512Hash hash = hmacSha512(key.data(), key.size(), message.data(), message.size());
+        benchmark::DoNotOptimize(hash);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations());
+
+    selectSha512Backend(original);
+}
+
+void BM_HmacSha512_mac(benchmark::State & state)
+{
+    Sha512Backend original = sha512Backend();
+    if (!selectBackend(state))
+        return;
+
+    std::vector<uint8_t> message((size_t)state.range(1), 0xa5);
+    HmacSha512 hmac(std::vector<uint8_t>(32, 0x5a));
+    for (auto _ : state)
+    {
+        Sha512Hash hash = hmac.mac(message);
+        benchmark::DoNotOptimize(hash);
+    }
+    state.SetItemsProcessed((int64_t)state.iterations());
+
+    selectSha512Backend(original);
+}
+} // anonymous namespace
+
+BENCHMARK(BM_sha512)->Apply(sha512Args);
+BENCHMARK(BM_hmacSha512)->Apply(hmacSha512Args);
+BENCHMARK(BM_HmacSha512_mac)->Apply(hmacSha512Args);
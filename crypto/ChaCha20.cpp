@@ -0,0 +1,77 @@
+#include "ChaCha20.h"
+
+namespace
+{
+inline uint32_t rotl(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+inline uint32_t readLittleEndian32(uint8_t const * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+inline void writeLittleEndian32(uint32_t x, uint8_t * p)
+{
+    p[0] = (uint8_t)x;
+    p[1] = (uint8_t)(x >> 8);
+    p[2] = (uint8_t)(x >> 16);
+    p[3] = (uint8_t)(x >> 24);
+}
+
+inline void quarterRound(uint32_t & a, uint32_t & b, uint32_t & c, uint32_t & d)
+{
+    a += b; d ^= a; d = rotl(d, 16);
+    c += d; b ^= c; b = rotl(b, 12);
+    a += b; d ^= a; d = rotl(d, 8);
+    c += d; b ^= c; b = rotl(b, 7);
+}
+} // anonymous namespace
+
+namespace Crypto
+{
+
+void chacha20(uint8_t const * key, uint64_t nonce, uint64_t counter, uint8_t * out, size_t n)
+{
+    // "expand 32-byte k"
+    uint32_t input[16] = { 0x61707865, 0x3320646e, 0x79622d32, 0x6b206574 };
+    for (int i = 0; i < 8; ++i)
+    {
+        input[4 + i] = readLittleEndian32(key + 4 * i);
+    }
+    input[14] = (uint32_t)nonce;
+    input[15] = (uint32_t)(nonce >> 32);
+
+    while (n-- > 0)
+    {
+        input[12] = (uint32_t)counter;
+        input[13] = (uint32_t)(counter >> 32);
+
+        uint32_t x[16];
+        for (int i = 0; i < 16; ++i)
+        {
+            x[i] = input[i];
+        }
+
+        // 10 double rounds, each a column round and a diagonal round
+        for (int i = 0; i < 10; ++i)
+        {
+            quarterRound(x[0], x[4], x[8],  x[12]);
+            quarterRound(x[1], x[5], x[9],  x[13]);
+            quarterRound(x[2], x[6], x[10], x[14]);
+            quarterRound(x[3], x[7], x[11], x[15]);
+            quarterRound(x[0], x[5], x[10], x[15]);
+            quarterRound(x[1], x[6], x[11], x[12]);
+            quarterRound(x[2], x[7], x[8],  x[13]);
+            quarterRound(x[3], x[4], x[9],  x[14]);
+        }
+
+        for (int i = 0; i < 16; ++i)
+        {
+            writeLittleEndian32(x[i] + input[i], out + 4 * i);
+        }
+
+        ++counter;
+        out += CHACHA20_BLOCK_SIZE;
+    }
+}
+
+} // namespace Crypto
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Crypto
+{
+//! @addtogroup CryptoGroup
+//!@{
+
+size_t const CHACHA20_KEY_SIZE   = 256 / 8;     //!< Size of a ChaCha20 key in bytes
+size_t const CHACHA20_BLOCK_SIZE = 64;          //!< Size of a block of ChaCha20 key stream in bytes
+
+//! Generates blocks of ChaCha20 key stream.
+//!
+//! This is the original variant of ChaCha20, with a 64-bit block counter and a 64-bit nonce. It is the same as the
+//! variant of RFC 8439 when the low 32 bits of the nonce are the high 32 bits of RFC 8439's block counter.
+//!
+//! @param      key         key (CHACHA20_KEY_SIZE bytes)
+//! @param      nonce       nonce
+//! @param      counter     counter of the first block
+//! @param[out] out         key stream (n * CHACHA20_BLOCK_SIZE bytes)
+//! @param      n           number of blocks
+void chacha20(uint8_t const * key, uint64_t nonce, uint64_t counter, uint8_t * out, size_t n);
+
+//!@}
+} // namespace Crypto
@@ -0,0 +1,102 @@
+#include "CpuFeatures.h"
+
+#include <cstdint>
+
+#if defined(CRYPTO_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace
+{
+#if defined(CRYPTO_X86)
+
+// Executes cpuid for the given leaf and sub-leaf. Returns false if the leaf is not supported.
+bool cpuid(uint32_t leaf, uint32_t subleaf, uint32_t & a, uint32_t & b, uint32_t & c, uint32_t & d)
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if ((uint32_t)info[0] < leaf)
+        return false;
+    __cpuidex(info, (int)leaf, (int)subleaf);
+    a = (uint32_t)info[0];
+    b = (uint32_t)info[1];
+    c = (uint32_t)info[2];
+    d = (uint32_t)info[3];
+    return true;
+#else
+    if (__get_cpuid_max(0, nullptr) < leaf)
+        return false;
+    __cpuid_count(leaf, subleaf, a, b, c, d);
+    return true;
+#endif
+}
+
+// Returns the value of XCR0, which indicates which register sets are saved by the OS
+uint64_t xgetbv0()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t a;
+    uint32_t d;
+    __asm__("xgetbv" : "=a" (a), "=d" (d) : "c" (0));
+    return ((uint64_t)d << 32) | a;
+#endif
+}
+
+Crypto::CpuFeatures detect()
+{
+    Crypto::CpuFeatures features = {};
+
+    uint32_t a, b, c, d;
+    if (!cpuid(1, 0, a, b, c, d))
+        return features;
+
+    bool ssse3   = (c & (1u << 9)) != 0;
+    bool sse41   = (c & (1u << 19)) != 0;
+    bool osxsave = (c & (1u << 27)) != 0;
+    bool avx     = (c & (1u << 28)) != 0;
+
+    // The YMM and ZMM registers are only usable if the OS saves them on a context switch
+    uint64_t xcr0     = osxsave ? xgetbv0() : 0;
+    bool     ymmSaved = (xcr0 & 0x06) == 0x06;
+    bool     zmmSaved = (xcr0 & 0xe6) == 0xe6;
+
+    features.sse41 = ssse3 && sse41;
+
+    if (cpuid(7, 0, a, b, c, d))
+    {
+        features.avx2   = avx && ymmSaved && (b & (1u << 5)) != 0;
+        features.bmi2   = (b & (1u << 8)) != 0;
+        features.avx512 = avx && zmmSaved && (b & (1u << 16)) != 0;
+        features.sha    = features.sse41 && (b & (1u << 29)) != 0;
+    }
+
+    return features;
+}
+
+#else // if defined(CRYPTO_X86)
+
+Crypto::CpuFeatures detect()
+{
+    return Crypto::CpuFeatures();
+}
+
+#endif // if defined(CRYPTO_X86)
+} // anonymous namespace
+
+namespace Crypto
+{
+
+CpuFeatures const & cpuFeatures()
+{
+    static CpuFeatures const features = detect();
+    return features;
+}
+
+} // namespace Crypto
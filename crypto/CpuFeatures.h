@@ -0,0 +1,30 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+//! Defined if the target is an x86 or x86-64 processor and the SIMD implementations are available.
+#define CRYPTO_X86
+#endif
+
+namespace Crypto
+{
+//! @addtogroup CryptoGroup
+//!@{
+
+//! Instruction set extensions that are supported by the processor and the operating system.
+//!
+//! The features are detected once (using cpuid and xgetbv) the first time cpuFeatures() is called. The values are
+//! used to choose the fastest implementation of each algorithm at run time.
+struct CpuFeatures
+{
+    bool sse41;     //!< SSE4.1 (and SSSE3) instructions are supported
+    bool avx2;      //!< AVX2 instructions are supported and the OS saves the YMM registers
+    bool bmi2;      //!< BMI2 instructions (e.g. rorx) are supported
+    bool avx512;    //!< AVX-512F instructions are supported and the OS saves the ZMM registers
+    bool sha;       //!< SHA extensions (SHA-NI) are supported
+};
+
+//! Returns the instruction set extensions supported by the processor.
+CpuFeatures const & cpuFeatures();
+
+//!@}
+} // namespace Crypto
@@ -1,6 +1,8 @@
 #include "Ecc.h"
 
 #include "CppUtility.h"
+#include "Random.h"
+#include "Secp256k1.h"
 #include "Sha256.h"
 
 #include <wolfssl/options.h>
@@ -10,16 +12,76 @@
 #include <wolfssl/wolfcrypt/sha256.h>
 #include <wolfssl/wolfcrypt/sp_int.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// A parsed public key is shared by threads verifying signatures at the same time, so its wolfSSL key is passed to
+// wc_ecc_verify_hash_ex() by several threads at once. In a default build of wolfSSL, wc_ecc_verify_hash_ex() only reads
+// the key, even though it takes a non-const pointer. With asynchronous or non-blocking ECC, it keeps the state of the
+// operation in the key, so each verification would need its own copy.
+#if defined(WOLFSSL_ASYNC_CRYPT) || defined(WC_ECC_NONBLOCK)
+#error "Concurrent verification with a shared key requires wolfSSL without WOLFSSL_ASYNC_CRYPT and WC_ECC_NONBLOCK"
+#endif
 
 using namespace Crypto;
 using namespace Crypto::Ecc;
 
 size_t constexpr CURVE_SIZE = PRIVATE_KEY_SIZE;
 
+// Number of keys derived together by derivePublicKeys(), sharing one inversion
+size_t constexpr DERIVE_GROUP_SIZE = 64;
+
+// Number of signatures verified together by verifyBatch(), with their keys parsed together
+size_t constexpr VERIFY_GROUP_SIZE = 64;
+
+// Number of Schnorr signatures verified together by schnorrVerifyBatch() in one multi-scalar multiplication
+size_t constexpr SCHNORR_GROUP_SIZE = 128;
+
+struct Crypto::Ecc::ParsedPublicKey
+{
+    // Constructor
+    //
+    // If prepare is false, the verification table is not built and the caller must build it.
+    ParsedPublicKey(uint8_t const * k, size_t size, bool prepare = true);
+    ~ParsedPublicKey() { wc_ecc_free(&wolfKey_); }
+
+    ParsedPublicKey(ParsedPublicKey const &) = delete;
+    ParsedPublicKey & operator =(ParsedPublicKey const &) = delete;
+
+    // Returns true if the key is valid according to the given implementation
+    bool isValid(Backend backend) const;
+
+    // Returns the key loaded into wolfSSL, or nullptr if it is not valid. It is loaded the first time it is needed.
+    ecc_key * wolfKey() const;
+
+#if defined(CRYPTO_SECP256K1_NATIVE)
+    Secp256k1::AffinePoint point;           // The point, if it is valid
+    Secp256k1::KeyTable table;              // Odd multiples of the point for verification, if it is valid
+    bool valid;                             // True if the key was parsed and the point is on the curve
+#endif
+
+private:
+
+    std::vector<uint8_t> serialized_;
+    mutable std::once_flag wolfLoaded_;
+    mutable ecc_key wolfKey_;               // Shared by concurrent verifications (see below)
+    mutable bool wolfValid_;                // True if the key was loaded and passed wc_ecc_check_key
+};
+
 namespace
 {
+// The selected implementation
+Backend & currentBackend()
+{
+    static Backend backend = backendIsAvailable(BACKEND_NATIVE) ? BACKEND_NATIVE : BACKEND_WOLFSSL;
+    return backend;
+}
+
 // Loads a public key into a wolfSSL ecc_key structure.
 // Returns true if there were no problems.
 static bool loadPublicKey(uint8_t const * k, size_t size, ecc_key * pub)
@@ -70,29 +132,408 @@ bool loadPrivateKey(uint8_t const * k, size_t size, ecc_key * prv)
     int rc = wc_ecc_import_private_key_ex(k, (word32)size, NULL, 0, prv, ECC_SECP256K1);
     return rc == 0;
 }
+
+// The wolfSSL state used for signing. Setting up the RNG is expensive, so each thread sets up its state once and reuses
+// it for every signature.
+struct WolfSigningContext
+{
+    // Constructor
+    WolfSigningContext()
+    {
+        bool rngReady = wc_InitRng(&rng) == 0;
+        bool keyReady = wc_ecc_init(&key) == 0;
+        bool rReady   = mp_init(&r) == MP_OKAY;
+        bool sReady   = mp_init(&s) == MP_OKAY;
+        ready = rngReady && keyReady && rReady && sReady;
+    }
+
+    // Destructor
+    ~WolfSigningContext()
+    {
+        mp_free(&r);
+        mp_free(&s);
+        wc_ecc_free(&key);
+        wc_FreeRng(&rng);
+    }
+
+    WC_RNG rng;
+    ecc_key key;            // Reloaded with the private key for each signature
+    mp_int r;
+    mp_int s;
+    bool ready;             // True if everything was set up
+};
+
+WolfSigningContext & wolfSigningContext()
+{
+    thread_local WolfSigningContext context;
+    return context;
+}
+
+// Verifies a signature of a hash with a parsed public key
+bool verifyParsed(uint8_t const * hash, ParsedPublicKey const & pub, Signature const & signature)
+{
+    int rc;
+
+    if (signature.size() != 2 * CURVE_SIZE)
+        return false;
+
+#if defined(CRYPTO_SECP256K1_NATIVE)
+    if (backend() == BACKEND_NATIVE)
+        return pub.valid && Secp256k1::verify(hash, pub.table, signature.data());
+#endif
+
+    ecc_key * key = pub.wolfKey();
+    if (!key)
+        return false;
+
+    mp_int r;
+    rc = mp_init(&r);
+    assert(rc == MP_OKAY);
+    rc = mp_read_unsigned_bin(&r, &signature[0], CURVE_SIZE);
+
+    mp_int s;
+    rc = mp_init(&s);
+    assert(rc == MP_OKAY);
+    rc = mp_read_unsigned_bin(&s, &signature[CURVE_SIZE], CURVE_SIZE);
+
+    // Verify the signature
+    int verified = 0;
+    rc = wc_ecc_verify_hash_ex(&r, &s, hash, (word32)SIGNATURE_HASH_SIZE, &verified, key);
+    mp_free(&r);
+    mp_free(&s);
+    if (rc != 0)
+        return false;
+
+    return verified != 0;
+}
 } // anonymous namespace
 
-bool Crypto::Ecc::publicKeyIsValid(uint8_t const * k, size_t size)
+Crypto::Ecc::ParsedPublicKey::ParsedPublicKey(uint8_t const * k, size_t size, bool prepare /* = true */)
+    : serialized_(k, k + size)
+    , wolfValid_(false)
 {
-    int     rc;
-    ecc_key pub;
-    rc = wc_ecc_init(&pub);
+    int rc = wc_ecc_init(&wolfKey_);
     assert(rc == 0);
+    (void)rc;
+#if defined(CRYPTO_SECP256K1_NATIVE)
+    valid = Secp256k1::parsePublicKey(k, size, point);
+    if (valid && prepare)
+        Secp256k1::buildKeyTables(&point, &table, 1);
+#else
+    (void)prepare;
+#endif
+}
+
+bool Crypto::Ecc::ParsedPublicKey::isValid(Backend backend) const
+{
+#if defined(CRYPTO_SECP256K1_NATIVE)
+    if (backend == BACKEND_NATIVE)
+        return valid;
+#endif
+    return wolfKey() != nullptr;
+}
+
+ecc_key * Crypto::Ecc::ParsedPublicKey::wolfKey() const
+{
+    std::call_once(wolfLoaded_, [this] () {
+        wolfValid_ = loadPublicKey(serialized_.data(), serialized_.size(), &wolfKey_) && wc_ecc_check_key(&wolfKey_) == 0;
+    });
+    return wolfValid_ ? &wolfKey_ : nullptr;
+}
 
-    if (!loadPublicKey(k, size, &pub))
+bool Crypto::Ecc::backendIsAvailable(Backend backend)
+{
+    switch (backend)
     {
-        wc_ecc_free(&pub);
+        case BACKEND_WOLFSSL:   return true;
+#if defined(CRYPTO_SECP256K1_NATIVE)
+        case BACKEND_NATIVE:    return true;
+#endif
+        default:                return false;
+    }
+}
+
+Backend Crypto::Ecc::backend()
+{
+    return currentBackend();
+}
+
+bool Crypto::Ecc::selectBackend(Backend backend)
+{
+    if (!backendIsAvailable(backend))
         return false;
+    currentBackend() = backend;
+    return true;
+}
+
+char const * Crypto::Ecc::backendName(Backend backend)
+{
+    static char const * const NAMES[NUM_BACKENDS] =
+    {
+        "wolfssl",
+        "native"
+    };
+
+    assert(backend >= 0 && backend < NUM_BACKENDS);
+    return NAMES[backend];
+}
+
+Crypto::Ecc::PublicKeyCache::PublicKeyCache(size_t capacity)
+    : capacity_(capacity)
+    , hits_(0)
+    , misses_(0)
+{
+}
+
+Crypto::Ecc::PublicKeyCache::~PublicKeyCache()
+{
+}
+
+std::shared_ptr<ParsedPublicKey const> Crypto::Ecc::PublicKeyCache::get(uint8_t const * k, size_t size)
+{
+    std::string serialized(reinterpret_cast<char const *>(k), size);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto i = index_.find(serialized);
+        if (i != index_.end())
+        {
+            ++hits_;
+            entries_.splice(entries_.begin(), entries_, i->second);
+            return i->second->second;
+        }
     }
 
-    // Make sure it is a valid key
-    rc = wc_ecc_check_key(&pub);
-    wc_ecc_free(&pub);
-    return rc == 0;
+    // The key is parsed without holding the lock. If another thread adds the same key in the meantime, its entry is kept.
+    ++misses_;
+    std::shared_ptr<ParsedPublicKey const> parsed = std::make_shared<ParsedPublicKey>(k, size);
+    if (capacity_ == 0)
+        return parsed;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    insert(std::move(serialized), parsed);
+    return parsed;
+}
+
+void Crypto::Ecc::PublicKeyCache::getBatch(PublicKey const * const *                keys,
+                                           size_t                                   n,
+                                           std::shared_ptr<ParsedPublicKey const> * parsed)
+{
+    std::vector<size_t> missing;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < n; ++i)
+        {
+            std::string serialized(reinterpret_cast<char const *>(keys[i]->data()), keys[i]->size());
+            auto j = index_.find(serialized);
+            if (j != index_.end())
+            {
+                ++hits_;
+                entries_.splice(entries_.begin(), entries_, j->second);
+                parsed[i] = j->second->second;
+            }
+            else
+            {
+                missing.push_back(i);
+            }
+        }
+    }
+    if (missing.empty())
+        return;
+
+    // The missing keys are parsed without holding the lock, and then their tables are built together
+    misses_ += missing.size();
+    std::vector<std::shared_ptr<ParsedPublicKey>> added;
+    added.reserve(missing.size());
+    for (size_t i : missing)
+    {
+        added.push_back(std::make_shared<ParsedPublicKey>(keys[i]->data(), keys[i]->size(), false));
+    }
+
+#if defined(CRYPTO_SECP256K1_NATIVE)
+    std::vector<Secp256k1::AffinePoint> points;
+    std::vector<ParsedPublicKey *> owners;
+    for (auto const & a : added)
+    {
+        if (a->valid)
+        {
+            points.push_back(a->point);
+            owners.push_back(a.get());
+        }
+    }
+    std::vector<Secp256k1::KeyTable> tables(points.size());
+    Secp256k1::buildKeyTables(points.data(), tables.data(), points.size());
+    for (size_t j = 0; j < owners.size(); ++j)
+    {
+        owners[j]->table = tables[j];
+    }
+#endif
+
+    for (size_t j = 0; j < missing.size(); ++j)
+    {
+        parsed[missing[j]] = added[j];
+    }
+    if (capacity_ == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t j = 0; j < missing.size(); ++j)
+    {
+        PublicKey const & k = *keys[missing[j]];
+        insert(std::string(reinterpret_cast<char const *>(k.data()), k.size()), added[j]);
+    }
+}
+
+void Crypto::Ecc::PublicKeyCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    entries_.clear();
+}
+
+size_t Crypto::Ecc::PublicKeyCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+PublicKeyCache & Crypto::Ecc::PublicKeyCache::shared()
+{
+    static PublicKeyCache cache;
+    return cache;
+}
+
+void Crypto::Ecc::PublicKeyCache::insert(std::string &&                                 serialized,
+                                         std::shared_ptr<ParsedPublicKey const> const & parsed)
+{
+    if (index_.find(serialized) != index_.end())
+        return;
+
+    if (entries_.size() >= capacity_)
+    {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+    entries_.emplace_front(serialized, parsed);
+    index_.emplace(std::move(serialized), entries_.begin());
+}
+
+Crypto::Ecc::SignatureCache::SignatureCache(size_t capacity)
+    : capacity_(WAYS)
+    , hits_(0)
+    , misses_(0)
+{
+    while (capacity_ < capacity)
+    {
+        capacity_ *= 2;
+    }
+    entries_.reset(new std::atomic<uint64_t>[capacity_]);
+    clear();
+
+    // The salt fills a whole block, so hashing it is done once here
+    uint8_t salt[64];
+    Random::getBytes(salt, sizeof(salt));
+    salted_.update(salt, sizeof(salt));
+    std::fill(salt, salt + sizeof(salt), 0);
+}
+
+bool Crypto::Ecc::SignatureCache::contains(uint8_t const *    hash,
+                                           PublicKey const &  pubKey,
+                                           Signature const &  signature,
+                                           bool               erase)
+{
+    size_t   first;
+    uint64_t f = fingerprint(hash, pubKey, signature, first);
+    for (size_t i = first; i < first + WAYS; ++i)
+    {
+        if (entries_[i].load(std::memory_order_relaxed) == f)
+        {
+            if (erase)
+                entries_[i].compare_exchange_strong(f, 0, std::memory_order_relaxed);
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void Crypto::Ecc::SignatureCache::insert(uint8_t const * hash, PublicKey const & pubKey, Signature const & signature)
+{
+    size_t   first;
+    uint64_t f = fingerprint(hash, pubKey, signature, first);
+
+    // Use an empty entry if there is one, unless the signature is already there
+    for (size_t i = first; i < first + WAYS; ++i)
+    {
+        uint64_t expected = entries_[i].load(std::memory_order_relaxed);
+        if (expected == f)
+            return;
+        if (expected == 0 && entries_[i].compare_exchange_strong(expected, f, std::memory_order_relaxed))
+            return;
+    }
+
+    // Otherwise replace an entry chosen by the fingerprint, which is random
+    entries_[first + (f >> 62) % WAYS].store(f, std::memory_order_relaxed);
+}
+
+void Crypto::Ecc::SignatureCache::clear()
+{
+    for (size_t i = 0; i < capacity_; ++i)
+    {
+        entries_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+SignatureCache & Crypto::Ecc::SignatureCache::shared()
+{
+    static SignatureCache cache;
+    return cache;
+}
+
+uint64_t Crypto::Ecc::SignatureCache::fingerprint(uint8_t const *    hash,
+                                                  PublicKey const &  pubKey,
+                                                  Signature const &  signature,
+                                                  size_t &           first) const
+{
+    // The sizes are included so that the boundary between the key and the signature is unambiguous
+    uint8_t sizes[2 * sizeof(uint32_t)];
+    for (size_t i = 0; i < sizeof(uint32_t); ++i)
+    {
+        sizes[i]                    = (uint8_t)(pubKey.size() >> (8 * i));
+        sizes[sizeof(uint32_t) + i] = (uint8_t)(signature.size() >> (8 * i));
+    }
+
+    Sha256Hasher hasher = salted_;
+    hasher.update(hash, SIGNATURE_HASH_SIZE);
+    hasher.update(sizes, sizeof(sizes));
+    hasher.update(pubKey.data(), pubKey.size());
+    hasher.update(signature.data(), signature.size());
+    Sha256Hash digest = hasher.finalize();
+
+    uint64_t f;
+    uint64_t b;
+    memcpy(&f, &digest[0], sizeof(f));
+    memcpy(&b, &digest[8], sizeof(b));
+    first = (size_t)(b & (capacity_ / WAYS - 1)) * WAYS;
+    return (f != 0) ? f : 1;
+}
+
+bool Crypto::Ecc::publicKeyIsValid(uint8_t const * k, size_t size)
+{
+    return PublicKeyCache::shared().get(k, size)->isValid(backend());
 }
 
 bool Crypto::Ecc::privateKeyIsValid(uint8_t const * k, size_t size)
 {
+#if defined(CRYPTO_SECP256K1_NATIVE)
+    if (backend() == BACKEND_NATIVE)
+    {
+        // The key must be in [1, n-1]
+        Secp256k1::Scalar key;
+        return size == PRIVATE_KEY_SIZE && !Secp256k1::scalarSetBytes(key, k) && !Secp256k1::isZero(key);
+    }
+#endif
+
     int rc;
 
     // Load the private key
@@ -114,10 +555,24 @@ bool Crypto::Ecc::privateKeyIsValid(uint8_t const * k, size_t size)
 
 bool Crypto::Ecc::derivePublicKey(PrivateKey const & prvKey, PublicKey & pubKey, bool uncompressed /* = false*/)
 {
-    int rc;
-
     pubKey.clear();
 
+#if defined(CRYPTO_SECP256K1_NATIVE)
+    if (backend() == BACKEND_NATIVE)
+    {
+        Secp256k1::Scalar key;
+        if (Secp256k1::scalarSetBytes(key, prvKey.data()) || Secp256k1::isZero(key))
+            return false;
+
+        Secp256k1::AffinePoint point = Secp256k1::toAffine(Secp256k1::mulGenerator(key));
+        pubKey.resize(uncompressed ? UNCOMPRESSED_PUBLIC_KEY_SIZE : COMPRESSED_PUBLIC_KEY_SIZE);
+        Secp256k1::serializePublicKey(point, !uncompressed, pubKey.data());
+        return true;
+    }
+#endif
+
+    int rc;
+
     // Load the private key
     ecc_key prv;
     rc = wc_ecc_init(&prv);
@@ -163,106 +618,294 @@ bool Crypto::Ecc::derivePublicKey(PrivateKey const & prvKey, PublicKey & pubKey,
     return true;
 }
 
+bool Crypto::Ecc::derivePublicKeys(PrivateKey const * prvKeys,
+                                   size_t             n,
+                                   PublicKey *        pubKeys,
+                                   bool               uncompressed,
+                                   ThreadPool &       pool)
+{
+    size_t nGroups = (n + DERIVE_GROUP_SIZE - 1) / DERIVE_GROUP_SIZE;
+    std::atomic<bool> allValid(true);
+    pool.run(nGroups, [prvKeys, n, pubKeys, uncompressed, &allValid] (size_t group) {
+        size_t begin = group * DERIVE_GROUP_SIZE;
+        size_t end   = std::min(begin + DERIVE_GROUP_SIZE, n);
+#if defined(CRYPTO_SECP256K1_NATIVE)
+        if (backend() == BACKEND_NATIVE)
+        {
+            // Invalid keys are marked as the point at infinity
+            Secp256k1::JacobianPoint points[DERIVE_GROUP_SIZE];
+            for (size_t i = begin; i < end; ++i)
+            {
+                Secp256k1::Scalar key;
+                if (Secp256k1::scalarSetBytes(key, prvKeys[i].data()) || Secp256k1::isZero(key))
+                    points[i - begin].infinity = true;
+                else
+                    points[i - begin] = Secp256k1::mulGenerator(key);
+            }
+
+            Secp256k1::AffinePoint affine[DERIVE_GROUP_SIZE];
+            Secp256k1::toAffine(points, affine, end - begin);
+            for (size_t i = begin; i < end; ++i)
+            {
+                PublicKey & pubKey = pubKeys[i];
+                if (affine[i - begin].infinity)
+                {
+                    pubKey.clear();
+                    allValid = false;
+                    continue;
+                }
+                pubKey.resize(uncompressed ? UNCOMPRESSED_PUBLIC_KEY_SIZE : COMPRESSED_PUBLIC_KEY_SIZE);
+                Secp256k1::serializePublicKey(affine[i - begin], !uncompressed, pubKey.data());
+            }
+            return;
+        }
+#endif
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (!derivePublicKey(prvKeys[i], pubKeys[i], uncompressed))
+                allValid = false;
+        }
+    });
+    return allValid;
+}
+
 bool Crypto::Ecc::sign(uint8_t const * message, size_t size, PrivateKey const & prvKey, Signature & signature)
 {
-    int rc;
+    Sha256Hash hash = sha256(message, size);
+    return signHash(hash.data(), prvKey, signature);
+}
 
+bool Crypto::Ecc::signHash(uint8_t const * hash, PrivateKey const & prvKey, Signature & signature)
+{
     signature.clear();
 
-    // Hash the message
-    Sha256Hash hash = sha256(message, size);
+#if defined(CRYPTO_SECP256K1_NATIVE)
+    if (backend() == BACKEND_NATIVE)
+    {
+        Secp256k1::Scalar key;
+        if (Secp256k1::scalarSetBytes(key, prvKey.data()) || Secp256k1::isZero(key))
+            return false;
 
-    // Set up the rng
-    WC_RNG rng;
-    rc = wc_InitRng(&rng);
-    assert(rc == 0);
+        signature.resize(2 * CURVE_SIZE);
+        Secp256k1::sign(hash, key, signature.data());
+        return true;
+    }
+#endif
 
-    // Load the private key
-    ecc_key prv;
-    rc = wc_ecc_init(&prv);
-    assert(rc == 0);
+    int rc;
 
-    if (!loadPrivateKey(prvKey.data(), (word32)prvKey.size(), &prv))
-    {
-        wc_ecc_free(&prv);
-        wc_FreeRng(&rng);
+    WolfSigningContext & context = wolfSigningContext();
+    if (!context.ready)
         return false;
-    }
 
-    // Set up r & s
-    mp_int r, s;
-    rc = mp_init(&r);
-    assert(rc == MP_OKAY);
-    rc = mp_init(&s);
-    assert(rc == MP_OKAY);
+    if (!loadPrivateKey(prvKey.data(), (word32)prvKey.size(), &context.key))
+        return false;
 
-    rc = wc_ecc_sign_hash_ex(hash.data(), (word32)hash.size(), &rng, &prv, &r, &s);
+    rc = wc_ecc_sign_hash_ex(hash, (word32)SIGNATURE_HASH_SIZE, &context.rng, &context.key, &context.r, &context.s);
     if (rc != 0)
+        return false;
+
+    // Export r and s, padded to the size of the curve
+    signature.resize(2 * CURVE_SIZE);
+    rc = mp_to_unsigned_bin_len(&context.r, &signature[0], CURVE_SIZE);
+    if (rc != MP_OKAY)
     {
-        mp_free(&r);
-        mp_free(&s);
-        wc_ecc_free(&prv);
-        wc_FreeRng(&rng);
+        signature.clear();
+        return false;
+    }
+    rc = mp_to_unsigned_bin_len(&context.s, &signature[CURVE_SIZE], CURVE_SIZE);
+    if (rc != MP_OKAY)
+    {
+        signature.clear();
         return false;
     }
 
-    wc_ecc_free(&prv);
-    wc_FreeRng(&rng);
+    return true;
+}
 
-    /* export r/s */
-    size_t rSize = (size_t)mp_unsigned_bin_size(&r);
-    assert(rSize == CURVE_SIZE);
-    size_t sSize = (size_t)mp_unsigned_bin_size(&s);
-    assert(sSize == CURVE_SIZE);
-    signature.resize(rSize + sSize);
-    mp_to_unsigned_bin(&r, &signature[0]);
-    mp_to_unsigned_bin(&s, &signature[rSize]);
+bool Crypto::Ecc::signBatch(SignJob * jobs, size_t n, ThreadPool & pool)
+{
+    std::atomic<bool> allValid(true);
+    pool.run(n, [jobs, &allValid] (size_t i) {
+        SignJob & job = jobs[i];
+        job.valid = signHash(job.hash, *job.prvKey, job.signature);
+        if (!job.valid)
+            allValid = false;
+    });
+    return allValid;
+}
 
-    mp_free(&r);
-    mp_free(&s);
+bool Crypto::Ecc::verify(uint8_t const * message, size_t size, PublicKey const & pubKey, Signature const & signature)
+{
+    Sha256Hash hash = sha256(message, size);
+    return verifyHash(hash.data(), pubKey, signature);
+}
 
+bool Crypto::Ecc::verifyHash(uint8_t const * hash, PublicKey const & pubKey, Signature const & signature)
+{
+    if (signature.size() != 2 * CURVE_SIZE)
+        return false;
+
+    return verifyParsed(hash, *PublicKeyCache::shared().get(pubKey.data(), pubKey.size()), signature);
+}
+
+bool Crypto::Ecc::verifyHashCached(uint8_t const *    hash,
+                                   PublicKey const &  pubKey,
+                                   Signature const &  signature,
+                                   bool               store,
+                                   SignatureCache &   cache)
+{
+    if (cache.contains(hash, pubKey, signature, !store))
+        return true;
+
+    if (!verifyHash(hash, pubKey, signature))
+        return false;
+
+    if (store)
+        cache.insert(hash, pubKey, signature);
     return true;
 }
 
-bool Crypto::Ecc::verify(uint8_t const * message, size_t size, PublicKey const & pubKey, Signature const & signature)
+bool Crypto::Ecc::verifyBatch(VerifyJob * jobs, size_t n, ThreadPool & pool)
 {
-    int rc;
+    size_t nGroups = (n + VERIFY_GROUP_SIZE - 1) / VERIFY_GROUP_SIZE;
+    std::atomic<bool> allValid(true);
+    pool.run(nGroups, [jobs, n, &allValid] (size_t group) {
+        size_t begin = group * VERIFY_GROUP_SIZE;
+        size_t end   = std::min(begin + VERIFY_GROUP_SIZE, n);
+
+        PublicKey const * keys[VERIFY_GROUP_SIZE];
+        std::shared_ptr<ParsedPublicKey const> parsed[VERIFY_GROUP_SIZE];
+        for (size_t i = begin; i < end; ++i)
+        {
+            keys[i - begin] = jobs[i].pubKey;
+        }
+        PublicKeyCache::shared().getBatch(keys, end - begin, parsed);
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            VerifyJob & job = jobs[i];
+            Sha256Hash hash = sha256(job.message, job.size);
+            job.valid = verifyParsed(hash.data(), *parsed[i - begin], *job.signature);
+            if (!job.valid)
+                allValid = false;
+        }
+    });
+    return allValid;
+}
 
-    if (signature.size() != 2 * CURVE_SIZE)
+bool Crypto::Ecc::deriveXOnlyPublicKey(PrivateKey const & prvKey, PublicKey & pubKey)
+{
+    pubKey.clear();
+
+#if defined(CRYPTO_SECP256K1_NATIVE)
+    Secp256k1::Scalar key;
+    if (Secp256k1::scalarSetBytes(key, prvKey.data()) || Secp256k1::isZero(key))
         return false;
 
-    // Hash the message
-    Sha256Hash hash = sha256(message, size);
+    Secp256k1::AffinePoint point = Secp256k1::toAffine(Secp256k1::mulGenerator(key));
+    pubKey.resize(XONLY_PUBLIC_KEY_SIZE);
+    Secp256k1::fieldGetBytes(point.x, pubKey.data());
+    return true;
+#else
+    (void)prvKey;
+    return false;
+#endif
+}
 
-    ecc_key pub;
-    rc = wc_ecc_init(&pub);
+bool Crypto::Ecc::schnorrSign(uint8_t const *    message,
+                              size_t             size,
+                              PrivateKey const & prvKey,
+                              Signature &        signature,
+                              uint8_t const *    aux /* = nullptr */)
+{
+    signature.clear();
 
-    assert(rc == 0);
-    rc = loadPublicKey(pubKey.data(), pubKey.size(), &pub);
-    if (rc != 0)
-    {
-        wc_ecc_free(&pub);
+#if defined(CRYPTO_SECP256K1_NATIVE)
+    Secp256k1::Scalar key;
+    if (Secp256k1::scalarSetBytes(key, prvKey.data()) || Secp256k1::isZero(key))
         return false;
-    }
 
-    mp_int r;
-    rc = mp_init(&r);
-    assert(rc == MP_OKAY);
-    rc = mp_read_unsigned_bin(&r, &signature[0], CURVE_SIZE);
+    uint8_t random[32];
+    if (!aux)
+    {
+        Random::getBytes(random, sizeof(random));
+        aux = random;
+    }
 
-    mp_int s;
-    rc = mp_init(&s);
-    assert(rc == MP_OKAY);
-    rc = mp_read_unsigned_bin(&s, &signature[CURVE_SIZE], CURVE_SIZE);
+    signature.resize(SCHNORR_SIGNATURE_SIZE);
+    if (!Secp256k1::schnorrSign(message, size, key, aux, signature.data()))
+    {
+        signature.clear();
+        return false;
+    }
+    return true;
+#else
+    (void)message;
+    (void)size;
+    (void)prvKey;
+    (void)aux;
+    return false;
+#endif
+}
 
-    // Verify the signature
-    int verified = 0;
-    rc = wc_ecc_verify_hash_ex(&r, &s, hash.data(), (word32)hash.size(), &verified, &pub);
-    mp_free(&r);
-    mp_free(&s);
-    wc_ecc_free(&pub);
-    if (rc != 0)
+bool Crypto::Ecc::schnorrVerify(uint8_t const *   message,
+                                size_t            size,
+                                PublicKey const & pubKey,
+                                Signature const & signature)
+{
+#if defined(CRYPTO_SECP256K1_NATIVE)
+    if (pubKey.size() != XONLY_PUBLIC_KEY_SIZE || signature.size() != SCHNORR_SIGNATURE_SIZE)
         return false;
+    return Secp256k1::schnorrVerify(message, size, pubKey.data(), signature.data());
+#else
+    (void)message;
+    (void)size;
+    (void)pubKey;
+    (void)signature;
+    return false;
+#endif
+}
 
-    return verified != 0;
+bool Crypto::Ecc::schnorrVerifyBatch(SchnorrVerifyJob * jobs, size_t n, ThreadPool & pool)
+{
+    size_t nGroups = (n + SCHNORR_GROUP_SIZE - 1) / SCHNORR_GROUP_SIZE;
+    std::atomic<bool> allValid(true);
+    pool.run(nGroups, [jobs, n, &allValid] (size_t group) {
+        size_t begin = group * SCHNORR_GROUP_SIZE;
+        size_t end   = std::min(begin + SCHNORR_GROUP_SIZE, n);
+
+        // Signatures and keys that are the wrong size are not valid and are left out of the batch
+#if defined(CRYPTO_SECP256K1_NATIVE)
+        std::vector<Secp256k1::SchnorrItem> items;
+        items.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i)
+        {
+            SchnorrVerifyJob const & job = jobs[i];
+            if (job.pubKey->size() == XONLY_PUBLIC_KEY_SIZE && job.signature->size() == SCHNORR_SIGNATURE_SIZE)
+            {
+                items.push_back(
+                    Secp256k1::SchnorrItem{ job.message, job.size, job.pubKey->data(), job.signature->data() });
+            }
+        }
+        if (items.size() == end - begin && Secp256k1::schnorrVerifyBatch(items.data(), items.size()))
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                jobs[i].valid = true;
+            }
+            return;
+        }
+#endif
+
+        // Find the signatures that are not valid
+        for (size_t i = begin; i < end; ++i)
+        {
+            SchnorrVerifyJob & job = jobs[i];
+            job.valid = schnorrVerify(job.message, job.size, *job.pubKey, *job.signature);
+            if (!job.valid)
+                allValid = false;
+        }
+    });
+    return allValid;
 }
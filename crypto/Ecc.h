@@ -1,7 +1,16 @@
 #pragma once
 
+#include "Sha256.h"
+#include "ThreadPool.h"
+
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 //! @defgroup   CryptoGroup  Cryptographic library
@@ -21,16 +30,203 @@ namespace Ecc
 size_t constexpr PRIVATE_KEY_SIZE             = 256 / 8;                    //!< Size of a private key
 size_t constexpr COMPRESSED_PUBLIC_KEY_SIZE   = 1 + PRIVATE_KEY_SIZE;       //!< Size of a compressed public key
 size_t constexpr UNCOMPRESSED_PUBLIC_KEY_SIZE = 1 + 2 * PRIVATE_KEY_SIZE;   //!< Size of an uncompressed public key
+size_t constexpr SIGNATURE_HASH_SIZE          = 256 / 8;                    //!< Size of the hash that is signed
+size_t constexpr XONLY_PUBLIC_KEY_SIZE        = PRIVATE_KEY_SIZE;           //!< Size of an x-only public key (BIP 340)
+size_t constexpr SCHNORR_SIGNATURE_SIZE       = 2 * PRIVATE_KEY_SIZE;       //!< Size of a Schnorr signature (BIP 340)
 
 typedef std::vector<uint8_t> PublicKey;                         //!< An ECC public key
 typedef std::array<uint8_t, PRIVATE_KEY_SIZE> PrivateKey;       //!< An ECC private key
 typedef std::vector<uint8_t> Signature;                         //!< An ECC signature
 
+//! Implementations of the ECC functions.
+//!
+//! The native implementation is selected automatically if it is available. The native implementation signs with
+//! deterministic nonces (RFC 6979) and wolfSSL signs with random nonces.
+enum Backend
+{
+    BACKEND_WOLFSSL,        //!< wolfSSL's generic ECC code
+    BACKEND_NATIVE,         //!< Arithmetic specialized for secp256k1, with endomorphism-accelerated verification
+    NUM_BACKENDS
+};
+
+//! Returns true if the given ECC implementation is available.
+//! @param  backend     implementation to check
+bool backendIsAvailable(Backend backend);
+
+//! Returns the ECC implementation in use.
+Backend backend();
+
+//! Selects the ECC implementation to use.
+//!
+//! @param  backend     implementation to use
+//! @return false if the implementation is not available (in which case nothing is changed)
+//! @note   This is intended for testing and benchmarking. It must not be called while keys are being used.
+bool selectBackend(Backend backend);
+
+//! Returns the name of an ECC implementation.
+//! @param  backend     implementation
+char const * backendName(Backend backend);
+
+struct ParsedPublicKey;     //!< A public key ready for verifying signatures (opaque)
+
+//! A bounded, thread-safe cache of parsed public keys.
+//!
+//! Parsing a serialized public key (and decompressing it if it is compressed) is a large part of the cost of verifying
+//! a signature. Keys that sign many inputs, such as those of exchange hot wallets and multisig cosigners, are parsed
+//! once and then found in the cache. When the cache is full, the least recently used key is dropped.
+//!
+//! verify() and publicKeyIsValid() use the shared cache.
+class PublicKeyCache
+{
+public:
+
+    static size_t constexpr DEFAULT_CAPACITY = 16384;   //!< Default maximum number of keys
+
+    // Constructor
+    //!
+    //! @param  capacity    maximum number of keys (0 disables caching)
+    explicit PublicKeyCache(size_t capacity = DEFAULT_CAPACITY);
+
+    // Destructor
+    ~PublicKeyCache();
+
+    PublicKeyCache(PublicKeyCache const &) = delete;
+    PublicKeyCache & operator =(PublicKeyCache const &) = delete;
+
+    //! Returns the parsed form of a public key, parsing it and adding it to the cache if it is not already there.
+    //!
+    //! Keys that fail to parse or are not valid are cached too, so that they are rejected quickly.
+    //!
+    //! @param  k       key
+    //! @param  size    size of key
+    std::shared_ptr<ParsedPublicKey const> get(uint8_t const * k, size_t size);
+
+    //! Returns the parsed forms of a number of public keys, parsing the ones that are not already in the cache.
+    //!
+    //! The keys that are parsed are prepared for verification together, using one field inversion for all of them
+    //! rather than one for each, so this is much faster than calling get() for each key when many of them are new, as
+    //! when a block is first seen.
+    //!
+    //! @param      keys    keys
+    //! @param      n       number of keys
+    //! @param[out] parsed  parsed keys (n elements)
+    void getBatch(PublicKey const * const * keys, size_t n, std::shared_ptr<ParsedPublicKey const> * parsed);
+
+    //! Removes all keys. The counters are not reset.
+    void clear();
+
+    //! Returns the number of keys in the cache
+    size_t size() const;
+
+    //! Returns the maximum number of keys in the cache
+    size_t capacity() const { return capacity_; }
+
+    //! Returns the number of calls to get() that found the key in the cache
+    uint64_t hits() const { return hits_; }
+
+    //! Returns the number of calls to get() that had to parse the key
+    uint64_t misses() const { return misses_; }
+
+    //! Returns the cache used by verify() and publicKeyIsValid()
+    static PublicKeyCache & shared();
+
+private:
+
+    typedef std::pair<std::string, std::shared_ptr<ParsedPublicKey const>> Entry;
+
+    // Adds a key if it is not already in the cache, dropping the least recently used key if the cache is full. mutex_
+    // must be held.
+    void insert(std::string && serialized, std::shared_ptr<ParsedPublicKey const> const & parsed);
+
+    size_t capacity_;
+    mutable std::mutex mutex_;                                          // Guards entries_ and index_
+    std::list<Entry> entries_;                                          // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_; // Serialized key -> entry
+    std::atomic<uint64_t> hits_;
+    std::atomic<uint64_t> misses_;
+};
+
+//! A fixed-size, lock-free cache of signatures that have been verified.
+//!
+//! A transaction's signatures are verified when it enters the mempool, and verified again when the block containing it
+//! is connected. If they are added to the cache the first time, the second verification is a lookup.
+//!
+//! An entry is a 64-bit fingerprint taken from a SHA-256 hash of the hash that was signed, the public key and the
+//! signature, salted with a secret random value so that entries cannot be made to collide deliberately. Entries are
+//! stored in buckets of 4, and when a bucket is full, an entry in it is replaced. Lookups and insertions only use
+//! atomic loads, stores and compare-and-swaps on the entries.
+//!
+//! verifyHashCached() uses the shared cache by default.
+class SignatureCache
+{
+public:
+
+    static size_t constexpr DEFAULT_CAPACITY = 1 << 20;     //!< Default number of entries (8 MiB)
+
+    // Constructor
+    //!
+    //! @param  capacity    number of entries (rounded up to a power of 2, and at least 4)
+    explicit SignatureCache(size_t capacity = DEFAULT_CAPACITY);
+
+    SignatureCache(SignatureCache const &) = delete;
+    SignatureCache & operator =(SignatureCache const &) = delete;
+
+    //! Returns true if the signature is in the cache.
+    //!
+    //! @param  hash        hash that was signed (SIGNATURE_HASH_SIZE bytes)
+    //! @param  pubKey      public key
+    //! @param  signature   signature
+    //! @param  erase       if true, the entry is removed (for example, when it will not be needed again)
+    bool contains(uint8_t const *    hash,
+                  PublicKey const &  pubKey,
+                  Signature const &  signature,
+                  bool               erase = false);
+
+    //! Adds a signature that has been verified.
+    //!
+    //! @param  hash        hash that was signed (SIGNATURE_HASH_SIZE bytes)
+    //! @param  pubKey      public key
+    //! @param  signature   signature
+    void insert(uint8_t const * hash, PublicKey const & pubKey, Signature const & signature);
+
+    //! Removes all entries. The counters are not reset.
+    void clear();
+
+    //! Returns the number of entries
+    size_t capacity() const { return capacity_; }
+
+    //! Returns the number of calls to contains() that found the signature
+    uint64_t hits() const { return hits_; }
+
+    //! Returns the number of calls to contains() that did not find the signature
+    uint64_t misses() const { return misses_; }
+
+    //! Returns the cache used by default by verifyHashCached()
+    static SignatureCache & shared();
+
+private:
+
+    static size_t constexpr WAYS = 4;   // Number of entries in a bucket
+
+    // Returns the fingerprint of an entry (never 0) and sets the index of the first entry in its bucket
+    uint64_t fingerprint(uint8_t const *    hash,
+                         PublicKey const &  pubKey,
+                         Signature const &  signature,
+                         size_t &           first) const;
+
+    size_t capacity_;
+    std::unique_ptr<std::atomic<uint64_t>[]> entries_;  // 0 means empty
+    Sha256Hasher salted_;                               // A hasher that has already hashed the salt
+    std::atomic<uint64_t> hits_;
+    std::atomic<uint64_t> misses_;
+};
+
 //! Returns true if the public key is valid.
 //!
 //! @param  k       key
 //! @param  size    size of key
 //! @return true if the key is valid
+//! @note   The result is cached in PublicKeyCache::shared().
 bool publicKeyIsValid(uint8_t const * k, size_t size);
 
 //! Returns true if the public key is valid.
@@ -60,16 +256,86 @@ bool privateKeyIsValid(PrivateKey const & k);
 //! @return true if the returned key is valid
 bool derivePublicKey(PrivateKey const & prvKey, PublicKey & pubKey, bool uncompressed = false);
 
+//! Derives the public keys of a number of private keys.
+//!
+//! The keys are divided into groups that are derived concurrently by the threads of a pool. The keys in a group share
+//! a single field inversion when they are converted to affine coordinates. Each result is the same as the result of
+//! derivePublicKey().
+//!
+//! @param      prvKeys         private keys
+//! @param      n               number of keys
+//! @param[out] pubKeys         derived public keys (n elements, a key is empty if its private key is not valid)
+//! @param      uncompressed    if true, then the resulting public keys are uncompressed (default: false)
+//! @param      pool            threads to use
+//! @return true if every private key is valid
+bool derivePublicKeys(PrivateKey const * prvKeys,
+                      size_t             n,
+                      PublicKey *        pubKeys,
+                      bool               uncompressed = false,
+                      ThreadPool &       pool         = ThreadPool::shared());
+
+//! Derives the public keys of a number of private keys.
+//!
+//! @param      prvKeys         private keys
+//! @param[out] pubKeys         derived public keys (a key is empty if its private key is not valid)
+//! @param      uncompressed    if true, then the resulting public keys are uncompressed (default: false)
+//! @param      pool            threads to use
+//! @return true if every private key is valid
+bool derivePublicKeys(std::vector<PrivateKey> const & prvKeys,
+                      std::vector<PublicKey> &        pubKeys,
+                      bool                            uncompressed = false,
+                      ThreadPool &                    pool         = ThreadPool::shared());
+
 //! Signs a message.
 //!
+//! The message is hashed with SHA-256 and the hash is signed with signHash().
+//!
 //! @param      message     message to sign
 //! @param      size        size of the message
 //! @param      prvKey      private key
-//! @param      pubKey      public key
 //! @param[out] signature   signature
 //! @return true if the returned signature is valid
 bool sign(uint8_t const * message, size_t size, PrivateKey const & prvKey, Signature & signature);
 
+//! Signs a hash, such as the signature hash of a transaction input.
+//!
+//! The signature is r || s (64 bytes). The native implementation uses a deterministic nonce (RFC 6979 with
+//! HMAC-SHA256), so the same key and hash always give the same signature, and it always returns s in the lower half
+//! of its range. The wolfSSL implementation reuses a random number generator that is set up once per thread.
+//!
+//! @param      hash        hash to sign (SIGNATURE_HASH_SIZE bytes)
+//! @param      prvKey      private key
+//! @param[out] signature   signature
+//! @return true if the returned signature is valid
+bool signHash(uint8_t const * hash, PrivateKey const & prvKey, Signature & signature);
+
+//! A hash to be signed by signBatch()
+struct SignJob
+{
+    uint8_t const * hash;           //!< Hash to sign (SIGNATURE_HASH_SIZE bytes)
+    PrivateKey const * prvKey;      //!< Private key
+    Signature signature;            //!< Set by signBatch() to the signature
+    bool valid;                     //!< Set by signBatch() to the result of signHash()
+};
+
+//! Signs a number of hashes.
+//!
+//! The hashes are signed concurrently by the threads of a pool. The result for each job is the same as the result of
+//! signHash().
+//!
+//! @param      jobs    hashes to sign (the signature and valid members of each are set)
+//! @param      n       number of jobs
+//! @param      pool    threads to use
+//! @return true if every signature is valid
+bool signBatch(SignJob * jobs, size_t n, ThreadPool & pool = ThreadPool::shared());
+
+//! Signs a number of hashes.
+//!
+//! @param      jobs    hashes to sign (the signature and valid members of each are set)
+//! @param      pool    threads to use
+//! @return true if every signature is valid
+bool signBatch(std::vector<SignJob> & jobs, ThreadPool & pool = ThreadPool::shared());
+
 //! Verifies a signed message.
 //!
 //! @param      message     message to sign
@@ -77,8 +343,134 @@ bool sign(uint8_t const * message, size_t size, PrivateKey const & prvKey, Signa
 //! @param      pubKey      public key
 //! @param      signature   signature
 //! @return true if the message's signature is valid and it matches the message
+//! @note   The parsed public key is cached in PublicKeyCache::shared().
 bool verify(uint8_t const * message, size_t size, PublicKey const & pubKey, Signature const & signature);
 
+//! Verifies a signature of a hash.
+//!
+//! @param      hash        hash that was signed (SIGNATURE_HASH_SIZE bytes)
+//! @param      pubKey      public key
+//! @param      signature   signature
+//! @return true if the signature is valid and it matches the hash
+//! @note   The parsed public key is cached in PublicKeyCache::shared().
+bool verifyHash(uint8_t const * hash, PublicKey const & pubKey, Signature const & signature);
+
+//! Verifies a signature of a hash, skipping the verification if the signature is in a signature cache.
+//!
+//! When a transaction enters the mempool, its signatures are verified with store = true, which adds them to the
+//! cache. When the block containing the transaction is connected, they are verified with store = false, which finds
+//! them and removes them from the cache.
+//!
+//! @param      hash        hash that was signed (SIGNATURE_HASH_SIZE bytes)
+//! @param      pubKey      public key
+//! @param      signature   signature
+//! @param      store       if true, a valid signature is added to the cache, otherwise a cached one is removed
+//! @param      cache       cache to use
+//! @return true if the signature is valid and it matches the hash
+bool verifyHashCached(uint8_t const *    hash,
+                      PublicKey const &  pubKey,
+                      Signature const &  signature,
+                      bool               store,
+                      SignatureCache &   cache = SignatureCache::shared());
+
+//! A signature to be checked by verifyBatch()
+struct VerifyJob
+{
+    uint8_t const * message;        //!< Message that was signed
+    size_t size;                    //!< Size of the message
+    PublicKey const * pubKey;       //!< Public key
+    Signature const * signature;    //!< Signature
+    bool valid;                     //!< Set by verifyBatch() to the result of verify()
+};
+
+//! Verifies a number of signed messages.
+//!
+//! The signatures are checked concurrently by the threads of a pool, in groups. The public keys of each group are
+//! found or parsed together with PublicKeyCache::getBatch(). The result for each job is the same as the result
+//! of verify(). To check the signatures in order on the calling thread (for example, in tests), use a pool with a
+//! single thread.
+//!
+//! @param      jobs    signatures to check (the valid member of each is set to the result)
+//! @param      n       number of jobs
+//! @param      pool    threads to use
+//! @return true if every signature is valid
+bool verifyBatch(VerifyJob * jobs, size_t n, ThreadPool & pool = ThreadPool::shared());
+
+//! Verifies a number of signed messages.
+//!
+//! @param      jobs    signatures to check (the valid member of each is set to the result)
+//! @param      pool    threads to use
+//! @return true if every signature is valid
+bool verifyBatch(std::vector<VerifyJob> & jobs, ThreadPool & pool = ThreadPool::shared());
+
+//! @name Schnorr signatures (BIP 340)
+//!
+//! Schnorr signatures always use the native implementation, whichever implementation is selected, because wolfSSL does
+//! not support them. If the native implementation is not available, these functions return false.
+//!@{
+
+//! Derives the x-only public key of a private key.
+//!
+//! @param      prvKey      private key
+//! @param[out] pubKey      derived public key (XONLY_PUBLIC_KEY_SIZE bytes)
+//! @return true if the returned key is valid
+bool deriveXOnlyPublicKey(PrivateKey const & prvKey, PublicKey & pubKey);
+
+//! Signs a message.
+//!
+//! @param      message     message to sign
+//! @param      size        size of the message
+//! @param      prvKey      private key
+//! @param[out] signature   signature (SCHNORR_SIGNATURE_SIZE bytes)
+//! @param      aux         32 bytes of auxiliary random data, or nullptr to generate them with Random::getBytes()
+//! @return true if the returned signature is valid
+bool schnorrSign(uint8_t const *    message,
+                 size_t             size,
+                 PrivateKey const & prvKey,
+                 Signature &        signature,
+                 uint8_t const *    aux = nullptr);
+
+//! Verifies a signed message.
+//!
+//! @param      message     message that was signed
+//! @param      size        size of the message
+//! @param      pubKey      x-only public key
+//! @param      signature   signature
+//! @return true if the signature is valid and it matches the message and the key
+bool schnorrVerify(uint8_t const * message, size_t size, PublicKey const & pubKey, Signature const & signature);
+
+//! A signature to be checked by schnorrVerifyBatch()
+struct SchnorrVerifyJob
+{
+    uint8_t const * message;        //!< Message that was signed
+    size_t size;                    //!< Size of the message
+    PublicKey const * pubKey;       //!< x-only public key
+    Signature const * signature;    //!< Signature
+    bool valid;                     //!< Set by schnorrVerifyBatch() to the result of schnorrVerify()
+};
+
+//! Verifies a number of signed messages using batch verification.
+//!
+//! The jobs are divided into groups that are checked concurrently by the threads of a pool. The signatures of a group
+//! are checked together with one multi-scalar multiplication, which is much cheaper than checking them one at a time.
+//! If a group fails, its signatures are checked one at a time to find the ones that are not valid, so the result for
+//! each job is the same as the result of schnorrVerify().
+//!
+//! @param      jobs    signatures to check (the valid member of each is set to the result)
+//! @param      n       number of jobs
+//! @param      pool    threads to use
+//! @return true if every signature is valid
+bool schnorrVerifyBatch(SchnorrVerifyJob * jobs, size_t n, ThreadPool & pool = ThreadPool::shared());
+
+//! Verifies a number of signed messages using batch verification.
+//!
+//! @param      jobs    signatures to check (the valid member of each is set to the result)
+//! @param      pool    threads to use
+//! @return true if every signature is valid
+bool schnorrVerifyBatch(std::vector<SchnorrVerifyJob> & jobs, ThreadPool & pool = ThreadPool::shared());
+
+//!@}
+
 /********************************************************************************************************************/
 
 inline bool publicKeyIsValid(PublicKey const & k)
@@ -91,5 +483,29 @@ inline bool privateKeyIsValid(PrivateKey const & k)
     return privateKeyIsValid(k.data(), k.size());
 }
 
+inline bool derivePublicKeys(std::vector<PrivateKey> const & prvKeys,
+                             std::vector<PublicKey> &        pubKeys,
+                             bool                            uncompressed,
+                             ThreadPool &                    pool)
+{
+    pubKeys.resize(prvKeys.size());
+    return derivePublicKeys(prvKeys.data(), prvKeys.size(), pubKeys.data(), uncompressed, pool);
+}
+
+inline bool signBatch(std::vector<SignJob> & jobs, ThreadPool & pool)
+{
+    return signBatch(jobs.data(), jobs.size(), pool);
+}
+
+inline bool verifyBatch(std::vector<VerifyJob> & jobs, ThreadPool & pool)
+{
+    return verifyBatch(jobs.data(), jobs.size(), pool);
+}
+
+inline bool schnorrVerifyBatch(std::vector<SchnorrVerifyJob> & jobs, ThreadPool & pool)
+{
+    return schnorrVerifyBatch(jobs.data(), jobs.size(), pool);
+}
+
 } // namespace Ecc
 } // namespace Crypto
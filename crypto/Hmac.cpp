@@ -1,23 +1,93 @@
 #include "Hmac.h"
+#include "Sha256.h"
 #include "Sha512.h"
 
-#include "utility/Debug.h"
-
-#include <wolfssl/options.h>
-#include <wolfssl/wolfcrypt/settings.h>
-#include <wolfssl/wolfcrypt/hmac.h>
-#include <wolfssl/wolfcrypt/sha512.h>
-
+#include <algorithm>
 #include <cassert>
 
+namespace
+{
+size_t const BLOCK_SIZE = 128;  // Size of a SHA-512 block
+size_t const SHA256_BLOCK_SIZE = 64;
+uint8_t const IPAD = 0x36;
+uint8_t const OPAD = 0x5c;
+} // anonymous namespace
+
 namespace Crypto
 {
 
+HmacSha512::HmacSha512(uint8_t const * key, size_t keySize)
+{
+    // Keys longer than a block are hashed first. Shorter keys are padded with 0s.
+    uint8_t padded[BLOCK_SIZE] = {};
+    if (keySize > BLOCK_SIZE)
+    {
+        Sha512Hash hash = sha512(key, keySize);
+        std::copy(hash.begin(), hash.end(), padded);
+    }
+    else
+    {
+        std::copy(key, key + keySize, padded);
+    }
+
+    uint8_t pad[BLOCK_SIZE];
+    std::transform(padded, padded + BLOCK_SIZE, pad, [] (uint8_t x) { return x ^ IPAD; });
+    inner_.update(pad, BLOCK_SIZE);
+    std::transform(padded, padded + BLOCK_SIZE, pad, [] (uint8_t x) { return x ^ OPAD; });
+    outer_.update(pad, BLOCK_SIZE);
+}
+
+Sha512Hash HmacSha512::mac(uint8_t const * message, size_t messageSize) const
+{
+    Sha512Hasher inner = inner_;
+    inner.update(message, messageSize);
+    Sha512Hash innerHash = inner.finalize();
+
+    Sha512Hasher outer = outer_;
+    outer.update(innerHash.data(), innerHash.size());
+    return outer.finalize();
+}
+
+HmacSha256::HmacSha256(uint8_t const * key, size_t keySize)
+{
+    // Keys longer than a block are hashed first. Shorter keys are padded with 0s.
+    uint8_t padded[SHA256_BLOCK_SIZE] = {};
+    if (keySize > SHA256_BLOCK_SIZE)
+    {
+        Sha256Hash hash = sha256(key, keySize);
+        std::copy(hash.begin(), hash.end(), padded);
+    }
+    else
+    {
+        std::copy(key, key + keySize, padded);
+    }
+
+    uint8_t pad[SHA256_BLOCK_SIZE];
+    std::transform(padded, padded + SHA256_BLOCK_SIZE, pad, [] (uint8_t x) { return x ^ IPAD; });
+    inner_.update(pad, SHA256_BLOCK_SIZE);
+    std::transform(padded, padded + SHA256_BLOCK_SIZE, pad, [] (uint8_t x) { return x ^ OPAD; });
+    outer_.update(pad, SHA256_BLOCK_SIZE);
+}
+
+Sha256Hash HmacSha256::mac(uint8_t const * message, size_t messageSize) const
+{
+    Sha256Hasher inner = inner_;
+    inner.update(message, messageSize);
+    Sha256Hash innerHash = inner.finalize();
+
+    Sha256Hasher outer = outer_;
+    outer.update(innerHash.data(), innerHash.size());
+    return outer.finalize();
+}
+
+Sha256Hash hmacSha256(uint8_t const * key, size_t keySize, uint8_t const * message, size_t messageSize)
+{
+    return HmacSha256(key, keySize).mac(message, messageSize);
+}
+
 Sha512Hash hmacSha512(uint8_t const * key, size_t keySize, uint8_t const * message, size_t messageSize)
 {
-    NOT_YET_IMPLEMENTED();
-    Sha512Hash hash = {};
-    return hash;
+    return HmacSha512(key, keySize).mac(message, messageSize);
 }
 
 } // namespace Crypto
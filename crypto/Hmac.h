@@ -1,15 +1,103 @@
 #pragma once
 
+#include "Sha256.h"
 #include "Sha512.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace Crypto
 {
+//! @addtogroup CryptoGroup
+//!@{
+
+//! Computes HMACs using SHA-512 with a fixed key.
+//!
+//! The states of the inner and outer hashes after the padded key are computed once by the constructor, so each MAC of
+//! a message shorter than 112 bytes costs only two SHA-512 compressions.
+class HmacSha512
+{
+public:
+
+    // Constructor
+    //!
+    //! @param  key         key
+    //! @param  keySize     size of the key
+    HmacSha512(uint8_t const * key, size_t keySize);
+
+    // Constructor
+    //!
+    //! @param  key         key
+    explicit HmacSha512(std::vector<uint8_t> const & key) : HmacSha512(key.data(), key.size()) {}
+
+    //! Returns the HMAC of a message.
+    //!
+    //! @param  message         message to generate the HMAC for
+    //! @param  messageSize     size of the message
+    Sha512Hash mac(uint8_t const * message, size_t messageSize) const;
+
+    //! Returns the HMAC of a message.
+    //!
+    //! @param  message         message to generate the HMAC for
+    Sha512Hash mac(std::vector<uint8_t> const & message) const { return mac(message.data(), message.size()); }
+
+private:
+
+    Sha512Hasher inner_;    // State after the key XOR ipad
+    Sha512Hasher outer_;    // State after the key XOR opad
+};
+
+//! Computes HMACs using SHA-256 with a fixed key.
+//!
+//! The states of the inner and outer hashes after the padded key are computed once by the constructor, so each MAC of
+//! a message shorter than 56 bytes costs only two SHA-256 compressions.
+class HmacSha256
+{
+public:
+
+    // Constructor
+    //!
+    //! @param  key         key
+    //! @param  keySize     size of the key
+    HmacSha256(uint8_t const * key, size_t keySize);
+
+    // Constructor
+    //!
+    //! @param  key         key
+    explicit HmacSha256(std::vector<uint8_t> const & key) : HmacSha256(key.data(), key.size()) {}
+
+    //! Returns the HMAC of a message.
+    //!
+    //! @param  message         message to generate the HMAC for
+    //! @param  messageSize     size of the message
+    Sha256Hash mac(uint8_t const * message, size_t messageSize) const;
+
+    //! Returns the HMAC of a message.
+    //!
+    //! @param  message         message to generate the HMAC for
+    Sha256Hash mac(std::vector<uint8_t> const & message) const { return mac(message.data(), message.size()); }
+
+private:
+
+    Sha256Hasher inner_;    // State after the key XOR ipad
+    Sha256Hasher outer_;    // State after the key XOR opad
+};
+
+//! Computes an HMAC of the message using SHA-256.
+//!
+//! @param  key             key
+//! @param  keySize         size of the key
+//! @param  message         message to generate the HMAC for
+//! @param  messageSize     size of the message
+Sha256Hash hmacSha256(uint8_t const * key, size_t keySize, uint8_t const * message, size_t messageSize);
+
 //! Computes an HMAC of the message using SHA-512.
 //!
 //! @param  key             key
 //! @param  keySize         size of the key
 //! @param  message         message to generate the HMAC for
 //! @param  messageSize     size of the message
-//! @ingroup CryptoGroup
-    Sha512Hash hmacSha512(uint8_t const * key, size_t keySize, uint8_t const * message, size_t messageSize);
-}
+Sha512Hash hmacSha512(uint8_t const * key, size_t keySize, uint8_t const * message, size_t messageSize);
+
+//!@}
+} // namespace Crypto
@@ -1,13 +1,145 @@
 #include "Pbkdf2.h"
 
-#include <wolfssl/options.h>
-#include <wolfssl/wolfcrypt/settings.h>
-#include <wolfssl/wolfcrypt/pwdbased.h>
-#include <wolfssl/wolfcrypt/sha512.h>
+#include "Sha512Impl.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 
+using namespace Crypto::Sha512Impl;
+
+namespace
+{
+size_t const HASH_SIZE = Crypto::SHA512_HASH_SIZE;
+uint8_t const IPAD     = 0x36;
+uint8_t const OPAD     = 0x5c;
+
+// A derived key is made of 64-byte blocks, each computed independently. A task is one block of one key.
+struct Task
+{
+    uint8_t const * password;
+    size_t passwordSize;
+    uint8_t const * salt;
+    size_t saltSize;
+    uint32_t index;         // Block number, starting at 1
+    uint8_t * out;          // Where the block goes
+    size_t outSize;         // Number of bytes of the block that are used
+};
+
+// Computes the states of the inner and outer hashes of HMAC-SHA512 after the padded key
+void keyStates(uint8_t const * key, size_t keySize, uint64_t * inner, uint64_t * outer)
+{
+    Transform transform = Crypto::Sha512Impl::transform();
+
+    // Keys longer than a block are hashed first. Shorter keys are padded with 0s.
+    uint8_t padded[BLOCK_SIZE] = {};
+    if (keySize > BLOCK_SIZE)
+    {
+        Crypto::Sha512Hash hash = Crypto::sha512(key, keySize);
+        std::copy(hash.begin(), hash.end(), padded);
+    }
+    else
+    {
+        std::copy(key, key + keySize, padded);
+    }
+
+    uint8_t pad[BLOCK_SIZE];
+    std::transform(padded, padded + BLOCK_SIZE, pad, [] (uint8_t x) { return x ^ IPAD; });
+    std::copy(INITIAL_STATE, INITIAL_STATE + STATE_SIZE, inner);
+    transform(inner, pad, 1);
+    std::transform(padded, padded + BLOCK_SIZE, pad, [] (uint8_t x) { return x ^ OPAD; });
+    std::copy(INITIAL_STATE, INITIAL_STATE + STATE_SIZE, outer);
+    transform(outer, pad, 1);
+}
+
+// Computes U1 = HMAC(P, S || INT(i)) of a task from the states of the inner and outer hashes after the padded key
+void firstBlock(Task const & task, uint64_t const * inner, uint64_t const * outer, uint64_t * u1)
+{
+    Transform transform = Crypto::Sha512Impl::transform();
+
+    // Inner hash of S || INT(i). The full blocks of the salt are hashed where they are, and the rest of the salt is
+    // followed by the block number and the padding.
+    uint64_t state[STATE_SIZE];
+    std::copy(inner, inner + STATE_SIZE, state);
+    size_t fullBlocks = task.saltSize / BLOCK_SIZE;
+    transform(state, task.salt, fullBlocks);
+
+    uint8_t rest[BLOCK_SIZE + 4];
+    size_t restSize = task.saltSize % BLOCK_SIZE;
+    std::copy(task.salt + fullBlocks * BLOCK_SIZE, task.salt + task.saltSize, rest);
+    rest[restSize++] = (uint8_t)(task.index >> 24);
+    rest[restSize++] = (uint8_t)(task.index >> 16);
+    rest[restSize++] = (uint8_t)(task.index >> 8);
+    rest[restSize++] = (uint8_t)task.index;
+    uint8_t const * last = rest;
+    if (restSize >= BLOCK_SIZE)
+    {
+        transform(state, rest, 1);
+        last += BLOCK_SIZE;
+    }
+
+    uint8_t tail[2 * BLOCK_SIZE];
+    transform(state, tail, pad(last, BLOCK_SIZE + task.saltSize + 4, tail));
+
+    // Outer hash of the inner hash
+    uint8_t digest[HASH_SIZE];
+    for (size_t i = 0; i < STATE_SIZE; ++i)
+    {
+        writeBigEndian64(&digest[8 * i], state[i]);
+    }
+    std::copy(outer, outer + STATE_SIZE, u1);
+    transform(u1, tail, pad(digest, BLOCK_SIZE + HASH_SIZE, tail));
+}
+
+// Computes the blocks of up to "lanes" tasks at once. Unused lanes repeat the first task.
+void runTasks(Task const * tasks, size_t n, int count, LanePbkdf2 kernel, int lanes)
+{
+    assert(n > 0 && n <= (size_t)lanes);
+
+    uint64_t inner[STATE_SIZE * 16];
+    uint64_t outer[STATE_SIZE * 16];
+    uint64_t t[STATE_SIZE * 16];
+    for (size_t lane = 0; lane < n; ++lane)
+    {
+        uint64_t laneInner[STATE_SIZE];
+        uint64_t laneOuter[STATE_SIZE];
+        uint64_t laneT[STATE_SIZE];
+        keyStates(tasks[lane].password, tasks[lane].passwordSize, laneInner, laneOuter);
+        firstBlock(tasks[lane], laneInner, laneOuter, laneT);
+
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            inner[i * lanes + lane] = laneInner[i];
+            outer[i * lanes + lane] = laneOuter[i];
+            t[i * lanes + lane]     = laneT[i];
+        }
+    }
+
+    // The unused lanes are copies of the first one
+    for (size_t lane = n; lane < (size_t)lanes; ++lane)
+    {
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            inner[i * lanes + lane] = inner[i * lanes];
+            outer[i * lanes + lane] = outer[i * lanes];
+            t[i * lanes + lane]     = t[i * lanes];
+        }
+    }
+
+    kernel(inner, outer, t, count);
+
+    for (size_t lane = 0; lane < n; ++lane)
+    {
+        uint8_t block[HASH_SIZE];
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            writeBigEndian64(&block[8 * i], t[i * lanes + lane]);
+        }
+        std::copy(block, block + tasks[lane].outSize, tasks[lane].out);
+    }
+}
+} // anonymous namespace
+
 namespace Crypto
 {
 
@@ -19,14 +151,91 @@ std::vector<uint8_t> pbkdf2HmacSha512(uint8_t const * password, size_t passwordS
     assert(count > 0);
     assert(size > 0);
 
-    int rc;
-    std::vector<uint8_t> key(WC_SHA512_DIGEST_SIZE);
+    std::vector<uint8_t> key(size);
+    uint8_t * keys[] = { key.data() };
+    pbkdf2HmacSha512Batch(&password, &passwordSize, &salt, &saltSize, 1, count, size, keys);
+    return key;
+}
 
-    rc = wc_PBKDF2(&key[0], password, (word32)passwordSize, salt, (word32)saltSize, count, WC_SHA512_DIGEST_SIZE, WC_SHA512);
-    if (!rc)
-        return std::vector<uint8_t>();
+void pbkdf2HmacSha512Batch(uint8_t const * const * passwords,
+                           size_t const *          passwordSizes,
+                           uint8_t const * const * salts,
+                           size_t const *          saltSizes,
+                           size_t                  n,
+                           int                     count,
+                           size_t                  size,
+                           uint8_t * const *       keys,
+                           ThreadPool &            pool)
+{
+    assert(count > 0);
+    assert(size > 0);
 
-    return key;
+    // Split the keys into blocks
+    std::vector<Task> tasks;
+    size_t blocksPerKey = (size + HASH_SIZE - 1) / HASH_SIZE;
+    tasks.reserve(n * blocksPerKey);
+    for (size_t k = 0; k < n; ++k)
+    {
+        for (size_t b = 0; b < blocksPerKey; ++b)
+        {
+            size_t offset = b * HASH_SIZE;
+            tasks.push_back(Task{ passwords[k], passwordSizes[k], salts[k], saltSizes[k], (uint32_t)(b + 1),
+                                  keys[k] + offset, std::min(HASH_SIZE, size - offset) });
+        }
+    }
+
+    // Groups of tasks fill the lanes of the selected kernel. A final partial group is computed in the vector lanes only
+    // if it fills at least half of them. Otherwise, its tasks are computed one at a time.
+    int lanes;
+    LanePbkdf2 kernel = lanePbkdf2(lanes);
+    size_t nGroups    = tasks.size() / lanes;
+    size_t rest       = tasks.size() % lanes;
+    size_t nSingles   = 0;
+    if (rest * 2 >= (size_t)lanes)
+        ++nGroups;
+    else
+        nSingles = rest;
+
+    pool.run(nGroups + nSingles, [&] (size_t i) {
+        if (i < nGroups)
+        {
+            size_t first = i * lanes;
+            runTasks(&tasks[first], std::min((size_t)lanes, tasks.size() - first), count, kernel, lanes);
+        }
+        else
+        {
+            runTasks(&tasks[tasks.size() - nSingles + (i - nGroups)], 1, count, pbkdf2Portable, 1);
+        }
+    });
+}
+
+std::vector<std::vector<uint8_t>> pbkdf2HmacSha512Batch(std::vector<std::vector<uint8_t>> const & passwords,
+                                                        std::vector<std::vector<uint8_t>> const & salts,
+                                                        int                                       count,
+                                                        size_t                                    size,
+                                                        ThreadPool &                              pool)
+{
+    assert(passwords.size() == salts.size());
+
+    size_t n = passwords.size();
+    std::vector<std::vector<uint8_t>> keys(n, std::vector<uint8_t>(size));
+    std::vector<uint8_t const *> passwordData(n);
+    std::vector<size_t> passwordSizes(n);
+    std::vector<uint8_t const *> saltData(n);
+    std::vector<size_t> saltSizes(n);
+    std::vector<uint8_t *> keyData(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        passwordData[i]  = passwords[i].data();
+        passwordSizes[i] = passwords[i].size();
+        saltData[i]      = salts[i].data();
+        saltSizes[i]     = salts[i].size();
+        keyData[i]       = keys[i].data();
+    }
+
+    pbkdf2HmacSha512Batch(passwordData.data(), passwordSizes.data(), saltData.data(), saltSizes.data(), n, count, size,
+                          keyData.data(), pool);
+    return keys;
 }
 
 } // namespace Crypto
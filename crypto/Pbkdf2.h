@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ThreadPool.h"
+
 #include <vector>
 #include <cstdint>
 
@@ -34,6 +36,43 @@ std::vector<uint8_t> pbkdf2HmacSha512(uint8_t const * password,
                                       int             count,
                                       size_t          size);
 
+//! Computes PBKDF2 using HMAC-SHA512 for several passwords and salts at once.
+//!
+//! The iterations for several passwords are computed together in the lanes of the SIMD registers, and groups of
+//! passwords are distributed among the threads of a pool.
+//!
+//! @param  passwords       passwords
+//! @param  passwordSizes   lengths of the passwords
+//! @param  salts           salts
+//! @param  saltSizes       lengths of the salts
+//! @param  n               number of passwords and salts
+//! @param  count           number of iterations
+//! @param  size            desired size of each derived key
+//! @param  keys            buffers of size bytes that receive the derived keys
+//! @param  pool            threads to use
+void pbkdf2HmacSha512Batch(uint8_t const * const * passwords,
+                           size_t const *          passwordSizes,
+                           uint8_t const * const * salts,
+                           size_t const *          saltSizes,
+                           size_t                  n,
+                           int                     count,
+                           size_t                  size,
+                           uint8_t * const *       keys,
+                           ThreadPool &            pool = ThreadPool::shared());
+
+//! Returns the results of PBKDF2 using HMAC-SHA512 for several passwords and salts.
+//!
+//! @param  passwords   passwords
+//! @param  salts       salts (one for each password)
+//! @param  count       number of iterations
+//! @param  size        desired size of each derived key
+//! @param  pool        threads to use
+std::vector<std::vector<uint8_t>> pbkdf2HmacSha512Batch(std::vector<std::vector<uint8_t>> const & passwords,
+                                                        std::vector<std::vector<uint8_t>> const & salts,
+                                                        int                                       count,
+                                                        size_t                                    size,
+                                                        ThreadPool &                              pool = ThreadPool::shared());
+
 //!@}
 
 /********************************************************************************************************************/
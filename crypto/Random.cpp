@@ -1,9 +1,246 @@
 #include "Random.h"
 
-#include "utility/Debug.h"
+#include "ChaCha20.h"
+#include "Sha256.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cerrno>
+#include <cstring>
 #include <limits>
+#include <mutex>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <bcrypt.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "bcrypt")
+#endif
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sys/random.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// Key stream is generated this many blocks at a time
+size_t constexpr BUFFER_BLOCKS = 16;
+size_t constexpr BUFFER_SIZE   = BUFFER_BLOCKS * Crypto::CHACHA20_BLOCK_SIZE;
+
+// A thread's generator is reseeded from the system after it generates this many bytes
+uint64_t constexpr RESEED_INTERVAL = 1 << 24;
+
+// Reads bytes from the system's entropy source. Returns false if the source is not available.
+bool getSystemEntropy(uint8_t * buffer, size_t size)
+{
+#if defined(_WIN32)
+    return BCryptGenRandom(NULL, buffer, (ULONG)size, BCRYPT_USE_SYSTEM_PREFERRED_RNG) == 0;
+#elif defined(__linux__)
+    while (size > 0)
+    {
+        ssize_t n = getrandom(buffer, size, 0);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        buffer += n;
+        size   -= (size_t)n;
+    }
+    return true;
+#else
+    // getentropy() returns at most 256 bytes per call
+    while (size > 0)
+    {
+        size_t n = std::min(size, (size_t)256);
+        if (getentropy(buffer, n) != 0)
+            return false;
+        buffer += n;
+        size   -= n;
+    }
+    return true;
+#endif
+}
+
+// Entropy added with addEntropy(), shared by all threads. Each thread mixes it into its generator when the generation
+// number changes.
+class EntropyPool
+{
+public:
+
+    // Returns the pool
+    static EntropyPool & shared()
+    {
+        static EntropyPool pool;
+        return pool;
+    }
+
+    // Mixes entropy into the pool
+    void add(uint8_t const * buffer, size_t size, double entropy)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<uint8_t> input(pool_.begin(), pool_.end());
+        input.insert(input.end(), buffer, buffer + size);
+        pool_ = Crypto::sha256(input);
+        std::fill(input.begin(), input.end(), 0);
+        entropy_ += entropy;
+        changed();
+    }
+
+    // Returns the contents of the pool
+    Crypto::Sha256Hash get() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pool_;
+    }
+
+    // Returns the generation number, which changes when the pool changes or the process forks
+    uint64_t generation() const
+    {
+        return generation_.load(std::memory_order_acquire);
+    }
+
+    // Forces every generator to reseed
+    void changed()
+    {
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+
+private:
+
+    // Constructor
+    EntropyPool()
+        : pool_()
+        , entropy_(0.0)
+        , generation_(0)
+    {
+#if !defined(_WIN32)
+        // A forked child has copies of its parent's generators, which must not produce the same bytes
+        pthread_atfork(nullptr, nullptr, [] () { shared().changed(); });
+#endif
+    }
+
+    mutable std::mutex mutex_;
+    Crypto::Sha256Hash pool_;
+    double entropy_;                        // Estimated entropy added so far (informational)
+    std::atomic<uint64_t> generation_;
+};
+
+// A ChaCha20 generator with "fast key erasure": each refill of the buffer generates key stream under the current key
+// and replaces the key with the first 32 bytes of it, so past output cannot be recovered from the generator's state.
+// Bytes are erased from the buffer as they are returned.
+class Generator
+{
+public:
+
+    // Constructor
+    Generator()
+        : available_(0)
+        , sinceReseed_(0)
+        , generation_(0)
+        , seeded_(false)
+    {
+        std::fill(key_, key_ + sizeof(key_), 0);
+        std::fill(buffer_, buffer_ + sizeof(buffer_), 0);
+    }
+
+    // Destructor
+    ~Generator()
+    {
+        std::fill(key_, key_ + sizeof(key_), 0);
+        std::fill(buffer_, buffer_ + sizeof(buffer_), 0);
+    }
+
+    // Returns true if the generator has been seeded, seeding it if necessary
+    bool seeded()
+    {
+        return seeded_ || reseed();
+    }
+
+    // Generates bytes. Returns false if the generator could not be seeded.
+    bool getBytes(uint8_t * out, size_t size)
+    {
+        EntropyPool const & pool = EntropyPool::shared();
+        if (!seeded_ || sinceReseed_ >= RESEED_INTERVAL || generation_ != pool.generation())
+        {
+            if (!reseed())
+                return false;
+        }
+
+        sinceReseed_ += size;
+        while (size > 0)
+        {
+            if (available_ == 0)
+                refill();
+            size_t    n     = std::min(size, available_);
+            uint8_t * bytes = buffer_ + BUFFER_SIZE - available_;
+            memcpy(out, bytes, n);
+            std::fill(bytes, bytes + n, 0);
+            available_ -= n;
+            out        += n;
+            size       -= n;
+        }
+        return true;
+    }
+
+private:
+
+    // key = SHA-256(key || system entropy || pool)
+    bool reseed()
+    {
+        EntropyPool const & pool = EntropyPool::shared();
+        uint8_t seed[Crypto::CHACHA20_KEY_SIZE + Crypto::CHACHA20_KEY_SIZE + Crypto::SHA256_HASH_SIZE];
+        memcpy(seed, key_, Crypto::CHACHA20_KEY_SIZE);
+        if (!getSystemEntropy(seed + Crypto::CHACHA20_KEY_SIZE, Crypto::CHACHA20_KEY_SIZE))
+            return false;
+
+        // The generation is read before the pool, so a change made in between causes another reseed
+        generation_ = pool.generation();
+        Crypto::Sha256Hash added = pool.get();
+        memcpy(seed + 2 * Crypto::CHACHA20_KEY_SIZE, added.data(), added.size());
+
+        Crypto::Sha256Hash key = Crypto::sha256(seed, sizeof(seed));
+        memcpy(key_, key.data(), sizeof(key_));
+        std::fill(seed, seed + sizeof(seed), 0);
+        std::fill(key.begin(), key.end(), 0);
+
+        // Bytes generated with the old key are discarded
+        std::fill(buffer_, buffer_ + sizeof(buffer_), 0);
+        available_   = 0;
+        sinceReseed_ = 0;
+        seeded_      = true;
+        return true;
+    }
+
+    void refill()
+    {
+        Crypto::chacha20(key_, 0, 0, buffer_, BUFFER_BLOCKS);
+        memcpy(key_, buffer_, sizeof(key_));
+        std::fill(buffer_, buffer_ + sizeof(key_), 0);
+        available_ = BUFFER_SIZE - sizeof(key_);
+    }
+
+    uint8_t key_[Crypto::CHACHA20_KEY_SIZE];
+    uint8_t buffer_[BUFFER_SIZE];
+    size_t available_;                      // Number of unused bytes at the end of the buffer
+    uint64_t sinceReseed_;                  // Number of bytes generated since the last reseed
+    uint64_t generation_;                   // Generation of the entropy pool at the last reseed
+    bool seeded_;
+};
+
+// Each thread has its own generator, so generating bytes does not need a lock
+Generator & generator()
+{
+    thread_local Generator g;
+    return g;
+}
+} // anonymous namespace
 
 namespace Crypto
 {
@@ -12,20 +249,27 @@ namespace Random
 
 bool status()
 {
-    NOT_YET_IMPLEMENTED();
-	return false;
+    return generator().seeded();
 }
 
 void getBytes(uint8_t * buffer, size_t size)
 {
     assert(size < std::numeric_limits<int>().max());
-    NOT_YET_IMPLEMENTED();
+    if (!generator().getBytes(buffer, size))
+        throw std::runtime_error("Crypto::Random: the system's entropy source is not available");
+}
+
+uint64_t getUint64()
+{
+    uint64_t x;
+    getBytes((uint8_t *)&x, sizeof(x));
+    return x;
 }
 
 void addEntropy(uint8_t const * buffer, size_t size, double entropy)
 {
     assert(size < std::numeric_limits<int>().max());
-    NOT_YET_IMPLEMENTED();
+    EntropyPool::shared().add(buffer, size, entropy);
 }
 
 }  // namespace Random
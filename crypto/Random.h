@@ -11,18 +11,32 @@ namespace Random
 //! @addtogroup CryptoGroup
 //!@{
 
-//! Returns true if the RNG has enough entropy
+//! Random bytes are generated by a ChaCha20-based generator in each thread, so no lock is taken when generating bytes.
+//! A thread's generator is seeded from the system's entropy source (getrandom() on Linux) when it is first used, and
+//! it is reseeded after generating 16 MiB, when entropy is added with addEntropy(), and in a child process after
+//! fork().
+
+//! Returns true if the RNG has enough entropy (that is, if the system's entropy source is available)
 bool status();
 
 //! Fills the buffer with random bytes.
 //! @param[out]     buffer  buffer to hold bytes
 //! @param          size    number of byte to generate
+//! @note   std::runtime_error is thrown if the system's entropy source is not available
 void getBytes(uint8_t * buffer, size_t size);
 
+//! Returns a random 64-bit value, such as a message nonce or a hash-table salt.
+//! @note   std::runtime_error is thrown if the system's entropy source is not available
+uint64_t getUint64();
+
 //! Adds entropy to the random byte generator.
+//!
+//! The bytes are mixed into a pool that is shared by all threads, and each thread's generator mixes the pool into its
+//! state before it generates more bytes.
+//!
 //! @param      buffer      additional entropy
-//! @param      entropy     entropy to add
 //! @param      size        number of bytes of entropy
+//! @param      entropy     estimated amount of entropy in the bytes
 void addEntropy(uint8_t const * buffer, size_t size, double entropy);
 
 //!@}
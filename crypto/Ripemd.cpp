@@ -1,8 +1,95 @@
 #include "Ripemd.h"
 
+#include "CpuFeatures.h"
+#include "RipemdLanes.h"
+#include "Sha256.h"
+
 #include <algorithm>
 #include <cassert>
 
+using namespace Crypto::RipemdImpl;
+
+namespace
+{
+size_t const MAX_LANES = 16;
+size_t const CHUNK_SIZE = 64;   // Number of messages whose SHA-256 hashes are computed at a time by hash160Batch()
+
+// Operations for RipemdImpl::Lanes using a single lane
+struct PortableOps
+{
+    typedef uint32_t Vector;
+    static int const LANES = 1;
+
+    static Vector load(uint32_t const * p) { return *p; }
+    static void store(uint32_t * p, Vector x) { *p = x; }
+    static Vector set1(uint32_t x) { return x; }
+    static Vector add(Vector x, Vector y) { return x + y; }
+    template <int N> static Vector rotl(Vector x) { return (x << N) | (x >> (32 - N)); }
+    static Vector f1(Vector x, Vector y, Vector z) { return x ^ y ^ z; }
+    static Vector f2(Vector x, Vector y, Vector z) { return z ^ (x & (y ^ z)); }
+    static Vector f3(Vector x, Vector y, Vector z) { return (x | ~y) ^ z; }
+    static Vector f4(Vector x, Vector y, Vector z) { return y ^ (z & (x ^ y)); }
+    static Vector f5(Vector x, Vector y, Vector z) { return x ^ (y | ~z); }
+};
+
+typedef Lanes<PortableOps> Portable;
+
+// Updates the state with n consecutive 64-byte blocks
+void transform(uint32_t * state, uint8_t const * blocks, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        uint32_t w[16];
+        for (int j = 0; j < 16; ++j)
+        {
+            w[j] = readLittleEndian32(blocks + 4 * j);
+        }
+        Portable::compress(state, w);
+        blocks += BLOCK_SIZE;
+    }
+}
+
+Crypto::Ripemd160Hash hashOf(uint32_t const * state, size_t stride = 1)
+{
+    Crypto::Ripemd160Hash hash;
+    for (size_t i = 0; i < STATE_SIZE; ++i)
+    {
+        writeLittleEndian32(&hash[4 * i], state[i * stride]);
+    }
+    return hash;
+}
+
+// The RIPEMD-160 implementation used by hash160Batch(). It uses the same instruction set as the SHA-256 batch
+// implementation so that it can be selected for testing and benchmarking.
+struct LaneDispatch
+{
+    LaneHash32 hash32;
+    size_t lanes;
+};
+
+LaneDispatch laneDispatch()
+{
+#if defined(CRYPTO_X86)
+    switch (Crypto::sha256BatchBackend())
+    {
+        case Crypto::SHA256_SSE4:   return LaneDispatch{ hash32Sse4x4, 4 };
+        case Crypto::SHA256_AVX2:   return LaneDispatch{ hash32Avx2x8, 8 };
+        case Crypto::SHA256_AVX512: return LaneDispatch{ hash32Avx512x16, 16 };
+        case Crypto::SHA256_SHANI:
+            // There are no SHA extension instructions for RIPEMD-160
+            if (Crypto::cpuFeatures().avx2)
+                return LaneDispatch{ hash32Avx2x8, 8 };
+            if (Crypto::cpuFeatures().sse41)
+                return LaneDispatch{ hash32Sse4x4, 4 };
+            break;
+        default:
+            break;
+    }
+#endif
+    return LaneDispatch{ Portable::hash32, 1 };
+}
+} // anonymous namespace
+
 namespace Crypto
 {
 
@@ -13,8 +100,90 @@ Ripemd160Hash ripemd160(std::vector<uint8_t> const & input)
 
 Ripemd160Hash ripemd160(uint8_t const * input, size_t length)
 {
-    Ripemd160Hash hash = {};
-    return hash;
+    uint32_t state[STATE_SIZE];
+    std::copy(INITIAL_STATE, INITIAL_STATE + STATE_SIZE, state);
+
+    // Full blocks are hashed in place
+    size_t nBlocks = length / BLOCK_SIZE;
+    transform(state, input, nBlocks);
+
+    // The remainder is padded with 0x80, 0s, and the length in bits (little-endian), requiring one or two blocks
+    uint8_t  tail[2 * BLOCK_SIZE];
+    size_t   restSize = length % BLOCK_SIZE;
+    uint64_t bits     = (uint64_t)length * 8;
+    size_t   size     = (restSize + 1 + 8 <= BLOCK_SIZE) ? BLOCK_SIZE : 2 * BLOCK_SIZE;
+    std::copy(input + nBlocks * BLOCK_SIZE, input + length, tail);
+    tail[restSize] = 0x80;
+    std::fill(tail + restSize + 1, tail + size - 8, 0);
+    writeLittleEndian32(tail + size - 8, (uint32_t)bits);
+    writeLittleEndian32(tail + size - 4, (uint32_t)(bits >> 32));
+    transform(state, tail, size / BLOCK_SIZE);
+
+    return hashOf(state);
+}
+
+Ripemd160Hash hash160(std::vector<uint8_t> const & input)
+{
+    return hash160(input.data(), input.size());
+}
+
+Ripemd160Hash hash160(uint8_t const * input, size_t length)
+{
+    // The SHA-256 hash fits in a single block, so its padding is known in advance
+    Sha256Hash    sha256Hash = sha256(input, length);
+    uint8_t const * message  = sha256Hash.data();
+    uint32_t      state[STATE_SIZE];
+    Portable::hash32(&message, state);
+    return hashOf(state);
+}
+
+void hash160Batch(uint8_t const * const * inputs, size_t const * lengths, size_t n, Ripemd160Hash * hashes)
+{
+    LaneDispatch d = laneDispatch();
+    assert(CHUNK_SIZE % d.lanes == 0);
+
+    for (size_t first = 0; first < n; first += CHUNK_SIZE)
+    {
+        size_t count = std::min(CHUNK_SIZE, n - first);
+
+        Sha256Hash sha256Hashes[CHUNK_SIZE];
+        sha256Batch(inputs + first, lengths + first, count, sha256Hashes);
+
+        // The last group is filled out with copies of its first message
+        for (size_t i = 0; i < count; i += d.lanes)
+        {
+            uint8_t const * messages[MAX_LANES];
+            size_t          lanes = std::min(d.lanes, count - i);
+            for (size_t lane = 0; lane < d.lanes; ++lane)
+            {
+                messages[lane] = sha256Hashes[i + ((lane < lanes) ? lane : 0)].data();
+            }
+
+            uint32_t states[STATE_SIZE * MAX_LANES];
+            d.hash32(messages, states);
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                hashes[first + i + lane] = hashOf(states + lane, d.lanes);
+            }
+        }
+    }
+}
+
+Ripemd160HashList hash160Batch(std::vector<std::vector<uint8_t>> const & inputs)
+{
+    std::vector<uint8_t const *> pointers;
+    std::vector<size_t> lengths;
+    pointers.reserve(inputs.size());
+    lengths.reserve(inputs.size());
+    for (auto const & input : inputs)
+    {
+        pointers.push_back(input.data());
+        lengths.push_back(input.size());
+    }
+
+    Ripemd160HashList hashes(inputs.size());
+    hash160Batch(pointers.data(), lengths.data(), inputs.size(), hashes.data());
+    return hashes;
 }
 
 } // namespace Crypto
@@ -11,6 +11,7 @@ namespace Crypto
 
 size_t const RIPEMD160_HASH_SIZE = 160 / 8;                         //!< The sized of a RIPEMD-160 hash in bytes
 typedef std::array<uint8_t, RIPEMD160_HASH_SIZE> Ripemd160Hash;     //!< A RIPEMD-160 hash
+typedef std::vector<Ripemd160Hash> Ripemd160HashList;               //!< A vector of RIPEMD-160 hashes
 
 //! Computes the RIPEMD-160 hash of the input
 Ripemd160Hash ripemd160(std::vector<uint8_t> const & input);
@@ -21,6 +22,34 @@ Ripemd160Hash ripemd160(uint8_t const * input, size_t length);
 //! Computes the RIPEMD-160 hash of an std::array input
 template <size_t N> Ripemd160Hash ripemd160(std::array<uint8_t, N> const & input);
 
+//! Computes the HASH160 of the input, which is ripemd160(sha256(input)).
+//! @param  input   data to hash
+Ripemd160Hash hash160(std::vector<uint8_t> const & input);
+
+//! Computes the HASH160 of the input, which is ripemd160(sha256(input)).
+//! @param  input   data to hash
+//! @param  length  length of the data
+Ripemd160Hash hash160(uint8_t const * input, size_t length);
+
+//! Computes the HASH160 of an std::array input
+//! @param  input   data to hash
+template <size_t N> Ripemd160Hash hash160(std::array<uint8_t, N> const & input);
+
+//! Computes the HASH160s of several independent messages.
+//!
+//! The SHA-256 hashes are computed with sha256Batch(), and the RIPEMD-160 hashes of the results are computed in
+//! parallel using the same instruction set (AVX2 or SSE4.1 if the SHA-256 batch implementation is SHA256_SHANI).
+//!
+//! @param  inputs      data to hash
+//! @param  lengths     lengths of the data
+//! @param  n           number of messages
+//! @param[out] hashes  the hashes (n elements)
+void hash160Batch(uint8_t const * const * inputs, size_t const * lengths, size_t n, Ripemd160Hash * hashes);
+
+//! Computes the HASH160s of several independent messages.
+//! @param  inputs      data to hash
+Ripemd160HashList hash160Batch(std::vector<std::vector<uint8_t>> const & inputs);
+
 //!@}
 
 /********************************************************************************************************************/
@@ -30,4 +59,10 @@ Ripemd160Hash ripemd160(std::array<uint8_t, N> const & input)
 {
     return ripemd160(input.data(), input.size());
 }
+
+template <size_t N>
+Ripemd160Hash hash160(std::array<uint8_t, N> const & input)
+{
+    return hash160(input.data(), input.size());
+}
 } // namespace Crypto
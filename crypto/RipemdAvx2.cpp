@@ -0,0 +1,53 @@
+// RIPEMD-160 compression function that hashes eight messages at once using AVX2.
+//
+// This file must be compiled with AVX2 code generation enabled (e.g. -mavx2).
+
+#include "RipemdLanes.h"
+
+#if defined(CRYPTO_X86)
+
+#include <immintrin.h>
+
+namespace
+{
+// Vector operations for RipemdImpl::Lanes
+struct Avx2Ops
+{
+    typedef __m256i Vector;
+    static int const LANES = 8;
+
+    static Vector load(uint32_t const * p) { return _mm256_loadu_si256((__m256i const *)p); }
+    static void store(uint32_t * p, Vector x) { _mm256_storeu_si256((__m256i *)p, x); }
+    static Vector set1(uint32_t x) { return _mm256_set1_epi32((int)x); }
+    static Vector add(Vector x, Vector y) { return _mm256_add_epi32(x, y); }
+    template <int N> static Vector rotl(Vector x)
+    {
+        return _mm256_or_si256(_mm256_slli_epi32(x, N), _mm256_srli_epi32(x, 32 - N));
+    }
+    static Vector f1(Vector x, Vector y, Vector z) { return _mm256_xor_si256(_mm256_xor_si256(x, y), z); }
+    static Vector f2(Vector x, Vector y, Vector z)
+    {
+        return _mm256_xor_si256(z, _mm256_and_si256(x, _mm256_xor_si256(y, z)));
+    }
+    static Vector f3(Vector x, Vector y, Vector z) { return _mm256_xor_si256(_mm256_or_si256(x, notOf(y)), z); }
+    static Vector f4(Vector x, Vector y, Vector z) { return f2(z, x, y); }
+    static Vector f5(Vector x, Vector y, Vector z) { return _mm256_xor_si256(x, _mm256_or_si256(y, notOf(z))); }
+
+    static Vector notOf(Vector x) { return _mm256_xor_si256(x, _mm256_set1_epi32(-1)); }
+};
+} // anonymous namespace
+
+namespace Crypto
+{
+namespace RipemdImpl
+{
+
+void hash32Avx2x8(uint8_t const * const * messages, uint32_t * hashes)
+{
+    Lanes<Avx2Ops>::hash32(messages, hashes);
+}
+
+} // namespace RipemdImpl
+} // namespace Crypto
+
+#endif // if defined(CRYPTO_X86)
@@ -0,0 +1,45 @@
+// RIPEMD-160 compression function that hashes sixteen messages at once using AVX-512.
+//
+// This file must be compiled with AVX-512F code generation enabled (e.g. -mavx512f).
+
+#include "RipemdLanes.h"
+
+#if defined(CRYPTO_X86)
+
+#include <immintrin.h>
+
+namespace
+{
+// Vector operations for RipemdImpl::Lanes. The boolean functions are each a single ternary logic instruction.
+struct Avx512Ops
+{
+    typedef __m512i Vector;
+    static int const LANES = 16;
+
+    static Vector load(uint32_t const * p) { return _mm512_loadu_si512(p); }
+    static void store(uint32_t * p, Vector x) { _mm512_storeu_si512(p, x); }
+    static Vector set1(uint32_t x) { return _mm512_set1_epi32((int)x); }
+    static Vector add(Vector x, Vector y) { return _mm512_add_epi32(x, y); }
+    template <int N> static Vector rotl(Vector x) { return _mm512_rol_epi32(x, N); }
+    static Vector f1(Vector x, Vector y, Vector z) { return _mm512_ternarylogic_epi32(x, y, z, 0x96); }
+    static Vector f2(Vector x, Vector y, Vector z) { return _mm512_ternarylogic_epi32(x, y, z, 0xca); }
+    static Vector f3(Vector x, Vector y, Vector z) { return _mm512_ternarylogic_epi32(x, y, z, 0x59); }
+    static Vector f4(Vector x, Vector y, Vector z) { return _mm512_ternarylogic_epi32(x, y, z, 0xe4); }
+    static Vector f5(Vector x, Vector y, Vector z) { return _mm512_ternarylogic_epi32(x, y, z, 0x2d); }
+};
+} // anonymous namespace
+
+namespace Crypto
+{
+namespace RipemdImpl
+{
+
+void hash32Avx512x16(uint8_t const * const * messages, uint32_t * hashes)
+{
+    Lanes<Avx512Ops>::hash32(messages, hashes);
+}
+
+} // namespace RipemdImpl
+} // namespace Crypto
+
+#endif // if defined(CRYPTO_X86)
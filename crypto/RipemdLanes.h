@@ -0,0 +1,340 @@
+#pragma once
+
+// Multi-lane RIPEMD-160 compression function shared by the portable and SIMD implementations. This header is not part
+// of the public API.
+//
+// Each lane of a vector holds the state of an independent message. As with Sha256Lanes.h, the code is instantiated in
+// each source file with that file's vector operations, so it is in an anonymous namespace. The portable implementation
+// uses a single lane of uint32_t.
+//
+// The vector operations are provided by a class with the following static members:
+//
+//      typedef ... Vector;                                         // A vector of LANES 32-bit words
+//      static int const LANES;                                     // Number of lanes
+//      static Vector load(uint32_t const * p);                     // Loads LANES words
+//      static void   store(uint32_t * p, Vector x);                // Stores LANES words
+//      static Vector set1(uint32_t x);                             // Sets every lane to x
+//      static Vector add(Vector x, Vector y);
+//      template <int N> static Vector rotl(Vector x);
+//      static Vector f1(Vector x, Vector y, Vector z);             // x ^ y ^ z
+//      static Vector f2(Vector x, Vector y, Vector z);             // (x & y) | (~x & z)
+//      static Vector f3(Vector x, Vector y, Vector z);             // (x | ~y) ^ z
+//      static Vector f4(Vector x, Vector y, Vector z);             // (x & z) | (y & ~z)
+//      static Vector f5(Vector x, Vector y, Vector z);             // x ^ (y | ~z)
+
+#include "CpuFeatures.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Crypto
+{
+namespace RipemdImpl
+{
+size_t constexpr BLOCK_SIZE = 64;   // Size of a RIPEMD-160 message block in bytes
+size_t constexpr STATE_SIZE = 5;    // Number of 32-bit words in the RIPEMD-160 state
+
+// Computes the RIPEMD-160 hashes of several 32-byte messages (i.e., SHA-256 hashes). The hash values are stored
+// word-major (hashes[i * lanes + lane]) and messages[lane] is the message for the lane.
+typedef void (*LaneHash32)(uint8_t const * const * messages, uint32_t * hashes);
+
+#if defined(CRYPTO_X86)
+void hash32Sse4x4(uint8_t const * const * messages, uint32_t * hashes);
+void hash32Avx2x8(uint8_t const * const * messages, uint32_t * hashes);
+void hash32Avx512x16(uint8_t const * const * messages, uint32_t * hashes);
+#endif
+
+namespace
+{
+uint32_t const INITIAL_STATE[STATE_SIZE] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+
+inline uint32_t readLittleEndian32(uint8_t const * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+inline void writeLittleEndian32(uint8_t * p, uint32_t x)
+{
+    p[0] = (uint8_t)x;
+    p[1] = (uint8_t)(x >> 8);
+    p[2] = (uint8_t)(x >> 16);
+    p[3] = (uint8_t)(x >> 24);
+}
+
+template <typename Ops>
+struct Lanes
+{
+    typedef typename Ops::Vector Vector;
+
+    // One step of the compression function. Rather than rotating the five working variables after each step, the
+    // caller rotates the arguments.
+    template <int S>
+    static void step(Vector & a, Vector & c, Vector e, Vector f, Vector x, uint32_t k)
+    {
+        a = Ops::add(Ops::template rotl<S>(Ops::add(Ops::add(a, f), Ops::add(x, Ops::set1(k)))), e);
+        c = Ops::template rotl<10>(c);
+    }
+
+    // The steps of the left and right lines in each of the five rounds
+    template <int S> static void left1(Vector & a, Vector b, Vector & c, Vector d, Vector e, Vector x)
+    {
+        step<S>(a, c, e, Ops::f1(b, c, d), x, 0x00000000);
+    }
+    template <int S> static void left2(Vector & a, Vector b, Vector & c, Vector d, Vector e, Vector x)
+    {
+        step<S>(a, c, e, Ops::f2(b, c, d), x, 0x5a827999);
+    }
+    template <int S> static void left3(Vector & a, Vector b, Vector & c, Vector d, Vector e, Vector x)
+    {
+        step<S>(a, c, e, Ops::f3(b, c, d), x, 0x6ed9eba1);
+    }
+    template <int S> static void left4(Vector & a, Vector b, Vector & c, Vector d, Vector e, Vector x)
+    {
+        step<S>(a, c, e, Ops::f4(b, c, d), x, 0x8f1bbcdc);
+    }
+    template <int S> static void left5(Vector & a, Vector b, Vector & c, Vector d, Vector e, Vector x)
+    {
+        step<S>(a, c, e, Ops::f5(b, c, d), x, 0xa953fd4e);
+    }
+    template <int S> static void right1(Vector & a, Vector b, Vector & c, Vector d, Vector e, Vector x)
+    {
+        step<S>(a, c, e, Ops::f5(b, c, d), x, 0x50a28be6);
+    }
+    template <int S> static void right2(Vector & a, Vector b, Vector & c, Vector d, Vector e, Vector x)
+    {
+        step<S>(a, c, e, Ops::f4(b, c, d), x, 0x5c4dd124);
+    }
+    template <int S> static void right3(Vector & a, Vector b, Vector & c, Vector d, Vector e, Vector x)
+    {
+        step<S>(a, c, e, Ops::f3(b, c, d), x, 0x6d703ef3);
+    }
+    template <int S> static void right4(Vector & a, Vector b, Vector & c, Vector d, Vector e, Vector x)
+    {
+        step<S>(a, c, e, Ops::f2(b, c, d), x, 0x7a6d76e9);
+    }
+    template <int S> static void right5(Vector & a, Vector b, Vector & c, Vector d, Vector e, Vector x)
+    {
+        step<S>(a, c, e, Ops::f1(b, c, d), x, 0x00000000);
+    }
+
+    // Updates the working state s[0..4] with one block per lane given its 16 words
+    static void compress(Vector * s, Vector const * w)
+    {
+        Vector a1 = s[0], b1 = s[1], c1 = s[2], d1 = s[3], e1 = s[4];
+        Vector a2 = a1, b2 = b1, c2 = c1, d2 = d1, e2 = e1;
+
+        left1<11>(a1, b1, c1, d1, e1, w[0]);
+        right1<8>(a2, b2, c2, d2, e2, w[5]);
+        left1<14>(e1, a1, b1, c1, d1, w[1]);
+        right1<9>(e2, a2, b2, c2, d2, w[14]);
+        left1<15>(d1, e1, a1, b1, c1, w[2]);
+        right1<9>(d2, e2, a2, b2, c2, w[7]);
+        left1<12>(c1, d1, e1, a1, b1, w[3]);
+        right1<11>(c2, d2, e2, a2, b2, w[0]);
+        left1<5>(b1, c1, d1, e1, a1, w[4]);
+        right1<13>(b2, c2, d2, e2, a2, w[9]);
+        left1<8>(a1, b1, c1, d1, e1, w[5]);
+        right1<15>(a2, b2, c2, d2, e2, w[2]);
+        left1<7>(e1, a1, b1, c1, d1, w[6]);
+        right1<15>(e2, a2, b2, c2, d2, w[11]);
+        left1<9>(d1, e1, a1, b1, c1, w[7]);
+        right1<5>(d2, e2, a2, b2, c2, w[4]);
+        left1<11>(c1, d1, e1, a1, b1, w[8]);
+        right1<7>(c2, d2, e2, a2, b2, w[13]);
+        left1<13>(b1, c1, d1, e1, a1, w[9]);
+        right1<7>(b2, c2, d2, e2, a2, w[6]);
+        left1<14>(a1, b1, c1, d1, e1, w[10]);
+        right1<8>(a2, b2, c2, d2, e2, w[15]);
+        left1<15>(e1, a1, b1, c1, d1, w[11]);
+        right1<11>(e2, a2, b2, c2, d2, w[8]);
+        left1<6>(d1, e1, a1, b1, c1, w[12]);
+        right1<14>(d2, e2, a2, b2, c2, w[1]);
+        left1<7>(c1, d1, e1, a1, b1, w[13]);
+        right1<14>(c2, d2, e2, a2, b2, w[10]);
+        left1<9>(b1, c1, d1, e1, a1, w[14]);
+        right1<12>(b2, c2, d2, e2, a2, w[3]);
+        left1<8>(a1, b1, c1, d1, e1, w[15]);
+        right1<6>(a2, b2, c2, d2, e2, w[12]);
+
+        left2<7>(e1, a1, b1, c1, d1, w[7]);
+        right2<9>(e2, a2, b2, c2, d2, w[6]);
+        left2<6>(d1, e1, a1, b1, c1, w[4]);
+        right2<13>(d2, e2, a2, b2, c2, w[11]);
+        left2<8>(c1, d1, e1, a1, b1, w[13]);
+        right2<15>(c2, d2, e2, a2, b2, w[3]);
+        left2<13>(b1, c1, d1, e1, a1, w[1]);
+        right2<7>(b2, c2, d2, e2, a2, w[7]);
+        left2<11>(a1, b1, c1, d1, e1, w[10]);
+        right2<12>(a2, b2, c2, d2, e2, w[0]);
+        left2<9>(e1, a1, b1, c1, d1, w[6]);
+        right2<8>(e2, a2, b2, c2, d2, w[13]);
+        left2<7>(d1, e1, a1, b1, c1, w[15]);
+        right2<9>(d2, e2, a2, b2, c2, w[5]);
+        left2<15>(c1, d1, e1, a1, b1, w[3]);
+        right2<11>(c2, d2, e2, a2, b2, w[10]);
+        left2<7>(b1, c1, d1, e1, a1, w[12]);
+        right2<7>(b2, c2, d2, e2, a2, w[14]);
+        left2<12>(a1, b1, c1, d1, e1, w[0]);
+        right2<7>(a2, b2, c2, d2, e2, w[15]);
+        left2<15>(e1, a1, b1, c1, d1, w[9]);
+        right2<12>(e2, a2, b2, c2, d2, w[8]);
+        left2<9>(d1, e1, a1, b1, c1, w[5]);
+        right2<7>(d2, e2, a2, b2, c2, w[12]);
+        left2<11>(c1, d1, e1, a1, b1, w[2]);
+        right2<6>(c2, d2, e2, a2, b2, w[4]);
+        left2<7>(b1, c1, d1, e1, a1, w[14]);
+        right2<15>(b2, c2, d2, e2, a2, w[9]);
+        left2<13>(a1, b1, c1, d1, e1, w[11]);
+        right2<13>(a2, b2, c2, d2, e2, w[1]);
+        left2<12>(e1, a1, b1, c1, d1, w[8]);
+        right2<11>(e2, a2, b2, c2, d2, w[2]);
+
+        left3<11>(d1, e1, a1, b1, c1, w[3]);
+        right3<9>(d2, e2, a2, b2, c2, w[15]);
+        left3<13>(c1, d1, e1, a1, b1, w[10]);
+        right3<7>(c2, d2, e2, a2, b2, w[5]);
+        left3<6>(b1, c1, d1, e1, a1, w[14]);
+        right3<15>(b2, c2, d2, e2, a2, w[1]);
+        left3<7>(a1, b1, c1, d1, e1, w[4]);
+        right3<11>(a2, b2, c2, d2, e2, w[3]);
+        left3<14>(e1, a1, b1, c1, d1, w[9]);
+        right3<8>(e2, a2, b2, c2, d2, w[7]);
+        left3<9>(d1, e1, a1, b1, c1, w[15]);
+        right3<6>(d2, e2, a2, b2, c2, w[14]);
+        left3<13>(c1, d1, e1, a1, b1, w[8]);
+        right3<6>(c2, d2, e2, a2, b2, w[6]);
+        left3<15>(b1, c1, d1, e1, a1, w[1]);
+        right3<14>(b2, c2, d2, e2, a2, w[9]);
+        left3<14>(a1, b1, c1, d1, e1, w[2]);
+        right3<12>(a2, b2, c2, d2, e2, w[11]);
+        left3<8>(e1, a1, b1, c1, d1, w[7]);
+        right3<13>(e2, a2, b2, c2, d2, w[8]);
+        left3<13>(d1, e1, a1, b1, c1, w[0]);
+        right3<5>(d2, e2, a2, b2, c2, w[12]);
+        left3<6>(c1, d1, e1, a1, b1, w[6]);
+        right3<14>(c2, d2, e2, a2, b2, w[2]);
+        left3<5>(b1, c1, d1, e1, a1, w[13]);
+        right3<13>(b2, c2, d2, e2, a2, w[10]);
+        left3<12>(a1, b1, c1, d1, e1, w[11]);
+        right3<13>(a2, b2, c2, d2, e2, w[0]);
+        left3<7>(e1, a1, b1, c1, d1, w[5]);
+        right3<7>(e2, a2, b2, c2, d2, w[4]);
+        left3<5>(d1, e1, a1, b1, c1, w[12]);
+        right3<5>(d2, e2, a2, b2, c2, w[13]);
+
+        left4<11>(c1, d1, e1, a1, b1, w[1]);
+        right4<15>(c2, d2, e2, a2, b2, w[8]);
+        left4<12>(b1, c1, d1, e1, a1, w[9]);
+        right4<5>(b2, c2, d2, e2, a2, w[6]);
+        left4<14>(a1, b1, c1, d1, e1, w[11]);
+        right4<8>(a2, b2, c2, d2, e2, w[4]);
+        left4<15>(e1, a1, b1, c1, d1, w[10]);
+        right4<11>(e2, a2, b2, c2, d2, w[1]);
+        left4<14>(d1, e1, a1, b1, c1, w[0]);
+        right4<14>(d2, e2, a2, b2, c2, w[3]);
+        left4<15>(c1, d1, e1, a1, b1, w[8]);
+        right4<14>(c2, d2, e2, a2, b2, w[11]);
+        left4<9>(b1, c1, d1, e1, a1, w[12]);
+        right4<6>(b2, c2, d2, e2, a2, w[15]);
+        left4<8>(a1, b1, c1, d1, e1, w[4]);
+        right4<14>(a2, b2, c2, d2, e2, w[0]);
+        left4<9>(e1, a1, b1, c1, d1, w[13]);
+        right4<6>(e2, a2, b2, c2, d2, w[5]);
+        left4<14>(d1, e1, a1, b1, c1, w[3]);
+        right4<9>(d2, e2, a2, b2, c2, w[12]);
+        left4<5>(c1, d1, e1, a1, b1, w[7]);
+        right4<12>(c2, d2, e2, a2, b2, w[2]);
+        left4<6>(b1, c1, d1, e1, a1, w[15]);
+        right4<9>(b2, c2, d2, e2, a2, w[13]);
+        left4<8>(a1, b1, c1, d1, e1, w[14]);
+        right4<12>(a2, b2, c2, d2, e2, w[9]);
+        left4<6>(e1, a1, b1, c1, d1, w[5]);
+        right4<5>(e2, a2, b2, c2, d2, w[7]);
+        left4<5>(d1, e1, a1, b1, c1, w[6]);
+        right4<15>(d2, e2, a2, b2, c2, w[10]);
+        left4<12>(c1, d1, e1, a1, b1, w[2]);
+        right4<8>(c2, d2, e2, a2, b2, w[14]);
+
+        left5<9>(b1, c1, d1, e1, a1, w[4]);
+        right5<8>(b2, c2, d2, e2, a2, w[12]);
+        left5<15>(a1, b1, c1, d1, e1, w[0]);
+        right5<5>(a2, b2, c2, d2, e2, w[15]);
+        left5<5>(e1, a1, b1, c1, d1, w[5]);
+        right5<12>(e2, a2, b2, c2, d2, w[10]);
+        left5<11>(d1, e1, a1, b1, c1, w[9]);
+        right5<9>(d2, e2, a2, b2, c2, w[4]);
+        left5<6>(c1, d1, e1, a1, b1, w[7]);
+        right5<12>(c2, d2, e2, a2, b2, w[1]);
+        left5<8>(b1, c1, d1, e1, a1, w[12]);
+        right5<5>(b2, c2, d2, e2, a2, w[5]);
+        left5<13>(a1, b1, c1, d1, e1, w[2]);
+        right5<14>(a2, b2, c2, d2, e2, w[8]);
+        left5<12>(e1, a1, b1, c1, d1, w[10]);
+        right5<6>(e2, a2, b2, c2, d2, w[7]);
+        left5<5>(d1, e1, a1, b1, c1, w[14]);
+        right5<8>(d2, e2, a2, b2, c2, w[6]);
+        left5<12>(c1, d1, e1, a1, b1, w[1]);
+        right5<13>(c2, d2, e2, a2, b2, w[2]);
+        left5<13>(b1, c1, d1, e1, a1, w[3]);
+        right5<6>(b2, c2, d2, e2, a2, w[13]);
+        left5<14>(a1, b1, c1, d1, e1, w[8]);
+        right5<5>(a2, b2, c2, d2, e2, w[14]);
+        left5<11>(e1, a1, b1, c1, d1, w[11]);
+        right5<15>(e2, a2, b2, c2, d2, w[0]);
+        left5<8>(d1, e1, a1, b1, c1, w[6]);
+        right5<13>(d2, e2, a2, b2, c2, w[3]);
+        left5<5>(c1, d1, e1, a1, b1, w[15]);
+        right5<11>(c2, d2, e2, a2, b2, w[9]);
+        left5<6>(b1, c1, d1, e1, a1, w[13]);
+        right5<11>(b2, c2, d2, e2, a2, w[11]);
+
+        Vector t = Ops::add(s[1], Ops::add(c1, d2));
+        s[1] = Ops::add(s[2], Ops::add(d1, e2));
+        s[2] = Ops::add(s[3], Ops::add(e1, a2));
+        s[3] = Ops::add(s[4], Ops::add(a1, b2));
+        s[4] = Ops::add(s[0], Ops::add(b1, c2));
+        s[0] = t;
+    }
+
+    // Computes the RIPEMD-160 hash of one 32-byte message per lane. The hashes are stored word-major
+    // (hashes[i * LANES + lane]).
+    static void hash32(uint8_t const * const * messages, uint32_t * hashes)
+    {
+        // The message is the first half of the block and the padding is the second half
+        uint32_t words[8 * Ops::LANES];
+        for (int lane = 0; lane < Ops::LANES; ++lane)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                words[i * Ops::LANES + lane] = readLittleEndian32(messages[lane] + 4 * i);
+            }
+        }
+
+        Vector w[16];
+        for (int i = 0; i < 8; ++i)
+        {
+            w[i] = Ops::load(words + i * Ops::LANES);
+        }
+        w[8] = Ops::set1(0x80);
+        for (int i = 9; i < 16; ++i)
+        {
+            w[i] = Ops::set1(0);
+        }
+        w[14] = Ops::set1(256);
+
+        Vector s[STATE_SIZE];
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            s[i] = Ops::set1(INITIAL_STATE[i]);
+        }
+        compress(s, w);
+
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            Ops::store(hashes + i * Ops::LANES, s[i]);
+        }
+    }
+};
+} // anonymous namespace
+} // namespace RipemdImpl
+} // namespace Crypto
@@ -0,0 +1,47 @@
+// RIPEMD-160 compression function that hashes four messages at once using SSE4.1.
+//
+// This file must be compiled with SSE4.1 code generation enabled (e.g. -msse4.1).
+
+#include "RipemdLanes.h"
+
+#if defined(CRYPTO_X86)
+
+#include <immintrin.h>
+
+namespace
+{
+// Vector operations for RipemdImpl::Lanes
+struct Sse4Ops
+{
+    typedef __m128i Vector;
+    static int const LANES = 4;
+
+    static Vector load(uint32_t const * p) { return _mm_loadu_si128((__m128i const *)p); }
+    static void store(uint32_t * p, Vector x) { _mm_storeu_si128((__m128i *)p, x); }
+    static Vector set1(uint32_t x) { return _mm_set1_epi32((int)x); }
+    static Vector add(Vector x, Vector y) { return _mm_add_epi32(x, y); }
+    template <int N> static Vector rotl(Vector x) { return _mm_or_si128(_mm_slli_epi32(x, N), _mm_srli_epi32(x, 32 - N)); }
+    static Vector f1(Vector x, Vector y, Vector z) { return _mm_xor_si128(_mm_xor_si128(x, y), z); }
+    static Vector f2(Vector x, Vector y, Vector z) { return _mm_xor_si128(z, _mm_and_si128(x, _mm_xor_si128(y, z))); }
+    static Vector f3(Vector x, Vector y, Vector z) { return _mm_xor_si128(_mm_or_si128(x, notOf(y)), z); }
+    static Vector f4(Vector x, Vector y, Vector z) { return f2(z, x, y); }
+    static Vector f5(Vector x, Vector y, Vector z) { return _mm_xor_si128(x, _mm_or_si128(y, notOf(z))); }
+
+    static Vector notOf(Vector x) { return _mm_xor_si128(x, _mm_set1_epi32(-1)); }
+};
+} // anonymous namespace
+
+namespace Crypto
+{
+namespace RipemdImpl
+{
+
+void hash32Sse4x4(uint8_t const * const * messages, uint32_t * hashes)
+{
+    Lanes<Sse4Ops>::hash32(messages, hashes);
+}
+
+} // namespace RipemdImpl
+} // namespace Crypto
+
+#endif // if defined(CRYPTO_X86)
@@ -0,0 +1,1222 @@
+#include "Secp256k1.h"
+
+#if defined(CRYPTO_SECP256K1_NATIVE)
+
+#include "ChaCha20.h"
+#include "Hmac.h"
+#include "Sha256.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+using namespace Crypto::Secp256k1;
+
+namespace
+{
+// The group order n
+uint64_t const N[4] = { 0xBFD25E8CD0364141, 0xBAAEDCE6AF48A03B, 0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF };
+
+// 2^256 - n
+uint64_t const N_COMPLEMENT[3] = { 0x402DA1732FC9BEBF, 0x4551231950B75FC4, 1 };
+
+// n / 2
+uint64_t const N_HALF[4] = { 0xDFE92F46681B20A0, 0x5D576E7357A4501D, 0xFFFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF };
+
+// n - 2, the exponent of the inverse
+uint64_t const N_MINUS_2[4] = { 0xBFD25E8CD036413F, 0xBAAEDCE6AF48A03B, 0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF };
+
+// p - n. An x-coordinate less than this may be r + n rather than r.
+uint64_t const P_MINUS_N[4] = { 0x402DA1722FC9BAEE, 0x4551231950B75FC4, 1, 0 };
+
+// n as a field element
+Field const N_FIELD = { { 0x25E8CD0364141, 0xE6AF48A03BBFD, 0xFFFFFFEBAAEDC, 0xFFFFFFFFFFFFF, 0xFFFFFFFFFFFF } };
+
+// The endomorphism: lambda * (x, y) = (beta * x, y)
+Field const BETA = { { 0x96C28719501EE, 0x7512F58995C13, 0xC3434E99CF049, 0x7106E64479EA, 0x7AE96A2B657C } };
+
+// Constants of the lambda split (see splitLambda). g1 and g2 are round(2^384 * b2 / n) and round(2^384 * -b1 / n),
+// where (a1, b1) and (a2, b2) are a short basis of the lattice of (k1, k2) such that k1 + k2 * lambda = 0 (mod n).
+Scalar const G1           = { { 0xE893209A45DBB031, 0x3DAA8A1471E8CA7F, 0xE86C90E49284EB15, 0x3086D221A7D46BCD } };
+Scalar const G2           = { { 0x1571B4AE8AC47F71, 0x221208AC9DF506C6, 0x6F547FA90ABFE4C4, 0xE4437ED6010E8828 } };
+Scalar const MINUS_B1     = { { 0x6F547FA90ABFE4C3, 0xE4437ED6010E8828, 0, 0 } };
+Scalar const MINUS_B2     = { { 0xD765CDA83DB1562C, 0x8A280AC50774346D, 0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF } };
+Scalar const MINUS_LAMBDA = { { 0xE0CFC810B51283CF, 0xA880B9FC8EC739C2, 0x5AD9E3FD77ED9BA4, 0xAC9C52B33FA3CF1F } };
+
+AffinePoint const GENERATOR =
+{
+    { { 0x2815B16F81798, 0xDB2DCE28D959F, 0xE870B07029BFC, 0xBBAC55A06295C, 0x79BE667EF9DC } },
+    { { 0x7D08FFB10D4B8, 0x48A68554199C4, 0xE1108A8FD17B4, 0xC4655DA4FBFC0, 0x483ADA7726A3 } },
+    false
+};
+
+int constexpr WINDOW_G      = 8;                        // wNAF window for the generator
+int constexpr WINDOW_Q      = 5;                        // wNAF window for other points
+int constexpr TABLE_SIZE_G  = 1 << (WINDOW_G - 2);      // Number of odd multiples in the generator's tables
+int constexpr TABLE_SIZE_Q  = 1 << (WINDOW_Q - 2);      // Number of odd multiples in a point's tables
+int constexpr MAX_WNAF_SIZE = 130;                      // Maximum number of digits of a 129-bit value
+
+static_assert(TABLE_SIZE_Q == Crypto::Secp256k1::KEY_TABLE_SIZE, "A key table must match the window of other points");
+
+// Compares two 4-limb values
+bool lessThan(uint64_t const * a, uint64_t const * b)
+{
+    for (int i = 3; i >= 0; --i)
+    {
+        if (a[i] != b[i])
+            return a[i] < b[i];
+    }
+    return false;
+}
+
+// Subtracts n from the value a + extra * 2^256 if the value is not less than n. The value must be less than 2n.
+// Returns 1 if n was subtracted. The running time does not depend on the value.
+uint64_t reduceOnce(uint64_t * a, uint64_t extra)
+{
+    uint64_t t[4];
+    uint64_t borrow = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint128_t diff = (uint128_t)a[i] - N[i] - borrow;
+        t[i]   = (uint64_t)diff;
+        borrow = (uint64_t)(diff >> 64) & 1;
+    }
+
+    uint64_t flag = extra | (borrow ^ 1);
+    uint64_t mask = 0 - flag;
+    for (int i = 0; i < 4; ++i)
+    {
+        a[i] = (t[i] & mask) | (a[i] & ~mask);
+    }
+    return flag;
+}
+
+// Computes t[0..3] + t[4..7] * (2^256 - n), which is congruent to t (mod n), and stores it in t[0..7]
+void fold(uint64_t * t)
+{
+    uint64_t r[8] = { t[0], t[1], t[2], t[3], 0, 0, 0, 0 };
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t carry = 0;
+        for (int j = 0; j < 3; ++j)
+        {
+            uint128_t x = (uint128_t)t[4 + i] * N_COMPLEMENT[j] + r[i + j] + carry;
+            r[i + j] = (uint64_t)x;
+            carry    = (uint64_t)(x >> 64);
+        }
+        for (int k = i + 3; k < 8; ++k)
+        {
+            uint128_t x = (uint128_t)r[k] + carry;
+            r[k]  = (uint64_t)x;
+            carry = (uint64_t)(x >> 64);
+        }
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        t[i] = r[i];
+    }
+}
+
+// Computes the 512-bit product of two 4-limb values
+void mul512(uint64_t const * a, uint64_t const * b, uint64_t * t)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        t[i] = 0;
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t carry = 0;
+        for (int j = 0; j < 4; ++j)
+        {
+            uint128_t x = (uint128_t)a[i] * b[j] + t[i + j] + carry;
+            t[i + j] = (uint64_t)x;
+            carry    = (uint64_t)(x >> 64);
+        }
+        t[i + 4] = carry;
+    }
+}
+
+// Returns round(a * b / 2^384)
+Scalar mulShift384(Scalar const & a, Scalar const & b)
+{
+    uint64_t t[8];
+    mul512(a.d, b.d, t);
+    uint128_t x = (uint128_t)t[6] + (t[5] >> 63);
+    uint64_t  lo = (uint64_t)x;
+    uint64_t  hi = t[7] + (uint64_t)(x >> 64);
+    return Scalar{ { lo, hi, 0, 0 } };
+}
+
+AffinePoint negate(AffinePoint const & p)
+{
+    AffinePoint r = p;
+    r.y = -p.y;
+    return r;
+}
+
+JacobianPoint infinity()
+{
+    JacobianPoint r;
+    r.x        = fieldFromInt(0);
+    r.y        = fieldFromInt(1);
+    r.z        = fieldFromInt(0);
+    r.infinity = true;
+    return r;
+}
+
+// Doubles a point without checking for the point at infinity
+JacobianPoint dblUnchecked(JacobianPoint const & p)
+{
+    // dbl-2009-l from the Explicit-Formulas Database, for a = 0
+    Field a = sqr(p.x);
+    Field b = sqr(p.y);
+    Field c = sqr(b);
+    Field d = mulInt(sqr(p.x + b) - a - c, 2);
+    Field e = mulInt(a, 3);
+    JacobianPoint r;
+    r.x        = sqr(e) - mulInt(d, 2);
+    r.y        = e * (d - r.x) - mulInt(c, 8);
+    r.z        = mulInt(p.y * p.z, 2);
+    r.infinity = p.infinity;
+    return r;
+}
+
+// Adds an affine point to a point without handling the special cases (either point at infinity, or a = +/-b). h is 0
+// if the x-coordinates are equal, and then rr is 0 if the points are equal.
+JacobianPoint addUnchecked(JacobianPoint const & a, AffinePoint const & b, Field & h, Field & rr)
+{
+    Field z1z1 = sqr(a.z);
+    Field u2   = b.x * z1z1;
+    Field s2   = b.y * a.z * z1z1;
+    h  = u2 - a.x;
+    rr = s2 - a.y;
+    Field hh  = sqr(h);
+    Field hhh = h * hh;
+    Field v   = a.x * hh;
+    JacobianPoint r;
+    r.x        = sqr(rr) - hhh - mulInt(v, 2);
+    r.y        = rr * (v - r.x) - a.y * hhh;
+    r.z        = a.z * h;
+    r.infinity = false;
+    return r;
+}
+
+// Sets r to a if flag is 1 and leaves it unchanged if flag is 0, without branching
+void cmovPoint(JacobianPoint & r, JacobianPoint const & a, uint64_t flag)
+{
+    cmov(r.x, a.x, flag);
+    cmov(r.y, a.y, flag);
+    cmov(r.z, a.z, flag);
+}
+
+// Computes p, 3p, 5p, ... (count values) in Jacobian coordinates
+void oddMultiples(AffinePoint const & p, JacobianPoint * out, int count)
+{
+    JacobianPoint p1 = toJacobian(p);
+    JacobianPoint p2 = dbl(p1);
+    out[0] = p1;
+    for (int i = 1; i < count; ++i)
+    {
+        out[i] = add(out[i - 1], p2);
+    }
+}
+
+// Precomputed odd multiples of the generator for mulDouble
+struct GeneratorTables
+{
+    AffinePoint odd[TABLE_SIZE_G];          // G, 3G, 5G, ...
+    AffinePoint oddLambda[TABLE_SIZE_G];    // lambda * G, 3 * lambda * G, ...
+};
+
+GeneratorTables buildGeneratorTables()
+{
+    GeneratorTables t;
+    JacobianPoint   p[TABLE_SIZE_G];
+
+    oddMultiples(GENERATOR, p, TABLE_SIZE_G);
+    toAffine(p, t.odd, TABLE_SIZE_G);
+    for (int i = 0; i < TABLE_SIZE_G; ++i)
+    {
+        t.oddLambda[i]   = t.odd[i];
+        t.oddLambda[i].x = t.odd[i].x * BETA;
+        normalize(t.oddLambda[i].x);
+    }
+    return t;
+}
+
+GeneratorTables const & generatorTables()
+{
+    static GeneratorTables const TABLES = buildGeneratorTables();
+    return TABLES;
+}
+
+// Precomputed multiples of the generator for mulGenerator. Row i holds j * 16^i * G for j = 1 .. 15, so k * G is the
+// sum of one entry from each row (selected by the 4-bit digits of k) and no doublings are needed. The table is about
+// 80 KB and is built the first time it is needed.
+struct GeneratorComb
+{
+    static int constexpr ROWS    = 64;
+    static int constexpr COLUMNS = 16;
+
+    // Constructor
+    GeneratorComb();
+
+    AffinePoint points[ROWS][COLUMNS];      // Column 0 is unused
+};
+
+GeneratorComb::GeneratorComb()
+{
+    std::vector<JacobianPoint> p((size_t)ROWS * (COLUMNS - 1));
+    JacobianPoint base = toJacobian(GENERATOR);
+    for (int i = 0; i < ROWS; ++i)
+    {
+        JacobianPoint * row = &p[(size_t)i * (COLUMNS - 1)];
+        row[0] = base;
+        for (int j = 1; j < COLUMNS - 1; ++j)
+        {
+            row[j] = add(row[j - 1], base);
+        }
+        base = add(row[COLUMNS - 2], base);
+    }
+
+    std::vector<AffinePoint> affine(p.size());
+    toAffine(p.data(), affine.data(), p.size());
+    for (int i = 0; i < ROWS; ++i)
+    {
+        points[i][0] = GENERATOR;
+        for (int j = 1; j < COLUMNS; ++j)
+        {
+            points[i][j] = affine[(size_t)i * (COLUMNS - 1) + j - 1];
+        }
+    }
+}
+
+GeneratorComb const & generatorComb()
+{
+    static GeneratorComb const COMB;
+    return COMB;
+}
+
+// Computes the width-w NAF of a value less than 2^129. Returns the number of digits.
+int wnaf(Scalar const & s, int w, int * digits)
+{
+    assert(s.d[3] == 0 && s.d[2] <= 1);
+    uint64_t k[3] = { s.d[0], s.d[1], s.d[2] };
+    int      size = 0;
+    while ((k[0] | k[1] | k[2]) != 0)
+    {
+        int digit = 0;
+        if (k[0] & 1)
+        {
+            digit = (int)(k[0] & ((1u << w) - 1));
+            if (digit >= (1 << (w - 1)))
+            {
+                // k += -digit, which clears the low w bits
+                digit -= 1 << w;
+                uint128_t x = (uint128_t)k[0] + (uint64_t)(-digit);
+                k[0] = (uint64_t)x;
+                x    = (uint128_t)k[1] + (uint64_t)(x >> 64);
+                k[1] = (uint64_t)x;
+                k[2] += (uint64_t)(x >> 64);
+            }
+            else
+            {
+                k[0] -= (uint64_t)digit;
+            }
+        }
+        assert(size < MAX_WNAF_SIZE);
+        digits[size++] = digit;
+        k[0] = (k[0] >> 1) | (k[1] << 63);
+        k[1] = (k[1] >> 1) | (k[2] << 63);
+        k[2] >>= 1;
+    }
+    return size;
+}
+
+// Computes the wNAF of one half of a split scalar, which may be negative (greater than n / 2)
+int wnafOfHalf(Scalar const & s, int w, int * digits)
+{
+    if (!isHigh(s))
+        return wnaf(s, w, digits);
+
+    int size = wnaf(negate(s), w, digits);
+    for (int i = 0; i < size; ++i)
+    {
+        digits[i] = -digits[i];
+    }
+    return size;
+}
+
+// Adds the point for a wNAF digit, given a table of odd multiples
+JacobianPoint addDigit(JacobianPoint const & r, int digit, AffinePoint const * table)
+{
+    if (digit > 0)
+        return add(r, table[(digit - 1) / 2]);
+    else if (digit < 0)
+        return add(r, negate(table[(-digit - 1) / 2]));
+    else
+        return r;
+}
+
+JacobianPoint addDigit(JacobianPoint const & r, int digit, JacobianPoint const * table)
+{
+    if (digit > 0)
+        return add(r, table[(digit - 1) / 2]);
+    else if (digit < 0)
+        return add(r, Crypto::Secp256k1::negate(table[(-digit - 1) / 2]));
+    else
+        return r;
+}
+
+// The wNAF digits of the four halves of u1 * G + u2 * Q = a1 * G + a2 * (lambda * G) + b1 * Q + b2 * (lambda * Q),
+// where the halves are about 128 bits
+struct MulDoubleDigits
+{
+    // Constructor
+    MulDoubleDigits(Scalar const & u1, Scalar const & u2)
+    {
+        Scalar a1, a2, b1, b2;
+        Crypto::Secp256k1::splitLambda(u1, a1, a2);
+        Crypto::Secp256k1::splitLambda(u2, b1, b2);
+        sizeA1 = wnafOfHalf(a1, WINDOW_G, a1Digits);
+        sizeA2 = wnafOfHalf(a2, WINDOW_G, a2Digits);
+        sizeB1 = wnafOfHalf(b1, WINDOW_Q, b1Digits);
+        sizeB2 = wnafOfHalf(b2, WINDOW_Q, b2Digits);
+    }
+
+    // Returns the sum given the tables of odd multiples of Q and lambda * Q
+    template <typename Point>
+    JacobianPoint evaluate(Point const * qOdd, Point const * qOddLambda) const
+    {
+        GeneratorTables const & g = generatorTables();
+
+        int size = std::max(std::max(sizeA1, sizeA2), std::max(sizeB1, sizeB2));
+        JacobianPoint r = infinity();
+        for (int i = size - 1; i >= 0; --i)
+        {
+            r = Crypto::Secp256k1::dbl(r);
+            if (i < sizeA1)
+                r = addDigit(r, a1Digits[i], g.odd);
+            if (i < sizeA2)
+                r = addDigit(r, a2Digits[i], g.oddLambda);
+            if (i < sizeB1)
+                r = addDigit(r, b1Digits[i], qOdd);
+            if (i < sizeB2)
+                r = addDigit(r, b2Digits[i], qOddLambda);
+        }
+        return r;
+    }
+
+    int a1Digits[MAX_WNAF_SIZE];
+    int a2Digits[MAX_WNAF_SIZE];
+    int b1Digits[MAX_WNAF_SIZE];
+    int b2Digits[MAX_WNAF_SIZE];
+    int sizeA1;
+    int sizeA2;
+    int sizeB1;
+    int sizeB2;
+};
+
+// Verifies a signature, given the public key as a point or as a table
+template <typename Key>
+bool verifyWith(uint8_t const * hash, Key const & q, uint8_t const * signature)
+{
+    // r and s must be in [1, n-1]
+    Scalar r;
+    Scalar s;
+    if (Crypto::Secp256k1::scalarSetBytes(r, signature) || Crypto::Secp256k1::isZero(r))
+        return false;
+    if (Crypto::Secp256k1::scalarSetBytes(s, signature + 32) || Crypto::Secp256k1::isZero(s))
+        return false;
+
+    Scalar z;
+    Crypto::Secp256k1::scalarSetBytes(z, hash);
+
+    // R = (z / s) * G + (r / s) * Q
+    Scalar        w = Crypto::Secp256k1::inverse(s);
+    JacobianPoint R = Crypto::Secp256k1::mulDouble(Crypto::Secp256k1::mul(z, w), Crypto::Secp256k1::mul(r, w), q);
+    if (R.infinity)
+        return false;
+
+    // The signature is valid if x(R) = r (mod n). Rather than converting R to affine coordinates, r is compared with
+    // X / Z^2, and if r + n < p, then r + n is also a candidate.
+    Field xr;
+    fieldSetBytes(xr, signature);
+    Field zz = sqr(R.z);
+    if (equals(xr * zz, R.x))
+        return true;
+    if (!lessThan(r.d, P_MINUS_N))
+        return false;
+    return equals((xr + N_FIELD) * zz, R.x);
+}
+
+// Returns -a if flag is 1 and a if flag is 0, without branching
+Scalar conditionalNegate(Scalar const & a, uint64_t flag)
+{
+    Scalar   r    = Crypto::Secp256k1::negate(a);
+    uint64_t mask = 0 - flag;
+    for (int i = 0; i < 4; ++i)
+    {
+        r.d[i] = a.d[i] ^ (mask & (a.d[i] ^ r.d[i]));
+    }
+    return r;
+}
+
+// A hasher for the tagged hashes of BIP 340, SHA-256(SHA-256(tag) || SHA-256(tag) || x). The prefix is one block, so
+// it is hashed once.
+class TaggedHasher
+{
+public:
+
+    // Constructor
+    explicit TaggedHasher(char const * tag)
+    {
+        Crypto::Sha256Hash t = Crypto::sha256(reinterpret_cast<uint8_t const *>(tag), strlen(tag));
+        prefixed_.update(t.data(), t.size());
+        prefixed_.update(t.data(), t.size());
+    }
+
+    // Returns a hasher that has already hashed the prefix
+    Crypto::Sha256Hasher hasher() const { return prefixed_; }
+
+private:
+
+    Crypto::Sha256Hasher prefixed_;
+};
+
+TaggedHasher const & auxHasher()
+{
+    static TaggedHasher const hasher("BIP0340/aux");
+    return hasher;
+}
+
+TaggedHasher const & nonceHasher()
+{
+    static TaggedHasher const hasher("BIP0340/nonce");
+    return hasher;
+}
+
+TaggedHasher const & challengeHasher()
+{
+    static TaggedHasher const hasher("BIP0340/challenge");
+    return hasher;
+}
+
+TaggedHasher const & batchHasher()
+{
+    static TaggedHasher const hasher("BIP0340/batch");
+    return hasher;
+}
+
+// Returns the challenge of BIP 340, hash(R.x || P.x || message) mod n
+Scalar challenge(uint8_t const * rx, uint8_t const * px, uint8_t const * message, size_t size)
+{
+    Crypto::Sha256Hasher hasher = challengeHasher().hasher();
+    hasher.update(rx, 32);
+    hasher.update(px, 32);
+    hasher.update(message, size);
+    Crypto::Sha256Hash h = hasher.finalize();
+    Scalar e;
+    Crypto::Secp256k1::scalarSetBytes(e, h.data());
+    return e;
+}
+
+// Generates the candidate nonces of RFC 6979 (section 3.2) using HMAC-SHA256
+class NonceGenerator
+{
+public:
+
+    // Constructor
+    //
+    // key is the private key and hash is the hash reduced modulo n, both as 32 big-endian bytes
+    NonceGenerator(uint8_t const * key, uint8_t const * hash)
+        : first_(true)
+    {
+        std::fill(v_, v_ + SIZE, 0x01);
+        std::fill(k_, k_ + SIZE, 0x00);
+        update(0x00, key, hash);
+        update(0x01, key, hash);
+    }
+
+    // Returns the next candidate. It must be checked to be in [1, n-1].
+    void next(uint8_t * out)
+    {
+        if (!first_)
+        {
+            uint8_t data[SIZE + 1];
+            std::copy(v_, v_ + SIZE, data);
+            data[SIZE] = 0x00;
+            rekey(data, sizeof(data));
+        }
+        first_ = false;
+        mac(v_, SIZE, v_);
+        std::copy(v_, v_ + SIZE, out);
+    }
+
+private:
+
+    static size_t constexpr SIZE = 32;
+
+    // K = HMAC_K(V || separator || key || hash), V = HMAC_K(V)
+    void update(uint8_t separator, uint8_t const * key, uint8_t const * hash)
+    {
+        uint8_t data[3 * SIZE + 1];
+        std::copy(v_, v_ + SIZE, data);
+        data[SIZE] = separator;
+        std::copy(key, key + SIZE, data + SIZE + 1);
+        std::copy(hash, hash + SIZE, data + 2 * SIZE + 1);
+        rekey(data, sizeof(data));
+    }
+
+    // K = HMAC_K(data), V = HMAC_K(V)
+    void rekey(uint8_t const * data, size_t size)
+    {
+        mac(data, size, k_);
+        mac(v_, SIZE, v_);
+    }
+
+    void mac(uint8_t const * data, size_t size, uint8_t * out) const
+    {
+        Crypto::Sha256Hash h = Crypto::HmacSha256(k_, SIZE).mac(data, size);
+        std::copy(h.begin(), h.end(), out);
+    }
+
+    uint8_t v_[SIZE];
+    uint8_t k_[SIZE];
+    bool first_;
+};
+} // anonymous namespace
+
+namespace Crypto
+{
+namespace Secp256k1
+{
+
+bool scalarSetBytes(Scalar & a, uint8_t const * bytes)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t x = 0;
+        for (int j = 0; j < 8; ++j)
+        {
+            x = (x << 8) | bytes[8 * (3 - i) + j];
+        }
+        a.d[i] = x;
+    }
+    return reduceOnce(a.d, 0) != 0;
+}
+
+void scalarGetBytes(Scalar const & a, uint8_t * bytes)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = 0; j < 8; ++j)
+        {
+            bytes[8 * (3 - i) + j] = (uint8_t)(a.d[i] >> (56 - 8 * j));
+        }
+    }
+}
+
+bool isZero(Scalar const & a)
+{
+    return (a.d[0] | a.d[1] | a.d[2] | a.d[3]) == 0;
+}
+
+bool isHigh(Scalar const & a)
+{
+    return lessThan(N_HALF, a.d);
+}
+
+Scalar add(Scalar const & a, Scalar const & b)
+{
+    Scalar   r;
+    uint64_t carry = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint128_t x = (uint128_t)a.d[i] + b.d[i] + carry;
+        r.d[i] = (uint64_t)x;
+        carry  = (uint64_t)(x >> 64);
+    }
+    reduceOnce(r.d, carry);
+    return r;
+}
+
+Scalar mul(Scalar const & a, Scalar const & b)
+{
+    uint64_t t[8];
+    mul512(a.d, b.d, t);
+
+    // Each fold shrinks the value: < 2^386, < 2^260, and then < 2^256 + 2^133
+    fold(t);
+    fold(t);
+    fold(t);
+    reduceOnce(t, t[4]);
+    return Scalar{ { t[0], t[1], t[2], t[3] } };
+}
+
+Scalar negate(Scalar const & a)
+{
+    Scalar   r;
+    uint64_t borrow = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint128_t diff = (uint128_t)N[i] - a.d[i] - borrow;
+        r.d[i] = (uint64_t)diff;
+        borrow = (uint64_t)(diff >> 64) & 1;
+    }
+
+    // -0 is 0, not n
+    uint64_t z    = a.d[0] | a.d[1] | a.d[2] | a.d[3];
+    uint64_t mask = 0 - ((z | (0 - z)) >> 63);
+    for (int i = 0; i < 4; ++i)
+    {
+        r.d[i] &= mask;
+    }
+    return r;
+}
+
+Scalar inverse(Scalar const & a)
+{
+    // a^(n-2), using a fixed window of 4 bits. The exponent is public, so the multiplications by powers from the table
+    // do not reveal anything about a.
+    Scalar powers[16];
+    powers[0] = Scalar{ { 1, 0, 0, 0 } };
+    for (int i = 1; i < 16; ++i)
+    {
+        powers[i] = mul(powers[i - 1], a);
+    }
+
+    Scalar r = powers[0];
+    for (int i = 63; i >= 0; --i)
+    {
+        for (int j = 0; j < 4; ++j)
+        {
+            r = mul(r, r);
+        }
+        r = mul(r, powers[(N_MINUS_2[i / 16] >> (4 * (i % 16))) & 0xf]);
+    }
+    return r;
+}
+
+void splitLambda(Scalar const & k, Scalar & k1, Scalar & k2)
+{
+    // c1 = round(k * b2 / n), c2 = round(k * -b1 / n), and then k2 = -(c1 * b1 + c2 * b2) and k1 = k - k2 * lambda
+    Scalar c1 = mul(mulShift384(k, G1), MINUS_B1);
+    Scalar c2 = mul(mulShift384(k, G2), MINUS_B2);
+    k2 = add(c1, c2);
+    k1 = add(mul(k2, MINUS_LAMBDA), k);
+}
+
+AffinePoint const & generator()
+{
+    return GENERATOR;
+}
+
+bool isOnCurve(AffinePoint const & p)
+{
+    if (p.infinity)
+        return true;
+
+    // y^2 = x^3 + 7
+    return equals(sqr(p.y), sqr(p.x) * p.x + fieldFromInt(7));
+}
+
+JacobianPoint toJacobian(AffinePoint const & p)
+{
+    if (p.infinity)
+        return infinity();
+    return JacobianPoint{ p.x, p.y, fieldFromInt(1), false };
+}
+
+AffinePoint toAffine(JacobianPoint const & p)
+{
+    AffinePoint r;
+    if (p.infinity)
+    {
+        r.x        = fieldFromInt(0);
+        r.y        = fieldFromInt(0);
+        r.infinity = true;
+        return r;
+    }
+
+    Field zi  = inverse(p.z);
+    Field zi2 = sqr(zi);
+    r.x        = p.x * zi2;
+    r.y        = p.y * zi2 * zi;
+    r.infinity = false;
+    normalize(r.x);
+    normalize(r.y);
+    return r;
+}
+
+void toAffine(JacobianPoint const * p, AffinePoint * out, size_t n)
+{
+    std::vector<Field> z(n);
+    std::vector<Field> scratch(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        z[i] = p[i].infinity ? fieldFromInt(0) : p[i].z;
+    }
+    batchInverse(z.data(), n, scratch.data());
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (p[i].infinity)
+        {
+            out[i].x        = fieldFromInt(0);
+            out[i].y        = fieldFromInt(0);
+            out[i].infinity = true;
+            continue;
+        }
+        Field zi2 = sqr(z[i]);
+        out[i].x        = p[i].x * zi2;
+        out[i].y        = p[i].y * zi2 * z[i];
+        out[i].infinity = false;
+        normalize(out[i].x);
+        normalize(out[i].y);
+    }
+}
+
+JacobianPoint negate(JacobianPoint const & p)
+{
+    JacobianPoint r = p;
+    r.y = -p.y;
+    return r;
+}
+
+JacobianPoint dbl(JacobianPoint const & p)
+{
+    // There are no points of order 2, so y is never 0
+    if (p.infinity)
+        return p;
+    return dblUnchecked(p);
+}
+
+JacobianPoint add(JacobianPoint const & a, JacobianPoint const & b)
+{
+    if (a.infinity)
+        return b;
+    if (b.infinity)
+        return a;
+
+    // add-1998-cmo-2 from the Explicit-Formulas Database
+    Field z1z1 = sqr(a.z);
+    Field z2z2 = sqr(b.z);
+    Field u1   = a.x * z2z2;
+    Field u2   = b.x * z1z1;
+    Field s1   = a.y * b.z * z2z2;
+    Field s2   = b.y * a.z * z1z1;
+    Field h    = u2 - u1;
+    Field rr   = s2 - s1;
+    if (isZero(h))
+        return isZero(rr) ? dbl(a) : infinity();
+
+    Field hh  = sqr(h);
+    Field hhh = h * hh;
+    Field v   = u1 * hh;
+    JacobianPoint r;
+    r.x        = sqr(rr) - hhh - mulInt(v, 2);
+    r.y        = rr * (v - r.x) - s1 * hhh;
+    r.z        = a.z * b.z * h;
+    r.infinity = false;
+    return r;
+}
+
+JacobianPoint add(JacobianPoint const & a, AffinePoint const & b)
+{
+    if (a.infinity)
+        return toJacobian(b);
+    if (b.infinity)
+        return a;
+
+    Field h;
+    Field rr;
+    JacobianPoint r = addUnchecked(a, b, h, rr);
+    if (isZero(h))
+        return isZero(rr) ? dbl(a) : infinity();
+    return r;
+}
+
+void batchInverse(Field * a, size_t n, Field * scratch)
+{
+    // scratch[i] is the product of the elements before a[i]
+    Field product = fieldFromInt(1);
+    for (size_t i = 0; i < n; ++i)
+    {
+        scratch[i] = product;
+        if (!isZero(a[i]))
+            product = product * a[i];
+    }
+
+    Field inv = inverse(product);
+    for (size_t i = n; i-- > 0;)
+    {
+        if (isZero(a[i]))
+            continue;
+        Field next = inv * a[i];
+        a[i] = inv * scratch[i];
+        inv  = next;
+    }
+}
+
+JacobianPoint mulDouble(Scalar const & u1, Scalar const & u2, AffinePoint const & q)
+{
+    MulDoubleDigits d(u1, u2);
+
+    JacobianPoint qOdd[TABLE_SIZE_Q];
+    JacobianPoint qOddLambda[TABLE_SIZE_Q];
+    if (d.sizeB1 > 0 || d.sizeB2 > 0)
+    {
+        oddMultiples(q, qOdd, TABLE_SIZE_Q);
+        for (int i = 0; i < TABLE_SIZE_Q; ++i)
+        {
+            qOddLambda[i]   = qOdd[i];
+            qOddLambda[i].x = qOdd[i].x * BETA;
+        }
+    }
+    return d.evaluate(qOdd, qOddLambda);
+}
+
+JacobianPoint mulDouble(Scalar const & u1, Scalar const & u2, KeyTable const & q)
+{
+    MulDoubleDigits d(u1, u2);
+
+    AffinePoint qOddLambda[TABLE_SIZE_Q];
+    if (d.sizeB2 > 0)
+    {
+        for (int i = 0; i < TABLE_SIZE_Q; ++i)
+        {
+            qOddLambda[i]   = q.odd[i];
+            qOddLambda[i].x = q.odd[i].x * BETA;
+        }
+    }
+    return d.evaluate(q.odd, qOddLambda);
+}
+
+void buildKeyTables(AffinePoint const * p, KeyTable * tables, size_t n)
+{
+    std::vector<JacobianPoint> multiples(n * TABLE_SIZE_Q);
+    for (size_t i = 0; i < n; ++i)
+    {
+        assert(!p[i].infinity);
+        oddMultiples(p[i], &multiples[i * TABLE_SIZE_Q], TABLE_SIZE_Q);
+    }
+
+    std::vector<AffinePoint> affine(multiples.size());
+    toAffine(multiples.data(), affine.data(), multiples.size());
+    for (size_t i = 0; i < n; ++i)
+    {
+        std::copy(&affine[i * TABLE_SIZE_Q], &affine[(i + 1) * TABLE_SIZE_Q], tables[i].odd);
+    }
+}
+
+JacobianPoint mulGenerator(Scalar const & k)
+{
+    GeneratorComb const & comb = generatorComb();
+
+    // One entry is added from each row of the comb. The entry is selected by scanning the whole row, and the point at
+    // infinity is tracked with a mask instead of by branching.
+    JacobianPoint r          = infinity();
+    uint64_t      atInfinity = 1;
+    for (int i = 0; i < GeneratorComb::ROWS; ++i)
+    {
+        uint64_t    digit = (k.d[i / 16] >> (4 * (i % 16))) & 0xf;
+        AffinePoint t     = comb.points[i][1];
+        for (uint64_t j = 2; j < GeneratorComb::COLUMNS; ++j)
+        {
+            uint64_t match = ((j ^ digit) - 1) >> 63;
+            cmov(t.x, comb.points[i][j].x, match);
+            cmov(t.y, comb.points[i][j].y, match);
+        }
+
+        // r is the sum of the entries for the lower digits, which is less than 16^i * G. Since k < n, r is never equal
+        // to t or -t unless r is the point at infinity.
+        Field h;
+        Field rr;
+        JacobianPoint sum       = addUnchecked(r, t, h, rr);
+        JacobianPoint tJacobian = { t.x, t.y, fieldFromInt(1), false };
+        uint64_t      zeroDigit = (digit - 1) >> 63;
+        cmovPoint(sum, tJacobian, atInfinity);
+        cmovPoint(sum, r, zeroDigit);
+        r           = sum;
+        atInfinity &= zeroDigit;
+    }
+    r.infinity = atInfinity != 0;
+    return r;
+}
+
+JacobianPoint mulMulti(Scalar const & g, Scalar const * k, AffinePoint const * p, size_t n)
+{
+    GeneratorTables const & gt = generatorTables();
+
+    // Each multiplier is split into two halves, as in mulDouble()
+    Scalar g1, g2;
+    splitLambda(g, g1, g2);
+    int digitsG1[MAX_WNAF_SIZE];
+    int digitsG2[MAX_WNAF_SIZE];
+    int sizeG1 = wnafOfHalf(g1, WINDOW_G, digitsG1);
+    int sizeG2 = wnafOfHalf(g2, WINDOW_G, digitsG2);
+    int size   = std::max(sizeG1, sizeG2);
+
+    std::vector<int> digits(2 * n * MAX_WNAF_SIZE);
+    std::vector<int> sizes(2 * n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        Scalar k1, k2;
+        splitLambda(k[i], k1, k2);
+        sizes[2 * i]     = wnafOfHalf(k1, WINDOW_Q, &digits[(2 * i) * MAX_WNAF_SIZE]);
+        sizes[2 * i + 1] = wnafOfHalf(k2, WINDOW_Q, &digits[(2 * i + 1) * MAX_WNAF_SIZE]);
+        size = std::max(size, std::max(sizes[2 * i], sizes[2 * i + 1]));
+    }
+
+    // The tables of all of the points are converted to affine coordinates together
+    std::vector<KeyTable> tables(n);
+    buildKeyTables(p, tables.data(), n);
+    std::vector<KeyTable> lambdaTables(tables);
+    for (auto & t : lambdaTables)
+    {
+        for (auto & a : t.odd)
+        {
+            a.x = a.x * BETA;
+        }
+    }
+
+    JacobianPoint r = infinity();
+    for (int j = size - 1; j >= 0; --j)
+    {
+        r = dbl(r);
+        if (j < sizeG1)
+            r = addDigit(r, digitsG1[j], gt.odd);
+        if (j < sizeG2)
+            r = addDigit(r, digitsG2[j], gt.oddLambda);
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (j < sizes[2 * i])
+                r = addDigit(r, digits[(2 * i) * MAX_WNAF_SIZE + j], tables[i].odd);
+            if (j < sizes[2 * i + 1])
+                r = addDigit(r, digits[(2 * i + 1) * MAX_WNAF_SIZE + j], lambdaTables[i].odd);
+        }
+    }
+    return r;
+}
+
+bool parsePublicKey(uint8_t const * k, size_t size, AffinePoint & p)
+{
+    p.infinity = false;
+    if (size == 33 && (k[0] == 0x02 || k[0] == 0x03))
+    {
+        // y = sqrt(x^3 + 7), choosing the root with the parity given by the prefix
+        if (!fieldSetBytes(p.x, k + 1))
+            return false;
+        if (!sqrt(sqr(p.x) * p.x + fieldFromInt(7), p.y))
+            return false;
+        if (isOdd(p.y) != (k[0] == 0x03))
+            p.y = -p.y;
+        normalize(p.x);
+        normalize(p.y);
+        return true;
+    }
+    else if (size == 65 && k[0] == 0x04)
+    {
+        if (!fieldSetBytes(p.x, k + 1) || !fieldSetBytes(p.y, k + 33))
+            return false;
+        return isOnCurve(p);
+    }
+    return false;
+}
+
+size_t serializePublicKey(AffinePoint const & p, bool compressed, uint8_t * out)
+{
+    assert(!p.infinity);
+    fieldGetBytes(p.x, out + 1);
+    if (compressed)
+    {
+        out[0] = isOdd(p.y) ? 0x03 : 0x02;
+        return 33;
+    }
+    out[0] = 0x04;
+    fieldGetBytes(p.y, out + 33);
+    return 65;
+}
+
+void sign(uint8_t const * hash, Scalar const & key, uint8_t * signature)
+{
+    assert(!isZero(key));
+
+    Scalar  z;
+    uint8_t zBytes[32];
+    uint8_t keyBytes[32];
+    scalarSetBytes(z, hash);
+    scalarGetBytes(z, zBytes);
+    scalarGetBytes(key, keyBytes);
+
+    // Candidates are tried until one gives r and s that are not 0. In practice, the first one always does.
+    NonceGenerator nonces(keyBytes, zBytes);
+    for (;;)
+    {
+        uint8_t candidate[32];
+        nonces.next(candidate);
+        Scalar k;
+        if (scalarSetBytes(k, candidate) || isZero(k))
+            continue;
+
+        // r = x(k * G) mod n, s = (z + r * key) / k
+        uint8_t rBytes[32];
+        fieldGetBytes(toAffine(mulGenerator(k)).x, rBytes);
+        Scalar r;
+        scalarSetBytes(r, rBytes);
+        if (isZero(r))
+            continue;
+        Scalar s = mul(inverse(k), add(z, mul(r, key)));
+        if (isZero(s))
+            continue;
+
+        // Both s and -s are valid, and the low one is required by the standardness rules (BIP 62, BIP 146)
+        if (isHigh(s))
+            s = negate(s);
+        scalarGetBytes(r, signature);
+        scalarGetBytes(s, signature + 32);
+        return;
+    }
+}
+
+bool verify(uint8_t const * hash, AffinePoint const & q, uint8_t const * signature)
+{
+    return verifyWith(hash, q, signature);
+}
+
+bool verify(uint8_t const * hash, KeyTable const & q, uint8_t const * signature)
+{
+    return verifyWith(hash, q, signature);
+}
+
+bool liftX(uint8_t const * x, AffinePoint & p)
+{
+    p.infinity = false;
+    if (!fieldSetBytes(p.x, x))
+        return false;
+    if (!sqrt(sqr(p.x) * p.x + fieldFromInt(7), p.y))
+        return false;
+    if (isOdd(p.y))
+        p.y = -p.y;
+    normalize(p.x);
+    normalize(p.y);
+    return true;
+}
+
+bool schnorrSign(uint8_t const * message, size_t size, Scalar const & key, uint8_t const * aux, uint8_t * signature)
+{
+    assert(!isZero(key));
+
+    // The key is negated if necessary so that its public key has an even y-coordinate
+    AffinePoint p = toAffine(mulGenerator(key));
+    Scalar      d = conditionalNegate(key, isOdd(p.y));
+    uint8_t     px[32];
+    fieldGetBytes(p.x, px);
+
+    // t = d xor hash_aux(aux), k = hash_nonce(t || P.x || message) mod n
+    Crypto::Sha256Hasher hasher = auxHasher().hasher();
+    hasher.update(aux, 32);
+    Crypto::Sha256Hash t = hasher.finalize();
+    uint8_t dBytes[32];
+    scalarGetBytes(d, dBytes);
+    for (int i = 0; i < 32; ++i)
+    {
+        t[i] ^= dBytes[i];
+    }
+    hasher = nonceHasher().hasher();
+    hasher.update(t.data(), t.size());
+    hasher.update(px, sizeof(px));
+    hasher.update(message, size);
+    Crypto::Sha256Hash rand = hasher.finalize();
+    Scalar k;
+    scalarSetBytes(k, rand.data());
+    if (isZero(k))
+        return false;
+
+    // The nonce is also negated if necessary so that R has an even y-coordinate
+    AffinePoint r = toAffine(mulGenerator(k));
+    k = conditionalNegate(k, isOdd(r.y));
+    fieldGetBytes(r.x, signature);
+
+    // s = k + e * d
+    Scalar e = challenge(signature, px, message, size);
+    scalarGetBytes(add(k, mul(e, d)), signature + 32);
+    return true;
+}
+
+bool schnorrVerify(uint8_t const * message, size_t size, uint8_t const * pubKey, uint8_t const * signature)
+{
+    AffinePoint p;
+    if (!liftX(pubKey, p))
+        return false;
+    Field r;
+    if (!fieldSetBytes(r, signature))
+        return false;
+    Scalar s;
+    if (scalarSetBytes(s, signature + 32))
+        return false;
+
+    // R = s * G - e * P must have an even y-coordinate and an x-coordinate equal to r
+    Scalar        e  = challenge(signature, pubKey, message, size);
+    JacobianPoint rj = mulDouble(s, negate(e), p);
+    if (rj.infinity)
+        return false;
+    AffinePoint ra = toAffine(rj);
+    return !isOdd(ra.y) && equals(ra.x, r);
+}
+
+bool schnorrVerifyBatch(SchnorrItem const * items, size_t n)
+{
+    if (n == 0)
+        return true;
+
+    // The multipliers a[i] are derived from a hash of all of the inputs, with a[0] = 1
+    Crypto::Sha256Hasher hasher = batchHasher().hasher();
+    for (size_t i = 0; i < n; ++i)
+    {
+        uint8_t sizeBytes[8];
+        for (int j = 0; j < 8; ++j)
+        {
+            sizeBytes[j] = (uint8_t)((uint64_t)items[i].size >> (8 * j));
+        }
+        hasher.update(items[i].pubKey, 32);
+        hasher.update(items[i].signature, 64);
+        hasher.update(sizeBytes, sizeof(sizeBytes));
+        hasher.update(items[i].message, items[i].size);
+    }
+    Crypto::Sha256Hash seed = hasher.finalize();
+
+    // Checks that (sum of a[i] * s[i]) * G - sum of a[i] * R[i] - sum of (a[i] * e[i]) * P[i] is the point at infinity
+    std::vector<AffinePoint> points(2 * n);
+    std::vector<Scalar>      multipliers(2 * n);
+    Scalar g = { { 0, 0, 0, 0 } };
+    for (size_t i = 0; i < n; ++i)
+    {
+        SchnorrItem const & item = items[i];
+        if (!liftX(item.signature, points[2 * i]) || !liftX(item.pubKey, points[2 * i + 1]))
+            return false;
+        Scalar s;
+        if (scalarSetBytes(s, item.signature + 32))
+            return false;
+        Scalar e = challenge(item.signature, item.pubKey, item.message, item.size);
+
+        Scalar a = { { 1, 0, 0, 0 } };
+        if (i > 0)
+        {
+            uint8_t block[Crypto::CHACHA20_BLOCK_SIZE];
+            Crypto::chacha20(seed.data(), 0, i, block, 1);
+            scalarSetBytes(a, block);
+        }
+        g                      = add(g, mul(a, s));
+        multipliers[2 * i]     = negate(a);
+        multipliers[2 * i + 1] = negate(mul(a, e));
+    }
+    return mulMulti(g, multipliers.data(), points.data(), points.size()).infinity;
+}
+
+} // namespace Secp256k1
+} // namespace Crypto
+
+#endif // defined(CRYPTO_SECP256K1_NATIVE)
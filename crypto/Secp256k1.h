@@ -0,0 +1,217 @@
+#pragma once
+
+// Native implementation of the secp256k1 curve used by the native Ecc backend. This header is not part of the public
+// API.
+//
+// Field elements use five 52-bit limbs (see Secp256k1Field.h) and scalars (integers modulo the group order n) use four
+// 64-bit limbs. Points are added in Jacobian coordinates. Verification computes u1 * G + u2 * Q with the secp256k1
+// endomorphism (lambda * (x, y) = (beta * x, y)), which splits each 256-bit scalar into two 128-bit halves and halves
+// the number of doublings, and with wNAF representations of the halves.
+//
+// Operations on secret values (signing keys) do not branch on them or index memory with them. Verification and parsing
+// only involve public values and are not constant-time.
+
+#if defined(__SIZEOF_INT128__)
+//! Defined if the native secp256k1 implementation is available (it requires 128-bit integer arithmetic).
+#define CRYPTO_SECP256K1_NATIVE
+#endif
+
+#if defined(CRYPTO_SECP256K1_NATIVE)
+
+#include "Secp256k1Field.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Crypto
+{
+namespace Secp256k1
+{
+//! An integer modulo the group order n, in four 64-bit limbs (least significant first)
+struct Scalar
+{
+    uint64_t d[4];
+};
+
+//! A point in affine coordinates
+struct AffinePoint
+{
+    Field x;
+    Field y;
+    bool infinity;
+};
+
+//! A point in Jacobian coordinates, (x, y) = (X / Z^2, Y / Z^3)
+struct JacobianPoint
+{
+    Field x;
+    Field y;
+    Field z;
+    bool infinity;
+};
+
+//! Number of odd multiples in a public key's verification table
+int constexpr KEY_TABLE_SIZE = 8;
+
+//! The odd multiples q, 3q, ..., 15q of a public key in affine coordinates. Verifying with a key's table saves building
+//! the multiples for every signature, and they are added with mixed additions, which are cheaper.
+struct KeyTable
+{
+    AffinePoint odd[KEY_TABLE_SIZE];
+};
+
+//! Sets a scalar from 32 big-endian bytes, reducing it modulo n. Returns true if the value was not less than n.
+bool scalarSetBytes(Scalar & a, uint8_t const * bytes);
+
+//! Stores a scalar as 32 big-endian bytes
+void scalarGetBytes(Scalar const & a, uint8_t * bytes);
+
+//! Returns true if the scalar is 0
+bool isZero(Scalar const & a);
+
+//! Returns true if the scalar is greater than n / 2
+bool isHigh(Scalar const & a);
+
+//! Returns a + b (mod n)
+Scalar add(Scalar const & a, Scalar const & b);
+
+//! Returns a * b (mod n)
+Scalar mul(Scalar const & a, Scalar const & b);
+
+//! Returns -a (mod n)
+Scalar negate(Scalar const & a);
+
+//! Returns 1 / a (mod n). The exponent is public, but the running time does not depend on a.
+Scalar inverse(Scalar const & a);
+
+//! Splits k into k1 and k2 such that k = k1 + k2 * lambda (mod n), where k1 and k2 (or their negations) are less than
+//! 2^128.
+void splitLambda(Scalar const & k, Scalar & k1, Scalar & k2);
+
+//! Returns the generator
+AffinePoint const & generator();
+
+//! Returns true if the point is on the curve (or is the point at infinity)
+bool isOnCurve(AffinePoint const & p);
+
+//! Converts an affine point to Jacobian coordinates
+JacobianPoint toJacobian(AffinePoint const & p);
+
+//! Converts a point in Jacobian coordinates to affine coordinates
+AffinePoint toAffine(JacobianPoint const & p);
+
+//! Converts a number of points to affine coordinates using one field inversion
+//!
+//! @param      p       points
+//! @param[out] out     converted points
+//! @param      n       number of points
+void toAffine(JacobianPoint const * p, AffinePoint * out, size_t n);
+
+//! Returns -p
+JacobianPoint negate(JacobianPoint const & p);
+
+//! Returns 2p
+JacobianPoint dbl(JacobianPoint const & p);
+
+//! Returns a + b
+JacobianPoint add(JacobianPoint const & a, JacobianPoint const & b);
+
+//! Returns a + b
+JacobianPoint add(JacobianPoint const & a, AffinePoint const & b);
+
+//! Replaces each of n elements with its inverse using one field inversion (Montgomery's trick). Elements that are 0
+//! are left unchanged.
+//!
+//! @param  a       elements
+//! @param  n       number of elements
+//! @param  scratch space for n elements
+void batchInverse(Field * a, size_t n, Field * scratch);
+
+//! Returns u1 * G + u2 * q. The values are public, so the running time depends on them.
+JacobianPoint mulDouble(Scalar const & u1, Scalar const & u2, AffinePoint const & q);
+
+//! Returns u1 * G + u2 * q, given the table of q. The values are public, so the running time depends on them.
+JacobianPoint mulDouble(Scalar const & u1, Scalar const & u2, KeyTable const & q);
+
+//! Builds the verification tables of a number of points. The multiples are converted to affine coordinates together,
+//! using one field inversion for all of them (Montgomery's trick), so building many tables at once is much cheaper than
+//! building them one at a time.
+//!
+//! @param      p       points (none of them the point at infinity)
+//! @param[out] tables  tables
+//! @param      n       number of points
+void buildKeyTables(AffinePoint const * p, KeyTable * tables, size_t n);
+
+//! Returns g * G + the sum of k[i] * p[i], using one chain of doublings for all of the terms (Strauss's algorithm with
+//! the endomorphism). The values are public, so the running time depends on them.
+//!
+//! @param  g   multiplier of the generator
+//! @param  k   multipliers of the points
+//! @param  p   points (none of them the point at infinity)
+//! @param  n   number of points
+JacobianPoint mulMulti(Scalar const & g, Scalar const * k, AffinePoint const * p, size_t n);
+
+//! Returns k * G, using a table of multiples of G that is built the first time it is needed. The running time and
+//! memory accesses do not depend on k.
+JacobianPoint mulGenerator(Scalar const & k);
+
+//! Parses a serialized public key (33 bytes compressed or 65 bytes uncompressed). Returns false if the key is not
+//! properly encoded or the point is not on the curve.
+bool parsePublicKey(uint8_t const * k, size_t size, AffinePoint & p);
+
+//! Serializes a public key. Returns the size (33 bytes if compressed and 65 bytes if uncompressed).
+size_t serializePublicKey(AffinePoint const & p, bool compressed, uint8_t * out);
+
+//! Signs a hash with a private key in [1, n-1], using a deterministic nonce (RFC 6979 with HMAC-SHA256). The signature
+//! is r || s (64 bytes), with s in the lower half of its range. The computations involving the key and the nonce are
+//! constant-time.
+void sign(uint8_t const * hash, Scalar const & key, uint8_t * signature);
+
+//! Verifies an ECDSA signature given the hash of the message and the signature as r || s (64 bytes)
+bool verify(uint8_t const * hash, AffinePoint const & q, uint8_t const * signature);
+
+//! Returns the point with the given x-coordinate (32 big-endian bytes) and an even y-coordinate, as in BIP 340.
+//! Returns false if the value is not less than p or there is no such point.
+bool liftX(uint8_t const * x, AffinePoint & p);
+
+//! Signs a message with a private key in [1, n-1] as specified by BIP 340. The signature is R.x || s (64 bytes).
+//!
+//! @param      message     message
+//! @param      size        size of the message
+//! @param      key         private key
+//! @param      aux         auxiliary random data (32 bytes)
+//! @param[out] signature   signature
+//! @return false if the nonce is 0 (which is negligibly unlikely)
+bool schnorrSign(uint8_t const * message, size_t size, Scalar const & key, uint8_t const * aux, uint8_t * signature);
+
+//! Verifies a BIP 340 signature given the message, the x-only public key (32 bytes), and the signature (64 bytes)
+bool schnorrVerify(uint8_t const * message, size_t size, uint8_t const * pubKey, uint8_t const * signature);
+
+//! A signature checked by schnorrVerifyBatch()
+struct SchnorrItem
+{
+    uint8_t const * message;        //!< Message
+    size_t size;                    //!< Size of the message
+    uint8_t const * pubKey;         //!< x-only public key (32 bytes)
+    uint8_t const * signature;      //!< Signature (64 bytes)
+};
+
+//! Verifies a number of BIP 340 signatures together.
+//!
+//! The signatures are combined with random multipliers into a single equation that is checked with one multi-scalar
+//! multiplication (see mulMulti()), as described in BIP 340. The multipliers are generated from a hash of all of the
+//! inputs. The result is true if and only if every signature is valid (except with negligible probability), but it
+//! does not tell which ones are not.
+//!
+//! @param  items   signatures
+//! @param  n       number of signatures
+//! @return true if every signature is valid
+bool schnorrVerifyBatch(SchnorrItem const * items, size_t n);
+
+//! Verifies an ECDSA signature given the hash of the message, the table of the public key, and the signature
+bool verify(uint8_t const * hash, KeyTable const & q, uint8_t const * signature);
+
+} // namespace Secp256k1
+} // namespace Crypto
+
+#endif // defined(CRYPTO_SECP256K1_NATIVE)
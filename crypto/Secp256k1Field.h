@@ -0,0 +1,322 @@
+#pragma once
+
+// Arithmetic in the field of the secp256k1 curve (integers modulo p = 2^256 - 2^32 - 977). This header is not part of
+// the public API.
+//
+// An element is stored in five 52-bit limbs, value = n[0] + n[1] * 2^52 + n[2] * 2^104 + n[3] * 2^156 + n[4] * 2^208.
+// Every operation returns a weakly normalized element (n[0..3] < 2^52 and n[4] <= 2^48), which is congruent to the
+// value but not necessarily less than p. normalize() produces the unique representation. The spare bits allow sums to
+// be computed without carries, and products are computed with 128-bit arithmetic.
+//
+// None of the operations branch on the values of the elements.
+
+#include <cstdint>
+
+namespace Crypto
+{
+namespace Secp256k1
+{
+typedef unsigned __int128 uint128_t;
+
+//! An element of the secp256k1 field
+struct Field
+{
+    uint64_t n[5];
+};
+
+namespace FieldImpl
+{
+uint64_t constexpr M52  = 0xFFFFFFFFFFFFF;  // Low 52 bits
+uint64_t constexpr M48  = 0x0FFFFFFFFFFFF;  // Low 48 bits
+uint64_t constexpr R256 = 0x1000003D1;      // 2^256 mod p
+uint64_t constexpr R260 = 0x1000003D10;     // 2^260 mod p
+
+// 2p, which is greater than every limb of a weakly normalized element
+uint64_t constexpr P2[5] =
+{
+    2 * 0xFFFFEFFFFFC2F, 2 * M52, 2 * M52, 2 * M52, 2 * M48
+};
+
+// Carries so that n[0..3] < 2^52, folding the bits of n[4] at or above 2^48 back into n[0]. The limbs must be less than
+// 2^63.
+inline void normalizeWeak(uint64_t * t)
+{
+    uint64_t x = t[4] >> 48;
+    t[4] &= M48;
+    t[0] += x * R256;
+    t[1] += t[0] >> 52; t[0] &= M52;
+    t[2] += t[1] >> 52; t[1] &= M52;
+    t[3] += t[2] >> 52; t[2] &= M52;
+    t[4] += t[3] >> 52; t[3] &= M52;
+}
+
+// Reduces a product given in nine 128-bit columns (column k has weight 2^(52k))
+inline Field reduce(uint128_t const * c)
+{
+    // Carry into ten 52-bit limbs
+    uint64_t  d[10];
+    uint128_t acc = 0;
+    for (int k = 0; k < 9; ++k)
+    {
+        acc += c[k];
+        d[k] = (uint64_t)acc & M52;
+        acc >>= 52;
+    }
+    d[9] = (uint64_t)acc;
+
+    // Fold the upper five limbs (weight 2^260) into the lower five
+    Field r;
+    acc = 0;
+    for (int k = 0; k < 5; ++k)
+    {
+        acc += (uint128_t)d[k] + (uint128_t)d[k + 5] * R260;
+        r.n[k] = (uint64_t)acc & M52;
+        acc >>= 52;
+    }
+
+    // Fold everything at or above 2^256 into the low limb
+    uint128_t top = (acc << 4) | (r.n[4] >> 48);
+    r.n[4] &= M48;
+    acc     = (uint128_t)r.n[0] + top * R256;
+    r.n[0]  = (uint64_t)acc & M52;
+    acc     = (acc >> 52) + r.n[1];
+    r.n[1]  = (uint64_t)acc & M52;
+    acc     = (acc >> 52) + r.n[2];
+    r.n[2]  = (uint64_t)acc & M52;
+    acc     = (acc >> 52) + r.n[3];
+    r.n[3]  = (uint64_t)acc & M52;
+    r.n[4] += (uint64_t)(acc >> 52);
+    return r;
+}
+} // namespace FieldImpl
+
+//! Returns a small integer as a field element
+inline Field fieldFromInt(uint32_t x)
+{
+    return Field{ { x, 0, 0, 0, 0 } };
+}
+
+//! Reduces an element to its unique representation (less than p)
+inline void normalize(Field & a)
+{
+    using namespace FieldImpl;
+
+    uint64_t t[5] = { a.n[0], a.n[1], a.n[2], a.n[3], a.n[4] };
+    normalizeWeak(t);
+
+    // At most one subtraction of p is needed. It is done by adding 2^256 - p and dropping the bit at 2^256.
+    uint64_t m = t[1] & t[2] & t[3];
+    uint64_t x = (t[4] >> 48) | ((uint64_t)(t[4] == M48) & (uint64_t)(m == M52) & (uint64_t)(t[0] >= 0xFFFFEFFFFFC2F));
+    t[0] += x * R256;
+    t[1] += t[0] >> 52; t[0] &= M52;
+    t[2] += t[1] >> 52; t[1] &= M52;
+    t[3] += t[2] >> 52; t[2] &= M52;
+    t[4] += t[3] >> 52; t[3] &= M52;
+    t[4] &= M48;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        a.n[i] = t[i];
+    }
+}
+
+//! Sets an element from 32 big-endian bytes. Returns false if the value is not less than p.
+inline bool fieldSetBytes(Field & a, uint8_t const * bytes)
+{
+    uint64_t w[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t x = 0;
+        for (int j = 0; j < 8; ++j)
+        {
+            x = (x << 8) | bytes[8 * (3 - i) + j];
+        }
+        w[i] = x;
+    }
+
+    a.n[0] = w[0] & FieldImpl::M52;
+    a.n[1] = ((w[0] >> 52) | (w[1] << 12)) & FieldImpl::M52;
+    a.n[2] = ((w[1] >> 40) | (w[2] << 24)) & FieldImpl::M52;
+    a.n[3] = ((w[2] >> 28) | (w[3] << 36)) & FieldImpl::M52;
+    a.n[4] = w[3] >> 16;
+
+    // p = FFFFFFFF FFFFFFFF FFFFFFFF FFFFFFFF FFFFFFFF FFFFFFFF FFFFFFFE FFFFFC2F
+    return !(w[3] == ~0ull && w[2] == ~0ull && w[1] == ~0ull && w[0] >= 0xFFFFFFFEFFFFFC2F);
+}
+
+//! Stores an element as 32 big-endian bytes
+inline void fieldGetBytes(Field a, uint8_t * bytes)
+{
+    normalize(a);
+    uint64_t w[4] =
+    {
+        a.n[0] | (a.n[1] << 52),
+        (a.n[1] >> 12) | (a.n[2] << 40),
+        (a.n[2] >> 24) | (a.n[3] << 28),
+        (a.n[3] >> 36) | (a.n[4] << 16)
+    };
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = 0; j < 8; ++j)
+        {
+            bytes[8 * (3 - i) + j] = (uint8_t)(w[i] >> (56 - 8 * j));
+        }
+    }
+}
+
+//! Returns true if the element is 0 (mod p)
+inline bool isZero(Field a)
+{
+    normalize(a);
+    return (a.n[0] | a.n[1] | a.n[2] | a.n[3] | a.n[4]) == 0;
+}
+
+//! Returns true if the element (mod p) is odd
+inline bool isOdd(Field a)
+{
+    normalize(a);
+    return (a.n[0] & 1) != 0;
+}
+
+//! Returns true if the elements are equal (mod p)
+inline bool equals(Field a, Field b)
+{
+    normalize(a);
+    normalize(b);
+    return ((a.n[0] ^ b.n[0]) | (a.n[1] ^ b.n[1]) | (a.n[2] ^ b.n[2]) | (a.n[3] ^ b.n[3]) | (a.n[4] ^ b.n[4])) == 0;
+}
+
+//! Sets r to a if flag is 1 and leaves it unchanged if flag is 0, without branching
+inline void cmov(Field & r, Field const & a, uint64_t flag)
+{
+    uint64_t mask = 0 - flag;
+    for (int i = 0; i < 5; ++i)
+    {
+        r.n[i] ^= mask & (r.n[i] ^ a.n[i]);
+    }
+}
+
+inline Field operator +(Field const & a, Field const & b)
+{
+    uint64_t t[5] = { a.n[0] + b.n[0], a.n[1] + b.n[1], a.n[2] + b.n[2], a.n[3] + b.n[3], a.n[4] + b.n[4] };
+    FieldImpl::normalizeWeak(t);
+    return Field{ { t[0], t[1], t[2], t[3], t[4] } };
+}
+
+inline Field operator -(Field const & a, Field const & b)
+{
+    using FieldImpl::P2;
+    uint64_t t[5] =
+    {
+        a.n[0] + P2[0] - b.n[0], a.n[1] + P2[1] - b.n[1], a.n[2] + P2[2] - b.n[2], a.n[3] + P2[3] - b.n[3],
+        a.n[4] + P2[4] - b.n[4]
+    };
+    FieldImpl::normalizeWeak(t);
+    return Field{ { t[0], t[1], t[2], t[3], t[4] } };
+}
+
+inline Field operator -(Field const & a)
+{
+    return fieldFromInt(0) - a;
+}
+
+//! Returns a * k for a small k (less than 2^10)
+inline Field mulInt(Field const & a, uint32_t k)
+{
+    uint64_t t[5] = { a.n[0] * k, a.n[1] * k, a.n[2] * k, a.n[3] * k, a.n[4] * k };
+    FieldImpl::normalizeWeak(t);
+    return Field{ { t[0], t[1], t[2], t[3], t[4] } };
+}
+
+inline Field operator *(Field const & a, Field const & b)
+{
+    uint64_t const * x = a.n;
+    uint64_t const * y = b.n;
+    uint128_t c[9];
+    c[0] = (uint128_t)x[0] * y[0];
+    c[1] = (uint128_t)x[0] * y[1] + (uint128_t)x[1] * y[0];
+    c[2] = (uint128_t)x[0] * y[2] + (uint128_t)x[1] * y[1] + (uint128_t)x[2] * y[0];
+    c[3] = (uint128_t)x[0] * y[3] + (uint128_t)x[1] * y[2] + (uint128_t)x[2] * y[1] + (uint128_t)x[3] * y[0];
+    c[4] = (uint128_t)x[0] * y[4] + (uint128_t)x[1] * y[3] + (uint128_t)x[2] * y[2] + (uint128_t)x[3] * y[1] +
+           (uint128_t)x[4] * y[0];
+    c[5] = (uint128_t)x[1] * y[4] + (uint128_t)x[2] * y[3] + (uint128_t)x[3] * y[2] + (uint128_t)x[4] * y[1];
+    c[6] = (uint128_t)x[2] * y[4] + (uint128_t)x[3] * y[3] + (uint128_t)x[4] * y[2];
+    c[7] = (uint128_t)x[3] * y[4] + (uint128_t)x[4] * y[3];
+    c[8] = (uint128_t)x[4] * y[4];
+    return FieldImpl::reduce(c);
+}
+
+//! Returns a^2
+inline Field sqr(Field const & a)
+{
+    uint64_t const * x = a.n;
+    uint64_t x0d = x[0] * 2;
+    uint64_t x1d = x[1] * 2;
+    uint64_t x2d = x[2] * 2;
+    uint64_t x3d = x[3] * 2;
+    uint128_t c[9];
+    c[0] = (uint128_t)x[0] * x[0];
+    c[1] = (uint128_t)x0d * x[1];
+    c[2] = (uint128_t)x0d * x[2] + (uint128_t)x[1] * x[1];
+    c[3] = (uint128_t)x0d * x[3] + (uint128_t)x1d * x[2];
+    c[4] = (uint128_t)x0d * x[4] + (uint128_t)x1d * x[3] + (uint128_t)x[2] * x[2];
+    c[5] = (uint128_t)x1d * x[4] + (uint128_t)x2d * x[3];
+    c[6] = (uint128_t)x2d * x[4] + (uint128_t)x[3] * x[3];
+    c[7] = (uint128_t)x3d * x[4];
+    c[8] = (uint128_t)x[4] * x[4];
+    return FieldImpl::reduce(c);
+}
+
+//! Returns a^(2^n)
+inline Field sqrN(Field a, int n)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        a = sqr(a);
+    }
+    return a;
+}
+
+namespace FieldImpl
+{
+// Computes a^(2^223 - 1) and the intermediate powers a^(2^k - 1) for k = 2, 3, and 22, which are the building blocks of
+// the exponents p - 2 and (p + 1) / 4
+inline Field pow223(Field const & a, Field & x2, Field & x3, Field & x22)
+{
+    x2         = sqr(a) * a;
+    x3         = sqr(x2) * a;
+    Field x6   = sqrN(x3, 3) * x3;
+    Field x9   = sqrN(x6, 3) * x3;
+    Field x11  = sqrN(x9, 2) * x2;
+    x22        = sqrN(x11, 11) * x11;
+    Field x44  = sqrN(x22, 22) * x22;
+    Field x88  = sqrN(x44, 44) * x44;
+    Field x176 = sqrN(x88, 88) * x88;
+    Field x220 = sqrN(x176, 44) * x44;
+    return sqrN(x220, 3) * x3;
+}
+} // namespace FieldImpl
+
+//! Returns 1 / a, computed as a^(p - 2). The inverse of 0 is 0.
+inline Field inverse(Field const & a)
+{
+    Field x2, x3, x22;
+    Field t = FieldImpl::pow223(a, x2, x3, x22);
+    t = sqrN(t, 23) * x22;
+    t = sqrN(t, 5) * a;
+    t = sqrN(t, 3) * x2;
+    return sqrN(t, 2) * a;
+}
+
+//! Computes a square root of a, a^((p + 1) / 4). Returns false if a has no square root.
+inline bool sqrt(Field const & a, Field & r)
+{
+    Field x2, x3, x22;
+    Field t = FieldImpl::pow223(a, x2, x3, x22);
+    t = sqrN(t, 23) * x22;
+    t = sqrN(t, 6) * x2;
+    r = sqrN(t, 2);
+    return equals(sqr(r), a);
+}
+} // namespace Secp256k1
+} // namespace Crypto
@@ -1,8 +1,57 @@
 #include "Sha1.h"
 
+#include "CpuFeatures.h"
+#include "Sha1Impl.h"
+
 #include <algorithm>
 #include <cassert>
 
+using namespace Crypto::Sha1Impl;
+
+namespace
+{
+uint32_t const INITIAL_STATE[STATE_SIZE] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+
+void writeBigEndian32(uint8_t * p, uint32_t x)
+{
+    p[0] = (uint8_t)(x >> 24);
+    p[1] = (uint8_t)(x >> 16);
+    p[2] = (uint8_t)(x >> 8);
+    p[3] = (uint8_t)x;
+}
+
+Transform transformOf(Crypto::Sha1Backend backend)
+{
+    switch (backend)
+    {
+#if defined(CRYPTO_X86)
+        case Crypto::SHA1_SHANI:    return transformShaNi;
+#endif
+        default:                    return transformPortable;
+    }
+}
+
+// The selected implementation. It is chosen the first time it is needed.
+struct Dispatch
+{
+    Crypto::Sha1Backend backend;
+    Transform transform;
+};
+
+Dispatch initialDispatch()
+{
+    Crypto::Sha1Backend backend =
+        Crypto::sha1BackendIsAvailable(Crypto::SHA1_SHANI) ? Crypto::SHA1_SHANI : Crypto::SHA1_PORTABLE;
+    return Dispatch{ backend, transformOf(backend) };
+}
+
+Dispatch & dispatch()
+{
+    static Dispatch d = initialDispatch();
+    return d;
+}
+} // anonymous namespace
+
 namespace Crypto
 {
 
@@ -13,8 +62,73 @@ Sha1Hash sha1(std::vector<uint8_t> const & input)
 
 Sha1Hash sha1(uint8_t const * input, size_t length)
 {
-    Sha1Hash hash = {};
+    Transform transform = dispatch().transform;
+
+    uint32_t state[STATE_SIZE];
+    std::copy(INITIAL_STATE, INITIAL_STATE + STATE_SIZE, state);
+
+    // Full blocks are hashed in place
+    size_t nBlocks = length / BLOCK_SIZE;
+    transform(state, input, nBlocks);
+
+    // The remainder is padded with 0x80, 0s, and the length in bits (big-endian), requiring one or two blocks
+    uint8_t  tail[2 * BLOCK_SIZE];
+    size_t   restSize = length % BLOCK_SIZE;
+    uint64_t bits     = (uint64_t)length * 8;
+    size_t   size     = (restSize + 1 + 8 <= BLOCK_SIZE) ? BLOCK_SIZE : 2 * BLOCK_SIZE;
+    std::copy(input + nBlocks * BLOCK_SIZE, input + length, tail);
+    tail[restSize] = 0x80;
+    std::fill(tail + restSize + 1, tail + size - 8, 0);
+    writeBigEndian32(tail + size - 8, (uint32_t)(bits >> 32));
+    writeBigEndian32(tail + size - 4, (uint32_t)bits);
+    transform(state, tail, size / BLOCK_SIZE);
+
+    Sha1Hash hash;
+    for (size_t i = 0; i < STATE_SIZE; ++i)
+    {
+        writeBigEndian32(&hash[4 * i], state[i]);
+    }
     return hash;
 }
 
+bool sha1BackendIsAvailable(Sha1Backend backend)
+{
+    switch (backend)
+    {
+        case SHA1_PORTABLE: return true;
+#if defined(CRYPTO_X86)
+        case SHA1_SHANI:    return cpuFeatures().sha;
+#endif
+        default:            return false;
+    }
+}
+
+Sha1Backend sha1Backend()
+{
+    return dispatch().backend;
+}
+
+bool selectSha1Backend(Sha1Backend backend)
+{
+    if (!sha1BackendIsAvailable(backend))
+        return false;
+
+    Dispatch & d = dispatch();
+    d.backend   = backend;
+    d.transform = transformOf(backend);
+    return true;
+}
+
+char const * sha1BackendName(Sha1Backend backend)
+{
+    static char const * const NAMES[NUM_SHA1_BACKENDS] =
+    {
+        "portable",
+        "sha-ni"
+    };
+
+    assert(backend >= 0 && backend < NUM_SHA1_BACKENDS);
+    return NAMES[backend];
+}
+
 } // namespace Crypto
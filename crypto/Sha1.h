@@ -21,6 +21,34 @@ Sha1Hash sha1(uint8_t const * input, size_t length);
 //! Returns the SHA-1 hash of the input
 template <size_t N> Sha1Hash sha1(std::array<uint8_t, N> const & input);
 
+//! SHA-1 implementations.
+//!
+//! The fastest implementation supported by the processor is selected automatically the first time a hash is computed.
+enum Sha1Backend
+{
+    SHA1_PORTABLE,          //!< Portable C++
+    SHA1_SHANI,             //!< Intel SHA extensions
+    NUM_SHA1_BACKENDS       //!< Number of SHA-1 implementations
+};
+
+//! Returns true if the given SHA-1 implementation is supported by the processor.
+//! @param  backend     implementation to check
+bool sha1BackendIsAvailable(Sha1Backend backend);
+
+//! Returns the SHA-1 implementation in use.
+Sha1Backend sha1Backend();
+
+//! Selects the SHA-1 implementation to use.
+//!
+//! @param  backend     implementation to use
+//! @return false if the implementation is not supported by the processor (in which case nothing is changed)
+//! @note   This is intended for testing and benchmarking. It must not be called while hashes are being computed.
+bool selectSha1Backend(Sha1Backend backend);
+
+//! Returns the name of a SHA-1 implementation.
+//! @param  backend     implementation
+char const * sha1BackendName(Sha1Backend backend);
+
 //!@}
 
 /********************************************************************************************************************/
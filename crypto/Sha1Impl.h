@@ -0,0 +1,25 @@
+#pragma once
+
+// Internal interface shared by the SHA-1 implementations. This header is not part of the public API.
+
+#include "CpuFeatures.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Crypto
+{
+namespace Sha1Impl
+{
+size_t constexpr BLOCK_SIZE = 64;   // Size of a SHA-1 message block in bytes
+size_t constexpr STATE_SIZE = 5;    // Number of 32-bit words in the SHA-1 state
+
+// Updates the state with n consecutive 64-byte blocks
+typedef void (*Transform)(uint32_t * state, uint8_t const * blocks, size_t n);
+
+void transformPortable(uint32_t * state, uint8_t const * blocks, size_t n);
+#if defined(CRYPTO_X86)
+void transformShaNi(uint32_t * state, uint8_t const * blocks, size_t n);
+#endif
+} // namespace Sha1Impl
+} // namespace Crypto
@@ -0,0 +1,79 @@
+// Portable implementation of the SHA-1 compression function
+
+#include "Sha1Impl.h"
+
+namespace
+{
+uint32_t readBigEndian32(uint8_t const * p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+uint32_t rotl(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+// One round, given f(b, c, d) + K + W
+void step(uint32_t & a, uint32_t & b, uint32_t & c, uint32_t & d, uint32_t & e, uint32_t fkw)
+{
+    uint32_t temp = rotl(a, 5) + e + fkw;
+    e = d;
+    d = c;
+    c = rotl(b, 30);
+    b = a;
+    a = temp;
+}
+} // anonymous namespace
+
+namespace Crypto
+{
+namespace Sha1Impl
+{
+
+void transformPortable(uint32_t * state, uint8_t const * blocks, size_t n)
+{
+    while (n-- > 0)
+    {
+        uint32_t w[80];
+        for (int t = 0; t < 16; ++t)
+        {
+            w[t] = readBigEndian32(blocks + 4 * t);
+        }
+        for (int t = 16; t < 80; ++t)
+        {
+            w[t] = rotl(w[t - 3] ^ w[t - 8] ^ w[t - 14] ^ w[t - 16], 1);
+        }
+
+        uint32_t a = state[0];
+        uint32_t b = state[1];
+        uint32_t c = state[2];
+        uint32_t d = state[3];
+        uint32_t e = state[4];
+
+        int t = 0;
+        for (; t < 20; ++t)
+        {
+            step(a, b, c, d, e, (d ^ (b & (c ^ d))) + 0x5a827999 + w[t]);
+        }
+        for (; t < 40; ++t)
+        {
+            step(a, b, c, d, e, (b ^ c ^ d) + 0x6ed9eba1 + w[t]);
+        }
+        for (; t < 60; ++t)
+        {
+            step(a, b, c, d, e, ((b & c) | (d & (b | c))) + 0x8f1bbcdc + w[t]);
+        }
+        for (; t < 80; ++t)
+        {
+            step(a, b, c, d, e, (b ^ c ^ d) + 0xca62c1d6 + w[t]);
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        blocks   += BLOCK_SIZE;
+    }
+}
+
+} // namespace Sha1Impl
+} // namespace Crypto
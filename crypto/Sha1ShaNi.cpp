@@ -0,0 +1,77 @@
+// SHA-1 compression function using the Intel SHA extensions.
+//
+// This file must be compiled with SHA and SSE4.1 code generation enabled (e.g. -msha -msse4.1).
+
+#include "Sha1Impl.h"
+
+#if defined(CRYPTO_X86)
+
+#include <immintrin.h>
+
+namespace
+{
+// Performs four rounds. The round function is an immediate operand, so it is selected here.
+__m128i fourRounds(__m128i abcd, __m128i e, int group)
+{
+    switch (group / 5)
+    {
+        case 0:     return _mm_sha1rnds4_epu32(abcd, e, 0);
+        case 1:     return _mm_sha1rnds4_epu32(abcd, e, 1);
+        case 2:     return _mm_sha1rnds4_epu32(abcd, e, 2);
+        default:    return _mm_sha1rnds4_epu32(abcd, e, 3);
+    }
+}
+} // anonymous namespace
+
+namespace Crypto
+{
+namespace Sha1Impl
+{
+
+void transformShaNi(uint32_t * state, uint8_t const * blocks, size_t n)
+{
+    __m128i const BYTE_SWAP = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    // The SHA instructions expect A in the most significant word, and E in the most significant word of its own vector
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((__m128i const *)state), 0x1b);
+    __m128i e0   = _mm_set_epi32((int)state[4], 0, 0, 0);
+
+    while (n-- > 0)
+    {
+        __m128i abcdSaved = abcd;
+        __m128i e0Saved   = e0;
+
+        // 20 groups of 4 rounds. w[i % 4] holds W[4i .. 4i+3] and is replaced by W[4i+16 .. 4i+19] once it is no
+        // longer needed. E for each group is derived from A of the group before last.
+        __m128i w[4];
+        __m128i previous = abcd;
+        for (int i = 0; i < 20; ++i)
+        {
+            if (i < 4)
+            {
+                w[i] = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const *)(blocks + 16 * i)), BYTE_SWAP);
+            }
+            else
+            {
+                __m128i x = _mm_xor_si128(_mm_sha1msg1_epu32(w[i & 3], w[(i + 1) & 3]), w[(i + 2) & 3]);
+                w[i & 3] = _mm_sha1msg2_epu32(x, w[(i + 3) & 3]);
+            }
+
+            __m128i e = (i == 0) ? _mm_add_epi32(e0, w[0]) : _mm_sha1nexte_epu32(previous, w[i & 3]);
+            previous = abcd;
+            abcd     = fourRounds(abcd, e, i);
+        }
+
+        e0      = _mm_sha1nexte_epu32(previous, e0Saved);
+        abcd    = _mm_add_epi32(abcd, abcdSaved);
+        blocks += BLOCK_SIZE;
+    }
+
+    _mm_storeu_si128((__m128i *)state, _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+} // namespace Sha1Impl
+} // namespace Crypto
+
+#endif // if defined(CRYPTO_X86)
@@ -1,25 +1,151 @@
 #include "Sha256.h"
 
+#include "CpuFeatures.h"
+#include "Sha256Impl.h"
+
 #include <algorithm>
 #include <cassert>
 
+using namespace Crypto::Sha256Impl;
+
+namespace
+{
+// The selected implementation. It is chosen the first time it is needed.
+struct Dispatch
+{
+    Crypto::Sha256Backend backend;
+    Transform transform;
+};
+
+Crypto::Sha256Backend fastestBackend()
+{
+    static Crypto::Sha256Backend const PREFERRED[] =
+    {
+        Crypto::SHA256_SHANI,
+        Crypto::SHA256_AVX2,
+        Crypto::SHA256_SSE4
+    };
+
+    for (auto backend : PREFERRED)
+    {
+        if (Crypto::sha256BackendIsAvailable(backend))
+            return backend;
+    }
+    return Crypto::SHA256_PORTABLE;
+}
+
+Dispatch initialDispatch()
+{
+    Crypto::Sha256Backend backend = fastestBackend();
+    return Dispatch{ backend, transformOf(backend) };
+}
+
+Dispatch & dispatch()
+{
+    static Dispatch d = initialDispatch();
+    return d;
+}
+
+// Hashes the input, leaving the result in the state
+void computeState(uint8_t const * input, size_t length, uint32_t * state)
+{
+    Transform transform = dispatch().transform;
+
+    std::copy(INITIAL_STATE, INITIAL_STATE + STATE_SIZE, state);
+
+    // Full blocks are hashed in place
+    transform(state, input, length / BLOCK_SIZE);
+
+    uint8_t tail[2 * BLOCK_SIZE];
+    transform(state, tail, pad(input + length / BLOCK_SIZE * BLOCK_SIZE, length, tail));
+}
+} // anonymous namespace
+
 namespace Crypto
 {
+namespace Sha256Impl
+{
+
+uint32_t const INITIAL_STATE[STATE_SIZE] =
+{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+uint32_t const K[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+uint32_t const PADDING_64_WK[64] =
+{
+    0xc28a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf374,
+    0x649b69c1, 0xf0fe4786, 0x0fe1edc6, 0x240cf254, 0x4fe9346f, 0x6cc984be, 0x61b9411e, 0x16f988fa,
+    0xf2c65152, 0xa88e5a6d, 0xb019fc65, 0xb9d99ec7, 0x9a1231c3, 0xe70eeaa0, 0xfdb1232b, 0xc7353eb0,
+    0x3069bad5, 0xcb976d5f, 0x5a0f118f, 0xdc1eeefd, 0x0a35b689, 0xde0b7a04, 0x58f4ca9d, 0xe15d5b16,
+    0x007f3e86, 0x37088980, 0xa507ea32, 0x6fab9537, 0x17406110, 0x0d8cd6f1, 0xcdaa3b6d, 0xc0bbbe37,
+    0x83613bda, 0xdb48a363, 0x0b02e931, 0x6fd15ca7, 0x521afaca, 0x31338431, 0x6ed41a95, 0x6d437890,
+    0xc39c91f2, 0x9eccabbd, 0xb5c9a0e6, 0x532fb63c, 0xd2c741c6, 0x07237ea3, 0xa4954b68, 0x4c191d76
+};
+
+Transform transform()
+{
+    return dispatch().transform;
+}
+
+Transform transformOf(Sha256Backend backend)
+{
+    switch (backend)
+    {
+#if defined(CRYPTO_X86)
+        case SHA256_SSE4:   return transformSse4;
+        case SHA256_AVX2:   return transformAvx2;
+        case SHA256_AVX512: return transformAvx2;   // AVX-512 is only used for multiple messages
+        case SHA256_SHANI:  return transformShaNi;
+#endif
+        default:            return transformPortable;
+    }
+}
+
+size_t pad(uint8_t const * rest, uint64_t length, uint8_t * tail)
+{
+    // The remainder is padded with 0x80, 0s, and the length in bits (big-endian), requiring one or two blocks
+    size_t   restSize = (size_t)(length % BLOCK_SIZE);
+    uint64_t bits     = length * 8;
+    size_t   size     = (restSize + 1 + 8 <= BLOCK_SIZE) ? BLOCK_SIZE : 2 * BLOCK_SIZE;
+    std::copy(rest, rest + restSize, tail);
+    tail[restSize] = 0x80;
+    std::fill(tail + restSize + 1, tail + size - 8, 0);
+    writeBigEndian32(tail + size - 8, (uint32_t)(bits >> 32));
+    writeBigEndian32(tail + size - 4, (uint32_t)bits);
+    return size / BLOCK_SIZE;
+}
+
+} // namespace Sha256Impl
 
 Sha256Hash sha256(std::vector<uint8_t> const & input)
 {
     return sha256(input.data(), input.size());
 }
 
-// Sha256Hash sha256(Sha256Hash const & input)
-// {
-//     return sha256(input.data(), input.size());
-// }
-
 Sha256Hash sha256(uint8_t const * input, size_t length)
 {
-    Sha256Hash hash = {};
-    return hash;
+    uint32_t state[STATE_SIZE];
+    computeState(input, length, state);
+
+    Sha256Hash out;
+    for (size_t i = 0; i < STATE_SIZE; ++i)
+    {
+        writeBigEndian32(&out[4 * i], state[i]);
+    }
+    return out;
 }
 
 Sha256Hash doubleSha256(std::vector<uint8_t> const & input)
@@ -45,4 +171,102 @@ Checksum checksum(uint8_t const * input, size_t length)
     return c;
 }
 
+void Sha256Hasher::init()
+{
+    std::copy(INITIAL_STATE, INITIAL_STATE + STATE_SIZE, state_);
+    length_ = 0;
+}
+
+void Sha256Hasher::update(uint8_t const * data, size_t length)
+{
+    Transform transform = dispatch().transform;
+    size_t    buffered  = (size_t)(length_ % BLOCK_SIZE);
+    length_ += length;
+
+    // Complete the buffered block first
+    if (buffered > 0)
+    {
+        size_t n = std::min(length, BLOCK_SIZE - buffered);
+        std::copy(data, data + n, buffer_ + buffered);
+        data     += n;
+        length   -= n;
+        buffered += n;
+        if (buffered < BLOCK_SIZE)
+            return;
+        transform(state_, buffer_, 1);
+    }
+
+    // Full blocks are hashed in place and the rest is buffered
+    size_t nBlocks = length / BLOCK_SIZE;
+    transform(state_, data, nBlocks);
+    data += nBlocks * BLOCK_SIZE;
+    std::copy(data, data + length % BLOCK_SIZE, buffer_);
+}
+
+Sha256Hash Sha256Hasher::finalize() const
+{
+    Transform transform = dispatch().transform;
+    uint32_t  state[STATE_SIZE];
+    uint8_t   tail[2 * BLOCK_SIZE];
+
+    std::copy(state_, state_ + STATE_SIZE, state);
+    transform(state, tail, pad(buffer_, length_, tail));
+
+    Sha256Hash out;
+    for (size_t i = 0; i < STATE_SIZE; ++i)
+    {
+        writeBigEndian32(&out[4 * i], state[i]);
+    }
+    return out;
+}
+
+bool sha256BackendIsAvailable(Sha256Backend backend)
+{
+#if defined(CRYPTO_X86)
+    CpuFeatures const & cpu = cpuFeatures();
+#endif
+    switch (backend)
+    {
+        case SHA256_PORTABLE:   return true;
+#if defined(CRYPTO_X86)
+        case SHA256_SSE4:       return cpu.sse41;
+        case SHA256_AVX2:       return cpu.avx2 && cpu.bmi2;
+        case SHA256_AVX512:     return cpu.avx512 && cpu.avx2 && cpu.bmi2;
+        case SHA256_SHANI:      return cpu.sha;
+#endif
+        default:                return false;
+    }
+}
+
+Sha256Backend sha256Backend()
+{
+    return dispatch().backend;
+}
+
+bool selectSha256Backend(Sha256Backend backend)
+{
+    if (!sha256BackendIsAvailable(backend))
+        return false;
+
+    Dispatch & d = dispatch();
+    d.backend   = backend;
+    d.transform = transformOf(backend);
+    return true;
+}
+
+char const * sha256BackendName(Sha256Backend backend)
+{
+    static char const * const NAMES[NUM_SHA256_BACKENDS] =
+    {
+        "portable",
+        "sse4",
+        "avx2",
+        "avx512",
+        "sha-ni"
+    };
+
+    assert(backend >= 0 && backend < NUM_SHA256_BACKENDS);
+    return NAMES[backend];
+}
+
 } // namespace Crypto
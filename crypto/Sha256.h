@@ -47,6 +47,139 @@ Checksum checksum(std::vector<uint8_t> const & input);
 //! @param  length  length of the data
 Checksum checksum(uint8_t const * input, size_t length);
 
+//! Computes a SHA-256 hash incrementally.
+//!
+//! The data is added in any number of pieces. A hasher can be copied at any point to save its intermediate state (the
+//! "midstate"), so that several messages with a common prefix only hash the prefix once.
+class Sha256Hasher
+{
+public:
+
+    //! Constructor
+    Sha256Hasher() { init(); }
+
+    //! Starts a new hash, discarding any data already added.
+    void init();
+
+    //! Adds data to the hash.
+    //!
+    //! @param  data    data to add
+    //! @param  length  length of the data
+    void update(uint8_t const * data, size_t length);
+
+    //! Adds data to the hash.
+    //!
+    //! @param  data    data to add
+    void update(std::vector<uint8_t> const & data) { update(data.data(), data.size()); }
+
+    //! Returns the hash of the data added since init().
+    //!
+    //! The hasher is not changed, so more data can be added afterwards.
+    Sha256Hash finalize() const;
+
+    //! Returns the number of bytes added since init().
+    uint64_t length() const { return length_; }
+
+private:
+
+    static size_t const BLOCK_SIZE = 64;
+
+    uint32_t state_[8];             // State after the last full block
+    uint8_t  buffer_[BLOCK_SIZE];   // Data following the last full block
+    uint64_t length_;               // Total amount of data added
+};
+
+//! Computes the SHA-256 hashes of several independent messages.
+//!
+//! The messages are hashed in parallel using the SIMD instructions supported by the processor, so this is much faster
+//! than hashing them one at a time when there are many.
+//!
+//! @param  inputs      data to hash
+//! @param  lengths     lengths of the data
+//! @param  n           number of messages
+//! @param[out] hashes  the hashes (n elements)
+void sha256Batch(uint8_t const * const * inputs, size_t const * lengths, size_t n, Sha256Hash * hashes);
+
+//! Computes the SHA-256 hashes of several independent messages.
+//! @param  inputs      data to hash
+Sha256HashList sha256Batch(std::vector<std::vector<uint8_t>> const & inputs);
+
+//! Computes the double-SHA-256 hashes of several independent messages.
+//!
+//! @param  inputs      data to hash
+//! @param  lengths     lengths of the data
+//! @param  n           number of messages
+//! @param[out] hashes  the hashes (n elements)
+//!
+//! @sa sha256Batch
+void doubleSha256Batch(uint8_t const * const * inputs, size_t const * lengths, size_t n, Sha256Hash * hashes);
+
+//! Computes the double-SHA-256 hashes of several independent messages.
+//! @param  inputs      data to hash
+Sha256HashList doubleSha256Batch(std::vector<std::vector<uint8_t>> const & inputs);
+
+//! Computes the double-SHA-256 hash of two concatenated hashes.
+//!
+//! This is the hash of an interior node of a Merkle tree. It is faster than doubleSha256() because the padding is
+//! known in advance.
+//!
+//! @param  left    first hash
+//! @param  right   second hash
+Sha256Hash doubleSha256_64(Sha256Hash const & left, Sha256Hash const & right);
+
+//! Computes the double-SHA-256 hashes of pairs of adjacent hashes.
+//!
+//! parents[i] is the double-SHA-256 hash of children[2i] and children[2i+1] concatenated, so this computes a level
+//! of a Merkle tree from the level below it. The pairs are hashed in parallel like sha256Batch().
+//!
+//! @param  children    hashes to combine (2n elements)
+//! @param  n           number of pairs
+//! @param[out] parents the hashes of the pairs (n elements)
+void doubleSha256_64(Sha256Hash const * children, size_t n, Sha256Hash * parents);
+
+//! SHA-256 implementations.
+//!
+//! The fastest implementation supported by the processor is selected automatically the first time a hash is computed.
+//! The implementation used to hash multiple messages at once is selected separately. In that case, SHA256_SSE4,
+//! SHA256_AVX2 and SHA256_AVX512 hash 4, 8 and 16 messages in parallel.
+enum Sha256Backend
+{
+    SHA256_PORTABLE,        //!< Portable C++
+    SHA256_SSE4,            //!< Message schedule vectorized with SSE4.1
+    SHA256_AVX2,            //!< Message schedules of two blocks vectorized with AVX2, rounds use BMI2
+    SHA256_AVX512,          //!< AVX-512 for multiple messages, otherwise the same as SHA256_AVX2
+    SHA256_SHANI,           //!< Intel SHA extensions
+    NUM_SHA256_BACKENDS     //!< Number of SHA-256 implementations
+};
+
+//! Returns true if the given SHA-256 implementation is supported by the processor.
+//! @param  backend     implementation to check
+bool sha256BackendIsAvailable(Sha256Backend backend);
+
+//! Returns the SHA-256 implementation in use.
+Sha256Backend sha256Backend();
+
+//! Selects the SHA-256 implementation to use.
+//!
+//! @param  backend     implementation to use
+//! @return false if the implementation is not supported by the processor (in which case nothing is changed)
+//! @note   This is intended for testing and benchmarking. It must not be called while hashes are being computed.
+bool selectSha256Backend(Sha256Backend backend);
+
+//! Returns the SHA-256 implementation used by sha256Batch() and doubleSha256Batch().
+Sha256Backend sha256BatchBackend();
+
+//! Selects the SHA-256 implementation used by sha256Batch() and doubleSha256Batch().
+//!
+//! @param  backend     implementation to use
+//! @return false if the implementation is not supported by the processor (in which case nothing is changed)
+//! @note   This is intended for testing and benchmarking. It must not be called while hashes are being computed.
+bool selectSha256BatchBackend(Sha256Backend backend);
+
+//! Returns the name of a SHA-256 implementation.
+//! @param  backend     implementation
+char const * sha256BackendName(Sha256Backend backend);
+
 //!@}
 
 /********************************************************************************************************************/
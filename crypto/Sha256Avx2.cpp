@@ -0,0 +1,162 @@
+// SHA-256 compression function with the message schedules of two blocks computed at once using AVX2. Each 128-bit lane
+// of a 256-bit register holds four words of one block's schedule. The rounds are scalar and benefit from BMI2 (rorx).
+// There is also a compression function that hashes eight messages at once.
+//
+// This file must be compiled with AVX2 and BMI2 code generation enabled (e.g. -mavx2 -mbmi2).
+
+#include "Sha256Lanes.h"
+
+#if defined(CRYPTO_X86)
+
+#include <immintrin.h>
+
+namespace
+{
+template <int N>
+__m256i rotr8(__m256i x)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+}
+
+__m256i smallSigma0x8(__m256i x)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(rotr8<7>(x), rotr8<18>(x)), _mm256_srli_epi32(x, 3));
+}
+
+__m256i smallSigma1x8(__m256i x)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(rotr8<17>(x), rotr8<19>(x)), _mm256_srli_epi32(x, 10));
+}
+
+// Computes W[t .. t+3] of both blocks given W[t-16 .. t-1] in four vectors. Since W[t+2] and W[t+3] depend on W[t] and
+// W[t+1], the sigma1 term is added in two halves.
+__m256i nextWords(__m256i w16, __m256i w12, __m256i w8, __m256i w4)
+{
+    __m256i const zero = _mm256_setzero_si256();
+
+    __m256i w = _mm256_add_epi32(w16, smallSigma0x8(_mm256_alignr_epi8(w12, w16, 4)));
+    w = _mm256_add_epi32(w, _mm256_alignr_epi8(w4, w8, 4));
+    w = _mm256_add_epi32(w, _mm256_blend_epi32(zero, smallSigma1x8(_mm256_shuffle_epi32(w4, 0xfe)), 0x33));
+    w = _mm256_add_epi32(w, _mm256_unpacklo_epi64(zero, smallSigma1x8(w)));
+    return w;
+}
+
+// Vector operations for Sha256Impl::Lanes
+struct Avx2Ops
+{
+    typedef __m256i Vector;
+    static int const LANES = 8;
+
+    static Vector load(uint32_t const * p) { return _mm256_loadu_si256((__m256i const *)p); }
+    static void store(uint32_t * p, Vector x) { _mm256_storeu_si256((__m256i *)p, x); }
+    static Vector set1(uint32_t x) { return _mm256_set1_epi32((int)x); }
+    static Vector add(Vector x, Vector y) { return _mm256_add_epi32(x, y); }
+    static Vector xor3(Vector x, Vector y, Vector z) { return _mm256_xor_si256(_mm256_xor_si256(x, y), z); }
+    template <int N> static Vector shr(Vector x) { return _mm256_srli_epi32(x, N); }
+    template <int N> static Vector rotr(Vector x) { return rotr8<N>(x); }
+    static Vector ch(Vector x, Vector y, Vector z)
+    {
+        return _mm256_xor_si256(z, _mm256_and_si256(x, _mm256_xor_si256(y, z)));
+    }
+    static Vector maj(Vector x, Vector y, Vector z)
+    {
+        return _mm256_or_si256(_mm256_and_si256(x, y), _mm256_and_si256(z, _mm256_or_si256(x, y)));
+    }
+
+    // Each group of eight words is loaded from the eight blocks and transposed
+    static void loadWords(uint8_t const * const * blocks, Vector * w)
+    {
+        __m256i const BYTE_SWAP = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                                  12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+        for (int i = 0; i < 2; ++i)
+        {
+            __m256i r[8];
+            for (int lane = 0; lane < 8; ++lane)
+            {
+                r[lane] = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i const *)(blocks[lane] + 32 * i)), BYTE_SWAP);
+            }
+
+            // Transpose 2x2 blocks of words, then of pairs of words within each 128-bit half, then the halves
+            __m256i t[8];
+            for (int j = 0; j < 8; j += 2)
+            {
+                t[j]     = _mm256_unpacklo_epi32(r[j], r[j + 1]);
+                t[j + 1] = _mm256_unpackhi_epi32(r[j], r[j + 1]);
+            }
+            __m256i u[8];
+            for (int j = 0; j < 8; j += 4)
+            {
+                u[j]     = _mm256_unpacklo_epi64(t[j], t[j + 2]);
+                u[j + 1] = _mm256_unpackhi_epi64(t[j], t[j + 2]);
+                u[j + 2] = _mm256_unpacklo_epi64(t[j + 1], t[j + 3]);
+                u[j + 3] = _mm256_unpackhi_epi64(t[j + 1], t[j + 3]);
+            }
+            for (int j = 0; j < 4; ++j)
+            {
+                w[8 * i + j]     = _mm256_permute2x128_si256(u[j], u[j + 4], 0x20);
+                w[8 * i + j + 4] = _mm256_permute2x128_si256(u[j], u[j + 4], 0x31);
+            }
+        }
+    }
+};
+} // anonymous namespace
+
+namespace Crypto
+{
+namespace Sha256Impl
+{
+
+void transformAvx2(uint32_t * state, uint8_t const * blocks, size_t n)
+{
+    __m256i const BYTE_SWAP = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                              12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+    uint32_t wk0[64];
+    uint32_t wk1[64];
+    while (n >= 2)
+    {
+        __m256i w[16];
+        for (int i = 0; i < 4; ++i)
+        {
+            __m128i first  = _mm_loadu_si128((__m128i const *)(blocks + 16 * i));
+            __m128i second = _mm_loadu_si128((__m128i const *)(blocks + BLOCK_SIZE + 16 * i));
+            w[i] = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(first), second, 1), BYTE_SWAP);
+        }
+        for (int i = 4; i < 16; ++i)
+        {
+            w[i] = nextWords(w[i - 4], w[i - 3], w[i - 2], w[i - 1]);
+        }
+        for (int i = 0; i < 16; ++i)
+        {
+            __m256i k  = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const *)&K[4 * i]));
+            __m256i wk = _mm256_add_epi32(w[i], k);
+            _mm_storeu_si128((__m128i *)&wk0[4 * i], _mm256_castsi256_si128(wk));
+            _mm_storeu_si128((__m128i *)&wk1[4 * i], _mm256_extracti128_si256(wk, 1));
+        }
+
+        compress(state, wk0);
+        compress(state, wk1);
+        blocks += 2 * BLOCK_SIZE;
+        n      -= 2;
+    }
+
+    // An odd block at the end is handled by the 128-bit implementation
+    if (n > 0)
+        transformSse4(state, blocks, n);
+}
+
+void transformAvx2x8(uint32_t * states, uint8_t const * const * blocks)
+{
+    Lanes<Avx2Ops>::transform(states, blocks);
+}
+
+void doubleHash64Avx2x8(uint8_t const * const * blocks, uint32_t * hashes)
+{
+    Lanes<Avx2Ops>::doubleHash64(blocks, hashes);
+}
+
+} // namespace Sha256Impl
+} // namespace Crypto
+
+#endif // if defined(CRYPTO_X86)
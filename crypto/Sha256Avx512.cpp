@@ -0,0 +1,75 @@
+// SHA-256 compression function that hashes sixteen messages at once using AVX-512.
+//
+// This file must be compiled with AVX-512F and AVX2 code generation enabled (e.g. -mavx512f -mavx2).
+
+#include "Sha256Lanes.h"
+
+#if defined(CRYPTO_X86)
+
+#include <immintrin.h>
+
+namespace
+{
+// Vector operations for Sha256Impl::Lanes
+struct Avx512Ops
+{
+    typedef __m512i Vector;
+    static int const LANES = 16;
+
+    static Vector load(uint32_t const * p) { return _mm512_loadu_si512(p); }
+    static void store(uint32_t * p, Vector x) { _mm512_storeu_si512(p, x); }
+    static Vector set1(uint32_t x) { return _mm512_set1_epi32((int)x); }
+    static Vector add(Vector x, Vector y) { return _mm512_add_epi32(x, y); }
+    static Vector xor3(Vector x, Vector y, Vector z) { return _mm512_ternarylogic_epi32(x, y, z, 0x96); }
+    template <int N> static Vector shr(Vector x) { return _mm512_srli_epi32(x, N); }
+    template <int N> static Vector rotr(Vector x) { return _mm512_ror_epi32(x, N); }
+    static Vector ch(Vector x, Vector y, Vector z) { return _mm512_ternarylogic_epi32(x, y, z, 0xca); }
+    static Vector maj(Vector x, Vector y, Vector z) { return _mm512_ternarylogic_epi32(x, y, z, 0xe8); }
+
+    // The words are gathered from the sixteen blocks, eight at a time. AVX-512F has no byte shuffle, so the bytes are
+    // swapped with AVX2.
+    static void loadWords(uint8_t const * const * blocks, Vector * w)
+    {
+        __m256i const BYTE_SWAP = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                                  12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+        long long addresses[16];
+        for (int lane = 0; lane < 16; ++lane)
+        {
+            addresses[lane] = (long long)(uintptr_t)blocks[lane];
+        }
+        __m512i lo = _mm512_loadu_si512(&addresses[0]);
+        __m512i hi = _mm512_loadu_si512(&addresses[8]);
+
+        for (int t = 0; t < 16; ++t)
+        {
+            __m512i offset = _mm512_set1_epi64(4 * t);
+            __m256i w0     = _mm512_i64gather_epi32(_mm512_add_epi64(lo, offset), nullptr, 1);
+            __m256i w1     = _mm512_i64gather_epi32(_mm512_add_epi64(hi, offset), nullptr, 1);
+            w0   = _mm256_shuffle_epi8(w0, BYTE_SWAP);
+            w1   = _mm256_shuffle_epi8(w1, BYTE_SWAP);
+            w[t] = _mm512_inserti64x4(_mm512_castsi256_si512(w0), w1, 1);
+        }
+    }
+};
+} // anonymous namespace
+
+namespace Crypto
+{
+namespace Sha256Impl
+{
+
+void transformAvx512x16(uint32_t * states, uint8_t const * const * blocks)
+{
+    Lanes<Avx512Ops>::transform(states, blocks);
+}
+
+void doubleHash64Avx512x16(uint8_t const * const * blocks, uint32_t * hashes)
+{
+    Lanes<Avx512Ops>::doubleHash64(blocks, hashes);
+}
+
+} // namespace Sha256Impl
+} // namespace Crypto
+
+#endif // if defined(CRYPTO_X86)
@@ -0,0 +1,429 @@
+// Multi-buffer SHA-256. Independent messages are hashed in parallel, each in its own lane of a SIMD register.
+
+#include "Sha256.h"
+
+#include "CpuFeatures.h"
+#include "Sha256Impl.h"
+
+#include <algorithm>
+
+using namespace Crypto::Sha256Impl;
+
+namespace
+{
+size_t const MAX_LANES = 16;
+
+// Block hashed by lanes that have no message
+uint8_t const IDLE_BLOCK[BLOCK_SIZE] = {};
+
+// The selected implementation. It is chosen the first time it is needed.
+struct BatchDispatch
+{
+    Crypto::Sha256Backend backend;
+    LaneTransform transform;        // nullptr if the messages are hashed one at a time
+    LaneDoubleHash64 doubleHash64;  // nullptr if the messages are hashed one at a time
+    size_t lanes;
+};
+
+BatchDispatch batchDispatchOf(Crypto::Sha256Backend backend)
+{
+    switch (backend)
+    {
+#if defined(CRYPTO_X86)
+        case Crypto::SHA256_SSE4:   return BatchDispatch{ backend, transformSse4x4, doubleHash64Sse4x4, 4 };
+        case Crypto::SHA256_AVX2:   return BatchDispatch{ backend, transformAvx2x8, doubleHash64Avx2x8, 8 };
+        case Crypto::SHA256_AVX512: return BatchDispatch{ backend, transformAvx512x16, doubleHash64Avx512x16, 16 };
+#endif
+        default:                    return BatchDispatch{ backend, nullptr, nullptr, 1 };
+    }
+}
+
+BatchDispatch initialBatchDispatch()
+{
+    // Hashing 16 messages in parallel with AVX-512 beats the SHA extensions, but 8 with AVX2 does not
+    static Crypto::Sha256Backend const PREFERRED[] =
+    {
+        Crypto::SHA256_AVX512,
+        Crypto::SHA256_SHANI,
+        Crypto::SHA256_AVX2,
+        Crypto::SHA256_SSE4
+    };
+
+    for (auto backend : PREFERRED)
+    {
+        if (Crypto::sha256BackendIsAvailable(backend))
+            return batchDispatchOf(backend);
+    }
+    return batchDispatchOf(Crypto::SHA256_PORTABLE);
+}
+
+BatchDispatch & batchDispatch()
+{
+    static BatchDispatch d = initialBatchDispatch();
+    return d;
+}
+
+// Hashes a list of messages. Each lane works through its message in up to three segments: the full blocks (hashed in
+// place), the padded tail, and for double-SHA-256, the padded first hash. When a lane finishes a message, it starts on
+// the next one.
+class Batch
+{
+public:
+
+    Batch(uint8_t const * const * inputs, size_t const * lengths, size_t n, Crypto::Sha256Hash * hashes, bool twice)
+        : inputs_(inputs)
+        , lengths_(lengths)
+        , n_(n)
+        , hashes_(hashes)
+        , twice_(twice)
+        , nextMessage_(0)
+    {
+    }
+
+    // Hashes the messages using a multi-lane transform. Once fewer than half of the lanes are busy, the remaining
+    // messages are finished with the single-message transform.
+    void run(LaneTransform laneTransform, size_t lanes, Transform transform)
+    {
+        uint32_t        states[STATE_SIZE * MAX_LANES];
+        Job             jobs[MAX_LANES];
+        uint8_t const * blocks[MAX_LANES];
+
+        size_t active = 0;
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            if (start(jobs[lane]))
+            {
+                setState(states, lanes, lane, INITIAL_STATE);
+                ++active;
+            }
+        }
+
+        while (active > lanes / 2)
+        {
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                blocks[lane] = (jobs[lane].segment != IDLE) ? jobs[lane].next : IDLE_BLOCK;
+            }
+
+            laneTransform(states, blocks);
+
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                Job & job = jobs[lane];
+                if (job.segment == IDLE)
+                    continue;
+
+                job.next += BLOCK_SIZE;
+                if (--job.nBlocks > 0)
+                    continue;
+
+                uint32_t state[STATE_SIZE];
+                getState(states, lanes, lane, state);
+                if (!nextSegment(job, state))
+                {
+                    if (!start(job))
+                    {
+                        --active;
+                        continue;
+                    }
+                    std::copy(INITIAL_STATE, INITIAL_STATE + STATE_SIZE, state);
+                }
+                setState(states, lanes, lane, state);
+            }
+        }
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            if (jobs[lane].segment != IDLE)
+            {
+                uint32_t state[STATE_SIZE];
+                getState(states, lanes, lane, state);
+                finish(jobs[lane], state, transform);
+            }
+        }
+    }
+
+    // Hashes the messages one at a time
+    void run(Transform transform)
+    {
+        Job job;
+        while (start(job))
+        {
+            uint32_t state[STATE_SIZE];
+            std::copy(INITIAL_STATE, INITIAL_STATE + STATE_SIZE, state);
+            finish(job, state, transform);
+        }
+    }
+
+private:
+
+    enum Segment
+    {
+        IDLE,
+        BODY,
+        TAIL,
+        SECOND_PASS
+    };
+
+    // The progress of a lane through its message
+    struct Job
+    {
+        Segment segment;
+        size_t message;                     // Index of the message
+        uint8_t const * next;               // Next block to hash
+        size_t nBlocks;                     // Number of blocks remaining in the segment
+        size_t nTailBlocks;                 // Number of blocks in the tail
+        uint8_t tail[2 * BLOCK_SIZE];       // Padded tail (and later the padded first hash)
+    };
+
+    // Starts the next message. Returns false if there are none left.
+    bool start(Job & job)
+    {
+        if (nextMessage_ >= n_)
+        {
+            job.segment = IDLE;
+            return false;
+        }
+
+        job.message     = nextMessage_++;
+        job.segment     = BODY;
+        job.next        = inputs_[job.message];
+        job.nBlocks     = lengths_[job.message] / BLOCK_SIZE;
+        job.nTailBlocks = pad(job.next + job.nBlocks * BLOCK_SIZE, lengths_[job.message], job.tail);
+        if (job.nBlocks == 0)
+            nextSegment(job, nullptr);
+        return true;
+    }
+
+    // Moves on to the next segment of the message given the state after the current segment. Returns false if the
+    // message is done, in which case its hash has been stored.
+    bool nextSegment(Job & job, uint32_t * state)
+    {
+        if (job.segment == BODY)
+        {
+            job.segment = TAIL;
+            job.next    = job.tail;
+            job.nBlocks = job.nTailBlocks;
+            return true;
+        }
+
+        if (job.segment == TAIL && twice_)
+        {
+            // The second pass hashes the 32-byte first hash, which is always padded to a single block
+            for (size_t i = 0; i < STATE_SIZE; ++i)
+            {
+                writeBigEndian32(&job.tail[4 * i], state[i]);
+            }
+            job.tail[Crypto::SHA256_HASH_SIZE] = 0x80;
+            std::fill(job.tail + Crypto::SHA256_HASH_SIZE + 1, job.tail + BLOCK_SIZE - 4, 0);
+            writeBigEndian32(job.tail + BLOCK_SIZE - 4, (uint32_t)Crypto::SHA256_HASH_SIZE * 8);
+            std::copy(INITIAL_STATE, INITIAL_STATE + STATE_SIZE, state);
+
+            job.segment = SECOND_PASS;
+            job.next    = job.tail;
+            job.nBlocks = 1;
+            return true;
+        }
+
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            writeBigEndian32(&hashes_[job.message][4 * i], state[i]);
+        }
+        return false;
+    }
+
+    // Finishes the message using the single-message transform
+    void finish(Job & job, uint32_t * state, Transform transform)
+    {
+        do
+        {
+            transform(state, job.next, job.nBlocks);
+        }
+        while (nextSegment(job, state));
+    }
+
+    static void getState(uint32_t const * states, size_t lanes, size_t lane, uint32_t * state)
+    {
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            state[i] = states[i * lanes + lane];
+        }
+    }
+
+    static void setState(uint32_t * states, size_t lanes, size_t lane, uint32_t const * state)
+    {
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            states[i * lanes + lane] = state[i];
+        }
+    }
+
+    uint8_t const * const * inputs_;
+    size_t const * lengths_;
+    size_t n_;
+    Crypto::Sha256Hash * hashes_;
+    bool twice_;
+    size_t nextMessage_;
+};
+
+void hashBatch(uint8_t const * const * inputs, size_t const * lengths, size_t n, Crypto::Sha256Hash * hashes, bool twice)
+{
+    BatchDispatch const & d = batchDispatch();
+    Batch batch(inputs, lengths, n, hashes, twice);
+    if (d.transform)
+        batch.run(d.transform, d.lanes, transform());
+    else
+        batch.run(transformOf(d.backend));
+}
+
+void hashBatch(std::vector<std::vector<uint8_t>> const & inputs, Crypto::Sha256HashList & hashes, bool twice)
+{
+    std::vector<uint8_t const *> pointers;
+    std::vector<size_t> lengths;
+    pointers.reserve(inputs.size());
+    lengths.reserve(inputs.size());
+    for (auto const & input : inputs)
+    {
+        pointers.push_back(input.data());
+        lengths.push_back(input.size());
+    }
+
+    hashes.resize(inputs.size());
+    hashBatch(pointers.data(), lengths.data(), inputs.size(), hashes.data(), twice);
+}
+
+// Computes the double-SHA-256 hash of a 64-byte message
+void doubleHash64(uint8_t const * message, Crypto::Sha256Hash & hash)
+{
+    // Padding block of a 64-byte message
+    static uint8_t const PADDING_64[BLOCK_SIZE] =
+    {
+        0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0
+    };
+
+    // Padding following the first hash in the second pass
+    static uint8_t const PADDING_32[BLOCK_SIZE - Crypto::SHA256_HASH_SIZE] =
+    {
+        0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0
+    };
+
+    Transform transform = Crypto::Sha256Impl::transform();
+    uint32_t  state[STATE_SIZE];
+
+    std::copy(INITIAL_STATE, INITIAL_STATE + STATE_SIZE, state);
+    transform(state, message, 1);
+
+    // The SHA extensions compute the message schedule in hardware. Otherwise, the precomputed schedule of the padding
+    // block saves a quarter of the work.
+    if (Crypto::sha256Backend() == Crypto::SHA256_SHANI)
+        transform(state, PADDING_64, 1);
+    else
+        compress(state, PADDING_64_WK);
+
+    uint8_t block[BLOCK_SIZE];
+    for (size_t i = 0; i < STATE_SIZE; ++i)
+    {
+        writeBigEndian32(&block[4 * i], state[i]);
+    }
+    std::copy(PADDING_32, PADDING_32 + sizeof(PADDING_32), block + Crypto::SHA256_HASH_SIZE);
+    std::copy(INITIAL_STATE, INITIAL_STATE + STATE_SIZE, state);
+    transform(state, block, 1);
+
+    for (size_t i = 0; i < STATE_SIZE; ++i)
+    {
+        writeBigEndian32(&hash[4 * i], state[i]);
+    }
+}
+} // anonymous namespace
+
+namespace Crypto
+{
+
+void sha256Batch(uint8_t const * const * inputs, size_t const * lengths, size_t n, Sha256Hash * hashes)
+{
+    hashBatch(inputs, lengths, n, hashes, false);
+}
+
+Sha256HashList sha256Batch(std::vector<std::vector<uint8_t>> const & inputs)
+{
+    Sha256HashList hashes;
+    hashBatch(inputs, hashes, false);
+    return hashes;
+}
+
+void doubleSha256Batch(uint8_t const * const * inputs, size_t const * lengths, size_t n, Sha256Hash * hashes)
+{
+    hashBatch(inputs, lengths, n, hashes, true);
+}
+
+Sha256HashList doubleSha256Batch(std::vector<std::vector<uint8_t>> const & inputs)
+{
+    Sha256HashList hashes;
+    hashBatch(inputs, hashes, true);
+    return hashes;
+}
+
+Sha256Hash doubleSha256_64(Sha256Hash const & left, Sha256Hash const & right)
+{
+    uint8_t message[2 * SHA256_HASH_SIZE];
+    std::copy(left.begin(), left.end(), message);
+    std::copy(right.begin(), right.end(), message + SHA256_HASH_SIZE);
+
+    Sha256Hash hash;
+    doubleHash64(message, hash);
+    return hash;
+}
+
+void doubleSha256_64(Sha256Hash const * children, size_t n, Sha256Hash * parents)
+{
+    static_assert(sizeof(Sha256Hash) == SHA256_HASH_SIZE, "Adjacent hashes must be contiguous");
+
+    BatchDispatch const & d = batchDispatch();
+
+    size_t i = 0;
+    if (d.doubleHash64)
+    {
+        uint8_t const * blocks[MAX_LANES];
+        uint32_t        hashes[STATE_SIZE * MAX_LANES];
+        for (; i + d.lanes <= n; i += d.lanes)
+        {
+            for (size_t lane = 0; lane < d.lanes; ++lane)
+            {
+                blocks[lane] = children[2 * (i + lane)].data();
+            }
+
+            d.doubleHash64(blocks, hashes);
+
+            for (size_t lane = 0; lane < d.lanes; ++lane)
+            {
+                for (size_t j = 0; j < STATE_SIZE; ++j)
+                {
+                    writeBigEndian32(&parents[i + lane][4 * j], hashes[j * d.lanes + lane]);
+                }
+            }
+        }
+    }
+
+    // Any remaining pairs are hashed one at a time
+    for (; i < n; ++i)
+    {
+        doubleHash64(children[2 * i].data(), parents[i]);
+    }
+}
+
+Sha256Backend sha256BatchBackend()
+{
+    return batchDispatch().backend;
+}
+
+bool selectSha256BatchBackend(Sha256Backend backend)
+{
+    if (!sha256BackendIsAvailable(backend))
+        return false;
+
+    batchDispatch() = batchDispatchOf(backend);
+    return true;
+}
+
+} // namespace Crypto
@@ -0,0 +1,130 @@
+#pragma once
+
+// Internal interface shared by the SHA-256 implementations. This header is not part of the public API.
+
+#include "CpuFeatures.h"
+#include "Sha256.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Crypto
+{
+namespace Sha256Impl
+{
+size_t constexpr BLOCK_SIZE = 64;   // Size of a SHA-256 message block in bytes
+size_t constexpr STATE_SIZE = 8;    // Number of 32-bit words in the SHA-256 state
+
+// Updates the state with n consecutive 64-byte blocks
+typedef void (*Transform)(uint32_t * state, uint8_t const * blocks, size_t n);
+
+// Updates the states of several independent messages with one block each. The states are stored word-major
+// (states[i * lanes + lane]) and blocks[lane] is the block for the lane.
+typedef void (*LaneTransform)(uint32_t * states, uint8_t const * const * blocks);
+
+// Computes the double-SHA-256 hashes of several 64-byte messages. The hash values are stored word-major
+// (hashes[i * lanes + lane]) and blocks[lane] is the message for the lane.
+typedef void (*LaneDoubleHash64)(uint8_t const * const * blocks, uint32_t * hashes);
+
+extern uint32_t const INITIAL_STATE[STATE_SIZE];    // Initial hash value (FIPS 180-4 5.3.3)
+extern uint32_t const K[64];                        // Round constants (FIPS 180-4 4.2.2)
+extern uint32_t const PADDING_64_WK[64];            // Message schedule plus K of the padding block of a 64-byte message
+
+// Returns the transform of the currently selected backend
+Transform transform();
+
+// Returns the transform of the given backend
+Transform transformOf(Sha256Backend backend);
+
+// Copies the part of a message following its last full block into tail and appends the padding. Returns the number of
+// blocks in the tail (1 or 2).
+//
+// rest points to the length % BLOCK_SIZE bytes following the last full block, and length is the length of the message.
+size_t pad(uint8_t const * rest, uint64_t length, uint8_t * tail);
+
+void transformPortable(uint32_t * state, uint8_t const * blocks, size_t n);
+#if defined(CRYPTO_X86)
+void transformSse4(uint32_t * state, uint8_t const * blocks, size_t n);
+void transformAvx2(uint32_t * state, uint8_t const * blocks, size_t n);
+void transformShaNi(uint32_t * state, uint8_t const * blocks, size_t n);
+void transformSse4x4(uint32_t * states, uint8_t const * const * blocks);
+void transformAvx2x8(uint32_t * states, uint8_t const * const * blocks);
+void transformAvx512x16(uint32_t * states, uint8_t const * const * blocks);
+void doubleHash64Sse4x4(uint8_t const * const * blocks, uint32_t * hashes);
+void doubleHash64Avx2x8(uint8_t const * const * blocks, uint32_t * hashes);
+void doubleHash64Avx512x16(uint8_t const * const * blocks, uint32_t * hashes);
+#endif
+
+// The helpers below are compiled separately into each backend with that backend's code generation flags. They are in an
+// anonymous namespace so that the linker never substitutes a copy compiled for a different instruction set.
+namespace
+{
+inline uint32_t readBigEndian32(uint8_t const * p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+inline void writeBigEndian32(uint8_t * p, uint32_t x)
+{
+    p[0] = (uint8_t)(x >> 24);
+    p[1] = (uint8_t)(x >> 16);
+    p[2] = (uint8_t)(x >> 8);
+    p[3] = (uint8_t)x;
+}
+
+inline uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+inline uint32_t ch(uint32_t x, uint32_t y, uint32_t z) { return z ^ (x & (y ^ z)); }
+inline uint32_t maj(uint32_t x, uint32_t y, uint32_t z) { return (x & y) | (z & (x | y)); }
+inline uint32_t bigSigma0(uint32_t x) { return rotr(x, 2) ^ rotr(x, 13) ^ rotr(x, 22); }
+inline uint32_t bigSigma1(uint32_t x) { return rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25); }
+inline uint32_t smallSigma0(uint32_t x) { return rotr(x, 7) ^ rotr(x, 18) ^ (x >> 3); }
+inline uint32_t smallSigma1(uint32_t x) { return rotr(x, 17) ^ rotr(x, 19) ^ (x >> 10); }
+
+// One round of the compression function. Rather than rotating the eight working variables after each round, the caller
+// rotates the arguments.
+inline void round(uint32_t a, uint32_t b, uint32_t c, uint32_t & d, uint32_t e, uint32_t f, uint32_t g, uint32_t & h,
+                  uint32_t wk)
+{
+    uint32_t t1 = h + bigSigma1(e) + ch(e, f, g) + wk;
+    uint32_t t2 = bigSigma0(a) + maj(a, b, c);
+    d += t1;
+    h  = t1 + t2;
+}
+
+// Performs the 64 rounds of the compression function given the message schedule with the round constants already
+// added (wk[t] = W[t] + K[t]).
+inline void compress(uint32_t * state, uint32_t const * wk)
+{
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
+    uint32_t f = state[5];
+    uint32_t g = state[6];
+    uint32_t h = state[7];
+
+    for (int t = 0; t < 64; t += 8)
+    {
+        round(a, b, c, d, e, f, g, h, wk[t + 0]);
+        round(h, a, b, c, d, e, f, g, wk[t + 1]);
+        round(g, h, a, b, c, d, e, f, wk[t + 2]);
+        round(f, g, h, a, b, c, d, e, wk[t + 3]);
+        round(e, f, g, h, a, b, c, d, wk[t + 4]);
+        round(d, e, f, g, h, a, b, c, wk[t + 5]);
+        round(c, d, e, f, g, h, a, b, wk[t + 6]);
+        round(b, c, d, e, f, g, h, a, wk[t + 7]);
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+} // anonymous namespace
+} // namespace Sha256Impl
+} // namespace Crypto
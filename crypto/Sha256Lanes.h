@@ -0,0 +1,186 @@
+#pragma once
+
+// Multi-lane SHA-256 compression function shared by the SIMD implementations. This header is not part of the public API.
+//
+// Each lane of a vector holds the state of an independent message. The code is instantiated in each SIMD source file
+// with that file's vector operations, so it is in an anonymous namespace to prevent the linker from substituting a copy
+// compiled for a different instruction set.
+//
+// The vector operations are provided by a class with the following static members:
+//
+//      typedef ... Vector;                                         // A vector of LANES 32-bit words
+//      static int const LANES;                                     // Number of lanes
+//      static Vector load(uint32_t const * p);                     // Loads LANES words
+//      static void   store(uint32_t * p, Vector x);                // Stores LANES words
+//      static Vector set1(uint32_t x);                             // Sets every lane to x
+//      static void   loadWords(uint8_t const * const * blocks, Vector * w);
+//                                                                  // Loads the 16 big-endian words of each lane's block
+//      static Vector add(Vector x, Vector y);
+//      static Vector xor3(Vector x, Vector y, Vector z);
+//      template <int N> static Vector shr(Vector x);
+//      template <int N> static Vector rotr(Vector x);
+//      static Vector ch(Vector x, Vector y, Vector z);
+//      static Vector maj(Vector x, Vector y, Vector z);
+
+#include "Sha256Impl.h"
+
+namespace Crypto
+{
+namespace Sha256Impl
+{
+namespace
+{
+template <typename Ops>
+struct Lanes
+{
+    typedef typename Ops::Vector Vector;
+
+    static Vector bigSigma0(Vector x)
+    {
+        return Ops::xor3(Ops::template rotr<2>(x), Ops::template rotr<13>(x), Ops::template rotr<22>(x));
+    }
+    static Vector bigSigma1(Vector x)
+    {
+        return Ops::xor3(Ops::template rotr<6>(x), Ops::template rotr<11>(x), Ops::template rotr<25>(x));
+    }
+    static Vector smallSigma0(Vector x)
+    {
+        return Ops::xor3(Ops::template rotr<7>(x), Ops::template rotr<18>(x), Ops::template shr<3>(x));
+    }
+    static Vector smallSigma1(Vector x)
+    {
+        return Ops::xor3(Ops::template rotr<17>(x), Ops::template rotr<19>(x), Ops::template shr<10>(x));
+    }
+
+    static void round(Vector a, Vector b, Vector c, Vector & d, Vector e, Vector f, Vector g, Vector & h, Vector wk)
+    {
+        Vector t1 = Ops::add(Ops::add(h, bigSigma1(e)), Ops::add(Ops::ch(e, f, g), wk));
+        Vector t2 = Ops::add(bigSigma0(a), Ops::maj(a, b, c));
+        d = Ops::add(d, t1);
+        h = Ops::add(t1, t2);
+    }
+
+    // Updates the working state s[0..7] with one block per lane given its 16 words
+    static void compress(Vector * s, Vector * w)
+    {
+        Vector a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+
+        for (int t = 0; t < 64; t += 8)
+        {
+            if (t >= 16)
+            {
+                for (int i = t; i < t + 8; ++i)
+                {
+                    w[i & 15] = Ops::add(Ops::add(w[i & 15], smallSigma0(w[(i + 1) & 15])),
+                                         Ops::add(w[(i + 9) & 15], smallSigma1(w[(i + 14) & 15])));
+                }
+            }
+            round(a, b, c, d, e, f, g, h, Ops::add(w[(t + 0) & 15], Ops::set1(K[t + 0])));
+            round(h, a, b, c, d, e, f, g, Ops::add(w[(t + 1) & 15], Ops::set1(K[t + 1])));
+            round(g, h, a, b, c, d, e, f, Ops::add(w[(t + 2) & 15], Ops::set1(K[t + 2])));
+            round(f, g, h, a, b, c, d, e, Ops::add(w[(t + 3) & 15], Ops::set1(K[t + 3])));
+            round(e, f, g, h, a, b, c, d, Ops::add(w[(t + 4) & 15], Ops::set1(K[t + 4])));
+            round(d, e, f, g, h, a, b, c, Ops::add(w[(t + 5) & 15], Ops::set1(K[t + 5])));
+            round(c, d, e, f, g, h, a, b, Ops::add(w[(t + 6) & 15], Ops::set1(K[t + 6])));
+            round(b, c, d, e, f, g, h, a, Ops::add(w[(t + 7) & 15], Ops::set1(K[t + 7])));
+        }
+
+        addState(s, a, b, c, d, e, f, g, h);
+    }
+
+    // Updates the working state s[0..7] with the same block in every lane given its precomputed message schedule with
+    // the round constants already added
+    static void compress(Vector * s, uint32_t const * wk)
+    {
+        Vector a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+
+        for (int t = 0; t < 64; t += 8)
+        {
+            round(a, b, c, d, e, f, g, h, Ops::set1(wk[t + 0]));
+            round(h, a, b, c, d, e, f, g, Ops::set1(wk[t + 1]));
+            round(g, h, a, b, c, d, e, f, Ops::set1(wk[t + 2]));
+            round(f, g, h, a, b, c, d, e, Ops::set1(wk[t + 3]));
+            round(e, f, g, h, a, b, c, d, Ops::set1(wk[t + 4]));
+            round(d, e, f, g, h, a, b, c, Ops::set1(wk[t + 5]));
+            round(c, d, e, f, g, h, a, b, Ops::set1(wk[t + 6]));
+            round(b, c, d, e, f, g, h, a, Ops::set1(wk[t + 7]));
+        }
+
+        addState(s, a, b, c, d, e, f, g, h);
+    }
+
+    static void addState(Vector * s, Vector a, Vector b, Vector c, Vector d, Vector e, Vector f, Vector g, Vector h)
+    {
+        s[0] = Ops::add(s[0], a);
+        s[1] = Ops::add(s[1], b);
+        s[2] = Ops::add(s[2], c);
+        s[3] = Ops::add(s[3], d);
+        s[4] = Ops::add(s[4], e);
+        s[5] = Ops::add(s[5], f);
+        s[6] = Ops::add(s[6], g);
+        s[7] = Ops::add(s[7], h);
+    }
+
+    static void initialize(Vector * s)
+    {
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            s[i] = Ops::set1(INITIAL_STATE[i]);
+        }
+    }
+
+    // Updates the states with one block per lane. The states are stored word-major (state[i * LANES + lane]).
+    static void transform(uint32_t * state, uint8_t const * const * blocks)
+    {
+        Vector s[STATE_SIZE];
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            s[i] = Ops::load(state + i * Ops::LANES);
+        }
+
+        Vector w[16];
+        Ops::loadWords(blocks, w);
+        compress(s, w);
+
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            Ops::store(state + i * Ops::LANES, s[i]);
+        }
+    }
+
+    // Computes the double-SHA-256 hash of one 64-byte message per lane. The hashes are stored word-major
+    // (hashes[i * LANES + lane]).
+    static void doubleHash64(uint8_t const * const * blocks, uint32_t * hashes)
+    {
+        Vector s[STATE_SIZE];
+        Vector w[16];
+
+        // First pass: the message and then the padding block, which is the same for every 64-byte message
+        initialize(s);
+        Ops::loadWords(blocks, w);
+        compress(s, w);
+        compress(s, PADDING_64_WK);
+
+        // Second pass: the first hash is the first half of the block, and the padding is the second half
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            w[i] = s[i];
+        }
+        w[8] = Ops::set1(0x80000000);
+        for (int i = 9; i < 15; ++i)
+        {
+            w[i] = Ops::set1(0);
+        }
+        w[15] = Ops::set1(256);
+        initialize(s);
+        compress(s, w);
+
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            Ops::store(hashes + i * Ops::LANES, s[i]);
+        }
+    }
+};
+} // anonymous namespace
+} // namespace Sha256Impl
+} // namespace Crypto
@@ -0,0 +1,35 @@
+// Portable implementation of the SHA-256 compression function
+
+#include "Sha256Impl.h"
+
+namespace Crypto
+{
+namespace Sha256Impl
+{
+
+void transformPortable(uint32_t * state, uint8_t const * blocks, size_t n)
+{
+    uint32_t wk[64];
+    while (n-- > 0)
+    {
+        uint32_t w[64];
+        for (int t = 0; t < 16; ++t)
+        {
+            w[t] = readBigEndian32(blocks + 4 * t);
+        }
+        for (int t = 16; t < 64; ++t)
+        {
+            w[t] = smallSigma1(w[t - 2]) + w[t - 7] + smallSigma0(w[t - 15]) + w[t - 16];
+        }
+        for (int t = 0; t < 64; ++t)
+        {
+            wk[t] = w[t] + K[t];
+        }
+
+        compress(state, wk);
+        blocks += BLOCK_SIZE;
+    }
+}
+
+} // namespace Sha256Impl
+} // namespace Crypto
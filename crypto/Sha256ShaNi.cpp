@@ -0,0 +1,71 @@
+// SHA-256 compression function using the Intel SHA extensions.
+//
+// This file must be compiled with SHA and SSE4.1 code generation enabled (e.g. -msha -msse4.1).
+
+#include "Sha256Impl.h"
+
+#if defined(CRYPTO_X86)
+
+#include <immintrin.h>
+
+namespace Crypto
+{
+namespace Sha256Impl
+{
+
+void transformShaNi(uint32_t * state, uint8_t const * blocks, size_t n)
+{
+    __m128i const BYTE_SWAP = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The SHA instructions expect the state as ABEF and CDGH
+    __m128i dcba = _mm_loadu_si128((__m128i const *)&state[0]);
+    __m128i hgfe = _mm_loadu_si128((__m128i const *)&state[4]);
+    __m128i cdab = _mm_shuffle_epi32(dcba, 0xb1);
+    __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1b);
+    __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xf0);
+
+    while (n-- > 0)
+    {
+        __m128i abefSaved = abef;
+        __m128i cdghSaved = cdgh;
+
+        __m128i w[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            w[i] = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const *)(blocks + 16 * i)), BYTE_SWAP);
+        }
+
+        // 16 groups of 4 rounds. w[i % 4] holds W[4i .. 4i+3] and is replaced by W[4i+16 .. 4i+19] once it is no
+        // longer needed.
+        for (int i = 0; i < 16; ++i)
+        {
+            if (i >= 4)
+            {
+                __m128i w4  = w[(i + 3) & 3];
+                __m128i tmp = _mm_add_epi32(_mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]),
+                                            _mm_alignr_epi8(w4, w[(i + 2) & 3], 4));
+                w[i & 3] = _mm_sha256msg2_epu32(tmp, w4);
+            }
+
+            __m128i wk = _mm_add_epi32(w[i & 3], _mm_loadu_si128((__m128i const *)&K[4 * i]));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(wk, 0x0e));
+        }
+
+        abef    = _mm_add_epi32(abef, abefSaved);
+        cdgh    = _mm_add_epi32(cdgh, cdghSaved);
+        blocks += BLOCK_SIZE;
+    }
+
+    // Convert back to DCBA and HGFE
+    __m128i feba = _mm_shuffle_epi32(abef, 0x1b);
+    __m128i dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128((__m128i *)&state[0], _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128((__m128i *)&state[4], _mm_alignr_epi8(dchg, feba, 8));
+}
+
+} // namespace Sha256Impl
+} // namespace Crypto
+
+#endif // if defined(CRYPTO_X86)
@@ -0,0 +1,129 @@
+// SHA-256 compression function with the message schedule computed four words at a time using SSSE3/SSE4.1, and a
+// compression function that hashes four messages at once.
+//
+// This file must be compiled with SSE4.1 code generation enabled (e.g. -msse4.1).
+
+#include "Sha256Lanes.h"
+
+#if defined(CRYPTO_X86)
+
+#include <immintrin.h>
+
+namespace
+{
+template <int N>
+__m128i rotr4(__m128i x)
+{
+    return _mm_or_si128(_mm_srli_epi32(x, N), _mm_slli_epi32(x, 32 - N));
+}
+
+__m128i smallSigma0x4(__m128i x)
+{
+    return _mm_xor_si128(_mm_xor_si128(rotr4<7>(x), rotr4<18>(x)), _mm_srli_epi32(x, 3));
+}
+
+__m128i smallSigma1x4(__m128i x)
+{
+    return _mm_xor_si128(_mm_xor_si128(rotr4<17>(x), rotr4<19>(x)), _mm_srli_epi32(x, 10));
+}
+
+// Computes W[t .. t+3] given W[t-16 .. t-1] in four vectors. Since W[t+2] and W[t+3] depend on W[t] and W[t+1], the
+// sigma1 term is added in two halves.
+__m128i nextWords(__m128i w16, __m128i w12, __m128i w8, __m128i w4)
+{
+    __m128i w = _mm_add_epi32(w16, smallSigma0x4(_mm_alignr_epi8(w12, w16, 4)));   // W[t-16] + s0(W[t-15])
+    w = _mm_add_epi32(w, _mm_alignr_epi8(w4, w8, 4));                               // + W[t-7]
+    w = _mm_add_epi32(w, _mm_move_epi64(smallSigma1x4(_mm_shuffle_epi32(w4, 0xfe)))); // + s1(W[t-2]) for t, t+1
+    w = _mm_add_epi32(w, _mm_unpacklo_epi64(_mm_setzero_si128(), smallSigma1x4(w)));  // + s1(W[t-2]) for t+2, t+3
+    return w;
+}
+
+// Vector operations for Sha256Impl::Lanes
+struct Sse4Ops
+{
+    typedef __m128i Vector;
+    static int const LANES = 4;
+
+    static Vector load(uint32_t const * p) { return _mm_loadu_si128((__m128i const *)p); }
+    static void store(uint32_t * p, Vector x) { _mm_storeu_si128((__m128i *)p, x); }
+    static Vector set1(uint32_t x) { return _mm_set1_epi32((int)x); }
+    static Vector add(Vector x, Vector y) { return _mm_add_epi32(x, y); }
+    static Vector xor3(Vector x, Vector y, Vector z) { return _mm_xor_si128(_mm_xor_si128(x, y), z); }
+    template <int N> static Vector shr(Vector x) { return _mm_srli_epi32(x, N); }
+    template <int N> static Vector rotr(Vector x) { return rotr4<N>(x); }
+    static Vector ch(Vector x, Vector y, Vector z) { return _mm_xor_si128(z, _mm_and_si128(x, _mm_xor_si128(y, z))); }
+    static Vector maj(Vector x, Vector y, Vector z)
+    {
+        return _mm_or_si128(_mm_and_si128(x, y), _mm_and_si128(z, _mm_or_si128(x, y)));
+    }
+
+    // Each group of four words is loaded from the four blocks and transposed
+    static void loadWords(uint8_t const * const * blocks, Vector * w)
+    {
+        __m128i const BYTE_SWAP = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            __m128i r0 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const *)(blocks[0] + 16 * i)), BYTE_SWAP);
+            __m128i r1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const *)(blocks[1] + 16 * i)), BYTE_SWAP);
+            __m128i r2 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const *)(blocks[2] + 16 * i)), BYTE_SWAP);
+            __m128i r3 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const *)(blocks[3] + 16 * i)), BYTE_SWAP);
+            __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+            __m128i t1 = _mm_unpackhi_epi32(r0, r1);
+            __m128i t2 = _mm_unpacklo_epi32(r2, r3);
+            __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+            w[4 * i + 0] = _mm_unpacklo_epi64(t0, t2);
+            w[4 * i + 1] = _mm_unpackhi_epi64(t0, t2);
+            w[4 * i + 2] = _mm_unpacklo_epi64(t1, t3);
+            w[4 * i + 3] = _mm_unpackhi_epi64(t1, t3);
+        }
+    }
+};
+} // anonymous namespace
+
+namespace Crypto
+{
+namespace Sha256Impl
+{
+
+void transformSse4(uint32_t * state, uint8_t const * blocks, size_t n)
+{
+    __m128i const BYTE_SWAP = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+    uint32_t wk[64];
+    while (n-- > 0)
+    {
+        __m128i w[16];
+        for (int i = 0; i < 4; ++i)
+        {
+            w[i] = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const *)(blocks + 16 * i)), BYTE_SWAP);
+        }
+        for (int i = 4; i < 16; ++i)
+        {
+            w[i] = nextWords(w[i - 4], w[i - 3], w[i - 2], w[i - 1]);
+        }
+        for (int i = 0; i < 16; ++i)
+        {
+            __m128i k = _mm_loadu_si128((__m128i const *)&K[4 * i]);
+            _mm_storeu_si128((__m128i *)&wk[4 * i], _mm_add_epi32(w[i], k));
+        }
+
+        compress(state, wk);
+        blocks += BLOCK_SIZE;
+    }
+}
+
+void transformSse4x4(uint32_t * states, uint8_t const * const * blocks)
+{
+    Lanes<Sse4Ops>::transform(states, blocks);
+}
+
+void doubleHash64Sse4x4(uint8_t const * const * blocks, uint32_t * hashes)
+{
+    Lanes<Sse4Ops>::doubleHash64(blocks, hashes);
+}
+
+} // namespace Sha256Impl
+} // namespace Crypto
+
+#endif // if defined(CRYPTO_X86)
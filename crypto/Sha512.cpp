@@ -1,29 +1,244 @@
 #include "Sha512.h"
 
-#include <wolfssl/options.h>
-#include <wolfssl/wolfcrypt/settings.h>
-#include <wolfssl/wolfcrypt/sha512.h>
+#include "CpuFeatures.h"
+#include "Sha512Impl.h"
 
 #include <algorithm>
 #include <cassert>
 
+using namespace Crypto::Sha512Impl;
+
+namespace
+{
+// The selected implementation. It is chosen the first time it is needed.
+struct Dispatch
+{
+    Crypto::Sha512Backend backend;
+    Transform transform;
+};
+
+Transform transformOf(Crypto::Sha512Backend backend)
+{
+    switch (backend)
+    {
+#if defined(CRYPTO_X86)
+        case Crypto::SHA512_AVX2:   return transformAvx2;
+        case Crypto::SHA512_AVX512: return transformAvx2;   // AVX-512 is only used for multiple messages
+#endif
+        default:                    return transformPortable;
+    }
+}
+
+Crypto::Sha512Backend fastestBackend()
+{
+    static Crypto::Sha512Backend const PREFERRED[] =
+    {
+        Crypto::SHA512_AVX512,
+        Crypto::SHA512_AVX2
+    };
+
+    for (auto backend : PREFERRED)
+    {
+        if (Crypto::sha512BackendIsAvailable(backend))
+            return backend;
+    }
+    return Crypto::SHA512_PORTABLE;
+}
+
+Dispatch initialDispatch()
+{
+    Crypto::Sha512Backend backend = fastestBackend();
+    return Dispatch{ backend, transformOf(backend) };
+}
+
+Dispatch & dispatch()
+{
+    static Dispatch d = initialDispatch();
+    return d;
+}
+
+Crypto::Sha512Hash hashOf(uint64_t const * state)
+{
+    Crypto::Sha512Hash out;
+    for (size_t i = 0; i < STATE_SIZE; ++i)
+    {
+        writeBigEndian64(&out[8 * i], state[i]);
+    }
+    return out;
+}
+} // anonymous namespace
+
 namespace Crypto
 {
+namespace Sha512Impl
+{
+
+uint64_t const INITIAL_STATE[STATE_SIZE] =
+{
+    0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+    0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179
+};
+
+uint64_t const K[80] =
+{
+    0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc, 0x3956c25bf348b538,
+    0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118, 0xd807aa98a3030242, 0x12835b0145706fbe,
+    0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2, 0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235,
+    0xc19bf174cf692694, 0xe49b69c19ef14ad2, 0xefbe4786384f25e3, 0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
+    0x2de92c6f592b0275, 0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5, 0x983e5152ee66dfab,
+    0xa831c66d2db43210, 0xb00327c898fb213f, 0xbf597fc7beef0ee4, 0xc6e00bf33da88fc2, 0xd5a79147930aa725,
+    0x06ca6351e003826f, 0x142929670a0e6e70, 0x27b70a8546d22ffc, 0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed,
+    0x53380d139d95b3df, 0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6, 0x92722c851482353b,
+    0xa2bfe8a14cf10364, 0xa81a664bbc423001, 0xc24b8b70d0f89791, 0xc76c51a30654be30, 0xd192e819d6ef5218,
+    0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8, 0x19a4c116b8d2d0c8, 0x1e376c085141ab53,
+    0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8, 0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb, 0x5b9cca4f7763e373,
+    0x682e6ff3d6b2b8a3, 0x748f82ee5defb2fc, 0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+    0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915, 0xc67178f2e372532b, 0xca273eceea26619c,
+    0xd186b8c721c0c207, 0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178, 0x06f067aa72176fba, 0x0a637dc5a2c898a6,
+    0x113f9804bef90dae, 0x1b710b35131c471b, 0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc,
+    0x431d67c49c100d4c, 0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817
+};
+
+Transform transform()
+{
+    return dispatch().transform;
+}
+
+LanePbkdf2 lanePbkdf2(int & lanes)
+{
+    switch (dispatch().backend)
+    {
+#if defined(CRYPTO_X86)
+        case SHA512_AVX2:   lanes = 4; return pbkdf2Avx2x4;
+        case SHA512_AVX512: lanes = 8; return pbkdf2Avx512x8;
+#endif
+        default:            lanes = 1; return pbkdf2Portable;
+    }
+}
+
+size_t pad(uint8_t const * rest, uint64_t length, uint8_t * tail)
+{
+    // The remainder is padded with 0x80, 0s, and the length in bits as a 128-bit big-endian number, requiring one or two
+    // blocks
+    size_t   restSize = (size_t)(length % BLOCK_SIZE);
+    uint64_t bits     = length * 8;
+    size_t   size     = (restSize + 1 + 16 <= BLOCK_SIZE) ? BLOCK_SIZE : 2 * BLOCK_SIZE;
+    std::copy(rest, rest + restSize, tail);
+    tail[restSize] = 0x80;
+    std::fill(tail + restSize + 1, tail + size - 8, 0);
+    writeBigEndian64(tail + size - 8, bits);
+    return size / BLOCK_SIZE;
+}
+
+} // namespace Sha512Impl
 
 Sha512Hash sha512(std::vector<uint8_t> const & input)
 {
     return sha512(input.data(), input.size());
 }
 
-//     Sha512Hash sha512(Sha512Hash const & input)
-//     {
-//         return sha512(input.data(), input.size());
-//     }
-
 Sha512Hash sha512(uint8_t const * input, size_t length)
 {
-    Sha512Hash hash = {};
-    return hash;
+    Transform transform = dispatch().transform;
+
+    uint64_t state[STATE_SIZE];
+    std::copy(INITIAL_STATE, INITIAL_STATE + STATE_SIZE, state);
+
+    // Full blocks are hashed in place
+    transform(state, input, length / BLOCK_SIZE);
+
+    uint8_t tail[2 * BLOCK_SIZE];
+    transform(state, tail, pad(input + length / BLOCK_SIZE * BLOCK_SIZE, length, tail));
+
+    return hashOf(state);
+}
+
+void Sha512Hasher::init()
+{
+    std::copy(INITIAL_STATE, INITIAL_STATE + STATE_SIZE, state_);
+    length_ = 0;
+}
+
+void Sha512Hasher::update(uint8_t const * data, size_t length)
+{
+    Transform transform = dispatch().transform;
+    size_t    buffered  = (size_t)(length_ % BLOCK_SIZE);
+    length_ += length;
+
+    // Complete the buffered block first
+    if (buffered > 0)
+    {
+        size_t n = std::min(length, BLOCK_SIZE - buffered);
+        std::copy(data, data + n, buffer_ + buffered);
+        data     += n;
+        length   -= n;
+        buffered += n;
+        if (buffered < BLOCK_SIZE)
+            return;
+        transform(state_, buffer_, 1);
+    }
+
+    // Full blocks are hashed in place and the rest is buffered
+    size_t nBlocks = length / BLOCK_SIZE;
+    transform(state_, data, nBlocks);
+    data += nBlocks * BLOCK_SIZE;
+    std::copy(data, data + length % BLOCK_SIZE, buffer_);
+}
+
+Sha512Hash Sha512Hasher::finalize() const
+{
+    Transform transform = dispatch().transform;
+    uint64_t  state[STATE_SIZE];
+    uint8_t   tail[2 * BLOCK_SIZE];
+
+    std::copy(state_, state_ + STATE_SIZE, state);
+    transform(state, tail, pad(buffer_, length_, tail));
+    return hashOf(state);
+}
+
+bool sha512BackendIsAvailable(Sha512Backend backend)
+{
+#if defined(CRYPTO_X86)
+    CpuFeatures const & cpu = cpuFeatures();
+#endif
+    switch (backend)
+    {
+        case SHA512_PORTABLE:   return true;
+#if defined(CRYPTO_X86)
+        case SHA512_AVX2:       return cpu.avx2 && cpu.bmi2;
+        case SHA512_AVX512:     return cpu.avx512 && cpu.avx2 && cpu.bmi2;
+#endif
+        default:                return false;
+    }
+}
+
+Sha512Backend sha512Backend()
+{
+    return dispatch().backend;
+}
+
+bool selectSha512Backend(Sha512Backend backend)
+{
+    if (!sha512BackendIsAvailable(backend))
+        return false;
+
+    Dispatch & d = dispatch();
+    d.backend   = backend;
+    d.transform = transformOf(backend);
+    return true;
+}
+
+char const * sha512BackendName(Sha512Backend backend)
+{
+    static char const * const NAMES[NUM_SHA512_BACKENDS] =
+    {
+        "portable",
+        "avx2",
+        "avx512"
+    };
+
+    assert(backend >= 0 && backend < NUM_SHA512_BACKENDS);
+    return NAMES[backend];
 }
 
 } // namespace Crypto
@@ -26,6 +26,77 @@ Sha512Hash sha512(uint8_t const * input, size_t length);
 //! @param  input   data to hash
 template <size_t N> Sha512Hash sha512(std::array<uint8_t, N> const & input);
 
+//! Computes a SHA-512 hash incrementally.
+//!
+//! The data is added in any number of pieces. A hasher can be copied at any point to save its intermediate state, so
+//! that several messages with a common prefix only hash the prefix once.
+class Sha512Hasher
+{
+public:
+
+    //! Constructor
+    Sha512Hasher() { init(); }
+
+    //! Starts a new hash, discarding any data already added.
+    void init();
+
+    //! Adds data to the hash.
+    //!
+    //! @param  data    data to add
+    //! @param  length  length of the data
+    void update(uint8_t const * data, size_t length);
+
+    //! Adds data to the hash.
+    //!
+    //! @param  data    data to add
+    void update(std::vector<uint8_t> const & data) { update(data.data(), data.size()); }
+
+    //! Returns the hash of the data added since init().
+    //!
+    //! The hasher is not changed, so more data can be added afterwards.
+    Sha512Hash finalize() const;
+
+    //! Returns the number of bytes added since init().
+    uint64_t length() const { return length_; }
+
+private:
+
+    static size_t const BLOCK_SIZE = 128;
+
+    uint64_t state_[8];             // State after the last full block
+    uint8_t  buffer_[BLOCK_SIZE];   // Data following the last full block
+    uint64_t length_;               // Total amount of data added
+};
+
+//! SHA-512 implementations.
+//!
+//! The fastest implementation supported by the processor is selected automatically the first time a hash is computed.
+enum Sha512Backend
+{
+    SHA512_PORTABLE,        //!< Portable C++
+    SHA512_AVX2,            //!< Message schedule vectorized with AVX2, rounds use BMI2
+    SHA512_AVX512,          //!< AVX-512 for multiple messages (PBKDF2), otherwise the same as SHA512_AVX2
+    NUM_SHA512_BACKENDS     //!< Number of SHA-512 implementations
+};
+
+//! Returns true if the given SHA-512 implementation is supported by the processor.
+//! @param  backend     implementation to check
+bool sha512BackendIsAvailable(Sha512Backend backend);
+
+//! Returns the SHA-512 implementation in use.
+Sha512Backend sha512Backend();
+
+//! Selects the SHA-512 implementation to use.
+//!
+//! @param  backend     implementation to use
+//! @return false if the implementation is not supported by the processor (in which case nothing is changed)
+//! @note   This is intended for testing and benchmarking. It must not be called while hashes are being computed.
+bool selectSha512Backend(Sha512Backend backend);
+
+//! Returns the name of a SHA-512 implementation.
+//! @param  backend     implementation
+char const * sha512BackendName(Sha512Backend backend);
+
 //!@}
 
 /********************************************************************************************************************/
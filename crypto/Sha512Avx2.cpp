@@ -0,0 +1,115 @@
+// SHA-512 compression function with the message schedule computed four words at a time using AVX2. The rounds are
+// scalar and use BMI2 rotations. There is also a PBKDF2 kernel that processes four passwords at once.
+//
+// This file must be compiled with AVX2 and BMI2 code generation enabled (e.g. -mavx2 -mbmi2).
+
+#include "Sha512Lanes.h"
+
+#if defined(CRYPTO_X86)
+
+#include <immintrin.h>
+
+namespace
+{
+template <int N>
+__m256i rotr4(__m256i x)
+{
+    return _mm256_or_si256(_mm256_srli_epi64(x, N), _mm256_slli_epi64(x, 64 - N));
+}
+
+__m256i smallSigma0x4(__m256i x)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(rotr4<1>(x), rotr4<8>(x)), _mm256_srli_epi64(x, 7));
+}
+
+__m256i smallSigma1x4(__m256i x)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(rotr4<19>(x), rotr4<61>(x)), _mm256_srli_epi64(x, 6));
+}
+
+// Returns words 1-3 of lo followed by word 0 of hi
+__m256i shiftWord(__m256i lo, __m256i hi)
+{
+    return _mm256_permute4x64_epi64(_mm256_blend_epi32(lo, hi, 0x03), 0x39);
+}
+
+// Computes W[t .. t+3] given W[t-16 .. t-1] in four vectors. Since W[t+2] and W[t+3] depend on W[t] and W[t+1], the
+// sigma1 term is added in two halves.
+__m256i nextWords(__m256i w16, __m256i w12, __m256i w8, __m256i w4)
+{
+    __m256i const ZERO = _mm256_setzero_si256();
+
+    __m256i w = _mm256_add_epi64(w16, smallSigma0x4(shiftWord(w16, w12)));                   // W[t-16] + s0(W[t-15])
+    w = _mm256_add_epi64(w, shiftWord(w8, w4));                                               // + W[t-7]
+    w = _mm256_add_epi64(w, _mm256_blend_epi32(ZERO, smallSigma1x4(_mm256_permute4x64_epi64(w4, 0x0e)), 0x0f));
+    w = _mm256_add_epi64(w, _mm256_blend_epi32(ZERO, smallSigma1x4(_mm256_permute4x64_epi64(w, 0x40)), 0xf0));
+    return w;
+}
+
+// Vector operations for Sha512Impl::Lanes
+struct Avx2Ops
+{
+    typedef __m256i Vector;
+    static int const LANES = 4;
+
+    static Vector load(uint64_t const * p) { return _mm256_loadu_si256((__m256i const *)p); }
+    static void store(uint64_t * p, Vector x) { _mm256_storeu_si256((__m256i *)p, x); }
+    static Vector set1(uint64_t x) { return _mm256_set1_epi64x((long long)x); }
+    static Vector add(Vector x, Vector y) { return _mm256_add_epi64(x, y); }
+    static Vector xor2(Vector x, Vector y) { return _mm256_xor_si256(x, y); }
+    static Vector xor3(Vector x, Vector y, Vector z) { return _mm256_xor_si256(_mm256_xor_si256(x, y), z); }
+    template <int N> static Vector shr(Vector x) { return _mm256_srli_epi64(x, N); }
+    template <int N> static Vector rotr(Vector x) { return rotr4<N>(x); }
+    static Vector ch(Vector x, Vector y, Vector z)
+    {
+        return _mm256_xor_si256(z, _mm256_and_si256(x, _mm256_xor_si256(y, z)));
+    }
+    static Vector maj(Vector x, Vector y, Vector z)
+    {
+        return _mm256_or_si256(_mm256_and_si256(x, y), _mm256_and_si256(z, _mm256_or_si256(x, y)));
+    }
+};
+} // anonymous namespace
+
+namespace Crypto
+{
+namespace Sha512Impl
+{
+
+void transformAvx2(uint64_t * state, uint8_t const * blocks, size_t n)
+{
+    __m256i const BYTE_SWAP = _mm256_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7,
+                                              8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+
+    alignas(32) uint64_t wk[80];
+    while (n-- > 0)
+    {
+        // w[i % 4] holds W[4i .. 4i+3]
+        __m256i w[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            w[i] = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i const *)(blocks + 32 * i)), BYTE_SWAP);
+            _mm256_store_si256((__m256i *)&wk[4 * i],
+                               _mm256_add_epi64(w[i], _mm256_loadu_si256((__m256i const *)&K[4 * i])));
+        }
+        for (int i = 4; i < 20; ++i)
+        {
+            w[i & 3] = nextWords(w[i & 3], w[(i + 1) & 3], w[(i + 2) & 3], w[(i + 3) & 3]);
+            _mm256_store_si256((__m256i *)&wk[4 * i],
+                               _mm256_add_epi64(w[i & 3], _mm256_loadu_si256((__m256i const *)&K[4 * i])));
+        }
+
+        compress(state, wk);
+        blocks += BLOCK_SIZE;
+    }
+}
+
+void pbkdf2Avx2x4(uint64_t const * inner, uint64_t const * outer, uint64_t * t, int count)
+{
+    Lanes<Avx2Ops>::pbkdf2(inner, outer, t, count);
+}
+
+} // namespace Sha512Impl
+} // namespace Crypto
+
+#endif // if defined(CRYPTO_X86)
@@ -0,0 +1,45 @@
+// SHA-512 PBKDF2 kernel that processes eight passwords at once using AVX-512.
+//
+// This file must be compiled with AVX-512F code generation enabled (e.g. -mavx512f).
+
+#include "Sha512Lanes.h"
+
+#if defined(CRYPTO_X86)
+
+#include <immintrin.h>
+
+namespace
+{
+// Vector operations for Sha512Impl::Lanes
+struct Avx512Ops
+{
+    typedef __m512i Vector;
+    static int const LANES = 8;
+
+    static Vector load(uint64_t const * p) { return _mm512_loadu_si512(p); }
+    static void store(uint64_t * p, Vector x) { _mm512_storeu_si512(p, x); }
+    static Vector set1(uint64_t x) { return _mm512_set1_epi64((long long)x); }
+    static Vector add(Vector x, Vector y) { return _mm512_add_epi64(x, y); }
+    static Vector xor2(Vector x, Vector y) { return _mm512_xor_si512(x, y); }
+    static Vector xor3(Vector x, Vector y, Vector z) { return _mm512_ternarylogic_epi64(x, y, z, 0x96); }
+    template <int N> static Vector shr(Vector x) { return _mm512_srli_epi64(x, N); }
+    template <int N> static Vector rotr(Vector x) { return _mm512_ror_epi64(x, N); }
+    static Vector ch(Vector x, Vector y, Vector z) { return _mm512_ternarylogic_epi64(x, y, z, 0xca); }
+    static Vector maj(Vector x, Vector y, Vector z) { return _mm512_ternarylogic_epi64(x, y, z, 0xe8); }
+};
+} // anonymous namespace
+
+namespace Crypto
+{
+namespace Sha512Impl
+{
+
+void pbkdf2Avx512x8(uint64_t const * inner, uint64_t const * outer, uint64_t * t, int count)
+{
+    Lanes<Avx512Ops>::pbkdf2(inner, outer, t, count);
+}
+
+} // namespace Sha512Impl
+} // namespace Crypto
+
+#endif // if defined(CRYPTO_X86)
@@ -0,0 +1,123 @@
+#pragma once
+
+// Internal interface shared by the SHA-512 implementations. This header is not part of the public API.
+
+#include "CpuFeatures.h"
+#include "Sha512.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Crypto
+{
+namespace Sha512Impl
+{
+size_t constexpr BLOCK_SIZE = 128;  // Size of a SHA-512 message block in bytes
+size_t constexpr STATE_SIZE = 8;    // Number of 64-bit words in the SHA-512 state
+
+// Updates the state with n consecutive 128-byte blocks
+typedef void (*Transform)(uint64_t * state, uint8_t const * blocks, size_t n);
+
+// Performs iterations 2 .. count of PBKDF2-HMAC-SHA512 for one output block in each of several lanes. inner and outer
+// are the HMAC states after the padded key, and t holds U1 on entry and the output block on return. All are stored
+// word-major (x[i * lanes + lane]).
+typedef void (*LanePbkdf2)(uint64_t const * inner, uint64_t const * outer, uint64_t * t, int count);
+
+extern uint64_t const INITIAL_STATE[STATE_SIZE];    // Initial hash value (FIPS 180-4 5.3.5)
+extern uint64_t const K[80];                        // Round constants (FIPS 180-4 4.2.3)
+
+// Returns the transform of the currently selected backend
+Transform transform();
+
+// Returns the PBKDF2 kernel of the currently selected backend and sets lanes to its number of lanes
+LanePbkdf2 lanePbkdf2(int & lanes);
+
+// Copies the part of a message following its last full block into tail and appends the padding. Returns the number of
+// blocks in the tail (1 or 2).
+//
+// rest points to the length % BLOCK_SIZE bytes following the last full block, and length is the length of the message.
+size_t pad(uint8_t const * rest, uint64_t length, uint8_t * tail);
+
+void transformPortable(uint64_t * state, uint8_t const * blocks, size_t n);
+void pbkdf2Portable(uint64_t const * inner, uint64_t const * outer, uint64_t * t, int count);
+#if defined(CRYPTO_X86)
+void transformAvx2(uint64_t * state, uint8_t const * blocks, size_t n);
+void pbkdf2Avx2x4(uint64_t const * inner, uint64_t const * outer, uint64_t * t, int count);
+void pbkdf2Avx512x8(uint64_t const * inner, uint64_t const * outer, uint64_t * t, int count);
+#endif
+
+// The helpers below are compiled separately into each backend with that backend's code generation flags. They are in an
+// anonymous namespace so that the linker never substitutes a copy compiled for a different instruction set.
+namespace
+{
+inline uint64_t readBigEndian64(uint8_t const * p)
+{
+    return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) | ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+           ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) | ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+}
+
+inline void writeBigEndian64(uint8_t * p, uint64_t x)
+{
+    for (int i = 7; i >= 0; --i)
+    {
+        p[i] = (uint8_t)x;
+        x  >>= 8;
+    }
+}
+
+inline uint64_t rotr(uint64_t x, int n) { return (x >> n) | (x << (64 - n)); }
+inline uint64_t ch(uint64_t x, uint64_t y, uint64_t z) { return z ^ (x & (y ^ z)); }
+inline uint64_t maj(uint64_t x, uint64_t y, uint64_t z) { return (x & y) | (z & (x | y)); }
+inline uint64_t bigSigma0(uint64_t x) { return rotr(x, 28) ^ rotr(x, 34) ^ rotr(x, 39); }
+inline uint64_t bigSigma1(uint64_t x) { return rotr(x, 14) ^ rotr(x, 18) ^ rotr(x, 41); }
+inline uint64_t smallSigma0(uint64_t x) { return rotr(x, 1) ^ rotr(x, 8) ^ (x >> 7); }
+inline uint64_t smallSigma1(uint64_t x) { return rotr(x, 19) ^ rotr(x, 61) ^ (x >> 6); }
+
+// One round of the compression function. Rather than rotating the eight working variables after each round, the caller
+// rotates the arguments.
+inline void round(uint64_t a, uint64_t b, uint64_t c, uint64_t & d, uint64_t e, uint64_t f, uint64_t g, uint64_t & h,
+                  uint64_t wk)
+{
+    uint64_t t1 = h + bigSigma1(e) + ch(e, f, g) + wk;
+    uint64_t t2 = bigSigma0(a) + maj(a, b, c);
+    d += t1;
+    h  = t1 + t2;
+}
+
+// Performs the 80 rounds of the compression function given the message schedule with the round constants already
+// added (wk[t] = W[t] + K[t]).
+inline void compress(uint64_t * state, uint64_t const * wk)
+{
+    uint64_t a = state[0];
+    uint64_t b = state[1];
+    uint64_t c = state[2];
+    uint64_t d = state[3];
+    uint64_t e = state[4];
+    uint64_t f = state[5];
+    uint64_t g = state[6];
+    uint64_t h = state[7];
+
+    for (int t = 0; t < 80; t += 8)
+    {
+        round(a, b, c, d, e, f, g, h, wk[t + 0]);
+        round(h, a, b, c, d, e, f, g, wk[t + 1]);
+        round(g, h, a, b, c, d, e, f, wk[t + 2]);
+        round(f, g, h, a, b, c, d, e, wk[t + 3]);
+        round(e, f, g, h, a, b, c, d, wk[t + 4]);
+        round(d, e, f, g, h, a, b, c, wk[t + 5]);
+        round(c, d, e, f, g, h, a, b, wk[t + 6]);
+        round(b, c, d, e, f, g, h, a, wk[t + 7]);
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+} // anonymous namespace
+} // namespace Sha512Impl
+} // namespace Crypto
@@ -0,0 +1,153 @@
+#pragma once
+
+// Multi-lane SHA-512 compression function shared by the SIMD implementations. This header is not part of the public API.
+//
+// Each lane of a vector holds the state of an independent message. The code is instantiated in each SIMD source file
+// with that file's vector operations, so it is in an anonymous namespace to prevent the linker from substituting a copy
+// compiled for a different instruction set.
+//
+// The vector operations are provided by a class with the following static members:
+//
+//      typedef ... Vector;                                         // A vector of LANES 64-bit words
+//      static int const LANES;                                     // Number of lanes
+//      static Vector load(uint64_t const * p);                     // Loads LANES words
+//      static void   store(uint64_t * p, Vector x);                // Stores LANES words
+//      static Vector set1(uint64_t x);                             // Sets every lane to x
+//      static Vector add(Vector x, Vector y);
+//      static Vector xor2(Vector x, Vector y);
+//      static Vector xor3(Vector x, Vector y, Vector z);
+//      template <int N> static Vector shr(Vector x);
+//      template <int N> static Vector rotr(Vector x);
+//      static Vector ch(Vector x, Vector y, Vector z);
+//      static Vector maj(Vector x, Vector y, Vector z);
+
+#include "Sha512Impl.h"
+
+namespace Crypto
+{
+namespace Sha512Impl
+{
+namespace
+{
+template <typename Ops>
+struct Lanes
+{
+    typedef typename Ops::Vector Vector;
+
+    static Vector bigSigma0(Vector x)
+    {
+        return Ops::xor3(Ops::template rotr<28>(x), Ops::template rotr<34>(x), Ops::template rotr<39>(x));
+    }
+    static Vector bigSigma1(Vector x)
+    {
+        return Ops::xor3(Ops::template rotr<14>(x), Ops::template rotr<18>(x), Ops::template rotr<41>(x));
+    }
+    static Vector smallSigma0(Vector x)
+    {
+        return Ops::xor3(Ops::template rotr<1>(x), Ops::template rotr<8>(x), Ops::template shr<7>(x));
+    }
+    static Vector smallSigma1(Vector x)
+    {
+        return Ops::xor3(Ops::template rotr<19>(x), Ops::template rotr<61>(x), Ops::template shr<6>(x));
+    }
+
+    static void round(Vector a, Vector b, Vector c, Vector & d, Vector e, Vector f, Vector g, Vector & h, Vector wk)
+    {
+        Vector t1 = Ops::add(Ops::add(h, bigSigma1(e)), Ops::add(Ops::ch(e, f, g), wk));
+        Vector t2 = Ops::add(bigSigma0(a), Ops::maj(a, b, c));
+        d = Ops::add(d, t1);
+        h = Ops::add(t1, t2);
+    }
+
+    // Updates the working state s[0..7] with one block per lane given its 16 words. The words are overwritten.
+    static void compress(Vector * s, Vector * w)
+    {
+        Vector a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+
+        for (int t = 0; t < 80; t += 8)
+        {
+            if (t >= 16)
+            {
+                for (int i = t; i < t + 8; ++i)
+                {
+                    w[i & 15] = Ops::add(Ops::add(w[i & 15], smallSigma0(w[(i + 1) & 15])),
+                                         Ops::add(w[(i + 9) & 15], smallSigma1(w[(i + 14) & 15])));
+                }
+            }
+            round(a, b, c, d, e, f, g, h, Ops::add(w[(t + 0) & 15], Ops::set1(K[t + 0])));
+            round(h, a, b, c, d, e, f, g, Ops::add(w[(t + 1) & 15], Ops::set1(K[t + 1])));
+            round(g, h, a, b, c, d, e, f, Ops::add(w[(t + 2) & 15], Ops::set1(K[t + 2])));
+            round(f, g, h, a, b, c, d, e, Ops::add(w[(t + 3) & 15], Ops::set1(K[t + 3])));
+            round(e, f, g, h, a, b, c, d, Ops::add(w[(t + 4) & 15], Ops::set1(K[t + 4])));
+            round(d, e, f, g, h, a, b, c, Ops::add(w[(t + 5) & 15], Ops::set1(K[t + 5])));
+            round(c, d, e, f, g, h, a, b, Ops::add(w[(t + 6) & 15], Ops::set1(K[t + 6])));
+            round(b, c, d, e, f, g, h, a, Ops::add(w[(t + 7) & 15], Ops::set1(K[t + 7])));
+        }
+
+        s[0] = Ops::add(s[0], a);
+        s[1] = Ops::add(s[1], b);
+        s[2] = Ops::add(s[2], c);
+        s[3] = Ops::add(s[3], d);
+        s[4] = Ops::add(s[4], e);
+        s[5] = Ops::add(s[5], f);
+        s[6] = Ops::add(s[6], g);
+        s[7] = Ops::add(s[7], h);
+    }
+
+    // Hashes a 64-byte value (one per lane) starting from the given states, which are those following a 128-byte key
+    // block. The value becomes the first half of the only block, and the padding is the second half.
+    static void hash64(Vector const * state, Vector const * value, Vector * out)
+    {
+        Vector w[16];
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            w[i]   = value[i];
+            out[i] = state[i];
+        }
+        w[8] = Ops::set1(0x8000000000000000);
+        for (int i = 9; i < 15; ++i)
+        {
+            w[i] = Ops::set1(0);
+        }
+        w[15] = Ops::set1((BLOCK_SIZE + 64) * 8);
+        compress(out, w);
+    }
+
+    // Performs iterations 2 .. count of PBKDF2-HMAC-SHA512 for one output block per lane. inner and outer are the HMAC
+    // states after the padded key, and t holds U1 on entry and the output block on return. All are stored word-major
+    // (x[i * LANES + lane]).
+    static void pbkdf2(uint64_t const * inner, uint64_t const * outer, uint64_t * t, int count)
+    {
+        Vector innerState[STATE_SIZE];
+        Vector outerState[STATE_SIZE];
+        Vector u[STATE_SIZE];
+        Vector sum[STATE_SIZE];
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            innerState[i] = Ops::load(inner + i * Ops::LANES);
+            outerState[i] = Ops::load(outer + i * Ops::LANES);
+            u[i]          = Ops::load(t + i * Ops::LANES);
+            sum[i]        = u[i];
+        }
+
+        // U(n) = HMAC(P, U(n-1)), and the output is U1 ^ U2 ^ ... ^ U(count)
+        for (int n = 1; n < count; ++n)
+        {
+            Vector innerHash[STATE_SIZE];
+            hash64(innerState, u, innerHash);
+            hash64(outerState, innerHash, u);
+            for (size_t i = 0; i < STATE_SIZE; ++i)
+            {
+                sum[i] = Ops::xor2(sum[i], u[i]);
+            }
+        }
+
+        for (size_t i = 0; i < STATE_SIZE; ++i)
+        {
+            Ops::store(t + i * Ops::LANES, sum[i]);
+        }
+    }
+};
+} // anonymous namespace
+} // namespace Sha512Impl
+} // namespace Crypto
@@ -0,0 +1,61 @@
+// Portable implementation of the SHA-512 compression function and a single-lane PBKDF2 kernel
+
+#include "Sha512Lanes.h"
+
+namespace
+{
+// Operations for Sha512Impl::Lanes with a single lane
+struct PortableOps
+{
+    typedef uint64_t Vector;
+    static int const LANES = 1;
+
+    static Vector load(uint64_t const * p) { return *p; }
+    static void store(uint64_t * p, Vector x) { *p = x; }
+    static Vector set1(uint64_t x) { return x; }
+    static Vector add(Vector x, Vector y) { return x + y; }
+    static Vector xor2(Vector x, Vector y) { return x ^ y; }
+    static Vector xor3(Vector x, Vector y, Vector z) { return x ^ y ^ z; }
+    template <int N> static Vector shr(Vector x) { return x >> N; }
+    template <int N> static Vector rotr(Vector x) { return (x >> N) | (x << (64 - N)); }
+    static Vector ch(Vector x, Vector y, Vector z) { return z ^ (x & (y ^ z)); }
+    static Vector maj(Vector x, Vector y, Vector z) { return (x & y) | (z & (x | y)); }
+};
+} // anonymous namespace
+
+namespace Crypto
+{
+namespace Sha512Impl
+{
+
+void transformPortable(uint64_t * state, uint8_t const * blocks, size_t n)
+{
+    uint64_t wk[80];
+    while (n-- > 0)
+    {
+        uint64_t w[80];
+        for (int t = 0; t < 16; ++t)
+        {
+            w[t] = readBigEndian64(blocks + 8 * t);
+        }
+        for (int t = 16; t < 80; ++t)
+        {
+            w[t] = smallSigma1(w[t - 2]) + w[t - 7] + smallSigma0(w[t - 15]) + w[t - 16];
+        }
+        for (int t = 0; t < 80; ++t)
+        {
+            wk[t] = w[t] + K[t];
+        }
+
+        compress(state, wk);
+        blocks += BLOCK_SIZE;
+    }
+}
+
+void pbkdf2Portable(uint64_t const * inner, uint64_t const * outer, uint64_t * t, int count)
+{
+    Lanes<PortableOps>::pbkdf2(inner, outer, t, count);
+}
+
+} // namespace Sha512Impl
+} // namespace Crypto
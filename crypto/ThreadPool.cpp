@@ -0,0 +1,129 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace Crypto
+{
+
+ThreadPool::ThreadPool(unsigned threads)
+    : next_(0)
+{
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    workers_.reserve(threads - 1);
+    for (unsigned i = 1; i < threads; ++i)
+    {
+        workers_.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    started_.notify_all();
+    for (auto & worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::run(size_t n, std::function<void(size_t)> const & f)
+{
+    // With no workers or only one call, there is no need to involve the other threads
+    if (workers_.empty() || n <= 1)
+    {
+        std::exception_ptr error;
+        for (size_t i = 0; i < n; ++i)
+        {
+            try
+            {
+                f(i);
+            }
+            catch (...)
+            {
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+        if (error)
+            std::rethrow_exception(error);
+        return;
+    }
+
+    std::lock_guard<std::mutex> serialized(runMutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        f_      = &f;
+        n_      = n;
+        next_   = 0;
+        active_ = (unsigned)workers_.size();
+        error_  = nullptr;
+        ++generation_;
+    }
+    started_.notify_all();
+
+    runCalls();
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_.wait(lock, [this] { return active_ == 0; });
+        f_ = nullptr;
+        std::swap(error, error_);
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+ThreadPool & ThreadPool::shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::work()
+{
+    uint64_t generation = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            started_.wait(lock, [this, generation] { return stopping_ || generation_ != generation; });
+            if (stopping_)
+                return;
+            generation = generation_;
+        }
+
+        runCalls();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--active_ == 0)
+                finished_.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runCalls()
+{
+    size_t i;
+    while ((i = next_.fetch_add(1)) < n_)
+    {
+        try
+        {
+            (*f_)(i);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_)
+                error_ = std::current_exception();
+        }
+    }
+}
+
+} // namespace Crypto
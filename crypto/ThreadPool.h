@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Crypto
+{
+//! @addtogroup CryptoGroup
+//!@{
+
+//! A fixed set of threads that run the iterations of a loop in parallel.
+//!
+//! The calling thread takes part in the work, so a pool of N threads starts N - 1 workers. A pool with a single thread
+//! runs everything in order on the calling thread, which makes the results of a batch operation reproducible.
+class ThreadPool
+{
+public:
+
+    // Constructor
+    //!
+    //! @param  threads     number of threads, including the calling thread (0 means the number of hardware threads)
+    explicit ThreadPool(unsigned threads = 0);
+
+    // Destructor
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const &) = delete;
+    ThreadPool & operator =(ThreadPool const &) = delete;
+
+    //! Calls f(i) for every i in [0, n) and returns when all the calls have returned.
+    //!
+    //! The calls are distributed among the pool's threads in no particular order. If a call throws an exception, the
+    //! remaining calls are still made and the first exception is rethrown.
+    //!
+    //! @param  n   number of calls
+    //! @param  f   function to call
+    //! @note   Concurrent calls to run() are serialized. run() must not be called by f on the same pool.
+    void run(size_t n, std::function<void(size_t)> const & f);
+
+    //! Returns the number of threads, including the calling thread
+    unsigned threads() const { return (unsigned)workers_.size() + 1; }
+
+    //! Returns a pool with one thread per hardware thread, shared by the batch operations of this library.
+    static ThreadPool & shared();
+
+private:
+
+    void work();
+    void runCalls();
+
+    std::vector<std::thread> workers_;
+    std::mutex runMutex_;                               // Serializes calls to run()
+    std::mutex mutex_;                                  // Guards the members below
+    std::condition_variable started_;
+    std::condition_variable finished_;
+    std::function<void(size_t)> const * f_ = nullptr;   // The function being run
+    size_t n_                              = 0;         // Number of calls to make
+    std::atomic<size_t> next_;                          // Next call to make
+    unsigned active_                       = 0;         // Number of workers still working on the current run
+    uint64_t generation_                   = 0;         // Incremented by each run
+    bool stopping_                         = false;
+    std::exception_ptr error_;                          // First exception thrown by a call
+};
+
+//!@}
+} // namespace Crypto
@@ -5,7 +5,6 @@
 #include "PublicKey.h"
 
 #include "crypto/Ripemd.h"
-#include "crypto/Sha256.h"
 
 using namespace Equity;
 using namespace Crypto;
@@ -34,7 +33,7 @@ Address::Address(Crypto::Ripemd160Hash const & k)
 }
 
 Address::Address(PublicKey const & publicKey)
-    : value_(ripemd160(sha256(publicKey.value())))
+    : value_(hash160(publicKey.value()))
     , valid_(true)
 {
 }
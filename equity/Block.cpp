@@ -2,7 +2,11 @@
 
 #include "crypto/Sha256.h"
 #include "p2p/Serialize.h"
+#include "utility/Endian.h"
 #include "utility/Utility.h"
+#include <algorithm>
+#include <cstddef>
+#include <utility>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
@@ -29,6 +33,47 @@ void Block::Header::serialize(std::vector<uint8_t> & out) const
     P2p::serialize(nonce, out);
 }
 
+void Block::Header::serialize(P2p::Sink & out) const
+{
+    P2p::serialize((uint32_t)version, out);
+    P2p::serialize(previousBlock, out);
+    P2p::serialize(merkleRoot, out);
+    P2p::serialize(timestamp, out);
+    P2p::serialize(target, out);
+    P2p::serialize(nonce, out);
+}
+
+Crypto::Sha256Hash Block::Header::hash() const
+{
+    uint8_t serialized[SIZE];
+    P2p::BufferSink sink(serialized, sizeof(serialized));
+    serialize(sink);
+    return Crypto::doubleSha256(serialized, sizeof(serialized));
+}
+
+Block::Header::Midstate Block::Header::midstate() const
+{
+    uint8_t serialized[SIZE];
+    P2p::BufferSink sink(serialized, sizeof(serialized));
+    serialize(sink);
+
+    Midstate midstate;
+    midstate.hasher.update(serialized, Midstate::PREFIX_SIZE);
+    std::copy(serialized + Midstate::PREFIX_SIZE, serialized + SIZE, midstate.tail);
+    return midstate;
+}
+
+Crypto::Sha256Hash Block::Header::hashWith(Midstate const & midstate, uint32_t nonce)
+{
+    uint8_t tail[sizeof(midstate.tail)];
+    std::copy(midstate.tail, midstate.tail + sizeof(tail), tail);
+    Utility::Endian::storeLittle(tail + Midstate::NONCE_OFFSET, nonce);
+
+    Crypto::Sha256Hasher hasher = midstate.hasher;
+    hasher.update(tail, sizeof(tail));
+    return Crypto::sha256(hasher.finalize());
+}
+
 json Block::Header::toJson() const
 {
     return json::object(
@@ -48,16 +93,107 @@ Block::Block(Header const & header, TransactionList const & transactions)
 {
 }
 
-Block::Block(uint8_t const * & in, size_t & size)
+Block::Block(Header const & header, TransactionList && transactions)
+    : header_(header)
+    , transactions_(std::move(transactions))
 {
-    header_       = Header(in, size);
-    transactions_ = P2p::VarArray<Transaction>(in, size).value();
+}
+
+Block::Block(uint8_t const * & in, size_t & size, std::pmr::memory_resource * arena)
+    : transactions_(arena)
+{
+    header_ = Header(in, size);
+
+    // The count is not trusted when reserving space, since every transaction takes at least Transaction::MINIMUM_SIZE
+    // bytes
+    uint64_t n = P2p::VASize(in, size).value();
+    transactions_.reserve((size_t)std::min<uint64_t>(n, size / Transaction::MINIMUM_SIZE));
+    for (uint64_t i = 0; i < n; ++i)
+    {
+        transactions_.emplace_back(in, size, arena);
+    }
 }
 
 void Block::serialize(std::vector<uint8_t> & out) const
+{
+    // A block is large, so the space is reserved once rather than grown as the transactions are added
+    out.reserve(out.size() + serializedSize());
+    P2p::VectorSink sink(out);
+    serialize(sink);
+}
+
+Crypto::Sha256HashList Block::transactionHashes() const
+{
+    // The transactions are serialized one after another into a single buffer and then hashed in place
+    size_t size = 0;
+    for (auto const & transaction : transactions_)
+    {
+        size += transaction.serializedSize();
+    }
+
+    std::vector<uint8_t> serialized;
+    serialized.reserve(size);
+    std::vector<size_t> ends;
+    ends.reserve(transactions_.size());
+    for (auto const & transaction : transactions_)
+    {
+        transaction.serialize(serialized);
+        ends.push_back(serialized.size());
+    }
+
+    std::vector<uint8_t const *> inputs;
+    std::vector<size_t> lengths;
+    inputs.reserve(ends.size());
+    lengths.reserve(ends.size());
+    size_t begin = 0;
+    for (size_t end : ends)
+    {
+        inputs.push_back(serialized.data() + begin);
+        lengths.push_back(end - begin);
+        begin = end;
+    }
+
+    Crypto::Sha256HashList hashes(transactions_.size());
+    Crypto::doubleSha256Batch(inputs.data(), lengths.data(), hashes.size(), hashes.data());
+    return hashes;
+}
+
+void Block::serialize(P2p::Sink & out) const
 {
     P2p::serialize(header_, out);
-    P2p::serialize(P2p::VarArray<Transaction>(transactions_), out);
+    P2p::serialize(P2p::VASize(transactions_.size()), out);
+    for (auto const & transaction : transactions_)
+    {
+        transaction.serialize(out);
+    }
+}
+
+size_t Block::serializedSize() const
+{
+    size_t size = Header::SIZE + P2p::VASize::size(transactions_.size());
+    for (auto const & transaction : transactions_)
+    {
+        size += transaction.serializedSize();
+    }
+    return size;
+}
+
+size_t Block::arenaSize(size_t serializedSize)
+{
+    // The number of elements in a valid list is never more than the limit on the space reserved for it, so every list
+    // is allocated once, at its final size.
+    // Each transaction, input, and output then takes no more memory per serialized byte than the smallest possible one
+    // does. A script takes as much memory as it does serialized bytes, and the list allocated after it can need up to
+    // alignof(T) - 1 bytes of padding, which is charged to the input or output the script belongs to.
+    size_t const TRANSACTION = (sizeof(Transaction) + Transaction::MINIMUM_SIZE - 1) / Transaction::MINIMUM_SIZE;
+    size_t const INPUT       = (sizeof(Transaction::Input) + alignof(Transaction::Input) - 1 +
+                                Transaction::Input::MINIMUM_SIZE - 1) / Transaction::Input::MINIMUM_SIZE;
+    size_t const OUTPUT      = (sizeof(Transaction::Output) + alignof(Transaction::Output) - 1 +
+                                Transaction::Output::MINIMUM_SIZE - 1) / Transaction::Output::MINIMUM_SIZE;
+    size_t const BYTES_PER_BYTE = std::max({ TRANSACTION, INPUT, OUTPUT, (size_t)1 });
+
+    // The first list may also need to be aligned
+    return BYTES_PER_BYTE * serializedSize + alignof(std::max_align_t);
 }
 
 json Block::toJson() const
@@ -65,6 +201,6 @@ json Block::toJson() const
     return json::object(
     {
         { "header", header_.toJson() },
-        { "transactions", P2p::toJson(transactions_) }
+        { "transactions", P2p::toJson(transactions_.data(), transactions_.size()) }
     });
 }
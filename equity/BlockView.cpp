@@ -0,0 +1,55 @@
+#include "BlockView.h"
+
+#include "crypto/Sha256.h"
+#include "p2p/Serialize.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace Equity;
+
+BlockView::BlockView(uint8_t const * & in, size_t & size)
+{
+    uint8_t const * start = in;
+
+    header_ = Block::Header(in, size);
+
+    // The count is not trusted when reserving space, since every transaction takes at least MINIMUM_SIZE bytes
+    uint64_t n = P2p::VASize(in, size).value();
+    transactions_.reserve((size_t)std::min<uint64_t>(n, size / TransactionView::MINIMUM_SIZE));
+    for (uint64_t i = 0; i < n; ++i)
+    {
+        transactions_.emplace_back(in, size);
+    }
+
+    serialized_.data = start;
+    serialized_.size = in - start;
+}
+
+Crypto::Sha256HashList BlockView::transactionHashes() const
+{
+    std::vector<uint8_t const *> inputs;
+    std::vector<size_t> lengths;
+    inputs.reserve(transactions_.size());
+    lengths.reserve(transactions_.size());
+    for (auto const & transaction : transactions_)
+    {
+        inputs.push_back(transaction.serialized().data);
+        lengths.push_back(transaction.serialized().size);
+    }
+
+    Crypto::Sha256HashList hashes(transactions_.size());
+    Crypto::doubleSha256Batch(inputs.data(), lengths.data(), hashes.size(), hashes.data());
+    return hashes;
+}
+
+Block BlockView::toBlock() const
+{
+    TransactionList transactions;
+    transactions.reserve(transactions_.size());
+    for (auto const & transaction : transactions_)
+    {
+        transactions.push_back(transaction.toTransaction());
+    }
+    return Block(header_, std::move(transactions));
+}
@@ -0,0 +1,84 @@
+#include "Miner.h"
+
+#include "Target.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Equity;
+
+namespace
+{
+uint64_t const CHUNK_SIZE = 0x10000;    // Number of nonces claimed by a thread at a time
+}
+
+Miner::Miner(unsigned threads)
+    : threads_(threads)
+    , stopped_(false)
+{
+    if (threads_ == 0)
+        threads_ = std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+Miner::Result Miner::mine(Block::Header const & header, uint32_t first, uint32_t last)
+{
+    Block::Header::Midstate const midstate = header.midstate();
+    Target const target(header.target);
+
+    Result result{ false, 0, Crypto::Sha256Hash(), 0 };
+    std::mutex resultMutex;
+    std::atomic<uint64_t> next(first);
+    std::atomic<uint64_t> hashes(0);
+    std::atomic<bool> found(false);
+    uint64_t const end = (uint64_t)last + 1;
+
+    auto scan = [&] () {
+        while (!found && !stopped_)
+        {
+            uint64_t chunk = next.fetch_add(CHUNK_SIZE);
+            if (chunk >= end)
+                break;
+            uint64_t chunkEnd = std::min(chunk + CHUNK_SIZE, end);
+
+            uint64_t n;
+            for (n = chunk; n < chunkEnd && !found && !stopped_; ++n)
+            {
+                Crypto::Sha256Hash hash = Block::Header::hashWith(midstate, (uint32_t)n);
+                if (hashMeetsTarget(hash, target))
+                {
+                    std::lock_guard<std::mutex> lock(resultMutex);
+                    if (!result.found || (uint32_t)n < result.nonce)
+                    {
+                        result.found = true;
+                        result.nonce = (uint32_t)n;
+                        result.hash  = hash;
+                    }
+                    found = true;
+                    ++n;
+                    break;
+                }
+            }
+            hashes += n - chunk;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < threads_; ++i)
+    {
+        workers.emplace_back(scan);
+    }
+    scan();
+    for (auto & w : workers)
+    {
+        w.join();
+    }
+
+    // The flag is cleared when the search ends rather than when it begins, so that a stop() made before the search
+    // starts is not lost
+    stopped_ = false;
+
+    result.hashes = hashes;
+    return result;
+}
@@ -328,23 +328,57 @@ Mnemonic::Mnemonic(uint8_t const * entropy, size_t size, Language language /* =
 
 std::vector<uint8_t> Mnemonic::seed(char const * password) const
 {
-    if (!valid_)
-    {
-        return std::vector<uint8_t>();
-    }
+    return seeds({ *this }, { password }).front();
+}
+
+std::vector<std::vector<uint8_t>> Mnemonic::seeds(std::vector<Mnemonic> const &    mnemonics,
+                                                  std::vector<std::string> const & passwords)
+{
+    assert(mnemonics.size() == passwords.size());
 
     // To create a binary seed from the mnemonic, we use the PBKDF2 function with a mnemonic sentence(in UTF-8 NFKD) used as the
     // password and the string "mnemonic" + passphrase (again in UTF-8 NFKD) used as the salt. The iteration count is set to 2048
     // and HMAC-SHA512 is used as the pseudo-random function. The length of the derived key is 512 bits(= 64 bytes).
 
-    std::string s = sentence();
-    std::string salt = std::string("mnemonic") + password;
-    return Crypto::pbkdf2HmacSha512(reinterpret_cast<uint8_t const *>(s.data()),
-                                    s.length(),
-                                    reinterpret_cast<uint8_t const *>(salt.data()),
-                                    salt.length(),
-                                    PBKDF2_ROUNDS,
-                                    SEED_SIZE);
+    std::vector<std::vector<uint8_t>> result(mnemonics.size());
+    std::vector<std::string> sentences;
+    std::vector<std::string> salts;
+    std::vector<size_t> valid;
+    for (size_t i = 0; i < mnemonics.size(); ++i)
+    {
+        if (mnemonics[i].isValid())
+        {
+            sentences.push_back(mnemonics[i].sentence());
+            salts.push_back("mnemonic" + passwords[i]);
+            result[i].resize(SEED_SIZE);
+            valid.push_back(i);
+        }
+    }
+
+    size_t n = valid.size();
+    std::vector<uint8_t const *> sentenceData(n);
+    std::vector<size_t> sentenceSizes(n);
+    std::vector<uint8_t const *> saltData(n);
+    std::vector<size_t> saltSizes(n);
+    std::vector<uint8_t *> seedData(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        sentenceData[i]  = reinterpret_cast<uint8_t const *>(sentences[i].data());
+        sentenceSizes[i] = sentences[i].length();
+        saltData[i]      = reinterpret_cast<uint8_t const *>(salts[i].data());
+        saltSizes[i]     = salts[i].length();
+        seedData[i]      = result[valid[i]].data();
+    }
+
+    Crypto::pbkdf2HmacSha512Batch(sentenceData.data(),
+                                  sentenceSizes.data(),
+                                  saltData.data(),
+                                  saltSizes.data(),
+                                  n,
+                                  PBKDF2_ROUNDS,
+                                  SEED_SIZE,
+                                  seedData.data());
+    return result;
 }
 
 std::vector<uint8_t> Mnemonic::entropy() const
@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <stack>
+#include <utility>
 
 using json = nlohmann::json;
 using namespace Equity;
@@ -18,6 +19,12 @@ Script::Script(std::vector<uint8_t> const & data)
     valid_ = parse(data);
 }
 
+Script::Script(std::vector<uint8_t> && data)
+    : data_(std::move(data))
+{
+    valid_ = parse(data_);
+}
+
 void Script::serialize(std::vector<uint8_t> & out) const
 {
     out.insert(out.end(), data_.begin(), data_.end());
@@ -647,7 +647,7 @@ bool ScriptEngine::run(Script const & script)
             }
             case Instruction::OP_HASH160:
             {
-                Crypto::Ripemd160Hash hash = Crypto::ripemd160(Crypto::sha256(*p0));
+                Crypto::Ripemd160Hash hash = Crypto::hash160(*p0);
                 mainStack_.back().assign(hash.begin(), hash.end());
                 break;
             }
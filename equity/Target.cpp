@@ -7,6 +7,7 @@
 #include <cmath>
 
 using namespace Equity;
+using Utility::Uint256;
 
 namespace
 {
@@ -33,74 +34,75 @@ Crypto::Sha256Hash const Target::DIFFICULTY_1 =
 };
 
 Target::Target(Crypto::Sha256Hash const & hash)
-    : hash_(hash)
-    , compact_(convertToCompact(hash))
+    : value_(Uint256::fromBigEndian(hash.data()))
+    , compact_(convertToCompact(value_))
 {
 }
 
 Target::Target(uint32_t compact)
-    : hash_(convertToHash(compact))
+    : value_(convertToValue(compact))
 {
     // @BUG : Assumes that the value is normalized
     compact_ = std::max(compact, TARGET_0_COMPACT);
 }
 
+Target::Target(Uint256 const & value)
+    : value_(value)
+    , compact_(convertToCompact(value))
+{
+}
+
+Target::operator Crypto::Sha256Hash() const
+{
+    Crypto::Sha256Hash hash;
+    value_.toBigEndian(hash.data());
+    return hash;
+}
+
 double Target::difficulty() const
 {
     return toDouble(DIFFICULTY_1_COMPACT) / toDouble(compact_);
 }
 
 Crypto::Sha256Hash Target::convertToHash(uint32_t compact)
+{
+    Crypto::Sha256Hash out;
+    convertToValue(compact).toBigEndian(out.data());
+    return out;
+}
+
+uint32_t Target::convertToCompact(Crypto::Sha256Hash const & hash)
+{
+    return convertToCompact(Uint256::fromBigEndian(hash.data()));
+}
+
+Uint256 Target::convertToValue(uint32_t compact)
 {
     assert((compact & 0x800000) == 0);         // No negative numbers
 
     uint32_t mantissa = extractMantissa(compact);
     int      exponent = extractExponent(compact);
 
-    if ((mantissa & 0x00ff0000) == 0)
-    {
-        mantissa <<= 8;
-        exponent  -= 1;
-    }
-    assert(exponent >= 0 && exponent <= 32);
+    if (exponent <= 3)
+        return Uint256(mantissa >> (8 * (3 - exponent)));
 
-    Crypto::Sha256Hash out;
-    out.fill(0);
-    if (exponent >= 3)
-    {
-        out[Crypto::SHA256_HASH_SIZE + 0 - exponent] = (mantissa >> 16) & 0xff;
-        out[Crypto::SHA256_HASH_SIZE + 1 - exponent] = (mantissa >>  8) & 0xff;
-        out[Crypto::SHA256_HASH_SIZE + 2 - exponent] =         mantissa & 0xff;
-    }
-    else
-    {
-        if (exponent >= 1)
-            out[Crypto::SHA256_HASH_SIZE + 0 - exponent] = (mantissa >> 16) & 0xff;
-        if (exponent >= 2)
-            out[Crypto::SHA256_HASH_SIZE + 1 - exponent] = (mantissa >> 8) & 0xff;
-    }
-
-    return out;
+    Uint256 value = Uint256(mantissa) << (unsigned)(8 * (exponent - 3));
+    assert((value >> (unsigned)(8 * (exponent - 3))) == Uint256(mantissa));    // No overflow
+    return value;
 }
 
-uint32_t Target::convertToCompact(Crypto::Sha256Hash const & hash)
+uint32_t Target::convertToCompact(Uint256 const & value)
 {
-    // Count the number of 0 bytes
-    Crypto::Sha256Hash::const_iterator i = std::find_if_not(hash.begin(), hash.end(), [](uint8_t x) {
-                                                                return x == 0;
-                                                            });
-    size_t zeros = std::distance(hash.begin(), i);
-
-    if (zeros == Crypto::SHA256_HASH_SIZE)
+    if (value.isZero())
         return TARGET_0_COMPACT;
 
-    // Get the mantissa
-    uint32_t m0 = (zeros <= Crypto::SHA256_HASH_SIZE - 1) ? hash[zeros + 0] : 0;
-    uint32_t m1 = (zeros <= Crypto::SHA256_HASH_SIZE - 2) ? hash[zeros + 1] : 0;
-    uint32_t m2 = (zeros <= Crypto::SHA256_HASH_SIZE - 3) ? hash[zeros + 2] : 0;
-    uint32_t mantissa = (m0 << 16) | (m1 << 8) | m2;
-
-    int exponent = (int)Crypto::SHA256_HASH_SIZE - (int)zeros;
+    // The exponent is the size of the value in bytes, and the mantissa is its 3 most significant bytes
+    int      exponent = (value.bits() + 7) / 8;
+    uint32_t mantissa;
+    if (exponent <= 3)
+        mantissa = (uint32_t)(value.limb(0) << (8 * (3 - exponent)));
+    else
+        mantissa = (uint32_t)(value >> (unsigned)(8 * (exponent - 3))).limb(0);
 
     // Mantissa is signed, so adjust if mantissa >= 0x800000
     if (mantissa >= 0x800000)
@@ -117,5 +119,23 @@ double Target::toDouble(uint32_t compact)
 {
     int mantissa = extractMantissa(compact);
     int exponent = extractExponent(compact);
-    return double(mantissa) * pow(256.0, exponent - 3);
+    return std::ldexp(double(mantissa), 8 * (exponent - 3));
+}
+
+bool Equity::hashMeetsTarget(Crypto::Sha256Hash const & hash, Target const & target)
+{
+    // The hash is a little-endian number
+    return Uint256::fromLittleEndian(hash.data()) <= target.value();
+}
+
+Uint256 Equity::workFromTarget(Target const & target)
+{
+    // 2^256 does not fit, but 2^256 / (t + 1) = (2^256 - t - 1) / (t + 1) + 1 = ~t / (t + 1) + 1
+    Uint256 const & t = target.value();
+    if (t.isZero())
+        return Uint256();
+    Uint256 divisor = t + 1;
+    if (divisor.isZero())
+        return Uint256(1);  // t + 1 = 2^256
+    return ~t / divisor + 1;
 }
@@ -1,28 +1,49 @@
 #include "Transaction.h"
 
+#include "crypto/Sha256.h"
 #include "equity/Script.h"
 #include "p2p/Serialize.h"
 #include "utility/Endian.h"
 #include "utility/Utility.h"
 
+#include <algorithm>
 #include <nlohmann/json.hpp>
+#include <utility>
 
 using json = nlohmann::json;
 using namespace Equity;
 
+namespace
+{
+// Deserializes a script into a vector that has already been given its memory resource
+void deserializeScript(uint8_t const * & in, size_t & size, std::pmr::vector<uint8_t> & script)
+{
+    P2p::ByteSpan bytes = P2p::deserializeByteSpan(in, size);
+    script.assign(bytes.begin(), bytes.end());
+}
+
+// Returns the script as an std::vector, which is what Script takes
+std::vector<uint8_t> toVector(std::pmr::vector<uint8_t> const & script)
+{
+    return std::vector<uint8_t>(script.begin(), script.end());
+}
+} // anonymous namespace
+
 Equity::Transaction::Input::Input(json const & json)
     : txid(json["txid"])
     , outputIndex(json["outputIndex"])
-    , script(Utility::fromHex(json["script"].get<std::string>()))
     , sequence(json["sequence"])
 {
+    std::vector<uint8_t> bytes = Utility::fromHex(json["script"].get<std::string>());
+    script.assign(bytes.begin(), bytes.end());
 }
 
-Transaction::Input::Input(uint8_t const * & in, size_t & size)
+Transaction::Input::Input(uint8_t const * & in, size_t & size, std::pmr::memory_resource * arena)
+    : script(arena)
 {
     txid        = Txid(in, size);
     outputIndex = P2p::deserialize<uint32_t>(in, size);
-    script      = P2p::VarArray<uint8_t>(in, size).value();
+    deserializeScript(in, size, script);
     sequence    = P2p::deserialize<uint32_t>(in, size);
 }
 
@@ -30,31 +51,61 @@ void Transaction::Input::serialize(std::vector<uint8_t> & out) const
 {
     P2p::serialize(txid, out);
     P2p::serialize(outputIndex, out);
-    P2p::VarArray<uint8_t>(script).serialize(out);
+    P2p::serialize(P2p::VASize(script.size()), out);
+    out.insert(out.end(), script.begin(), script.end());
+    P2p::serialize(sequence, out);
+}
+
+void Transaction::Input::serialize(P2p::Sink & out) const
+{
+    P2p::serialize(txid, out);
+    P2p::serialize(outputIndex, out);
+    P2p::serialize(P2p::VASize(script.size()), out);
+    out.write(script.data(), script.size());
     P2p::serialize(sequence, out);
 }
 
+size_t Transaction::Input::serializedSize() const
+{
+    return Crypto::SHA256_HASH_SIZE + sizeof(outputIndex) + P2p::VASize::size(script.size()) + script.size() +
+           sizeof(sequence);
+}
+
 json Transaction::Input::toJson() const
 {
     return json::object(
     {
         { "txid", txid.toJson() },
         { "outputIndex", outputIndex },
-        { "script", Script(script).toJson() },
+        { "script", Script(toVector(script)).toJson() },
         { "sequence", sequence }
     });
 }
 
-Transaction::Output::Output(uint8_t const * & in, size_t & size)
+Transaction::Output::Output(uint8_t const * & in, size_t & size, std::pmr::memory_resource * arena)
+    : script(arena)
 {
-    value  = P2p::deserialize<uint64_t>(in, size);
-    script = P2p::VarArray<uint8_t>(in, size).value();
+    value = P2p::deserialize<uint64_t>(in, size);
+    deserializeScript(in, size, script);
 }
 
 void Transaction::Output::serialize(std::vector<uint8_t> & out) const
 {
     P2p::serialize(value, out);
-    P2p::serialize(P2p::VarArray<uint8_t>(script), out);
+    P2p::serialize(P2p::VASize(script.size()), out);
+    out.insert(out.end(), script.begin(), script.end());
+}
+
+void Transaction::Output::serialize(P2p::Sink & out) const
+{
+    P2p::serialize(value, out);
+    P2p::serialize(P2p::VASize(script.size()), out);
+    out.write(script.data(), script.size());
+}
+
+size_t Transaction::Output::serializedSize() const
+{
+    return sizeof(value) + P2p::VASize::size(script.size()) + script.size();
 }
 
 json Transaction::Output::toJson() const
@@ -62,7 +113,7 @@ json Transaction::Output::toJson() const
     return json::object(
     {
         { "value", (double)value },
-        { "script", Script(script).toJson() }
+        { "script", Script(toVector(script)).toJson() }
     });
 }
 
@@ -75,16 +126,40 @@ Transaction::Transaction(int version, InputList const & inputs, OutputList const
 {
 }
 
-Transaction::Transaction(uint8_t const * & in, size_t & size)
-    : valid_(false)
+Transaction::Transaction(int version, InputList && inputs, OutputList && outputs, uint32_t lockTime)
+    : version_(version)
+    , inputs_(std::move(inputs))
+    , outputs_(std::move(outputs))
+    , lockTime_(lockTime)
+    , valid_(true)
+{
+}
+
+Transaction::Transaction(uint8_t const * & in, size_t & size, std::pmr::memory_resource * arena)
+    : inputs_(arena)
+    , outputs_(arena)
+    , valid_(false)
 {
     version_ = Utility::Endian::little(P2p::deserialize<uint32_t>(in, size));
     // Only version 1 is valid now.
     if (version_ != 1)
         throw P2p::DeserializationError();
 
-    inputs_   = P2p::VarArray<Input>(in, size).value();
-    outputs_  = P2p::VarArray<Output>(in, size).value();
+    // The inputs and outputs are constructed in place with the arena, so their scripts are allocated from it too
+    uint64_t nInputs = P2p::VASize(in, size).value();
+    inputs_.reserve((size_t)std::min<uint64_t>(nInputs, size / Input::MINIMUM_SIZE));
+    for (uint64_t i = 0; i < nInputs; ++i)
+    {
+        inputs_.emplace_back(in, size, arena);
+    }
+
+    uint64_t nOutputs = P2p::VASize(in, size).value();
+    outputs_.reserve((size_t)std::min<uint64_t>(nOutputs, size / Output::MINIMUM_SIZE));
+    for (uint64_t i = 0; i < nOutputs; ++i)
+    {
+        outputs_.emplace_back(in, size, arena);
+    }
+
     lockTime_ = Utility::Endian::little(P2p::deserialize<uint32_t>(in, size));
 
     valid_ = true;
@@ -97,19 +172,59 @@ Transaction::Transaction(std::string const & json)
 
 void Transaction::serialize(std::vector<uint8_t> & out) const
 {
+    // Serialized through the sink, which writes the inputs and outputs without copying them into VarArrays
+    P2p::VectorSink sink(out);
+    serialize(sink);
+}
+
+void Transaction::serialize(P2p::Sink & out) const
+{
+    // The arrays are written directly rather than through VarArray, which would copy them
     P2p::serialize(Utility::Endian::little(version_), out);
-    P2p::serialize(P2p::VarArray<Input>(inputs_), out);
-    P2p::serialize(P2p::VarArray<Output>(outputs_), out);
+    P2p::serialize(P2p::VASize(inputs_.size()), out);
+    for (auto const & input : inputs_)
+    {
+        input.serialize(out);
+    }
+    P2p::serialize(P2p::VASize(outputs_.size()), out);
+    for (auto const & output : outputs_)
+    {
+        output.serialize(out);
+    }
     P2p::serialize(Utility::Endian::little(lockTime_), out);
 }
 
+size_t Transaction::serializedSize() const
+{
+    size_t size = sizeof(version_) + P2p::VASize::size(inputs_.size()) + P2p::VASize::size(outputs_.size()) +
+                  sizeof(lockTime_);
+    for (auto const & input : inputs_)
+    {
+        size += input.serializedSize();
+    }
+    for (auto const & output : outputs_)
+    {
+        size += output.serializedSize();
+    }
+    return size;
+}
+
+Crypto::Sha256Hash Transaction::hash() const
+{
+    // The transaction is hashed as it is serialized, without a buffer
+    Crypto::Sha256Hasher hasher;
+    P2p::Sha256Sink sink(hasher);
+    serialize(sink);
+    return Crypto::sha256(hasher.finalize());
+}
+
 json Transaction::toJson() const
 {
     return json::object(
     {
         { "version", version_ },
-        { "inputs", P2p::toJson(inputs_) },
-        { "outputs", P2p::toJson(outputs_) },
+        { "inputs", P2p::toJson(inputs_.data(), inputs_.size()) },
+        { "outputs", P2p::toJson(outputs_.data(), outputs_.size()) },
         { "locktime", lockTime_ }
     });
 }
@@ -0,0 +1,107 @@
+#include "TransactionView.h"
+
+#include "crypto/Sha256.h"
+#include "p2p/Serialize.h"
+#include "utility/Endian.h"
+
+#include <utility>
+
+using namespace Equity;
+
+namespace
+{
+// Checks a serialized array of n elements of type T and returns its span. The elements are deserialized, but they do
+// not allocate, so this does not allocate.
+template <typename T>
+P2p::ByteSpan checkArray(uint64_t n, uint8_t const * & in, size_t & size)
+{
+    P2p::ByteSpan span;
+    span.data = in;
+    for (uint64_t i = 0; i < n; ++i)
+    {
+        T(in, size);
+    }
+    span.size = in - span.data;
+    return span;
+}
+} // anonymous namespace
+
+TransactionView::Input::Input(uint8_t const * & in, size_t & size)
+{
+    if (size < Crypto::SHA256_HASH_SIZE)
+        throw P2p::DeserializationError();
+    txid  = in;
+    in   += Crypto::SHA256_HASH_SIZE;
+    size -= Crypto::SHA256_HASH_SIZE;
+
+    outputIndex = P2p::deserialize<uint32_t>(in, size);
+    script      = P2p::deserializeByteSpan(in, size);
+    sequence    = P2p::deserialize<uint32_t>(in, size);
+}
+
+Transaction::Input TransactionView::Input::toInput() const
+{
+    uint8_t const * p = txid;
+    size_t n = Crypto::SHA256_HASH_SIZE;
+
+    Transaction::Input input;
+    input.txid        = Txid(p, n);
+    input.outputIndex = outputIndex;
+    input.script.assign(script.begin(), script.end());
+    input.sequence    = sequence;
+    return input;
+}
+
+TransactionView::Output::Output(uint8_t const * & in, size_t & size)
+{
+    value  = P2p::deserialize<uint64_t>(in, size);
+    script = P2p::deserializeByteSpan(in, size);
+}
+
+Transaction::Output TransactionView::Output::toOutput() const
+{
+    Transaction::Output output;
+    output.value  = value;
+    output.script.assign(script.begin(), script.end());
+    return output;
+}
+
+TransactionView::TransactionView(uint8_t const * & in, size_t & size)
+{
+    uint8_t const * start = in;
+
+    version_ = Utility::Endian::little(P2p::deserialize<uint32_t>(in, size));
+    // Only version 1 is valid now (see Transaction).
+    if (version_ != 1)
+        throw P2p::DeserializationError();
+
+    uint64_t nInputs = P2p::VASize(in, size).value();
+    inputs_ = InputRange(checkArray<Input>(nInputs, in, size), (size_t)nInputs);
+
+    uint64_t nOutputs = P2p::VASize(in, size).value();
+    outputs_ = OutputRange(checkArray<Output>(nOutputs, in, size), (size_t)nOutputs);
+
+    lockTime_ = Utility::Endian::little(P2p::deserialize<uint32_t>(in, size));
+
+    serialized_.data = start;
+    serialized_.size = in - start;
+}
+
+Transaction TransactionView::toTransaction() const
+{
+    Transaction::InputList inputs;
+    inputs.reserve(inputs_.size());
+    for (auto const & input : inputs_)
+    {
+        inputs.push_back(input.toInput());
+    }
+
+    Transaction::OutputList outputs;
+    outputs.reserve(outputs_.size());
+    for (auto const & output : outputs_)
+    {
+        outputs.push_back(output.toOutput());
+    }
+
+    return Transaction(version_, std::move(inputs), std::move(outputs), lockTime_);
+}
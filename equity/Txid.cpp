@@ -33,6 +33,13 @@ void Txid::serialize(std::vector<uint8_t> & out) const
                                                             // little-endian.
 }
 
+void Txid::serialize(P2p::Sink & out) const
+{
+    uint8_t reversed[Crypto::SHA256_HASH_SIZE];
+    std::reverse_copy(hash_.begin(), hash_.end(), reversed);
+    out.write(reversed, sizeof(reversed));
+}
+
 json Txid::toJson() const
 {
     return P2p::toJson(hash_);
@@ -4,6 +4,7 @@
 #include "equity/Transaction.h"
 #include "p2p/Serialize.h"
 #include <cstdint>
+#include <memory_resource>
 #include <nlohmann/json_fwd.hpp>
 #include <string>
 #include <vector>
@@ -16,6 +17,10 @@ namespace Equity
 //! A block in the block chain.
 //!
 //! A Block contains a list of validated transactions and information about its inclusion in the block chain
+//!
+//! A block can be deserialized into an arena, such as an std::pmr::monotonic_buffer_resource, so that its transactions
+//! and their lists and scripts are allocated from a few large blocks of memory and freed all at once instead of one at
+//! a time. If an arena is used, the block must not outlive it.
 class Block : public P2p::Serializable
 {
 public:
@@ -27,6 +32,8 @@ public:
 
     struct Header : public P2p::Serializable
     {
+        static size_t constexpr SIZE = 80;  //!< Size of a serialized header in bytes
+
         int32_t version;                    //!< Block version information, based upon the software version creating this block
         Crypto::Sha256Hash previousBlock;   //!< The hash value of the previous block this particular block references
         Crypto::Sha256Hash merkleRoot;      //!< The reference to a Merkle tree collection which is a hash of all transactions
@@ -47,9 +54,36 @@ public:
         //! @name Overrides Serializable
         //!@{
         virtual void           serialize(std::vector<uint8_t> & out) const override;
+        virtual void           serialize(P2p::Sink & out) const override;
+        virtual size_t         serializedSize() const override { return SIZE; }
         virtual nlohmann::json toJson() const override;
 
         //!@}
+
+        //! The SHA-256 state after the first 64 bytes of a serialized header, and the remaining bytes.
+        //!
+        //! The first 64 bytes do not include the timestamp, target, or nonce, so a header that differs only in its nonce
+        //! can be hashed from a midstate with two SHA-256 blocks instead of three (see hashWith()).
+        struct Midstate
+        {
+            static size_t constexpr PREFIX_SIZE = 64;               //!< Number of bytes hashed into the state
+            static size_t constexpr NONCE_OFFSET = 12;              //!< Offset of the nonce in the remaining bytes
+
+            Crypto::Sha256Hasher hasher;                            //!< State after the first PREFIX_SIZE bytes
+            uint8_t tail[SIZE - PREFIX_SIZE];                       //!< The remaining bytes
+        };
+
+        //! Returns the hash of the header (double-SHA-256, internal byte order).
+        Crypto::Sha256Hash hash() const;
+
+        //! Returns the midstate of the header, for hashing it repeatedly with different nonces.
+        Midstate midstate() const;
+
+        //! Returns the hash of a header with a different nonce (double-SHA-256, internal byte order).
+        //!
+        //! @param  midstate    midstate of the header (see midstate())
+        //! @param  nonce       nonce to use instead of the header's
+        static Crypto::Sha256Hash hashWith(Midstate const & midstate, uint32_t nonce);
     };
 
     // Constructor
@@ -61,24 +95,51 @@ public:
     //! @param  transactions    transactions included in the block
     Block(Header const & header, TransactionList const & transactions);
 
+    // Constructor
+    //!
+    //! @param  header          block header
+    //! @param  transactions    transactions included in the block (moved)
+    Block(Header const & header, TransactionList && transactions);
+
     // Deserialization constructor
     //!
     //! @param[in,out]  in      pointer to the next byte to deserialize
     //! @param[in,out]  size    number of bytes remaining in the serialized stream
-    Block(uint8_t const * & in, size_t & size);
+    //! @param          arena   memory for the transactions
+    Block(uint8_t const * &           in,
+          size_t &                    size,
+          std::pmr::memory_resource * arena = std::pmr::get_default_resource());
 
     //! @name Overrides Serializable
     //!@{
     virtual void           serialize(std::vector<uint8_t> & out) const override;
+    virtual void           serialize(P2p::Sink & out) const override;
+    virtual size_t         serializedSize() const override;
     virtual nlohmann::json toJson() const override;
 
     //!@}
 
     //! Returns the header
-    Header header() const { return header_; }
+    Header const & header() const { return header_; }
 
     //! Returns a list of transactions in the block
-    TransactionList transactions() const { return transactions_; }
+    TransactionList const & transactions() const { return transactions_; }
+
+    //! Returns the hashes of the transactions in the block.
+    //!
+    //! The transactions are hashed together in SIMD lanes, so this is much faster than calling Transaction::hash() for
+    //! each one.
+    //! The hashes are in internal byte order.
+    Crypto::Sha256HashList transactionHashes() const;
+
+    //! Returns a size of arena that is large enough to deserialize any valid block of the given size.
+    //!
+    //! The size is an upper bound, which is several times the size of a typical block. An arena of this size with no
+    //! upstream resource never runs out for a valid block, but a smaller arena with a growing upstream resource
+    //! wastes less memory.
+    //!
+    //! @param  serializedSize  size of the serialized block
+    static size_t arenaSize(size_t serializedSize);
 
 private:
 
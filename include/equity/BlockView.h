@@ -0,0 +1,64 @@
+#pragma once
+
+#include "crypto/Sha256.h"
+#include "equity/Block.h"
+#include "equity/TransactionView.h"
+#include "p2p/Serialize.h"
+#include <cstdint>
+#include <vector>
+
+namespace Equity
+{
+//! @addtogroup EquityGroup
+//!@{
+
+//! A read-only view of a serialized block.
+//!
+//! The header is decoded, but the transactions are TransactionViews of the serialized bytes. The only allocation is
+//! the list of transaction views.
+//!
+//! @note   The buffer must outlive the view.
+class BlockView
+{
+public:
+
+    //! A list of transaction views
+    typedef std::vector<TransactionView> TransactionViewList;
+
+    // Constructor
+    BlockView() {}
+
+    // Deserialization constructor
+    //!
+    //! @param[in,out]  in      pointer to the next byte to deserialize
+    //! @param[in,out]  size    number of bytes remaining in the serialized stream
+    //!
+    //! @exception  P2p::DeserializationError   the block is not well-formed
+    BlockView(uint8_t const * & in, size_t & size);
+
+    //! Returns the header
+    Block::Header const & header() const { return header_; }
+
+    //! Returns the transactions
+    TransactionViewList const & transactions() const { return transactions_; }
+
+    //! Returns the serialized block
+    P2p::ByteSpan serialized() const { return serialized_; }
+
+    //! Returns the hashes of the transactions in the block (see Block::transactionHashes()).
+    //!
+    //! The transactions are hashed together in SIMD lanes, in place, without being serialized again.
+    Crypto::Sha256HashList transactionHashes() const;
+
+    //! Returns a copy of the block
+    Block toBlock() const;
+
+private:
+
+    Block::Header header_;
+    TransactionViewList transactions_;
+    P2p::ByteSpan serialized_;
+};
+
+//!@}
+} // namespace Equity
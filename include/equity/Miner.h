@@ -0,0 +1,58 @@
+#pragma once
+
+#include "crypto/Sha256.h"
+#include "equity/Block.h"
+#include <atomic>
+#include <cstdint>
+
+namespace Equity
+{
+//! @addtogroup EquityGroup
+//!@{
+
+//! Searches for a nonce that gives a block header a hash meeting its target.
+//!
+//! The nonce range is divided into chunks that are scanned by a number of threads. The midstate of the header is
+//! computed once (see Block::Header::midstate()), so each nonce costs two SHA-256 blocks.
+class Miner
+{
+public:
+
+    //! The result of a search
+    struct Result
+    {
+        bool found;                 //!< True if a nonce was found
+        uint32_t nonce;             //!< The nonce, if found
+        Crypto::Sha256Hash hash;    //!< The hash of the header with the nonce (internal byte order), if found
+        uint64_t hashes;            //!< The number of hashes computed
+    };
+
+    // Constructor
+    //!
+    //! @param  threads     number of threads to use (0 means the number of hardware threads)
+    explicit Miner(unsigned threads = 0);
+
+    //! Searches for a nonce in the range [first, last] that gives the header a hash meeting its target.
+    //!
+    //! The search ends when a nonce is found, the range is exhausted, or stop() is called. If more than one thread is
+    //! used, the nonce found is not necessarily the lowest in the range that meets the target.
+    //!
+    //! @param  header  header to mine (its nonce is ignored)
+    //! @param  first   first nonce to try
+    //! @param  last    last nonce to try
+    Result mine(Block::Header const & header, uint32_t first = 0, uint32_t last = UINT32_MAX);
+
+    //! Stops a search in progress. If no search is in progress, the next one stops immediately.
+    void stop() { stopped_ = true; }
+
+    //! Returns the number of threads used
+    unsigned threads() const { return threads_; }
+
+private:
+
+    unsigned threads_;
+    std::atomic<bool> stopped_;
+};
+
+//!@}
+} // namespace Equity
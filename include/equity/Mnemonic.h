@@ -64,6 +64,16 @@ public:
     //! @return     A 512-bit seed value
     std::vector<uint8_t> seed(char const * password = "") const;
 
+    //! Returns the 512-bit seeds of several mnemonics.
+    //!
+    //! The seeds are computed together, which is much faster than calling seed() for each mnemonic.
+    //!
+    //! @param  mnemonics   mnemonics
+    //! @param  passwords   password for each mnemonic
+    //! @return     The seed of each mnemonic, or an empty vector if the mnemonic is not valid
+    static std::vector<std::vector<uint8_t>> seeds(std::vector<Mnemonic> const &    mnemonics,
+                                                   std::vector<std::string> const & passwords);
+
     //! Returns the original entropy data used to generate the mnemonic.
     std::vector<uint8_t> entropy() const;
 
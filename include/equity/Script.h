@@ -23,6 +23,10 @@ public:
     //! @param      data    script in raw form
     Script(std::vector<uint8_t> const & data);
 
+    // Constructor
+    //! @param      data    script in raw form (moved)
+    Script(std::vector<uint8_t> && data);
+
     //! @name Overrides Serializable
     //!@{
     virtual void           serialize(std::vector<uint8_t> & out) const override;
@@ -37,10 +41,10 @@ public:
     bool valid() const { return valid_; }
 
     //! Returns the script in raw form
-    std::vector<uint8_t> data() const { return data_; }
+    std::vector<uint8_t> const & data() const { return data_; }
 
     //! Returns the parsed script
-    Program instructions() const { return instructions_; }
+    Program const & instructions() const { return instructions_; }
 
 private:
 
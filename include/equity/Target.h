@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "crypto/Sha256.h"
+#include "utility/Uint256.h"
 
 namespace Equity
 {
@@ -39,12 +40,20 @@ public:
     //! @param compact  target in compact form
     explicit Target(uint32_t compact);
 
+    // Constructor
+    //!
+    //! @param  value   target value
+    explicit Target(Utility::Uint256 const & value);
+
     //! Returns the hash form
-    operator Crypto::Sha256Hash() const { return hash_; }
+    operator Crypto::Sha256Hash() const;
 
     //! Returns the compact form
     operator uint32_t() const { return compact_; }
 
+    //! Returns the value
+    Utility::Uint256 const & value() const { return value_; }
+
     //! Returns the associated difficulty value
     double difficulty() const;
 
@@ -54,27 +63,45 @@ public:
     //! Computes the compact form based on the hash form
     static uint32_t convertToCompact(Crypto::Sha256Hash const & hash);
 
+    //! Computes the value based on the compact form
+    static Utility::Uint256 convertToValue(uint32_t compact);
+
+    //! Computes the compact form based on the value
+    static uint32_t convertToCompact(Utility::Uint256 const & value);
+
 private:
 
     static double toDouble(uint32_t compact);
 
-    Crypto::Sha256Hash hash_;
+    Utility::Uint256 value_;
     uint32_t compact_;
 };
 
 //! Less-than operator overload for Target
 inline bool operator <(Target const & a, Target const b)
 {
-    // @BUG : Assumes that the compact form is normalized
-    return uint32_t(a) < uint32_t(b);
+    return a.value() < b.value();
 }
 
 //! Less-than-or-equal operator overload for Target
 inline bool operator <=(Target const & a, Target const b)
 {
-    // @BUG : Assumes that the compact form is normalized
     return !(b < a);
 }
 
+//! Returns true if a block hash meets a target, i.e., the hash is less than or equal to the target.
+//!
+//! @param  hash    block hash in internal byte order (as returned by Block::Header::hash())
+//! @param  target  target
+bool hashMeetsTarget(Crypto::Sha256Hash const & hash, Target const & target);
+
+//! Returns the expected number of hashes needed to find a block hash that meets a target, 2^256 / (target + 1).
+//!
+//! The chainwork of a chain is the sum of the work of its blocks' targets.
+//!
+//! @param  target  target
+//! @return the amount of work, or 0 if the target is 0
+Utility::Uint256 workFromTarget(Target const & target);
+
 //!@}
 } // namespace Equity
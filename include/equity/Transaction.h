@@ -4,6 +4,7 @@
 #include "p2p/Serialize.h"
 #include "Txid.h"
 #include <cstdint>
+#include <memory_resource>
 #include <nlohmann/json_fwd.hpp>
 #include <vector>
 
@@ -15,6 +16,10 @@ namespace Equity
 //! A Bitcoin transaction.
 //!
 //! A Bitcoin transaction moves bitcoins from outputs of other transactions to new outputs.
+//!
+//! The lists and scripts of a transaction use polymorphic allocators. Normally, they are allocated from the heap, but a
+//! transaction can be deserialized into an arena (see Block). Copying a transaction always allocates the copy from the
+//! heap.
 class Transaction : public P2p::Serializable
 {
 public:
@@ -28,13 +33,19 @@ public:
         TYPE_Other
     };
 
+    //! Size of the smallest possible serialized transaction (one with no inputs and no outputs)
+    static size_t constexpr MINIMUM_SIZE = 4 + 1 + 1 + 4;
+
     //! A transaction input
     struct Input : public P2p::Serializable
     {
-        Txid txid;                      //!< Source transaction
-        uint32_t outputIndex;           //!< Source transaction output index
-        std::vector<uint8_t> script;    //!< Input script
-        uint32_t sequence;              //!< Sequence number
+        //! Size of the smallest possible serialized input (one with an empty script)
+        static size_t constexpr MINIMUM_SIZE = Crypto::SHA256_HASH_SIZE + 4 + 1 + 4;
+
+        Txid txid;                          //!< Source transaction
+        uint32_t outputIndex;               //!< Source transaction output index
+        std::pmr::vector<uint8_t> script;   //!< Input script
+        uint32_t sequence;                  //!< Sequence number
 
         // Constructor
         Input()
@@ -50,24 +61,32 @@ public:
         //!
         //! @param[in,out]  in      pointer to the next byte to deserialize
         //! @param[in,out]  size    number of bytes remaining in the serialized stream
-        Input(uint8_t const * & in, size_t & size);
+        //! @param          arena   memory for the script
+        Input(uint8_t const * &           in,
+              size_t &                    size,
+              std::pmr::memory_resource * arena = std::pmr::get_default_resource());
 
         //! @name Overrides Serializable
         //!@{
         virtual void           serialize(std::vector<uint8_t> & out) const override;
+        virtual void           serialize(P2p::Sink & out) const override;
+        virtual size_t         serializedSize() const override;
         virtual nlohmann::json toJson() const override;
 
         //!@}
     };
 
     //! A list of transactions inputs
-    typedef std::vector<Input> InputList;
+    typedef std::pmr::vector<Input> InputList;
 
     //! A transaction output
     struct Output : public P2p::Serializable
     {
-        uint64_t value;                 //!< Value of the output in satoshis
-        std::vector<uint8_t> script;    //!< Output script
+        //! Size of the smallest possible serialized output (one with an empty script)
+        static size_t constexpr MINIMUM_SIZE = 8 + 1;
+
+        uint64_t value;                     //!< Value of the output in satoshis
+        std::pmr::vector<uint8_t> script;   //!< Output script
 
         // Constructor
         Output() {}
@@ -80,18 +99,23 @@ public:
         //!
         //! @param[in,out]  in      pointer to the next byte to deserialize
         //! @param[in,out]  size    number of bytes remaining in the serialized stream
-        Output(uint8_t const * & in, size_t & size);
+        //! @param          arena   memory for the script
+        Output(uint8_t const * &           in,
+               size_t &                    size,
+               std::pmr::memory_resource * arena = std::pmr::get_default_resource());
 
         //! @name Overrides Serializable
         //!@{
         virtual void           serialize(std::vector<uint8_t> & out) const override;
+        virtual void           serialize(P2p::Sink & out) const override;
+        virtual size_t         serializedSize() const override;
         virtual nlohmann::json toJson() const override;
 
         //!@}
     };
 
     //! A list of outputs
-    typedef std::vector<Output> OutputList;
+    typedef std::pmr::vector<Output> OutputList;
 
     // Constructor
     //! @param  version     version
@@ -100,6 +124,13 @@ public:
     //! @param  lockTime    locktime value
     Transaction(int version, InputList const & inputs, OutputList const & outputs, uint32_t lockTime);
 
+    // Constructor
+    //! @param  version     version
+    //! @param  inputs      list of inputs (moved)
+    //! @param  outputs     list of outputs (moved)
+    //! @param  lockTime    locktime value
+    Transaction(int version, InputList && inputs, OutputList && outputs, uint32_t lockTime);
+
     // Constructor
     //! @param  json    transaction in JSON form
     Transaction(std::string const & json);
@@ -108,11 +139,16 @@ public:
     //!
     //! @param[in,out]  in      pointer to the next byte to deserialize
     //! @param[in,out]  size    number of bytes remaining in the serialized stream
-    Transaction(uint8_t const * & in, size_t & size);
+    //! @param          arena   memory for the lists of inputs and outputs and their scripts
+    Transaction(uint8_t const * &           in,
+                size_t &                    size,
+                std::pmr::memory_resource * arena = std::pmr::get_default_resource());
 
     //! @name Overrides Serializable
     //!@{
     virtual void           serialize(std::vector<uint8_t> & out) const override;
+    virtual void           serialize(P2p::Sink & out) const override;
+    virtual size_t         serializedSize() const override;
     virtual nlohmann::json toJson() const override;
 
     //!@}
@@ -121,10 +157,10 @@ public:
     uint32_t version() const { return version_; }
 
     //! Returns the transaction's inputs
-    InputList inputs() const { return inputs_; }
+    InputList const & inputs() const { return inputs_; }
 
     //! Returns the transaction's outputs
-    OutputList outputs() const { return outputs_; }
+    OutputList const & outputs() const { return outputs_; }
 
     //! Returns the locktime value
     uint32_t lockTime() const { return lockTime_; }
@@ -132,6 +168,12 @@ public:
     //! Returns true if the transaction is well-formed
     bool valid() const { return valid_; }
 
+    //! Returns the double-SHA-256 hash of the serialized transaction.
+    //!
+    //! @note   The hash is in internal byte order, which is the reverse of the txid as it is normally displayed.
+    //! @sa     Block::transactionHashes
+    Crypto::Sha256Hash hash() const;
+
 private:
 
     uint32_t version_;
@@ -142,7 +184,7 @@ private:
 };
 
 //! A list of transactions
-typedef std::vector<Transaction> TransactionList;
+typedef std::pmr::vector<Transaction> TransactionList;
 
 //!@}
 } // namespace Equity
@@ -0,0 +1,208 @@
+#pragma once
+
+#include "crypto/Sha256.h"
+#include "equity/Transaction.h"
+#include "p2p/Serialize.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace Equity
+{
+//! @addtogroup EquityGroup
+//!@{
+
+//! A read-only view of a serialized transaction.
+//!
+//! A view refers to the serialized bytes instead of copying them. Its scripts are ranges of the buffer, and its inputs
+//! and outputs are decoded as they are visited. Constructing a view checks the structure of the whole transaction in
+//! a single pass without allocating memory, so a transaction can be validated and relayed as it was received, without
+//! materializing a Transaction.
+//!
+//! @note   The buffer must outlive the view.
+class TransactionView
+{
+public:
+
+    //! Size of the smallest possible serialized transaction (one with no inputs and no outputs)
+    static size_t constexpr MINIMUM_SIZE = Transaction::MINIMUM_SIZE;
+
+    //! A view of a transaction input
+    struct Input
+    {
+        uint8_t const * txid = nullptr; //!< Source transaction (SHA256_HASH_SIZE bytes, in serialized order)
+        uint32_t outputIndex = 0;       //!< Source transaction output index
+        P2p::ByteSpan script;           //!< Input script
+        uint32_t sequence = 0;          //!< Sequence number
+
+        // Constructor
+        Input() {}
+
+        // Deserialization constructor
+        //!
+        //! @param[in,out]  in      pointer to the next byte to deserialize
+        //! @param[in,out]  size    number of bytes remaining in the serialized stream
+        Input(uint8_t const * & in, size_t & size);
+
+        //! Returns a copy of the input
+        Transaction::Input toInput() const;
+    };
+
+    //! A view of a transaction output
+    struct Output
+    {
+        uint64_t value = 0;             //!< Value of the output in satoshis
+        P2p::ByteSpan script;           //!< Output script
+
+        // Constructor
+        Output() {}
+
+        // Deserialization constructor
+        //!
+        //! @param[in,out]  in      pointer to the next byte to deserialize
+        //! @param[in,out]  size    number of bytes remaining in the serialized stream
+        Output(uint8_t const * & in, size_t & size);
+
+        //! Returns a copy of the output
+        Transaction::Output toOutput() const;
+    };
+
+    //! A sequence of serialized elements that have been checked. The elements are decoded as they are visited.
+    template <typename T>
+    class Range
+    {
+    public:
+
+        //! A forward iterator over the elements of a Range
+        class const_iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef T                         value_type;
+            typedef ptrdiff_t                 difference_type;
+            typedef T const *                 pointer;
+            typedef T const &                 reference;
+
+            // Constructor
+            const_iterator() : next_(nullptr), size_(0), remaining_(0) {}
+
+            // Constructor
+            //!
+            //! @param  data    first element
+            //! @param  size    size of the elements
+            //! @param  count   number of elements
+            const_iterator(uint8_t const * data, size_t size, size_t count)
+                : next_(data)
+                , size_(size)
+                , remaining_(count)
+            {
+                if (remaining_ > 0)
+                    current_ = T(next_, size_);
+            }
+
+            reference operator *() const { return current_; }
+            pointer   operator ->() const { return &current_; }
+
+            const_iterator & operator ++()
+            {
+                if (--remaining_ > 0)
+                    current_ = T(next_, size_);
+                return *this;
+            }
+
+            const_iterator operator ++(int)
+            {
+                const_iterator old = *this;
+                ++*this;
+                return old;
+            }
+
+            //! Iterators are equal if the same number of elements remain (they must be from the same range)
+            bool operator ==(const_iterator const & b) const { return remaining_ == b.remaining_; }
+            bool operator !=(const_iterator const & b) const { return remaining_ != b.remaining_; }
+
+        private:
+            uint8_t const * next_;      // The element after the current one
+            size_t size_;               // Number of bytes from next_ to the end of the range
+            size_t remaining_;          // Number of elements from the current one to the end of the range
+            T current_;
+        };
+
+        // Constructor
+        Range() : count_(0) {}
+
+        // Constructor
+        //!
+        //! @param  serialized  the serialized elements (which must have been checked)
+        //! @param  count       number of elements
+        Range(P2p::ByteSpan const & serialized, size_t count) : serialized_(serialized), count_(count) {}
+
+        //! Returns the number of elements
+        size_t size() const { return count_; }
+
+        //! Returns true if there are no elements
+        bool empty() const { return count_ == 0; }
+
+        //! Returns an iterator to the first element
+        const_iterator begin() const { return const_iterator(serialized_.data, serialized_.size, count_); }
+
+        //! Returns an iterator past the last element
+        const_iterator end() const { return const_iterator(); }
+
+        //! Returns the serialized elements (not including their number)
+        P2p::ByteSpan serialized() const { return serialized_; }
+
+    private:
+        P2p::ByteSpan serialized_;
+        size_t count_;
+    };
+
+    //! A sequence of inputs
+    typedef Range<Input> InputRange;
+
+    //! A sequence of outputs
+    typedef Range<Output> OutputRange;
+
+    // Constructor
+    TransactionView() : version_(0), lockTime_(0) {}
+
+    // Deserialization constructor
+    //!
+    //! @param[in,out]  in      pointer to the next byte to deserialize
+    //! @param[in,out]  size    number of bytes remaining in the serialized stream
+    //!
+    //! @exception  P2p::DeserializationError   the transaction is not well-formed
+    TransactionView(uint8_t const * & in, size_t & size);
+
+    //! Returns the version
+    uint32_t version() const { return version_; }
+
+    //! Returns the inputs
+    InputRange const & inputs() const { return inputs_; }
+
+    //! Returns the outputs
+    OutputRange const & outputs() const { return outputs_; }
+
+    //! Returns the locktime value
+    uint32_t lockTime() const { return lockTime_; }
+
+    //! Returns the serialized transaction
+    P2p::ByteSpan serialized() const { return serialized_; }
+
+    //! Returns the double-SHA-256 hash of the serialized transaction, in internal byte order (see Transaction::hash()).
+    Crypto::Sha256Hash hash() const { return Crypto::doubleSha256(serialized_.data, serialized_.size); }
+
+    //! Returns a copy of the transaction
+    Transaction toTransaction() const;
+
+private:
+
+    uint32_t version_;
+    InputRange inputs_;
+    OutputRange outputs_;
+    uint32_t lockTime_;
+    P2p::ByteSpan serialized_;
+};
+
+//!@}
+} // namespace Equity
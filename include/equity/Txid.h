@@ -35,6 +35,8 @@ struct Txid : public P2p::Serializable
     //! @name Overrides Serializable
     //!@{
     virtual void           serialize(std::vector<uint8_t> & out) const override;
+    virtual void           serialize(P2p::Sink & out) const override;
+    virtual size_t         serializedSize() const override { return Crypto::SHA256_HASH_SIZE; }
     virtual nlohmann::json toJson() const override;
 
     //!@}
@@ -0,0 +1,81 @@
+//
+//  main.cpp
+//  Equity
+//
+//  Searches for a nonce that gives a block header a hash meeting its target.
+//
+
+#include "equity/Block.h"
+#include "equity/Miner.h"
+#include "p2p/Serialize.h"
+#include "utility/Utility.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Equity;
+
+static void syntax(int argc, char ** argv);
+
+int main(int argc, char ** argv)
+{
+    if (argc < 2)
+    {
+        syntax(argc, argv);
+        return 1;
+    }
+
+    --argc;
+    ++argv;
+
+    std::vector<uint8_t> data = Utility::fromHex(*argv);
+    if (data.size() != Block::Header::SIZE)
+    {
+        fprintf(stderr, "The header must be %zu bytes.\n", Block::Header::SIZE);
+        return 2;
+    }
+
+    unsigned threads = 0;
+    if (argc > 1 && 1 != sscanf(argv[1], "%u", &threads))
+    {
+        syntax(argc, argv);
+        return 1;
+    }
+
+    uint8_t const * in = data.data();
+    size_t size = data.size();
+    Block::Header header;
+    try
+    {
+        header = Block::Header(in, size);
+    }
+    catch (P2p::DeserializationError const &)
+    {
+        fprintf(stderr, "The header is invalid.\n");
+        return 2;
+    }
+
+    Miner miner(threads);
+    auto start = std::chrono::steady_clock::now();
+    Miner::Result result = miner.mine(header);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (result.found)
+    {
+        printf("Nonce = %u (0x%08x)\n", result.nonce, result.nonce);
+        printf("Hash = %s\n", Utility::toHexR(result.hash).c_str());
+    }
+    else
+    {
+        printf("No nonce found.\n");
+    }
+    printf("Hashes = %llu\n", (unsigned long long)result.hashes);
+    printf("Rate = %.0lf hashes/s (%u threads)\n", result.hashes / elapsed.count(), miner.threads());
+    return result.found ? 0 : 3;
+}
+
+static void syntax(int argc, char ** argv)
+{
+    fprintf(stderr, "syntax: %s <80-byte header in hex> [threads]\n", argv[0]);
+}
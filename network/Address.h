@@ -16,6 +16,8 @@ namespace Network
 class Address : public P2p::Serializable
 {
 public:
+    static size_t constexpr SIZE = 30;  //!< Size of a serialized address in bytes
+
     // Constructor
     Address();
 
@@ -36,6 +38,7 @@ public:
     //! @name Overrides Serializable
     //!@{
     virtual void           serialize(std::vector<uint8_t> & out) const override;
+    virtual size_t         serializedSize() const override { return SIZE; }
     virtual nlohmann::json toJson() const override;
 
     //!@}
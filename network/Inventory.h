@@ -28,6 +28,8 @@ struct InventoryId : public P2p::Serializable
         TYPE_FILTERED_BLOCK = 3 //!< Hash of a block header, but indicates that the reply should be a merkleblock message
     };
 
+    static size_t constexpr SIZE = 4 + Crypto::SHA256_HASH_SIZE;    //!< Size of a serialized inventory ID in bytes
+
     // Constructor
     //!
     //! @param  type    type of inventory
@@ -45,6 +47,7 @@ struct InventoryId : public P2p::Serializable
     //! @name Overrides Serializable
     //!@{
     virtual void           serialize(std::vector<uint8_t> & out) const override;
+    virtual size_t         serializedSize() const override { return SIZE; }
     virtual nlohmann::json toJson() const override;
 
     //!@}
@@ -18,7 +18,7 @@ AddressMessage::AddressMessage(std::vector<Address> const & addresses)
 AddressMessage::AddressMessage(uint8_t const * & in, size_t & size)
     : Message(TYPE)
 {
-    addresses_ = P2p::VarArray<Address>(in, size).value();
+    addresses_ = P2p::VarArray<Address>(in, size).take();
 }
 
 void AddressMessage::serialize(std::vector<uint8_t> & out) const
@@ -26,6 +26,11 @@ void AddressMessage::serialize(std::vector<uint8_t> & out) const
     P2p::serialize(P2p::VarArray<Address>(addresses_), out);
 }
 
+size_t AddressMessage::serializedSize() const
+{
+    return P2p::VASize::size(addresses_.size()) + P2p::serializedSize(addresses_);
+}
+
 json Network::AddressMessage::toJson() const
 {
     return json::object(
@@ -28,6 +28,11 @@ void AlertMessage::serialize(std::vector<uint8_t> & out) const
     P2p::serialize(message_, out);
 }
 
+size_t AlertMessage::serializedSize() const
+{
+    return message_.size();
+}
+
 json Network::AlertMessage::toJson() const
 {
     return json::object(
@@ -25,6 +25,11 @@ void BlockMessage::serialize(std::vector<uint8_t> & out) const
     P2p::serialize(block_, out);
 }
 
+size_t BlockMessage::serializedSize() const
+{
+    return block_.serializedSize();
+}
+
 json Network::BlockMessage::toJson() const
 {
     return block_.toJson();
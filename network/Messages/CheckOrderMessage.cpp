@@ -25,6 +25,12 @@ void CheckOrderMessage::serialize(std::vector<uint8_t> & out) const
     THIS_SHOULD_NEVER_HAPPEN();  // not supported
 }
 
+size_t CheckOrderMessage::serializedSize() const
+{
+    THIS_SHOULD_NEVER_HAPPEN();  // not supported
+    return 0;
+}
+
 json Network::CheckOrderMessage::toJson() const
 {
     THIS_SHOULD_NEVER_HAPPEN();  // not supported
@@ -18,7 +18,7 @@ FilterAddMessage::FilterAddMessage(std::vector<uint8_t> const & data)
 FilterAddMessage::FilterAddMessage(uint8_t const * & in, size_t & size)
     : Message(TYPE)
 {
-    data_ = P2p::VarArray<uint8_t>(in, size).value();
+    data_ = P2p::VarArray<uint8_t>(in, size).take();
     if (data_.size() > MAX_FILTER_SIZE)
         throw InvalidMessageError();
 }
@@ -28,6 +28,11 @@ void FilterAddMessage::serialize(std::vector<uint8_t> & out) const
     P2p::serialize(data_, out);
 }
 
+size_t FilterAddMessage::serializedSize() const
+{
+    return data_.size();
+}
+
 json Network::FilterAddMessage::toJson() const
 {
     return P2p::toJson(data_);
@@ -25,6 +25,11 @@ void FilterClearMessage::serialize(std::vector<uint8_t> & out) const
     // Nothing to serialize
 }
 
+size_t FilterClearMessage::serializedSize() const
+{
+    return 0;
+}
+
 json Network::FilterClearMessage::toJson() const
 {
     return json();
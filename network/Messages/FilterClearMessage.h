@@ -27,6 +27,7 @@ public:
     //! @name Overrides Serializable
     //!@{
     virtual void           serialize(std::vector<uint8_t> & out) const override;
+    virtual size_t         serializedSize() const override;
     virtual nlohmann::json toJson() const override;
 
     //!@}
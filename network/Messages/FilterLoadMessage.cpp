@@ -29,7 +29,7 @@ FilterLoadMessage::FilterLoadMessage(std::vector<uint8_t> const & filter,
 FilterLoadMessage::FilterLoadMessage(uint8_t const * & in, size_t & size)
     : Message(TYPE)
 {
-    filter_ = P2p::VarArray<uint8_t>(in, size).value();
+    filter_ = P2p::VarArray<uint8_t>(in, size).take();
     if (filter_.size() > MAX_FILTER_SIZE)
         throw InvalidMessageError();
     nHashFuncs_ = Endian::little(P2p::deserialize<uint32_t>(in, size));
@@ -47,6 +47,12 @@ void FilterLoadMessage::serialize(std::vector<uint8_t> & out) const
     P2p::serialize(flags_, out);
 }
 
+size_t FilterLoadMessage::serializedSize() const
+{
+    return P2p::VASize::size(filter_.size()) + filter_.size() + sizeof(nHashFuncs_) + sizeof(tweak_) +
+           sizeof(flags_);
+}
+
 json Network::FilterLoadMessage::toJson() const
 {
     return json::object(
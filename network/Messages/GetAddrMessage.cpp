@@ -24,6 +24,11 @@ void GetAddrMessage::serialize(std::vector<uint8_t> & out) const
     // Nothing to serialize
 }
 
+size_t GetAddrMessage::serializedSize() const
+{
+    return 0;
+}
+
 json Network::GetAddrMessage::toJson() const
 {
     return json();
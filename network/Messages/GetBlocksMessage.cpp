@@ -23,7 +23,7 @@ GetBlocksMessage::GetBlocksMessage(uint8_t const * & in, size_t & size)
     : Message(TYPE)
 {
     version_ = Endian::little(P2p::deserialize<uint32_t>(in, size));
-    hashes_  = P2p::VarArray<Crypto::Sha256Hash>(in, size).value();
+    hashes_  = P2p::VarArray<Crypto::Sha256Hash>(in, size).take();
     last_    = P2p::deserializeArray<Crypto::Sha256Hash>(in, size);
 }
 
@@ -34,6 +34,11 @@ void GetBlocksMessage::serialize(std::vector<uint8_t> & out) const
     P2p::serialize(last_, out);
 }
 
+size_t GetBlocksMessage::serializedSize() const
+{
+    return sizeof(version_) + P2p::VASize::size(hashes_.size()) + P2p::serializedSize(hashes_) + last_.size();
+}
+
 json GetBlocksMessage::toJson() const
 {
     return json::object(
@@ -18,7 +18,7 @@ GetDataMessage::GetDataMessage(InventoryList const & inventory)
 GetDataMessage::GetDataMessage(uint8_t const * & in, size_t & size)
     : Message(TYPE)
 {
-    inventory_ = P2p::VarArray<InventoryId>(in, size).value();
+    inventory_ = P2p::VarArray<InventoryId>(in, size).take();
 }
 
 void GetDataMessage::serialize(std::vector<uint8_t> & out) const
@@ -26,6 +26,11 @@ void GetDataMessage::serialize(std::vector<uint8_t> & out) const
     P2p::VarArray<InventoryId>(inventory_).serialize(out);
 }
 
+size_t GetDataMessage::serializedSize() const
+{
+    return P2p::VASize::size(inventory_.size()) + P2p::serializedSize(inventory_);
+}
+
 json Network::GetDataMessage::toJson() const
 {
     return json::object(
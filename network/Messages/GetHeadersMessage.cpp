@@ -23,7 +23,7 @@ GetHeadersMessage::GetHeadersMessage(uint8_t const * & in, size_t & size)
     : Message(TYPE)
 {
     version_ = Endian::little(P2p::deserialize<uint32_t>(in, size));
-    hashes_  = P2p::VarArray<Crypto::Sha256Hash>(in, size).value();
+    hashes_  = P2p::VarArray<Crypto::Sha256Hash>(in, size).take();
     last_    = P2p::deserializeArray<Crypto::Sha256Hash>(in, size);
 }
 
@@ -34,6 +34,11 @@ void GetHeadersMessage::serialize(std::vector<uint8_t> & out) const
     P2p::serialize(last_, out);
 }
 
+size_t GetHeadersMessage::serializedSize() const
+{
+    return sizeof(version_) + P2p::VASize::size(hashes_.size()) + P2p::serializedSize(hashes_) + last_.size();
+}
+
 json GetHeadersMessage::toJson() const
 {
     return json::object(
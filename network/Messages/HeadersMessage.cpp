@@ -21,10 +21,15 @@ HeadersMessage::HeadersMessage(Equity::BlockList const & blocks)
 HeadersMessage::HeadersMessage(uint8_t const * & in, size_t & size)
     : Message(TYPE)
 {
-    blocks_ = P2p::VarArray<Equity::Block>(in, size).value();
+    blocks_ = P2p::VarArray<Equity::Block>(in, size).take();
 }
 
 void HeadersMessage::serialize(std::vector<uint8_t> & out) const
 {
     P2p::VarArray<Equity::Block>(blocks_).serialize(out);
 }
+
+size_t HeadersMessage::serializedSize() const
+{
+    return P2p::VASize::size(blocks_.size()) + P2p::serializedSize(blocks_);
+}
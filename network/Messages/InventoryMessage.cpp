@@ -15,10 +15,15 @@ InventoryMessage::InventoryMessage(InventoryList const & inventory)
 InventoryMessage::InventoryMessage(uint8_t const * & in, size_t & size)
     : Message(TYPE)
 {
-    inventory_ = P2p::VarArray<InventoryId>(in, size).value();
+    inventory_ = P2p::VarArray<InventoryId>(in, size).take();
 }
 
 void InventoryMessage::serialize(std::vector<uint8_t> & out) const
 {
     P2p::serialize(P2p::VarArray<InventoryId>(inventory_), out);
 }
+
+size_t InventoryMessage::serializedSize() const
+{
+    return P2p::VASize::size(inventory_.size()) + P2p::serializedSize(inventory_);
+}
@@ -28,7 +28,7 @@ MerkleBlockMessage::MerkleBlockMessage(uint8_t const * & in, size_t & size)
 {
     header_ = Equity::Block::Header(in, size);
     count_  = Endian::little(P2p::deserialize<uint32_t>(in, size));
-    hashes_ = P2p::VarArray<Crypto::Sha256Hash>(in, size).value();
+    hashes_ = P2p::VarArray<Crypto::Sha256Hash>(in, size).take();
     flags_  = P2p::BitArray(in, size);
 }
 
@@ -40,6 +40,13 @@ void MerkleBlockMessage::serialize(std::vector<uint8_t> & out) const
     P2p::serialize(flags_, out);
 }
 
+size_t MerkleBlockMessage::serializedSize() const
+{
+    return Equity::Block::Header::SIZE + sizeof(count_) +
+           P2p::VASize::size(hashes_.size()) + P2p::serializedSize(hashes_) +
+           flags_.serializedSize();
+}
+
 json MerkleBlockMessage::toJson() const
 {
     return std::string("...");
@@ -14,7 +14,7 @@ NotFoundMessage::NotFoundMessage(InventoryList const & missing)
 
 NotFoundMessage::NotFoundMessage(uint8_t const * & in, size_t & size)
     : Message(TYPE)
-    , missing_(P2p::VarArray<InventoryId>(in, size).value())
+    , missing_(P2p::VarArray<InventoryId>(in, size).take())
 {
 }
 
@@ -22,3 +22,8 @@ void NotFoundMessage::serialize(std::vector<uint8_t> & out) const
 {
     P2p::VarArray<InventoryId>(missing_).serialize(out);
 }
+
+size_t NotFoundMessage::serializedSize() const
+{
+    return P2p::VASize::size(missing_.size()) + P2p::serializedSize(missing_);
+}
@@ -24,3 +24,8 @@ void PongMessage::serialize(std::vector<uint8_t> & out) const
 {
     P2p::serialize(Endian::little(nonce_), out);
 }
+
+size_t PongMessage::serializedSize() const
+{
+    return sizeof(nonce_);
+}
@@ -19,9 +19,9 @@ RejectMessage::RejectMessage(std::string const & message, Code code, std::string
 RejectMessage::RejectMessage(uint8_t const * & in, size_t & size)
     : Message(TYPE)
 {
-    message_ = P2p::VarString(in, size).value();
+    message_ = P2p::VarString(in, size).take();
     code_ = P2p::deserialize<uint8_t>(in, size);
-    reason_ = P2p::VarString(in, size).value();
+    reason_ = P2p::VarString(in, size).take();
     data_ = P2p::deserializeVector<uint8_t>(size, in, size);
 }
 
@@ -32,3 +32,9 @@ void RejectMessage::serialize(std::vector<uint8_t> & out) const
     P2p::serialize(P2p::VarString(reason_), out);
     P2p::serialize(data_, out);
 }
+
+size_t RejectMessage::serializedSize() const
+{
+    return P2p::VASize::size(message_.size()) + message_.size() + sizeof(code_) + P2p::VASize::size(reason_.size()) +
+           reason_.size() + data_.size();
+}
@@ -24,3 +24,9 @@ void ReplyMessage::serialize(std::vector<uint8_t> & out) const
 {
     THIS_SHOULD_NEVER_HAPPEN();
 }
+
+size_t ReplyMessage::serializedSize() const
+{
+    THIS_SHOULD_NEVER_HAPPEN();  // not supported
+    return 0;
+}
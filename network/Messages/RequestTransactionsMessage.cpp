@@ -19,3 +19,8 @@ RequestTransactionsMessage::RequestTransactionsMessage(uint8_t const * & in, siz
 void RequestTransactionsMessage::serialize(std::vector<uint8_t> & out) const
 {
 }
+
+size_t RequestTransactionsMessage::serializedSize() const
+{
+    return 0;
+}
@@ -20,3 +20,8 @@ void SendHeadersMessage::serialize(std::vector<uint8_t> & out) const
 {
     // This message has no payload
 }
+
+size_t SendHeadersMessage::serializedSize() const
+{
+    return 0;
+}
@@ -23,3 +23,9 @@ void SubmitOrderMessage::serialize(std::vector<uint8_t> & out) const
 {
     THIS_SHOULD_NEVER_HAPPEN();
 }
+
+size_t SubmitOrderMessage::serializedSize() const
+{
+    THIS_SHOULD_NEVER_HAPPEN();  // not supported
+    return 0;
+}
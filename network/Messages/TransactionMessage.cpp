@@ -17,3 +17,8 @@ TransactionMessage::TransactionMessage(uint8_t const * & in, size_t & size)
 void TransactionMessage::serialize(std::vector<uint8_t> & out) const
 {
 }
+
+size_t TransactionMessage::serializedSize() const
+{
+    return 0;
+}
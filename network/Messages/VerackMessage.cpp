@@ -19,3 +19,8 @@ VerackMessage::VerackMessage(uint8_t const * & in, size_t & size)
 void VerackMessage::serialize(std::vector<uint8_t> & out) const
 {
 }
+
+size_t VerackMessage::serializedSize() const
+{
+    return 0;
+}
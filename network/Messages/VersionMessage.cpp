@@ -41,7 +41,7 @@ VersionMessage::VersionMessage(uint8_t const * & in, size_t & size)
     {
         from_      = P2p::deserialize<Address>(in, size);
         nonce_     = P2p::deserialize<uint32_t>(in, size);
-        userAgent_ = P2p::VarString(in, size).value();
+        userAgent_ = P2p::VarString(in, size).take();
         height_    = P2p::deserialize<uint32_t>(in, size);
 
         // Fields below require version >= 70001
@@ -63,6 +63,12 @@ void VersionMessage::serialize(std::vector<uint8_t> & out) const
     P2p::serialize(static_cast<uint8_t>(relay_), out);
 }
 
+size_t VersionMessage::serializedSize() const
+{
+    return sizeof(version_) + sizeof(services_) + sizeof(timestamp_) + to_.serializedSize() + from_.serializedSize() +
+           sizeof(nonce_) + userAgent_.size() + sizeof(height_) + sizeof(uint8_t);
+}
+
 json VersionMessage::toJson() const
 {
     json j =
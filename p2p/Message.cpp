@@ -5,6 +5,7 @@
 #include "utility/Endian.h"
 
 #include <cassert>
+#include <utility>
 
 using namespace Utility;
 using namespace P2p;
@@ -16,6 +17,13 @@ Message::Message(char const * type, std::vector<uint8_t> const & payload)
     assert(!type_.empty() && type_.length() < Header::TYPE_SIZE);
 }
 
+Message::Message(char const * type, std::vector<uint8_t> && payload)
+    : type_(type)
+    , payload_(std::move(payload))
+{
+    assert(!type_.empty() && type_.length() < Header::TYPE_SIZE);
+}
+
 void Message::Header::serialize(std::vector<uint8_t> & out) const
 {
     // Network ID (uint32_t, little-endian)
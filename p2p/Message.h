@@ -31,11 +31,16 @@ public:
     //! @param  payload     message payload
     Message(char const * type, std::vector<uint8_t> const & payload);
 
+    // Constructor
+    //! @param  type        message type
+    //! @param  payload     message payload (moved)
+    Message(char const * type, std::vector<uint8_t> && payload);
+
     //! Returns the message type
     std::string type() const { return type_; }
 
     //! Returns the payload
-    Payload payload() const { return payload_;  }
+    Payload const & payload() const { return payload_; }
 
     //! Returns the size of the payload
     size_t size() const { return payload_.size(); }
@@ -64,6 +69,7 @@ public:
     static size_t const TYPE_SIZE     = 12;             //!< Size of the type field
     static size_t const LENGTH_SIZE   = 4;              //!< Size of the length field
     static size_t const CHECKSUM_SIZE = 4;              //!< Size of the checksum field
+    static size_t const SIZE = MAGIC_SIZE + TYPE_SIZE + LENGTH_SIZE + CHECKSUM_SIZE; //!< Size of a serialized header
 
     uint32_t magic_;                                    //!< Magic number
     char type_[TYPE_SIZE];                              //!< Message type
@@ -73,6 +79,7 @@ public:
     //! @name Overrides Serializable
     //!@{
     virtual void           serialize(std::vector<uint8_t> & out) const override;
+    virtual size_t         serializedSize() const override { return SIZE; }
     virtual nlohmann::json toJson() const override;
 
     //!@}
@@ -1,45 +1,83 @@
 #include "Serialize.h"
 
 // #include "Utility.h"
+#include "utility/Endian.h"
 
 #include <algorithm>
+#include <ostream>
 
 using json = nlohmann::json;
 
 namespace P2p
 {
+void Serializable::serialize(Sink & out) const
+{
+    std::vector<uint8_t> buffer;
+    serialize(buffer);
+    out.write(buffer.data(), buffer.size());
+}
+
+size_t Serializable::serializedSize() const
+{
+    SizeSink sink;
+    serialize(sink);
+    return sink.size();
+}
+
+void ScatterSink::write(uint8_t const * data, size_t size)
+{
+    while (size > 0)
+    {
+        if (current_ >= count_)
+            throw std::length_error("ScatterSink overflow");
+
+        Segment const & segment = segments_[current_];
+        size_t n = std::min(size, segment.size - offset_);
+        std::copy(data, data + n, segment.data + offset_);
+        data    += n;
+        size    -= n;
+        size_   += n;
+        offset_ += n;
+        if (offset_ == segment.size)
+        {
+            ++current_;
+            offset_ = 0;
+        }
+    }
+}
+
+void StreamSink::write(uint8_t const * data, size_t size)
+{
+    out_.write(reinterpret_cast<char const *>(data), size);
+}
+
 void serialize(uint8_t const & a, std::vector<uint8_t> & out)
 {
     out.push_back(a);
 }
 
+// The integers are stored with single unaligned writes and then written with a single insert. Use serializedSize() to
+// reserve space for a whole object.
+
 void serialize(uint16_t const & a, std::vector<uint8_t> & out)
 {
-    out.reserve(out.size() + 2);
-    out.push_back(a & 0xff);
-    out.push_back((a >> 8) & 0xff);
+    uint8_t bytes[sizeof(a)];
+    Utility::Endian::storeLittle(bytes, a);
+    out.insert(out.end(), bytes, bytes + sizeof(bytes));
 }
 
 void serialize(uint32_t const & a, std::vector<uint8_t> & out)
 {
-    out.reserve(out.size() + 4);
-    out.push_back(a & 0xff);
-    out.push_back((a >> 8) & 0xff);
-    out.push_back((a >> 16) & 0xff);
-    out.push_back((a >> 24) & 0xff);
+    uint8_t bytes[sizeof(a)];
+    Utility::Endian::storeLittle(bytes, a);
+    out.insert(out.end(), bytes, bytes + sizeof(bytes));
 }
 
 void serialize(uint64_t const & a, std::vector<uint8_t> & out)
 {
-    out.reserve(out.size() + 8);
-    out.push_back(a & 0xff);
-    out.push_back((a >> 8) & 0xff);
-    out.push_back((a >> 16) & 0xff);
-    out.push_back((a >> 24) & 0xff);
-    out.push_back((a >> 32) & 0xff);
-    out.push_back((a >> 40) & 0xff);
-    out.push_back((a >> 48) & 0xff);
-    out.push_back((a >> 56) & 0xff);
+    uint8_t bytes[sizeof(a)];
+    Utility::Endian::storeLittle(bytes, a);
+    out.insert(out.end(), bytes, bytes + sizeof(bytes));
 }
 
 void serialize(std::string const & s, std::vector<uint8_t> & out)
@@ -61,6 +99,33 @@ void serialize<uint8_t>(std::vector<uint8_t> const & a, std::vector<uint8_t> & o
     out.insert(out.end(), a.begin(), a.end());
 }
 
+void serialize(uint16_t const & a, Sink & out)
+{
+    uint8_t bytes[sizeof(a)];
+    Utility::Endian::storeLittle(bytes, a);
+    out.write(bytes, sizeof(bytes));
+}
+
+void serialize(uint32_t const & a, Sink & out)
+{
+    uint8_t bytes[sizeof(a)];
+    Utility::Endian::storeLittle(bytes, a);
+    out.write(bytes, sizeof(bytes));
+}
+
+void serialize(uint64_t const & a, Sink & out)
+{
+    uint8_t bytes[sizeof(a)];
+    Utility::Endian::storeLittle(bytes, a);
+    out.write(bytes, sizeof(bytes));
+}
+
+template <>
+void serialize<uint8_t>(std::vector<uint8_t> const & a, Sink & out)
+{
+    out.write(a.data(), a.size());
+}
+
 template <>
 uint8_t deserialize<uint8_t>(uint8_t const * & in, size_t & size)
 {
@@ -77,44 +142,33 @@ uint8_t deserialize<uint8_t>(uint8_t const * & in, size_t & size)
 template <>
 uint16_t deserialize<uint16_t>(uint8_t const * & in, size_t & size)
 {
-    if (size < 2)
+    if (size < sizeof(uint16_t))
         throw DeserializationError();
-    uint16_t out = (uint16_t)in[0] +
-                   ((uint16_t)in[1] << 8);
-    in   += 2;
-    size -= 2;
+    uint16_t out = Utility::Endian::loadLittle<uint16_t>(in);
+    in   += sizeof(uint16_t);
+    size -= sizeof(uint16_t);
     return out;
 }
 
 template <>
 uint32_t deserialize<uint32_t>(uint8_t const * & in, size_t & size)
 {
-    if (size < 4)
+    if (size < sizeof(uint32_t))
         throw DeserializationError();
-    uint32_t out = (uint32_t)in[0] +
-                   ((uint32_t)in[1] << 8) +
-                   ((uint32_t)in[2] << 16) +
-                   ((uint32_t)in[3] << 24);
-    in   += 4;
-    size -= 4;
+    uint32_t out = Utility::Endian::loadLittle<uint32_t>(in);
+    in   += sizeof(uint32_t);
+    size -= sizeof(uint32_t);
     return out;
 }
 
 template <>
 uint64_t deserialize<uint64_t>(uint8_t const * & in, size_t & size)
 {
-    if (size < 8)
+    if (size < sizeof(uint64_t))
         throw DeserializationError();
-    uint64_t out = (uint64_t)in[0] +
-                   ((uint64_t)in[1] << 8) +
-                   ((uint64_t)in[2] << 16) +
-                   ((uint64_t)in[3] << 24) +
-                   ((uint64_t)in[4] << 32) +
-                   ((uint64_t)in[5] << 40) +
-                   ((uint64_t)in[6] << 48) +
-                   ((uint64_t)in[7] << 56);
-    in   += 8;
-    size -= 8;
+    uint64_t out = Utility::Endian::loadLittle<uint64_t>(in);
+    in   += sizeof(uint64_t);
+    size -= sizeof(uint64_t);
     return out;
 }
 
@@ -147,6 +201,20 @@ json toJson(std::vector<uint8_t> const & v)
     return Utility::toHex(v);
 }
 
+ByteSpan deserializeByteSpan(uint8_t const * & in, size_t & size)
+{
+    uint64_t n = VASize(in, size).value();
+    if (size < n)
+        throw DeserializationError();
+
+    ByteSpan span;
+    span.data = in;
+    span.size = (size_t)n;
+    in   += n;
+    size -= n;
+    return span;
+}
+
 VASize::VASize(uint8_t const * & in, size_t & size)
 {
     uint8_t e = P2p::deserialize<uint8_t>(in, size);
@@ -167,24 +235,51 @@ void VASize::serialize(std::vector<uint8_t> & out) const
     }
     else if (value_ < 0x10000ULL)
     {
-        out.reserve(out.size() + 3);
         out.push_back(0xfd);
         P2p::serialize((uint16_t)value_, out);
     }
     else if (value_ < 0x100000000ULL)
     {
-        out.reserve(out.size() + 5);
         out.push_back(0xfe);
         P2p::serialize((uint32_t)value_, out);
     }
     else
     {
-        out.reserve(out.size() + 9);
         out.push_back(0xff);
         P2p::serialize((uint64_t)value_, out);
     }
 }
 
+void VASize::serialize(Sink & out) const
+{
+    uint8_t bytes[9];
+    size_t  size;
+    if (value_ < 0xfdULL)
+    {
+        bytes[0] = (uint8_t)value_;
+        size     = 1;
+    }
+    else if (value_ < 0x10000ULL)
+    {
+        bytes[0] = 0xfd;
+        size     = 3;
+    }
+    else if (value_ < 0x100000000ULL)
+    {
+        bytes[0] = 0xfe;
+        size     = 5;
+    }
+    else
+    {
+        bytes[0] = 0xff;
+        size     = 9;
+    }
+
+    // The value follows the prefix in little-endian order. All 8 bytes are stored, but only the low ones are written.
+    Utility::Endian::storeLittle(bytes + 1, value_);
+    out.write(bytes, size);
+}
+
 json VASize::toJson() const
 {
     return json::number_unsigned_t(value_);
@@ -192,7 +287,7 @@ json VASize::toJson() const
 
 BitArray::BitArray(uint8_t const * & in, size_t & size)
 {
-    bits_ = P2p::VarArray<uint8_t>(in, size).value();
+    bits_ = P2p::VarArray<uint8_t>(in, size).take();
 }
 
 bool BitArray::get(size_t index) const
@@ -1,12 +1,16 @@
 #pragma once
 
+#include "crypto/Sha256.h"
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <iosfwd>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <stdexcept>
 #include <string>
 #include <utility/Utility.h>
+#include <utility>
 #include <vector>
 
 //! @todo Move serialization to Serializer class in Network namespace
@@ -23,6 +27,204 @@ public:
     DeserializationError() : std::runtime_error("deserialization error") {}
 };
 
+//! A range of bytes in a buffer owned by something else.
+//!
+//! Views of serialized objects refer to their variable-length fields (such as scripts) with ByteSpans instead of
+//! copying them.
+struct ByteSpan
+{
+    uint8_t const * data = nullptr; //!< First byte
+    size_t size = 0;                //!< Number of bytes
+
+    //! Returns a pointer to the first byte
+    uint8_t const * begin() const { return data; }
+
+    //! Returns a pointer past the last byte
+    uint8_t const * end() const { return data + size; }
+
+    //! Returns true if there are no bytes
+    bool empty() const { return size == 0; }
+
+    //! Returns a copy of the bytes
+    std::vector<uint8_t> toVector() const { return std::vector<uint8_t>(data, data + size); }
+};
+
+//! A destination for serialized data.
+//!
+//! A Sink allows an object to be serialized directly to wherever the data is going (for example, a hash) without
+//! first serializing it into a buffer.
+class Sink
+{
+public:
+
+    virtual ~Sink() {}
+
+    //! Writes data to the sink.
+    //!
+    //! @param  data    data to write
+    //! @param  size    number of bytes to write
+    virtual void write(uint8_t const * data, size_t size) = 0;
+};
+
+//! A Sink that appends the data to a vector.
+class VectorSink : public Sink
+{
+public:
+
+    // Constructor
+    //!
+    //! @param  out     destination
+    explicit VectorSink(std::vector<uint8_t> & out) : out_(out) {}
+
+    //! @name Overrides Sink
+    //!@{
+    virtual void write(uint8_t const * data, size_t size) override { out_.insert(out_.end(), data, data + size); }
+
+    //!@}
+
+private:
+    std::vector<uint8_t> & out_;
+};
+
+//! A Sink that writes the data to a fixed-size buffer.
+class BufferSink : public Sink
+{
+public:
+
+    // Constructor
+    //!
+    //! @param  buffer  destination
+    //! @param  size    size of the destination
+    BufferSink(uint8_t * buffer, size_t size) : next_(buffer), end_(buffer + size) {}
+
+    //! @name Overrides Sink
+    //!@{
+    //! @exception  std::length_error   the data does not fit in the buffer
+    virtual void write(uint8_t const * data, size_t size) override
+    {
+        if (size > (size_t)(end_ - next_))
+            throw std::length_error("BufferSink overflow");
+        std::copy(data, data + size, next_);
+        next_ += size;
+    }
+
+    //!@}
+
+    //! Returns the number of bytes that can still be written
+    size_t remaining() const { return end_ - next_; }
+
+private:
+    uint8_t * next_;
+    uint8_t * end_;
+};
+
+//! A Sink that adds the data to a SHA-256 hash.
+class Sha256Sink : public Sink
+{
+public:
+
+    // Constructor
+    //!
+    //! @param  hasher  hasher that receives the data
+    explicit Sha256Sink(Crypto::Sha256Hasher & hasher) : hasher_(hasher) {}
+
+    //! @name Overrides Sink
+    //!@{
+    virtual void write(uint8_t const * data, size_t size) override { hasher_.update(data, size); }
+
+    //!@}
+
+private:
+    Crypto::Sha256Hasher & hasher_;
+};
+
+//! A Sink that only counts the bytes written to it.
+class SizeSink : public Sink
+{
+public:
+
+    // Constructor
+    SizeSink() : size_(0) {}
+
+    //! @name Overrides Sink
+    //!@{
+    virtual void write(uint8_t const *, size_t size) override { size_ += size; }
+
+    //!@}
+
+    //! Returns the number of bytes written
+    size_t size() const { return size_; }
+
+private:
+    size_t size_;
+};
+
+//! A Sink that fills a list of buffers in order (a scatter list, such as the one passed to writev() or WSASend()).
+//!
+//! Data is split across the buffers wherever one ends, so a large object can be serialized directly into a socket's
+//! or a ring buffer's segments.
+class ScatterSink : public Sink
+{
+public:
+
+    //! A destination buffer
+    struct Segment
+    {
+        uint8_t * data;     //!< First byte
+        size_t size;        //!< Size of the buffer
+    };
+
+    // Constructor
+    //!
+    //! @param  segments    destination buffers
+    //! @param  count       number of destination buffers
+    ScatterSink(Segment const * segments, size_t count)
+        : segments_(segments)
+        , count_(count)
+        , current_(0)
+        , offset_(0)
+        , size_(0)
+    {
+    }
+
+    //! @name Overrides Sink
+    //!@{
+    //! @exception  std::length_error   the data does not fit in the buffers
+    virtual void write(uint8_t const * data, size_t size) override;
+
+    //!@}
+
+    //! Returns the number of bytes written
+    size_t size() const { return size_; }
+
+private:
+    Segment const * segments_;
+    size_t count_;
+    size_t current_;    // Index of the segment being filled
+    size_t offset_;     // Number of bytes written to the segment being filled
+    size_t size_;
+};
+
+//! A Sink that writes the data to a stream (such as a file).
+class StreamSink : public Sink
+{
+public:
+
+    // Constructor
+    //!
+    //! @param  out     destination
+    explicit StreamSink(std::ostream & out) : out_(out) {}
+
+    //! @name Overrides Sink
+    //!@{
+    virtual void write(uint8_t const * data, size_t size) override;
+
+    //!@}
+
+private:
+    std::ostream & out_;
+};
+
 //! An abstract class that enables an object to be serialized by the serialization functions.
 class Serializable
 {
@@ -36,6 +238,23 @@ public:
     //! @note   Must be overridden
     virtual void serialize(std::vector<uint8_t> & out) const = 0;
 
+    //! Serializes the object to a sink.
+    //!
+    //! @param[out]     out     destination
+    //!
+    //! @note   The default implementation serializes the object into a temporary buffer and writes the buffer to the
+    //!         sink. Objects that are hashed often override it to avoid the buffer.
+    virtual void serialize(Sink & out) const;
+
+    //! Returns the number of bytes that serialize() writes.
+    //!
+    //! This allows a destination to be allocated once, and sizes (such as transaction sizes for fee rates) to be
+    //! computed without serializing anything.
+    //!
+    //! @note   The default implementation serializes the object to a sink that only counts the bytes. Objects override
+    //!         it to compute the size directly.
+    virtual size_t serializedSize() const;
+
     //! Converts the object to a JSON object.
     //!
     //! @note   Must be overridden
@@ -114,11 +333,146 @@ template <> void serialize<uint8_t>(std::vector<uint8_t> const & a, std::vector<
 //! @internal   The reason for this ridiculous code is that partial template specialization is not allowed with functions
 template <typename T, size_t N> void serialize(std::array<T, N> const & a, std::vector<uint8_t> & out);
 
+//! Serializes a Serializable to a sink.
+//!
+//! @param  a       object to be serialized
+//! @param  out     destination
+void serialize(Serializable const & a, Sink & out);
+
+//! Serializes a uint8_t to a sink.
+//!
+//! @param  a       value to be serialized
+//! @param  out     destination
+void serialize(uint8_t const & a, Sink & out);
+
+//! Serializes a uint16_t to a sink.
+//!
+//! @param  a       value to be serialized
+//! @param  out     destination
+void serialize(uint16_t const & a, Sink & out);
+
+//! Serializes a uint32_t to a sink.
+//!
+//! @param  a       value to be serialized
+//! @param  out     destination
+void serialize(uint32_t const & a, Sink & out);
+
+//! Serializes a uint64_t to a sink.
+//!
+//! @param  a       value to be serialized
+//! @param  out     destination
+void serialize(uint64_t const & a, Sink & out);
+
+//! Serializes an std::vector to a sink.
+//!
+//! @param  v       std::vector to be serialized
+//! @param  out     destination
+template <typename T> void serialize(std::vector<T> const & v, Sink & out);
+
+//! Serializes a vector of uint8_t to a sink.
+//!
+//! @param  a       std::vector to be serialized
+//! @param  out     destination
+template <> void serialize<uint8_t>(std::vector<uint8_t> const & a, Sink & out);
+
+//! Serializes an std::array of uint8_t to a sink.
+//!
+//! @param  a       std::array to be serialized
+//! @param  out     destination
+template <size_t N> void serialize(std::array<uint8_t, N> const & a, Sink & out);
+
+//! Returns the serialized size of a Serializable.
+//!
+//! @param  a       object
+inline size_t serializedSize(Serializable const & a) { return a.serializedSize(); }
+
+//! Returns the serialized size of a uint8_t.
+inline size_t serializedSize(uint8_t const &) { return 1; }
+
+//! Returns the serialized size of a uint16_t.
+inline size_t serializedSize(uint16_t const &) { return 2; }
+
+//! Returns the serialized size of a uint32_t.
+inline size_t serializedSize(uint32_t const &) { return 4; }
+
+//! Returns the serialized size of a uint64_t.
+inline size_t serializedSize(uint64_t const &) { return 8; }
+
+//! Returns the serialized size of an std::string.
+//!
+//! @param  s       string
+inline size_t serializedSize(std::string const & s) { return s.size(); }
+
+//! Returns the serialized size of an std::vector (not including its number of elements).
+//!
+//! @param  v       std::vector
+template <typename T> size_t serializedSize(std::vector<T> const & v);
+
+//! Returns the serialized size of a vector of uint8_t.
+//!
+//! @param  v       std::vector
+inline size_t serializedSize(std::vector<uint8_t> const & v) { return v.size(); }
+
+//! Returns the serialized size of an std::array.
+//!
+//! @param  a       std::array
+template <typename T, size_t N> size_t serializedSize(std::array<T, N> const & a);
+
+//! Returns the serialized size of an std::array of uint8_t.
+template <size_t N> size_t serializedSize(std::array<uint8_t, N> const &) { return N; }
+
 inline void serialize(Serializable const & a, std::vector<uint8_t> & out)
 {
     a.serialize(out);
 }
 
+inline void serialize(Serializable const & a, Sink & out)
+{
+    a.serialize(out);
+}
+
+inline void serialize(uint8_t const & a, Sink & out)
+{
+    out.write(&a, 1);
+}
+
+template <typename T>
+void serialize(std::vector<T> const & v, Sink & out)
+{
+    for (auto const & element : v)
+    {
+        serialize(element, out);
+    }
+}
+
+template <size_t N>
+void serialize(std::array<uint8_t, N> const & a, Sink & out)
+{
+    out.write(a.data(), a.size());
+}
+
+template <typename T>
+size_t serializedSize(std::vector<T> const & v)
+{
+    size_t size = 0;
+    for (auto const & element : v)
+    {
+        size += serializedSize(element);
+    }
+    return size;
+}
+
+template <typename T, size_t N>
+size_t serializedSize(std::array<T, N> const & a)
+{
+    size_t size = 0;
+    for (auto const & element : a)
+    {
+        size += serializedSize(element);
+    }
+    return size;
+}
+
 template <typename T>
 void serialize(std::vector<T> const & v, std::vector<uint8_t> & out)
 {
@@ -330,6 +684,13 @@ template <typename T> T deserializeArray(uint8_t const * & in, size_t & size);
 //! @note   The elements of the array must support deserialization
 template <typename T, size_t N> std::vector<std::array<T, N>> deserializeVector(size_t n, uint8_t const * & in, size_t & size);
 
+//! Deserializes an array of uint8_t and its size (as serialized by VarArray<uint8_t>) without copying it.
+//!
+//! @param[in,out]  in      pointer to the next byte to deserialize
+//! @param[in,out]  size    number of bytes remaining in the serialized stream
+//! @return the location of the bytes in the stream
+ByteSpan deserializeByteSpan(uint8_t const * & in, size_t & size);
+
 //! Deserializes a string.
 //!
 //! @param          n       Number of characters to deserialize
@@ -441,6 +802,8 @@ public:
     //! @name Overrides Serializable
     //!@{
     virtual void           serialize(std::vector<uint8_t> & out) const override;
+    virtual void           serialize(Sink & out) const override;
+    virtual size_t         serializedSize() const override { return size(value_); }
     virtual nlohmann::json toJson() const override;
 
     //!@}
@@ -448,6 +811,12 @@ public:
     //! Returns the value
     uint64_t value() const { return value_; }
 
+    //! Returns the serialized size of a value
+    static size_t size(uint64_t v)
+    {
+        return (v < 0xfdULL) ? 1 : (v < 0x10000ULL) ? 3 : (v < 0x100000000ULL) ? 5 : 9;
+    }
+
 private:
     uint64_t value_;
 };
@@ -474,6 +843,11 @@ public:
     //! @param  v       The elements to be contained in the array
     explicit VarArray(std::vector<T> const & v) : data_(v) {}
 
+    // Constructor
+    //!
+    //! @param  v       The elements to be contained in the array (moved)
+    explicit VarArray(std::vector<T> && v) : data_(std::move(v)) {}
+
     // Deserialization constructor
     //!
     //! @param[in,out]  in      pointer to the next byte to deserialize
@@ -492,6 +866,17 @@ public:
         P2p::serialize(data_, out);
     }
 
+    virtual void serialize(Sink & out) const override
+    {
+        P2p::serialize(VASize(data_.size()), out);
+        P2p::serialize(data_, out);
+    }
+
+    virtual size_t serializedSize() const override
+    {
+        return VASize::size(data_.size()) + P2p::serializedSize(data_);
+    }
+
     virtual nlohmann::json toJson() const override
     {
         return P2p::toJson(data_);
@@ -500,7 +885,10 @@ public:
     //!@}
 
     //! Returns the elements contained in the array
-    std::vector<T> value() const { return data_; }
+    std::vector<T> const & value() const { return data_; }
+
+    //! Moves the elements out of the array, leaving it empty
+    std::vector<T> take() { return std::move(data_); }
 
 private:
     std::vector<T> data_;
@@ -524,6 +912,11 @@ public:
     //! @param  v       The elements to be contained in the array
     explicit VarArray(std::vector<std::array<T, N>> const & v) : data_(v) {}
 
+    // Constructor
+    //!
+    //! @param  v       The elements to be contained in the array (moved)
+    explicit VarArray(std::vector<std::array<T, N>> && v) : data_(std::move(v)) {}
+
     // Deserialization constructor
     //!
     //! @param[in,out]  in      pointer to the next byte to deserialize
@@ -542,6 +935,17 @@ public:
         P2p::serialize(data_, out);
     }
 
+    virtual void serialize(Sink & out) const override
+    {
+        P2p::serialize(VASize(data_.size()), out);
+        P2p::serialize(data_, out);
+    }
+
+    virtual size_t serializedSize() const override
+    {
+        return VASize::size(data_.size()) + P2p::serializedSize(data_);
+    }
+
     nlohmann::json toJson() const override
     {
         return P2p::toJson(data_);
@@ -550,7 +954,10 @@ public:
     //!@}
 
     //! Returns the elements contained in the array
-    std::vector<std::array<T, N>> value() const { return data_; }
+    std::vector<std::array<T, N>> const & value() const { return data_; }
+
+    //! Moves the elements out of the array, leaving it empty
+    std::vector<std::array<T, N>> take() { return std::move(data_); }
 
 private:
     std::vector<std::array<T, N>> data_;
@@ -574,6 +981,11 @@ public:
     //! @param  v       The bytes to be contained in the array
     VarArray(std::vector<uint8_t> const & v) : data_(v) {}
 
+    // Constructor
+    //!
+    //! @param  v       The bytes to be contained in the array (moved)
+    VarArray(std::vector<uint8_t> && v) : data_(std::move(v)) {}
+
     // Deserialization constructor
     //!
     //! @param[in,out]  in      pointer to the next byte to deserialize
@@ -592,6 +1004,17 @@ public:
         P2p::serialize(data_, out);
     }
 
+    virtual void serialize(Sink & out) const override
+    {
+        P2p::serialize(VASize(data_.size()), out);
+        P2p::serialize(data_, out);
+    }
+
+    virtual size_t serializedSize() const override
+    {
+        return VASize::size(data_.size()) + P2p::serializedSize(data_);
+    }
+
     nlohmann::json toJson() const override
     {
         return Utility::toHex(data_);
@@ -600,7 +1023,10 @@ public:
     //!@}
 
     //! Returns the bytes contained in the array
-    std::vector<uint8_t> value() const { return data_; }
+    std::vector<uint8_t> const & value() const { return data_; }
+
+    //! Moves the bytes out of the array, leaving it empty
+    std::vector<uint8_t> take() { return std::move(data_); }
 
 private:
     std::vector<uint8_t> data_;
@@ -664,6 +1090,7 @@ public:
     //! @name Overrides Serializable
     //!@{
     virtual void           serialize(std::vector<uint8_t> & out) const override;
+    virtual size_t         serializedSize() const override { return VASize::size(bits_.size()) + bits_.size(); }
     virtual nlohmann::json toJson() const override;
 
     //!@}
@@ -712,6 +1139,11 @@ public:
         P2p::serialize(string_, out);
     }
 
+    virtual size_t serializedSize() const override
+    {
+        return VASize::size(string_.size()) + string_.size();
+    }
+
     virtual nlohmann::json toJson() const override
     {
         return string_;
@@ -719,8 +1151,11 @@ public:
 
     //!@}
 
-    //! Returns the bytes contained in the array
-    std::string value() const { return string_; }
+    //! Returns the string
+    std::string const & value() const { return string_; }
+
+    //! Moves the string out, leaving it empty
+    std::string take() { return std::move(string_); }
 
 private:
     std::string string_;
@@ -0,0 +1,74 @@
+#include "crypto/ChaCha20.h"
+#include "utility/Utility.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace Crypto;
+
+namespace
+{
+// Expected values were computed with Python's cryptography package
+struct ChaCha20TestCase
+{
+    char const * key;
+    uint64_t nonce;
+    uint64_t counter;
+    char const * expected;
+};
+
+ChaCha20TestCase const CHACHA20_CASES[] =
+{
+    {   // RFC 8439 A.1, test vector 1
+        "0000000000000000000000000000000000000000000000000000000000000000",
+        0,
+        0,
+        "76b8e0ada0f13d90405d6ae55386bd28bdd219b8a08ded1aa836efcc8b770dc7"
+        "da41597c5157488d7724e03fb8d84a376a43b8f41518a11cc387b669b2ee6586"
+    },
+    {   // RFC 8439 2.3.2
+        "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+        0x4a000000,
+        0x0900000000000001,
+        "10f1e7e4d13b5915500fdd1fa32071c4c7d1f4c733c068030422aa9ac3d46c4e"
+        "d2826446079faa0914c2d705d98b02a2b5129cd1de164eb9cbd083e8a2503c4e"
+    },
+    {   // The counter carries into its high 32 bits
+        "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+        0,
+        0xffffffff,
+        "1ce0deb8925fccea2d5587e850054559edcbbeb1a6c8e1c02c1e89abba08b01c"
+        "ad6048fe5ab5242ed6befbef6b4040fcb666a5f3858d942a912c4e8800301a42"
+        "d838fb09536e2e3a10e8f23f486273a69f42d8e640d781ede384793c34c32564"
+        "fc4361e5d5c5b620583b0528192f4c6109f23a0e14398ee6537cdcf2cd610ea2"
+    }
+};
+} // anonymous namespace
+
+TEST(CryptoChaCha20Test, chacha20)
+{
+    for (auto const & c : CHACHA20_CASES)
+    {
+        std::vector<uint8_t> key = Utility::fromHex(c.key);
+        size_t n = std::string(c.expected).size() / 2 / CHACHA20_BLOCK_SIZE;
+        std::vector<uint8_t> out(n * CHACHA20_BLOCK_SIZE);
+        chacha20(key.data(), c.nonce, c.counter, out.data(), n);
+        EXPECT_EQ(Utility::toHex(out), c.expected);
+
+        // Generating the blocks one at a time gives the same result
+        std::vector<uint8_t> single(out.size());
+        for (size_t i = 0; i < n; ++i)
+        {
+            chacha20(key.data(), c.nonce, c.counter + i, &single[i * CHACHA20_BLOCK_SIZE], 1);
+        }
+        EXPECT_EQ(single, out);
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,40 +1,917 @@
 #include "crypto/Ecc.h"
+#include "utility/Utility.h"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Signatures of SHA-256(message) generated with Python's cryptography package
+struct SignatureTestCase
+{
+    char const * message;
+    char const * pubKey;
+    char const * signature;
+};
+
+SignatureTestCase const SIGNATURE_CASES[] =
+{
+    {
+        "message 1",
+        "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798",
+        "0d8b6e987bc4828126a32ddd07c4e86ac7d2540f8622c995df60568508a6ee97"
+        "bc8668b91cd745c99d35d95bba6922ef5e6bc886c79cae2f508d6677f015e725"
+    },
+    {
+        "message 239",
+        "03f973a0b87062c389d125d8199e803b832b6ac6bf7867a4f6cd87506060fc4c58",
+        "a478ac841013cec9a23c8014c9b900d08a97d7c9564848245f7b622f7c7e829c"
+        "922bcbb6bd7d39fe84b33e4f4ba28a6203c6bb301837fdadb663b6dcaa948841"
+    },
+    {
+        "message 16",
+        "020a1fc1183e4e80e45544958e185e23e816702a0f9400e1ef30bc6546e7b481b1",
+        "e6753fc7a2d1f5bad403532a5930c8499306191a7b34c17103defdbdcaa4ff68"
+        "0d5052d46c1f85b93076bae0e885d1bfa16031045454440d10dfcbf1fd69e1e9"
+    }
+};
+
+// A deterministic signature (RFC 6979) with low s, computed with a Python implementation of RFC 6979
+struct
+{
+    char const * prvKey;
+    char const * message;
+    char const * hash;
+    char const * signature;
+} const SIGN_CASE =
+{
+    "1234567890abcdef1234567890abcdef1234567890abcdef1234567890abcdef",
+    "message 1",
+    "b526aef1a341cfe6e5c377ed4c222888eeb81f913a107110a867e009c1758f24",
+    "417e5dc0fb2ce038425d87093335281822bdbf31086931c5de2503a91bb24b68"
+    "6560048b872631d4ea06dfe9ab19e85d412b76a877fbb65d9c1b38e584ab945d"
+};
+
+// A signature where x(R) = r + n (the same as in CryptoSecp256k1Test.verify_rPlusN)
+struct
+{
+    char const * hash;
+    char const * pubKey;
+    char const * signature;
+} const R_PLUS_N_CASE =
+{
+    "470041d283562aa0a2953dac1bb58b3cce881e0b842d90eb8798ef81704cbe76",
+    "04cbf22c2273cdc689ab9eec3d99611e2569c27a9d970c6e996bd8ffa3d63487be"
+    "d532030c73c4f191696abdbf9df8994c8b364574c19efa4f78840f5124ea756c",
+    "0000000000000000000000000000000000000000000000000000000000000002"
+    "7c2cd6cc3f97f15f0a6fc9f5e943565043e3e69edfa1e4f70a337a2a3789169d"
+};
+
+// The order of the curve
+char const N[] = "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141";
+
+// Returns a signature with s replaced by n - s, which is also valid
+Crypto::Ecc::Signature otherS(Crypto::Ecc::Signature const & signature)
+{
+    std::vector<uint8_t> n = Utility::fromHex(N);
+    Crypto::Ecc::Signature other = signature;
+    int borrow = 0;
+    for (int i = 31; i >= 0; --i)
+    {
+        int d = n[i] - signature[32 + i] - borrow;
+        borrow = d < 0;
+        other[32 + i] = (uint8_t)(d + (borrow ? 256 : 0));
+    }
+    return other;
+}
+
+// Vector 1 of BIP 340's test-vectors.csv
+struct
+{
+    char const * prvKey;
+    char const * pubKey;
+    char const * aux;
+    char const * message;
+    char const * signature;
+} const SCHNORR_CASE =
+{
+    "b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef",
+    "dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659",
+    "0000000000000000000000000000000000000000000000000000000000000001",
+    "243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89",
+    "6896bd60eeae296db48a229ff71dfe071bde413e6d43f917dc8dcf8c78de3341"
+    "8906d11ac976abccb20b091292bff4ea897efcb639ea871cfa95f6de339e4b0a"
+};
+} // anonymous namespace
+
+TEST(CryptoEccTest, backend)
+{
+    Crypto::Ecc::Backend original = Crypto::Ecc::backend();
+    EXPECT_TRUE(Crypto::Ecc::backendIsAvailable(original));
+    EXPECT_TRUE(Crypto::Ecc::backendIsAvailable(Crypto::Ecc::BACKEND_WOLFSSL));
+    for (int i = 0; i < Crypto::Ecc::NUM_BACKENDS; ++i)
+    {
+        Crypto::Ecc::Backend backend = (Crypto::Ecc::Backend)i;
+        EXPECT_EQ(Crypto::Ecc::selectBackend(backend), Crypto::Ecc::backendIsAvailable(backend));
+        EXPECT_NE(Crypto::Ecc::backendName(backend), nullptr);
+    }
+    EXPECT_STREQ(Crypto::Ecc::backendName(Crypto::Ecc::BACKEND_NATIVE), "native");
+    EXPECT_TRUE(Crypto::Ecc::selectBackend(original));
+}
+
 TEST(CryptoEccTest, publicKeyIsValid_ptr_size)
 {
-    GTEST_SKIP();
+    if (Crypto::Ecc::backend() != Crypto::Ecc::BACKEND_NATIVE)
+        GTEST_SKIP();
+
+    for (auto const & c : SIGNATURE_CASES)
+    {
+        std::vector<uint8_t> k = Utility::fromHex(c.pubKey);
+        EXPECT_TRUE(Crypto::Ecc::publicKeyIsValid(k.data(), k.size()));
+        EXPECT_FALSE(Crypto::Ecc::publicKeyIsValid(k.data(), k.size() - 1));
+        k[0] = 0x04;
+        EXPECT_FALSE(Crypto::Ecc::publicKeyIsValid(k.data(), k.size()));
+    }
 }
 
 TEST(CryptoEccTest, publicKeyIsValid_PublicKey)
 {
-    GTEST_SKIP();
+    if (Crypto::Ecc::backend() != Crypto::Ecc::BACKEND_NATIVE)
+        GTEST_SKIP();
+
+    // The genesis block's coinbase key
+    EXPECT_TRUE(Crypto::Ecc::publicKeyIsValid(Utility::fromHex(
+        "04678afdb0fe5548271967f1a67130b7105cd6a828e03909a67962e0ea1f61deb649f6bc3f4cef38c4f35504e51ec112de5c384df7ba0b8d"
+        "578a4c702b6bf11d5f")));
+    EXPECT_FALSE(Crypto::Ecc::publicKeyIsValid(Crypto::Ecc::PublicKey()));
 }
 
 TEST(CryptoEccTest, privateKeyIsValid_ptr_size)
 {
-    GTEST_SKIP();
+    if (Crypto::Ecc::backend() != Crypto::Ecc::BACKEND_NATIVE)
+        GTEST_SKIP();
+
+    // Valid keys are in [1, n-1]
+    std::vector<uint8_t> one = Utility::fromHex("0000000000000000000000000000000000000000000000000000000000000001");
+    std::vector<uint8_t> zero(Crypto::Ecc::PRIVATE_KEY_SIZE, 0);
+    std::vector<uint8_t> nMinus1 = Utility::fromHex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140");
+    std::vector<uint8_t> n = Utility::fromHex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141");
+    EXPECT_TRUE(Crypto::Ecc::privateKeyIsValid(one.data(), one.size()));
+    EXPECT_TRUE(Crypto::Ecc::privateKeyIsValid(nMinus1.data(), nMinus1.size()));
+    EXPECT_FALSE(Crypto::Ecc::privateKeyIsValid(zero.data(), zero.size()));
+    EXPECT_FALSE(Crypto::Ecc::privateKeyIsValid(n.data(), n.size()));
+    EXPECT_FALSE(Crypto::Ecc::privateKeyIsValid(one.data(), one.size() - 1));
 }
 
 TEST(CryptoEccTest, privateKeyIsValid_PrivateKey)
 {
-    GTEST_SKIP();
+    if (Crypto::Ecc::backend() != Crypto::Ecc::BACKEND_NATIVE)
+        GTEST_SKIP();
+
+    Crypto::Ecc::PrivateKey k;
+    k.fill(0);
+    EXPECT_FALSE(Crypto::Ecc::privateKeyIsValid(k));
+    k.back() = 1;
+    EXPECT_TRUE(Crypto::Ecc::privateKeyIsValid(k));
 }
 
 TEST(CryptoEccTest, derivePublicKey_PrivateKey)
 {
-    GTEST_SKIP();
+    if (Crypto::Ecc::backend() != Crypto::Ecc::BACKEND_NATIVE)
+        GTEST_SKIP();
+
+    Crypto::Ecc::PrivateKey k;
+    std::vector<uint8_t> bytes = Utility::fromHex("1234567890abcdef1234567890abcdef1234567890abcdef1234567890abcdef");
+    std::copy(bytes.begin(), bytes.end(), k.begin());
+
+    Crypto::Ecc::PublicKey pubKey;
+    EXPECT_TRUE(Crypto::Ecc::derivePublicKey(k, pubKey));
+    EXPECT_EQ(Utility::toHex(pubKey), "02bb50e2d89a4ed70663d080659fe0ad4b9bc3e06c17a227433966cb59ceee020d");
+    EXPECT_TRUE(Crypto::Ecc::derivePublicKey(k, pubKey, true));
+    EXPECT_EQ(Utility::toHex(pubKey),
+              "04bb50e2d89a4ed70663d080659fe0ad4b9bc3e06c17a227433966cb59ceee020d"
+              "ecddbf6e00192011648d13b1c00af770c0c1bb609d4d3a5c98a43772e0e18ef4");
+
+    k.fill(0);
+    EXPECT_FALSE(Crypto::Ecc::derivePublicKey(k, pubKey));
+    EXPECT_TRUE(pubKey.empty());
+}
+
+TEST(CryptoEccTest, derivePublicKeys)
+{
+    // Enough keys for several groups, some of them not valid
+    std::vector<Crypto::Ecc::PrivateKey> prvKeys(150);
+    for (size_t i = 0; i < prvKeys.size(); ++i)
+    {
+        prvKeys[i].fill(0);
+        prvKeys[i][0]  = (uint8_t)i;
+        prvKeys[i][31] = (uint8_t)(i % 7 == 3 ? 0 : i + 1);
+        if (i % 7 == 3)
+            prvKeys[i][0] = 0;
+    }
+
+    for (bool uncompressed : { false, true })
+    {
+        for (unsigned threads : { 1u, 3u })
+        {
+            Crypto::ThreadPool pool(threads);
+            std::vector<Crypto::Ecc::PublicKey> pubKeys;
+            EXPECT_FALSE(Crypto::Ecc::derivePublicKeys(prvKeys, pubKeys, uncompressed, pool));
+            ASSERT_EQ(pubKeys.size(), prvKeys.size());
+            for (size_t i = 0; i < prvKeys.size(); ++i)
+            {
+                Crypto::Ecc::PublicKey expected;
+                EXPECT_EQ(Crypto::Ecc::derivePublicKey(prvKeys[i], expected, uncompressed), !pubKeys[i].empty()) << i;
+                EXPECT_EQ(pubKeys[i], expected) << i;
+            }
+        }
+    }
+
+    // All valid
+    std::vector<Crypto::Ecc::PrivateKey> valid(prvKeys.begin(), prvKeys.begin() + 3);
+    std::vector<Crypto::Ecc::PublicKey> pubKeys;
+    EXPECT_TRUE(Crypto::Ecc::derivePublicKeys(valid, pubKeys));
+    ASSERT_EQ(pubKeys.size(), valid.size());
+    for (size_t i = 0; i < valid.size(); ++i)
+    {
+        Crypto::Ecc::PublicKey expected;
+        EXPECT_TRUE(Crypto::Ecc::derivePublicKey(valid[i], expected)) << i;
+        EXPECT_EQ(pubKeys[i], expected) << i;
+    }
+    EXPECT_TRUE(Crypto::Ecc::derivePublicKeys(nullptr, 0, nullptr));
 }
 
 TEST(CryptoEccTest, sign)
 {
-    GTEST_SKIP();
+    if (Crypto::Ecc::backend() != Crypto::Ecc::BACKEND_NATIVE)
+        GTEST_SKIP();
+
+    Crypto::Ecc::PrivateKey prvKey;
+    std::vector<uint8_t> bytes = Utility::fromHex(SIGN_CASE.prvKey);
+    std::copy(bytes.begin(), bytes.end(), prvKey.begin());
+    std::string message = SIGN_CASE.message;
+
+    Crypto::Ecc::Signature signature;
+    EXPECT_TRUE(Crypto::Ecc::sign((uint8_t const *)message.data(), message.size(), prvKey, signature));
+    EXPECT_EQ(Utility::toHex(signature), SIGN_CASE.signature);
+
+    prvKey.fill(0);
+    EXPECT_FALSE(Crypto::Ecc::sign((uint8_t const *)message.data(), message.size(), prvKey, signature));
+    EXPECT_TRUE(signature.empty());
+}
+
+TEST(CryptoEccTest, signHash)
+{
+    if (Crypto::Ecc::backend() != Crypto::Ecc::BACKEND_NATIVE)
+        GTEST_SKIP();
+
+    Crypto::Ecc::PrivateKey prvKey;
+    std::vector<uint8_t> bytes = Utility::fromHex(SIGN_CASE.prvKey);
+    std::copy(bytes.begin(), bytes.end(), prvKey.begin());
+    std::vector<uint8_t> hash = Utility::fromHex(SIGN_CASE.hash);
+
+    Crypto::Ecc::Signature signature;
+    EXPECT_TRUE(Crypto::Ecc::signHash(hash.data(), prvKey, signature));
+    EXPECT_EQ(Utility::toHex(signature), SIGN_CASE.signature);
+
+    // The result is deterministic and it verifies
+    Crypto::Ecc::Signature again;
+    EXPECT_TRUE(Crypto::Ecc::signHash(hash.data(), prvKey, again));
+    EXPECT_EQ(again, signature);
+    Crypto::Ecc::PublicKey pubKey;
+    ASSERT_TRUE(Crypto::Ecc::derivePublicKey(prvKey, pubKey));
+    std::string message = SIGN_CASE.message;
+    EXPECT_TRUE(Crypto::Ecc::verify((uint8_t const *)message.data(), message.size(), pubKey, signature));
+
+    // Keys that are 0 or not less than n are not valid
+    prvKey.fill(0);
+    EXPECT_FALSE(Crypto::Ecc::signHash(hash.data(), prvKey, signature));
+    EXPECT_TRUE(signature.empty());
+    prvKey.fill(0xff);
+    EXPECT_FALSE(Crypto::Ecc::signHash(hash.data(), prvKey, signature));
+}
+
+TEST(CryptoEccTest, signBatch)
+{
+    if (Crypto::Ecc::backend() != Crypto::Ecc::BACKEND_NATIVE)
+        GTEST_SKIP();
+
+    // Distinct keys and hashes, one key not valid
+    std::vector<Crypto::Ecc::PrivateKey> prvKeys(20);
+    std::vector<std::vector<uint8_t>> hashes(prvKeys.size());
+    for (size_t i = 0; i < prvKeys.size(); ++i)
+    {
+        prvKeys[i].fill((uint8_t)(i + 1));
+        hashes[i].assign(Crypto::Ecc::SIGNATURE_HASH_SIZE, (uint8_t)(0x80 + i));
+    }
+    prvKeys[7].fill(0);
+
+    for (unsigned threads : { 1u, 4u })
+    {
+        Crypto::ThreadPool pool(threads);
+        std::vector<Crypto::Ecc::SignJob> jobs;
+        for (size_t i = 0; i < prvKeys.size(); ++i)
+        {
+            jobs.push_back(Crypto::Ecc::SignJob{ hashes[i].data(), &prvKeys[i], Crypto::Ecc::Signature(), false });
+        }
+        EXPECT_FALSE(Crypto::Ecc::signBatch(jobs, pool));
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            Crypto::Ecc::Signature expected;
+            EXPECT_EQ(jobs[i].valid, Crypto::Ecc::signHash(hashes[i].data(), prvKeys[i], expected)) << i;
+            EXPECT_EQ(jobs[i].signature, expected) << i;
+        }
+        EXPECT_FALSE(jobs[7].valid);
+
+        jobs.erase(jobs.begin() + 7);
+        EXPECT_TRUE(Crypto::Ecc::signBatch(jobs, pool)) << threads;
+
+        // An empty batch is valid
+        EXPECT_TRUE(Crypto::Ecc::signBatch(nullptr, 0, pool));
+    }
 }
 
 TEST(CryptoEccTest, verify)
 {
-    GTEST_SKIP();
+    if (Crypto::Ecc::backend() != Crypto::Ecc::BACKEND_NATIVE)
+        GTEST_SKIP();
+
+    for (auto const & c : SIGNATURE_CASES)
+    {
+        std::vector<uint8_t> pubKey    = Utility::fromHex(c.pubKey);
+        std::vector<uint8_t> signature = Utility::fromHex(c.signature);
+        std::string          message   = c.message;
+        EXPECT_TRUE(Crypto::Ecc::verify((uint8_t const *)message.data(), message.size(), pubKey, signature));
+
+        message += "!";
+        EXPECT_FALSE(Crypto::Ecc::verify((uint8_t const *)message.data(), message.size(), pubKey, signature));
+    }
+}
+
+TEST(CryptoEccTest, backends)
+{
+    // Every available implementation must derive the same keys and accept each other's signatures
+    std::vector<Crypto::Ecc::Backend> backends;
+    for (int i = 0; i < Crypto::Ecc::NUM_BACKENDS; ++i)
+    {
+        if (Crypto::Ecc::backendIsAvailable((Crypto::Ecc::Backend)i))
+            backends.push_back((Crypto::Ecc::Backend)i);
+    }
+    if (backends.size() < 2)
+        GTEST_SKIP();
+
+    Crypto::Ecc::Backend original = Crypto::Ecc::backend();
+
+    std::vector<Crypto::Ecc::PrivateKey> prvKeys;
+    for (char const * hex : { SIGN_CASE.prvKey,
+                              "0000000000000000000000000000000000000000000000000000000000000001",
+                              "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140",
+                              "7fffffffffffffffffffffffffffffff5d576e7357a4501ddfe92f46681b20a0" })
+    {
+        std::vector<uint8_t> bytes = Utility::fromHex(hex);
+        Crypto::Ecc::PrivateKey k;
+        std::copy(bytes.begin(), bytes.end(), k.begin());
+        prvKeys.push_back(k);
+    }
+    std::vector<uint8_t> hash = Utility::fromHex(SIGN_CASE.hash);
+
+    // Public keys
+    std::vector<std::vector<Crypto::Ecc::PublicKey>> pubKeys(backends.size());
+    for (size_t b = 0; b < backends.size(); ++b)
+    {
+        ASSERT_TRUE(Crypto::Ecc::selectBackend(backends[b]));
+        for (auto const & k : prvKeys)
+        {
+            for (bool uncompressed : { false, true })
+            {
+                Crypto::Ecc::PublicKey pubKey;
+                EXPECT_TRUE(Crypto::Ecc::derivePublicKey(k, pubKey, uncompressed))
+                    << Crypto::Ecc::backendName(backends[b]);
+                pubKeys[b].push_back(pubKey);
+            }
+        }
+        EXPECT_EQ(pubKeys[b], pubKeys[0]) << Crypto::Ecc::backendName(backends[b]);
+    }
+
+    // Signatures made with one implementation, and their other-s forms, are verified by every implementation
+    for (size_t signer = 0; signer < backends.size(); ++signer)
+    {
+        for (size_t i = 0; i < prvKeys.size(); ++i)
+        {
+            ASSERT_TRUE(Crypto::Ecc::selectBackend(backends[signer]));
+            Crypto::Ecc::Signature signature;
+            ASSERT_TRUE(Crypto::Ecc::signHash(hash.data(), prvKeys[i], signature))
+                << Crypto::Ecc::backendName(backends[signer]) << ", " << i;
+            if (backends[signer] == Crypto::Ecc::BACKEND_NATIVE && i == 0)
+                EXPECT_EQ(Utility::toHex(signature), SIGN_CASE.signature);
+            Crypto::Ecc::Signature other = otherS(signature);
+            Crypto::Ecc::Signature altered = signature;
+            altered[63] ^= 1;
+
+            for (size_t verifier = 0; verifier < backends.size(); ++verifier)
+            {
+                ASSERT_TRUE(Crypto::Ecc::selectBackend(backends[verifier]));
+                Crypto::Ecc::PublicKey const & pubKey = pubKeys[0][2 * i];
+                EXPECT_TRUE(Crypto::Ecc::verifyHash(hash.data(), pubKey, signature))
+                    << Crypto::Ecc::backendName(backends[signer]) << ", "
+                    << Crypto::Ecc::backendName(backends[verifier]) << ", " << i;
+                EXPECT_TRUE(Crypto::Ecc::verifyHash(hash.data(), pubKey, other))
+                    << Crypto::Ecc::backendName(backends[signer]) << ", "
+                    << Crypto::Ecc::backendName(backends[verifier]) << ", " << i;
+                EXPECT_FALSE(Crypto::Ecc::verifyHash(hash.data(), pubKey, altered))
+                    << Crypto::Ecc::backendName(backends[signer]) << ", "
+                    << Crypto::Ecc::backendName(backends[verifier]) << ", " << i;
+            }
+        }
+    }
+
+    // A signature where x(R) = r + n is valid, but the same signature with r + n in place of r is not
+    std::vector<uint8_t> rPlusNHash = Utility::fromHex(R_PLUS_N_CASE.hash);
+    Crypto::Ecc::PublicKey rPlusNKey = Utility::fromHex(R_PLUS_N_CASE.pubKey);
+    Crypto::Ecc::Signature rPlusN = Utility::fromHex(R_PLUS_N_CASE.signature);
+    Crypto::Ecc::Signature rTooLarge = rPlusN;
+    std::vector<uint8_t> n = Utility::fromHex(N);
+    std::copy(n.begin(), n.end(), rTooLarge.begin());
+    rTooLarge[31] += 2;
+    for (auto backend : backends)
+    {
+        ASSERT_TRUE(Crypto::Ecc::selectBackend(backend));
+        EXPECT_TRUE(Crypto::Ecc::verifyHash(rPlusNHash.data(), rPlusNKey, rPlusN)) << Crypto::Ecc::backendName(backend);
+        EXPECT_FALSE(Crypto::Ecc::verifyHash(rPlusNHash.data(), rPlusNKey, rTooLarge)) << Crypto::Ecc::backendName(backend);
+    }
+
+    EXPECT_TRUE(Crypto::Ecc::selectBackend(original));
+}
+
+TEST(CryptoEccTest, verifyBatch)
+{
+    // Each case is used as is, with the wrong message, and with a truncated signature
+    std::vector<std::vector<uint8_t>> pubKeys;
+    std::vector<std::vector<uint8_t>> signatures;
+    std::vector<std::string> messages;
+    std::vector<bool> expected;
+    for (auto const & c : SIGNATURE_CASES)
+    {
+        std::vector<uint8_t> pubKey    = Utility::fromHex(c.pubKey);
+        std::vector<uint8_t> signature = Utility::fromHex(c.signature);
+
+        pubKeys.push_back(pubKey);
+        signatures.push_back(signature);
+        messages.push_back(c.message);
+        expected.push_back(true);
+
+        pubKeys.push_back(pubKey);
+        signatures.push_back(signature);
+        messages.push_back(std::string(c.message) + "!");
+        expected.push_back(false);
+
+        pubKeys.push_back(pubKey);
+        signatures.push_back(std::vector<uint8_t>(signature.begin(), signature.end() - 1));
+        messages.push_back(c.message);
+        expected.push_back(false);
+    }
+
+    for (unsigned threads : { 1u, 4u })
+    {
+        Crypto::ThreadPool pool(threads);
+
+        std::vector<Crypto::Ecc::VerifyJob> jobs;
+        for (size_t i = 0; i < messages.size(); ++i)
+        {
+            jobs.push_back(Crypto::Ecc::VerifyJob{ (uint8_t const *)messages[i].data(), messages[i].size(), &pubKeys[i],
+                                                   &signatures[i], !expected[i] });
+        }
+        EXPECT_FALSE(Crypto::Ecc::verifyBatch(jobs, pool));
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            EXPECT_EQ(jobs[i].valid, expected[i]) << threads << ", " << i;
+        }
+
+        // Only the valid signatures
+        std::vector<Crypto::Ecc::VerifyJob> validJobs;
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            if (expected[i])
+                validJobs.push_back(jobs[i]);
+        }
+        EXPECT_TRUE(Crypto::Ecc::verifyBatch(validJobs, pool)) << threads;
+
+        // An empty batch is valid
+        EXPECT_TRUE(Crypto::Ecc::verifyBatch(nullptr, 0, pool));
+    }
+}
+
+TEST(CryptoEccTest, PublicKeyCache_get)
+{
+    // The genesis block's coinbase key and a key that is not on the curve
+    std::vector<uint8_t> valid = Utility::fromHex(
+        "04678afdb0fe5548271967f1a67130b7105cd6a828e03909a67962e0ea1f61deb649f6bc3f4cef38c4f35504e51ec112de5c384df7ba0b8d"
+        "578a4c702b6bf11d5f");
+    std::vector<uint8_t> invalid(Crypto::Ecc::COMPRESSED_PUBLIC_KEY_SIZE, 0);
+    invalid[0] = 0x02;
+
+    Crypto::Ecc::PublicKeyCache cache(10);
+    EXPECT_EQ(cache.capacity(), 10u);
+    EXPECT_EQ(cache.size(), 0u);
+
+    auto p1 = cache.get(valid.data(), valid.size());
+    EXPECT_EQ(cache.misses(), 1u);
+    EXPECT_EQ(cache.hits(), 0u);
+    auto p2 = cache.get(valid.data(), valid.size());
+    EXPECT_EQ(cache.misses(), 1u);
+    EXPECT_EQ(cache.hits(), 1u);
+    EXPECT_EQ(p1, p2);
+
+    // Invalid keys are cached too
+    cache.get(invalid.data(), invalid.size());
+    cache.get(invalid.data(), invalid.size());
+    EXPECT_EQ(cache.misses(), 2u);
+    EXPECT_EQ(cache.hits(), 2u);
+    EXPECT_EQ(cache.size(), 2u);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_NE(cache.get(valid.data(), valid.size()), p1);
+    EXPECT_EQ(cache.misses(), 3u);
+}
+
+TEST(CryptoEccTest, PublicKeyCache_getBatch)
+{
+    std::vector<std::vector<uint8_t>> keys;
+    for (auto const & c : SIGNATURE_CASES)
+    {
+        keys.push_back(Utility::fromHex(c.pubKey));
+    }
+    keys.push_back(std::vector<uint8_t>(Crypto::Ecc::COMPRESSED_PUBLIC_KEY_SIZE, 0));   // Not valid
+    keys.push_back(keys[0]);                                                            // Repeated
+
+    Crypto::Ecc::PublicKeyCache cache(10);
+    auto first = cache.get(keys[1].data(), keys[1].size());
+
+    std::vector<Crypto::Ecc::PublicKey const *> pointers;
+    for (auto const & k : keys)
+    {
+        pointers.push_back(&k);
+    }
+    std::vector<std::shared_ptr<Crypto::Ecc::ParsedPublicKey const>> parsed(keys.size());
+    cache.getBatch(pointers.data(), pointers.size(), parsed.data());
+    EXPECT_EQ(cache.hits(), 1u);
+    EXPECT_EQ(cache.misses(), 1u + keys.size() - 1);
+    EXPECT_EQ(cache.size(), keys.size() - 1);
+    EXPECT_EQ(parsed[1], first);
+
+    // The keys are found afterwards
+    for (size_t i = 0; i < keys.size() - 1; ++i)
+    {
+        EXPECT_NE(parsed[i], nullptr);
+        EXPECT_EQ(cache.get(keys[i].data(), keys[i].size()), parsed[i]) << i;
+    }
+    cache.getBatch(pointers.data(), pointers.size(), parsed.data());
+    EXPECT_EQ(cache.misses(), 1u + keys.size() - 1);
+
+    // Without caching
+    Crypto::Ecc::PublicKeyCache disabled(0);
+    disabled.getBatch(pointers.data(), pointers.size(), parsed.data());
+    EXPECT_EQ(disabled.size(), 0u);
+    EXPECT_NE(parsed[0], nullptr);
+    disabled.getBatch(nullptr, 0, nullptr);
+}
+
+TEST(CryptoEccTest, PublicKeyCache_eviction)
+{
+    std::vector<std::vector<uint8_t>> keys;
+    for (int i = 0; i < 5; ++i)
+    {
+        keys.push_back(std::vector<uint8_t>(Crypto::Ecc::COMPRESSED_PUBLIC_KEY_SIZE, (uint8_t)i));
+        keys.back()[0] = 0x02;
+    }
+
+    // The least recently used key is dropped when the cache is full
+    Crypto::Ecc::PublicKeyCache cache(3);
+    cache.get(keys[0].data(), keys[0].size());
+    cache.get(keys[1].data(), keys[1].size());
+    cache.get(keys[2].data(), keys[2].size());
+    cache.get(keys[0].data(), keys[0].size());  // keys[1] is now the least recently used
+    cache.get(keys[3].data(), keys[3].size());
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_EQ(cache.misses(), 4u);
+
+    cache.get(keys[0].data(), keys[0].size());
+    cache.get(keys[2].data(), keys[2].size());
+    cache.get(keys[3].data(), keys[3].size());
+    EXPECT_EQ(cache.misses(), 4u);
+    cache.get(keys[1].data(), keys[1].size());
+    EXPECT_EQ(cache.misses(), 5u);
+
+    // A capacity of 0 disables caching
+    Crypto::Ecc::PublicKeyCache disabled(0);
+    disabled.get(keys[0].data(), keys[0].size());
+    disabled.get(keys[0].data(), keys[0].size());
+    EXPECT_EQ(disabled.misses(), 2u);
+    EXPECT_EQ(disabled.size(), 0u);
+}
+
+TEST(CryptoEccTest, PublicKeyCache_threads)
+{
+    std::vector<std::vector<uint8_t>> keys;
+    for (int i = 0; i < 20; ++i)
+    {
+        keys.push_back(std::vector<uint8_t>(Crypto::Ecc::COMPRESSED_PUBLIC_KEY_SIZE, (uint8_t)i));
+        keys.back()[0] = 0x03;
+    }
+
+    Crypto::Ecc::PublicKeyCache cache(8);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&cache, &keys] {
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto const & k = keys[(size_t)i % keys.size()];
+                EXPECT_TRUE(cache.get(k.data(), k.size()) != nullptr);
+            }
+        });
+    }
+    for (auto & t : threads)
+    {
+        t.join();
+    }
+    EXPECT_EQ(cache.hits() + cache.misses(), 4000u);
+    EXPECT_LE(cache.size(), 8u);
+}
+
+TEST(CryptoEccTest, PublicKeyCache_shared)
+{
+    std::vector<uint8_t> k(Crypto::Ecc::COMPRESSED_PUBLIC_KEY_SIZE, 0x5a);
+    k[0] = 0x02;
+
+    // publicKeyIsValid() uses the shared cache
+    Crypto::Ecc::PublicKeyCache & cache = Crypto::Ecc::PublicKeyCache::shared();
+    uint64_t hits = cache.hits();
+    uint64_t misses = cache.misses();
+    bool valid = Crypto::Ecc::publicKeyIsValid(k);
+    EXPECT_EQ(Crypto::Ecc::publicKeyIsValid(k), valid);
+    EXPECT_EQ(cache.misses(), misses + 1);
+    EXPECT_EQ(cache.hits(), hits + 1);
+}
+
+TEST(CryptoEccTest, SignatureCache_insert)
+{
+    std::vector<uint8_t> hash(Crypto::Ecc::SIGNATURE_HASH_SIZE, 0x11);
+    std::vector<uint8_t> pubKey = Utility::fromHex(SIGNATURE_CASES[0].pubKey);
+    std::vector<uint8_t> signature = Utility::fromHex(SIGNATURE_CASES[0].signature);
+
+    Crypto::Ecc::SignatureCache cache(100);
+    EXPECT_EQ(cache.capacity(), 128u);
+    EXPECT_FALSE(cache.contains(hash.data(), pubKey, signature));
+    cache.insert(hash.data(), pubKey, signature);
+    EXPECT_TRUE(cache.contains(hash.data(), pubKey, signature));
+    EXPECT_EQ(cache.hits(), 1u);
+    EXPECT_EQ(cache.misses(), 1u);
+
+    // Any difference is a different entry
+    std::vector<uint8_t> other = hash;
+    other[31] ^= 1;
+    EXPECT_FALSE(cache.contains(other.data(), pubKey, signature));
+    std::vector<uint8_t> otherKey = Utility::fromHex(SIGNATURE_CASES[1].pubKey);
+    EXPECT_FALSE(cache.contains(hash.data(), otherKey, signature));
+    std::vector<uint8_t> truncated(signature.begin(), signature.end() - 1);
+    EXPECT_FALSE(cache.contains(hash.data(), pubKey, truncated));
+
+    // The key and signature are not simply concatenated
+    std::vector<uint8_t> longerKey = pubKey;
+    longerKey.push_back(signature[0]);
+    std::vector<uint8_t> shorterSignature(signature.begin() + 1, signature.end());
+    EXPECT_FALSE(cache.contains(hash.data(), longerKey, shorterSignature));
+
+    // Erasing
+    EXPECT_TRUE(cache.contains(hash.data(), pubKey, signature, true));
+    EXPECT_FALSE(cache.contains(hash.data(), pubKey, signature));
+
+    cache.insert(hash.data(), pubKey, signature);
+    cache.clear();
+    EXPECT_FALSE(cache.contains(hash.data(), pubKey, signature));
+
+    EXPECT_EQ(Crypto::Ecc::SignatureCache(0).capacity(), 4u);
+}
+
+TEST(CryptoEccTest, SignatureCache_eviction)
+{
+    std::vector<uint8_t> pubKey = Utility::fromHex(SIGNATURE_CASES[0].pubKey);
+    std::vector<uint8_t> signature = Utility::fromHex(SIGNATURE_CASES[0].signature);
+
+    // Far more signatures than entries. At most 16 are found, and the most recent one always is.
+    Crypto::Ecc::SignatureCache cache(16);
+    std::vector<std::vector<uint8_t>> hashes;
+    for (int i = 0; i < 200; ++i)
+    {
+        hashes.push_back(std::vector<uint8_t>(Crypto::Ecc::SIGNATURE_HASH_SIZE, 0));
+        hashes.back()[0] = (uint8_t)i;
+        cache.insert(hashes.back().data(), pubKey, signature);
+        EXPECT_TRUE(cache.contains(hashes.back().data(), pubKey, signature));
+    }
+    size_t found = 0;
+    for (auto const & h : hashes)
+    {
+        if (cache.contains(h.data(), pubKey, signature))
+            ++found;
+    }
+    EXPECT_GT(found, 0u);
+    EXPECT_LE(found, 16u);
+}
+
+TEST(CryptoEccTest, SignatureCache_threads)
+{
+    std::vector<uint8_t> pubKey = Utility::fromHex(SIGNATURE_CASES[0].pubKey);
+    std::vector<uint8_t> signature = Utility::fromHex(SIGNATURE_CASES[0].signature);
+
+    // Each thread inserts its own signatures, with enough room for all of them
+    Crypto::Ecc::SignatureCache cache(1 << 12);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&cache, &pubKey, &signature, t] {
+            std::vector<uint8_t> hash(Crypto::Ecc::SIGNATURE_HASH_SIZE, (uint8_t)t);
+            for (int i = 0; i < 100; ++i)
+            {
+                hash[0] = (uint8_t)i;
+                cache.insert(hash.data(), pubKey, signature);
+                cache.contains(hash.data(), pubKey, signature);
+            }
+        });
+    }
+    for (auto & t : threads)
+    {
+        t.join();
+    }
+    EXPECT_EQ(cache.hits() + cache.misses(), 400u);
+    EXPECT_GT(cache.hits(), 390u);
+}
+
+TEST(CryptoEccTest, verifyHashCached)
+{
+    if (Crypto::Ecc::backend() != Crypto::Ecc::BACKEND_NATIVE)
+        GTEST_SKIP();
+
+    Crypto::Ecc::SignatureCache cache(64);
+    for (auto const & c : SIGNATURE_CASES)
+    {
+        std::vector<uint8_t> pubKey    = Utility::fromHex(c.pubKey);
+        std::vector<uint8_t> signature = Utility::fromHex(c.signature);
+        std::string          message   = c.message;
+        Crypto::Sha256Hash   hash      = Crypto::sha256((uint8_t const *)message.data(), message.size());
+        EXPECT_TRUE(Crypto::Ecc::verifyHash(hash.data(), pubKey, signature));
+
+        // Mempool acceptance stores the signature, and connecting the block finds it and removes it
+        EXPECT_TRUE(Crypto::Ecc::verifyHashCached(hash.data(), pubKey, signature, true, cache));
+        EXPECT_TRUE(cache.contains(hash.data(), pubKey, signature));
+        uint64_t hits = cache.hits();
+        EXPECT_TRUE(Crypto::Ecc::verifyHashCached(hash.data(), pubKey, signature, false, cache));
+        EXPECT_EQ(cache.hits(), hits + 1);
+        EXPECT_FALSE(cache.contains(hash.data(), pubKey, signature));
+
+        // Not valid signatures are not stored
+        hash[0] ^= 1;
+        EXPECT_FALSE(Crypto::Ecc::verifyHashCached(hash.data(), pubKey, signature, true, cache));
+        EXPECT_FALSE(cache.contains(hash.data(), pubKey, signature));
+    }
+}
+
+TEST(CryptoEccTest, deriveXOnlyPublicKey)
+{
+    if (!Crypto::Ecc::backendIsAvailable(Crypto::Ecc::BACKEND_NATIVE))
+        GTEST_SKIP();
+
+    Crypto::Ecc::PrivateKey prvKey;
+    std::vector<uint8_t> bytes = Utility::fromHex(SCHNORR_CASE.prvKey);
+    std::copy(bytes.begin(), bytes.end(), prvKey.begin());
+    Crypto::Ecc::PublicKey pubKey;
+    EXPECT_TRUE(Crypto::Ecc::deriveXOnlyPublicKey(prvKey, pubKey));
+    EXPECT_EQ(Utility::toHex(pubKey), SCHNORR_CASE.pubKey);
+
+    prvKey.fill(0);
+    EXPECT_FALSE(Crypto::Ecc::deriveXOnlyPublicKey(prvKey, pubKey));
+    EXPECT_TRUE(pubKey.empty());
+}
+
+TEST(CryptoEccTest, schnorrSign)
+{
+    if (!Crypto::Ecc::backendIsAvailable(Crypto::Ecc::BACKEND_NATIVE))
+        GTEST_SKIP();
+
+    Crypto::Ecc::PrivateKey prvKey;
+    std::vector<uint8_t> bytes = Utility::fromHex(SCHNORR_CASE.prvKey);
+    std::copy(bytes.begin(), bytes.end(), prvKey.begin());
+    std::vector<uint8_t> aux     = Utility::fromHex(SCHNORR_CASE.aux);
+    std::vector<uint8_t> message = Utility::fromHex(SCHNORR_CASE.message);
+    std::vector<uint8_t> pubKey  = Utility::fromHex(SCHNORR_CASE.pubKey);
+
+    Crypto::Ecc::Signature signature;
+    EXPECT_TRUE(Crypto::Ecc::schnorrSign(message.data(), message.size(), prvKey, signature, aux.data()));
+    EXPECT_EQ(Utility::toHex(signature), SCHNORR_CASE.signature);
+
+    // With random auxiliary data, the signature is different, but it verifies
+    Crypto::Ecc::Signature randomized;
+    EXPECT_TRUE(Crypto::Ecc::schnorrSign(message.data(), message.size(), prvKey, randomized));
+    EXPECT_NE(randomized, signature);
+    EXPECT_TRUE(Crypto::Ecc::schnorrVerify(message.data(), message.size(), pubKey, randomized));
+
+    // Keys that are 0 or not less than n are not valid
+    prvKey.fill(0);
+    EXPECT_FALSE(Crypto::Ecc::schnorrSign(message.data(), message.size(), prvKey, signature, aux.data()));
+    EXPECT_TRUE(signature.empty());
+    prvKey.fill(0xff);
+    EXPECT_FALSE(Crypto::Ecc::schnorrSign(message.data(), message.size(), prvKey, signature, aux.data()));
+}
+
+TEST(CryptoEccTest, schnorrVerify)
+{
+    if (!Crypto::Ecc::backendIsAvailable(Crypto::Ecc::BACKEND_NATIVE))
+        GTEST_SKIP();
+
+    std::vector<uint8_t> message   = Utility::fromHex(SCHNORR_CASE.message);
+    std::vector<uint8_t> pubKey    = Utility::fromHex(SCHNORR_CASE.pubKey);
+    std::vector<uint8_t> signature = Utility::fromHex(SCHNORR_CASE.signature);
+    EXPECT_TRUE(Crypto::Ecc::schnorrVerify(message.data(), message.size(), pubKey, signature));
+
+    // Wrong message, and keys and signatures of the wrong size
+    std::vector<uint8_t> wrong = message;
+    wrong[0] ^= 1;
+    EXPECT_FALSE(Crypto::Ecc::schnorrVerify(wrong.data(), wrong.size(), pubKey, signature));
+    std::vector<uint8_t> compressed = pubKey;
+    compressed.insert(compressed.begin(), 0x02);
+    EXPECT_FALSE(Crypto::Ecc::schnorrVerify(message.data(), message.size(), compressed, signature));
+    std::vector<uint8_t> truncated(signature.begin(), signature.end() - 1);
+    EXPECT_FALSE(Crypto::Ecc::schnorrVerify(message.data(), message.size(), pubKey, truncated));
+}
+
+TEST(CryptoEccTest, schnorrVerifyBatch)
+{
+    if (!Crypto::Ecc::backendIsAvailable(Crypto::Ecc::BACKEND_NATIVE))
+        GTEST_SKIP();
+
+    // Enough signatures for several groups, signed by different keys
+    size_t const COUNT = 300;
+    std::vector<std::vector<uint8_t>> messages(COUNT);
+    std::vector<Crypto::Ecc::PublicKey> pubKeys(COUNT);
+    std::vector<Crypto::Ecc::Signature> signatures(COUNT);
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        Crypto::Ecc::PrivateKey prvKey;
+        prvKey.fill(0);
+        prvKey[30] = (uint8_t)((i + 1) >> 8);
+        prvKey[31] = (uint8_t)(i + 1);
+        messages[i].assign(i % 50, (uint8_t)i);
+        ASSERT_TRUE(Crypto::Ecc::deriveXOnlyPublicKey(prvKey, pubKeys[i]));
+        ASSERT_TRUE(Crypto::Ecc::schnorrSign(messages[i].data(), messages[i].size(), prvKey, signatures[i]));
+    }
+
+    // Some of the signatures are not valid, and one is the wrong size
+    std::vector<bool> expected(COUNT, true);
+    for (size_t i : { 5, 140, 141, 299 })
+    {
+        signatures[i][40] ^= 1;
+        expected[i] = false;
+    }
+    signatures[200].pop_back();
+    expected[200] = false;
+
+    for (unsigned threads : { 1u, 4u })
+    {
+        Crypto::ThreadPool pool(threads);
+
+        std::vector<Crypto::Ecc::SchnorrVerifyJob> jobs;
+        for (size_t i = 0; i < COUNT; ++i)
+        {
+            jobs.push_back(Crypto::Ecc::SchnorrVerifyJob{ messages[i].data(), messages[i].size(), &pubKeys[i],
+                                                          &signatures[i], !expected[i] });
+        }
+        EXPECT_FALSE(Crypto::Ecc::schnorrVerifyBatch(jobs, pool));
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            EXPECT_EQ(jobs[i].valid, expected[i]) << threads << ", " << i;
+        }
+
+        // Only the valid signatures
+        std::vector<Crypto::Ecc::SchnorrVerifyJob> validJobs;
+        for (size_t i = 0; i < COUNT; ++i)
+        {
+            if (expected[i])
+                validJobs.push_back(jobs[i]);
+        }
+        EXPECT_TRUE(Crypto::Ecc::schnorrVerifyBatch(validJobs, pool));
+        for (auto const & job : validJobs)
+        {
+            EXPECT_TRUE(job.valid);
+        }
+
+        std::vector<Crypto::Ecc::SchnorrVerifyJob> none;
+        EXPECT_TRUE(Crypto::Ecc::schnorrVerifyBatch(none, pool));
+    }
 }
 
 int main(int argc, char ** argv)
@@ -75,8 +75,70 @@ HmacSha512TestCase const HMACSHA512_CASES[] =
         }
     }
 };
+
+// From RFC 4231
+struct HmacSha256TestCase
+{
+    char const * key;           // note: in hex
+    char const * message;       // note: in hex
+    char const * expected;      // note: in hex
+};
+
+HmacSha256TestCase const HMACSHA256_CASES[] =
+{
+    {
+        "0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b",
+        "4869205468657265",
+        "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7"
+    },
+    {
+        "4a656665",
+        "7768617420646f2079612077616e7420666f72206e6f7468696e673f",
+        "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"
+    },
+    {
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+        "dddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddd",
+        "773ea91e36800e46854db8ebd09181a72959098b3ef8c122d9635514ced565fe"
+    },
+    {
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+        "54657374205573696e67204c6172676572205468616e20426c6f636b2d53697a65204b6579202d2048617368204b6579204669727374",
+        "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"
+    }
+};
 } // anonymous namespace
 
+TEST(CryptoHmacTest, hmacSha256)
+{
+    for (auto const & c : HMACSHA256_CASES)
+    {
+        std::vector<uint8_t> key     = Utility::fromHex(c.key, strlen(c.key));
+        std::vector<uint8_t> message = Utility::fromHex(c.message, strlen(c.message));
+        Crypto::Sha256Hash   result  = Crypto::hmacSha256(key.data(), key.size(), message.data(), message.size());
+        EXPECT_EQ(Utility::toHex(result), c.expected);
+    }
+}
+
+TEST(CryptoHmacTest, HmacSha256)
+{
+    for (auto const & c : HMACSHA256_CASES)
+    {
+        std::vector<uint8_t> key     = Utility::fromHex(c.key, strlen(c.key));
+        std::vector<uint8_t> message = Utility::fromHex(c.message, strlen(c.message));
+        Crypto::HmacSha256   hmac(key);
+
+        // The keyed state is reused
+        for (int i = 0; i < 2; ++i)
+        {
+            EXPECT_EQ(Utility::toHex(hmac.mac(message)), c.expected);
+        }
+        EXPECT_EQ(hmac.mac(message.data(), 0), Crypto::hmacSha256(key.data(), key.size(), nullptr, 0));
+    }
+}
+
 TEST(CryptoHmacTest, hmacSha512)
 {
     for (auto const & c : HMACSHA512_CASES)
@@ -88,6 +150,24 @@ TEST(CryptoHmacTest, hmacSha512)
     }
 }
 
+TEST(CryptoHmacTest, HmacSha512)
+{
+    for (auto const & c : HMACSHA512_CASES)
+    {
+        std::vector<uint8_t> key     = Utility::fromHex(c.key, strlen(c.key));
+        std::vector<uint8_t> message = Utility::fromHex(c.message, strlen(c.message));
+        Crypto::HmacSha512   hmac(key);
+
+        // The keyed state is reused
+        for (int i = 0; i < 2; ++i)
+        {
+            Crypto::Sha512Hash result = hmac.mac(message);
+            EXPECT_TRUE(std::equal(result.begin(), result.end(), c.expected));
+        }
+        EXPECT_EQ(hmac.mac(message.data(), 0), Crypto::hmacSha512(key.data(), key.size(), nullptr, 0));
+    }
+}
+
 int main(int argc, char ** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
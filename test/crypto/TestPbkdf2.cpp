@@ -1,4 +1,7 @@
+#include "crypto/Hmac.h"
 #include "crypto/Pbkdf2.h"
+#include "crypto/Sha512.h"
+#include "crypto/ThreadPool.h"
 #include "utility/Utility.h"
 
 #include <gtest/gtest.h>
@@ -278,6 +281,86 @@ TEST(CryptoPbkdf2Test, pbkdf2HmacSha512_vector)
     }
 }
 
+TEST(CryptoPbkdf2Test, pbkdf2HmacSha512_size)
+{
+    // Generated with Python: hashlib.pbkdf2_hmac('sha512', b'password', b'salt', 2, 100)
+    std::vector<uint8_t> expected =
+        Utility::fromHex("e1d9c16aa681708a45f5c7c4e215ceb66e011a2e9f0040713f18aefdb866d53cf76cab2868a39b9f7840edce4fef5a"
+                         "82be67335c77a6068e04112754f27ccf4e473e311ad827b68945f4e2dddb204c78e40e2495141e411cd272d02064"
+                         "0d673cd34aa29f");
+    std::vector<uint8_t> password = { 'p', 'a', 's', 's', 'w', 'o', 'r', 'd' };
+    std::vector<uint8_t> salt     = { 's', 'a', 'l', 't' };
+
+    EXPECT_EQ(Crypto::pbkdf2HmacSha512(password, salt, 2, 100), expected);
+    EXPECT_EQ(Crypto::pbkdf2HmacSha512(password, salt, 2, 20), std::vector<uint8_t>(expected.begin(), expected.begin() + 20));
+}
+
+TEST(CryptoPbkdf2Test, pbkdf2HmacSha512_saltSize)
+{
+    // With one iteration, the first block of the key is HMAC(P, S || INT(1)). The salt sizes cross the block boundaries
+    // of the inner hash, and the password is longer than a block.
+    std::vector<uint8_t> password(200, 'p');
+    for (size_t size = 0; size <= 260; ++size)
+    {
+        std::vector<uint8_t> salt(size, (uint8_t)size);
+        std::vector<uint8_t> message = salt;
+        message.insert(message.end(), { 0, 0, 0, 1 });
+        Crypto::Sha512Hash expected = Crypto::hmacSha512(password.data(), password.size(), message.data(), message.size());
+        std::vector<uint8_t> key = Crypto::pbkdf2HmacSha512(password, salt, 1, 64);
+        EXPECT_TRUE(std::equal(key.begin(), key.end(), expected.begin())) << size;
+    }
+}
+
+TEST(CryptoPbkdf2Test, pbkdf2HmacSha512Batch)
+{
+    std::vector<std::vector<uint8_t>> passwords;
+    std::vector<std::vector<uint8_t>> salts;
+    std::vector<uint8_t const *> expected;
+    for (auto const & c : PBKDF2HMACSHA512_CASES)
+    {
+        if (c.count > 1)
+            continue;
+        passwords.emplace_back(c.password, c.password + strlen(c.password));
+        salts.emplace_back(c.salt, c.salt + strlen(c.salt));
+        expected.push_back(c.expected);
+    }
+
+    // Every implementation and several thread counts, with batch sizes that leave partial groups of lanes
+    Crypto::Sha512Backend original = Crypto::sha512Backend();
+    for (int b = 0; b < Crypto::NUM_SHA512_BACKENDS; ++b)
+    {
+        Crypto::Sha512Backend backend = (Crypto::Sha512Backend)b;
+        if (!Crypto::selectSha512Backend(backend))
+            continue;
+
+        for (unsigned threads : { 1u, 3u })
+        {
+            Crypto::ThreadPool pool(threads);
+            for (size_t n = 0; n <= passwords.size(); ++n)
+            {
+                std::vector<std::vector<uint8_t>> p(passwords.begin(), passwords.begin() + n);
+                std::vector<std::vector<uint8_t>> s(salts.begin(), salts.begin() + n);
+                std::vector<std::vector<uint8_t>> keys = Crypto::pbkdf2HmacSha512Batch(p, s, 1, 64, pool);
+                ASSERT_EQ(keys.size(), n);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    EXPECT_TRUE(std::equal(keys[i].begin(), keys[i].end(), expected[i]))
+                        << Crypto::sha512BackendName(backend) << ", " << threads << ", " << n << ", " << i;
+                }
+            }
+        }
+
+        // Multiple iterations and keys longer than a block
+        std::vector<std::vector<uint8_t>> keys = Crypto::pbkdf2HmacSha512Batch(passwords, salts, 100, 130);
+        for (size_t i = 0; i < passwords.size(); ++i)
+        {
+            EXPECT_EQ(keys[i], Crypto::pbkdf2HmacSha512(passwords[i], salts[i], 100, 130))
+                << Crypto::sha512BackendName(backend) << ", " << i;
+        }
+    }
+    Crypto::selectSha512Backend(original);
+}
+
 int main(int argc, char ** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
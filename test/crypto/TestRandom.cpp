@@ -3,6 +3,10 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+#include <thread>
+#include <vector>
+
 using namespace Crypto;
 
 namespace
@@ -15,12 +19,26 @@ namespace
 
 TEST(CryptoRandomTest, status)
 {
-    GTEST_SKIP();
+    EXPECT_TRUE(Random::status());
 }
 
 TEST(CryptoRandomTest, addEntropy)
 {
-    GTEST_SKIP();
+    uint8_t buffer1[SIZE];
+    Random::getBytes(buffer1, SIZE);
+
+    // Adding the same entropy twice still results in different output
+    uint8_t const entropy[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    Random::addEntropy(entropy, sizeof(entropy), 0.0);
+    uint8_t buffer2[SIZE];
+    Random::getBytes(buffer2, SIZE);
+    Random::addEntropy(entropy, sizeof(entropy), 0.0);
+    uint8_t buffer3[SIZE];
+    Random::getBytes(buffer3, SIZE);
+
+    EXPECT_FALSE(std::equal(buffer1, buffer1 + SIZE, buffer2));
+    EXPECT_FALSE(std::equal(buffer2, buffer2 + SIZE, buffer3));
+    EXPECT_TRUE(Random::status());
 }
 
 TEST(CryptoRandomTest, getBytes)
@@ -45,6 +63,61 @@ TEST(CryptoRandomTest, getBytes)
     EXPECT_TRUE(buffer1[SAFE_SIZE - 1] != 0 || buffer2[SAFE_SIZE - 1] != 0);
 }
 
+TEST(CryptoRandomTest, getBytes_large)
+{
+    // Larger than the internal buffer and not a multiple of the block size
+    std::vector<uint8_t> buffer(10000 + 13, 0);
+    Random::getBytes(buffer.data(), buffer.size() - 1);
+    EXPECT_EQ(buffer.back(), 0);
+
+    // Roughly uniform: each byte value occurs about 39 times
+    size_t counts[256] = { 0 };
+    for (size_t i = 0; i < buffer.size() - 1; ++i)
+    {
+        ++counts[buffer[i]];
+    }
+    for (size_t c : counts)
+    {
+        EXPECT_GT(c, 5u);
+        EXPECT_LT(c, 100u);
+    }
+
+    Random::getBytes(nullptr, 0);
+}
+
+TEST(CryptoRandomTest, getUint64)
+{
+    std::set<uint64_t> values;
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.insert(Random::getUint64());
+    }
+    EXPECT_EQ(values.size(), 1000u);
+}
+
+TEST(CryptoRandomTest, threads)
+{
+    // Each thread has its own generator, and they must not produce the same bytes
+    size_t constexpr THREADS = 4;
+    std::vector<std::vector<uint8_t>> buffers(THREADS, std::vector<uint8_t>(SIZE));
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREADS; ++i)
+    {
+        threads.emplace_back([&buffers, i] () {
+            for (int j = 0; j < 100; ++j)
+            {
+                Random::getBytes(buffers[i].data(), buffers[i].size());
+            }
+        });
+    }
+    for (auto & t : threads)
+    {
+        t.join();
+    }
+    std::set<std::vector<uint8_t>> unique(buffers.begin(), buffers.end());
+    EXPECT_EQ(unique.size(), THREADS);
+}
+
 int main(int argc, char ** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
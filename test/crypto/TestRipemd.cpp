@@ -1,4 +1,5 @@
 #include "crypto/Ripemd.h"
+#include "crypto/Sha256.h"
 #include "utility/Utility.h"
 
 #include <gtest/gtest.h>
@@ -82,6 +83,83 @@ TEST(CryptoRipemdTest, ripemd160_array)
     EXPECT_TRUE(std::equal(result.begin(), result.end(), expected));
 }
 
+TEST(CryptoRipemdTest, ripemd160_million_a)
+{
+    std::vector<uint8_t> input(1000000, 'a');
+    EXPECT_EQ(toHex(Crypto::ripemd160(input)), "52783243c1697bdbe16d37f97f68f08325dc1528");
+}
+
+TEST(CryptoRipemdTest, ripemd160_padding)
+{
+    // Lengths of 'a's around the boundaries where the padding needs a second block
+    struct
+    {
+        size_t length;
+        char const * expected;
+    } const CASES[] =
+    {
+        {  55, "0d8a8c9063a48576a7c97e9f95253a6e53ff6765" },
+        {  56, "e72334b46c83cc70bef979e15453706c95b888be" },
+        {  63, "e640041293fe663b9bf3f8c21ffecac03819e6b2" },
+        {  64, "9dfb7d374ad924f3f88de96291c33e9abed53e32" },
+        { 119, "23e398ff2bac815aa1bbb57ca2a669c841872919" },
+        { 120, "c476770a6dae31fcee8d25efe6559a05c8024595" }
+    };
+
+    for (auto const & c : CASES)
+    {
+        std::vector<uint8_t> input(c.length, 'a');
+        EXPECT_EQ(toHex(Crypto::ripemd160(input)), c.expected) << c.length;
+    }
+}
+
+TEST(CryptoRipemdTest, hash160)
+{
+    // The public key and the address of the genesis block coinbase
+    std::vector<uint8_t> publicKey = fromHex(
+        "04678afdb0fe5548271967f1a67130b7105cd6a828e03909a67962e0ea1f61deb649f6bc3f4cef38c4f35504e51ec112de5c384df7ba0b8d"
+        "578a4c702b6bf11d5f");
+    EXPECT_EQ(toHex(Crypto::hash160(publicKey)), "62e907b15cbf27d5425399ebf6f0fb50ebb88f18");
+    EXPECT_EQ(Crypto::hash160(publicKey.data(), publicKey.size()), Crypto::ripemd160(Crypto::sha256(publicKey)));
+
+    std::array<uint8_t, 3> input = { 'a', 'b', 'c' };
+    EXPECT_EQ(Crypto::hash160(input), Crypto::ripemd160(Crypto::sha256(input)));
+}
+
+TEST(CryptoRipemdTest, hash160Batch)
+{
+    // Messages of many lengths, enough for several chunks and a partial group of lanes
+    std::vector<std::vector<uint8_t>> inputs;
+    for (size_t i = 0; i < 150; ++i)
+    {
+        std::vector<uint8_t> input(i % 70 + (i % 3 == 0 ? 33 : 0));
+        for (size_t j = 0; j < input.size(); ++j)
+        {
+            input[j] = (uint8_t)(i * 31 + j);
+        }
+        inputs.push_back(input);
+    }
+
+    Sha256Backend original = sha256BatchBackend();
+    for (int backend = 0; backend < NUM_SHA256_BACKENDS; ++backend)
+    {
+        if (!selectSha256BatchBackend((Sha256Backend)backend))
+            continue;
+
+        for (size_t n : { (size_t)0, (size_t)1, (size_t)15, (size_t)17, inputs.size() })
+        {
+            std::vector<std::vector<uint8_t>> subset(inputs.begin(), inputs.begin() + n);
+            Ripemd160HashList hashes = hash160Batch(subset);
+            ASSERT_EQ(hashes.size(), n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                EXPECT_EQ(hashes[i], Crypto::hash160(subset[i])) << sha256BackendName((Sha256Backend)backend) << " " << i;
+            }
+        }
+    }
+    selectSha256BatchBackend(original);
+}
+
 int main(int argc, char ** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
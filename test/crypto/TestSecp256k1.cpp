@@ -0,0 +1,773 @@
+#include "crypto/Secp256k1.h"
+#include "utility/Utility.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#if defined(CRYPTO_SECP256K1_NATIVE)
+
+using namespace Crypto::Secp256k1;
+
+namespace
+{
+// Expected values were computed with Python's arbitrary-precision integers
+
+Field fieldFromHex(char const * x)
+{
+    Field a;
+    EXPECT_TRUE(fieldSetBytes(a, Utility::fromHex(x).data()));
+    return a;
+}
+
+std::string toHex(Field const & a)
+{
+    uint8_t bytes[32];
+    fieldGetBytes(a, bytes);
+    return Utility::toHex(bytes, sizeof(bytes));
+}
+
+Scalar scalarFromHex(char const * x)
+{
+    Scalar a;
+    EXPECT_FALSE(scalarSetBytes(a, Utility::fromHex(x).data()));
+    return a;
+}
+
+std::string toHex(Scalar const & a)
+{
+    uint8_t bytes[32];
+    scalarGetBytes(a, bytes);
+    return Utility::toHex(bytes, sizeof(bytes));
+}
+
+std::string toHex(AffinePoint const & p, bool compressed)
+{
+    uint8_t bytes[65];
+    size_t  size = serializePublicKey(p, compressed, bytes);
+    return Utility::toHex(bytes, size);
+}
+
+char const P[]     = "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f";
+char const N[]     = "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141";
+char const ZERO[]  = "0000000000000000000000000000000000000000000000000000000000000000";
+char const X[]     = "a170b33839263059f28c105d1fb17c2390c192cfd3ac94af0f21ddb66cad4a26";
+char const Y[]     = "0cb1e29c658cda1495e60af593bd04cf0fd630f1f29d0da9953f48f1a09f76b5";
+char const A[]     = "36f675cc81e74ef5e8e25d940ed904759531985d5d9dc9f81818e811892f902b";
+char const B[]     = "8d116ece1738f7d93d9c172411e20b8f6b0d549b6f03675a1600a35a099950d8";
+
+struct DeriveTestCase
+{
+    char const * privateKey;
+    char const * compressed;
+    char const * uncompressed;
+};
+
+DeriveTestCase const DERIVE_CASES[] =
+{
+    {
+        "0000000000000000000000000000000000000000000000000000000000000001",
+        "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798",
+        "0479be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"
+        "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8"
+    },
+    {
+        "0000000000000000000000000000000000000000000000000000000000000002",
+        "02c6047f9441ed7d6d3045406e95c07cd85c778e4b8cef3ca7abac09b95c709ee5",
+        "04c6047f9441ed7d6d3045406e95c07cd85c778e4b8cef3ca7abac09b95c709ee5"
+        "1ae168fea63dc339a3c58419466ceaeef7f632653266d0e1236431a950cfe52a"
+    },
+    {
+        "0000000000000000000000000000000000000000000000000000000000000003",
+        "02f9308a019258c31049344f85f89d5229b531c845836f99b08601f113bce036f9",
+        "04f9308a019258c31049344f85f89d5229b531c845836f99b08601f113bce036f9"
+        "388f7b0f632de8140fe337e62a37f3566500a99934c2231b6cb9fd7584b8e672"
+    },
+    {
+        "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140",
+        "0379be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798",
+        "0479be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"
+        "b7c52588d95c3b9aa25b0403f1eef75702e84bb7597aabe663b82f6f04ef2777"
+    },
+    {
+        "1234567890abcdef1234567890abcdef1234567890abcdef1234567890abcdef",
+        "02bb50e2d89a4ed70663d080659fe0ad4b9bc3e06c17a227433966cb59ceee020d",
+        "04bb50e2d89a4ed70663d080659fe0ad4b9bc3e06c17a227433966cb59ceee020d"
+        "ecddbf6e00192011648d13b1c00af770c0c1bb609d4d3a5c98a43772e0e18ef4"
+    },
+    {
+        "d23f0824128b2f330c5c7fd0a6a3a4506513270e269e0d37f2a74de452e6b438",
+        "03aa3b595c1b27c190949877d6e947077b5a8cd042b512fcfae1297efe07386730",
+        "04aa3b595c1b27c190949877d6e947077b5a8cd042b512fcfae1297efe07386730"
+        "106fbae95854fb085204653519b86d622777c1c0e8714f8b14816be3a35c287d"
+    }
+};
+// Vectors 0 to 5 and 15 to 18 of BIP 340's test-vectors.csv. The other cases are variations of vector 1 computed with
+// BIP 340's reference implementation.
+struct SchnorrSignTestCase
+{
+    char const * key;
+    char const * pubKey;
+    char const * aux;
+    char const * message;
+    char const * signature;
+};
+
+SchnorrSignTestCase const SCHNORR_SIGN_CASES[] =
+{
+    {   // Vector 0
+        "0000000000000000000000000000000000000000000000000000000000000003",
+        "f9308a019258c31049344f85f89d5229b531c845836f99b08601f113bce036f9",
+        "0000000000000000000000000000000000000000000000000000000000000000",
+        "0000000000000000000000000000000000000000000000000000000000000000",
+        "e907831f80848d1069a5371b402410364bdf1c5f8307b0084c55f1ce2dca8215"
+        "25f66a4a85ea8b71e482a74f382d2ce5ebeee8fdb2172f477df4900d310536c0"
+    },
+    {   // Vector 1
+        "b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef",
+        "dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659",
+        "0000000000000000000000000000000000000000000000000000000000000001",
+        "243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89",
+        "6896bd60eeae296db48a229ff71dfe071bde413e6d43f917dc8dcf8c78de3341"
+        "8906d11ac976abccb20b091292bff4ea897efcb639ea871cfa95f6de339e4b0a"
+    },
+    {   // Vector 2
+        "c90fdaa22168c234c4c6628b80dc1cd129024e088a67cc74020bbea63b14e5c9",
+        "dd308afec5777e13121fa72b9cc1b7cc0139715309b086c960e18fd969774eb8",
+        "c87aa53824b4d7ae2eb035a2b5bbbccc080e76cdc6d1692c4b0b62d798e6d906",
+        "7e2d58d8b3bcdf1abadec7829054f90dda9805aab56c77333024b9d0a508b75c",
+        "5831aaeed7b44bb74e5eab94ba9d4294c49bcf2a60728d8b4c200f50dd313c1b"
+        "ab745879a5ad954a72c45a91c3a51d3c7adea98d82f8481e0e1e03674a6f3fb7"
+    },
+    {   // Vector 3
+        "0b432b2677937381aef05bb02a66ecd012773062cf3fa2549e44f58ed2401710",
+        "25d1dff95105f5253c4022f628a996ad3a0d95fbf21d468a1b33f8c160d8f517",
+        "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+        "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+        "7eb0509757e246f19449885651611cb965ecc1a187dd51b64fda1edc9637d5ec"
+        "97582b9cb13db3933705b32ba982af5af25fd78881ebb32771fc5922efc66ea3"
+    },
+    {   // Vector 15 (empty message)
+        "0340034003400340034003400340034003400340034003400340034003400340",
+        "778caa53b4393ac467774d09497a87224bf9fab6f6e68b23086497324d6fd117",
+        "0000000000000000000000000000000000000000000000000000000000000000",
+        "",
+        "71535db165ecd9fbbc046e5ffaea61186bb6ad436732fccc25291a55895464cf"
+        "6069ce26bf03466228f19a3a62db8a649f2d560fac652827d1af0574e427ab63"
+    },
+    {   // Vector 16
+        "0340034003400340034003400340034003400340034003400340034003400340",
+        "778caa53b4393ac467774d09497a87224bf9fab6f6e68b23086497324d6fd117",
+        "0000000000000000000000000000000000000000000000000000000000000000",
+        "11",
+        "08a20a0afef64124649232e0693c583ab1b9934ae63b4c3511f3ae1134c6a303"
+        "ea3173bfea6683bd101fa5aa5dbc1996fe7cacfc5a577d33ec14564cec2bacbf"
+    },
+    {   // Vector 17
+        "0340034003400340034003400340034003400340034003400340034003400340",
+        "778caa53b4393ac467774d09497a87224bf9fab6f6e68b23086497324d6fd117",
+        "0000000000000000000000000000000000000000000000000000000000000000",
+        "0102030405060708090a0b0c0d0e0f1011",
+        "5130f39a4059b43bc7cac09a19ece52b5d8699d1a71e3c52da9afdb6b50ac370"
+        "c4a482b77bf960f8681540e25b6771ece1e5a37fd80e5a51897c5566a97ea5a5"
+    },
+    {   // Vector 18 (100 bytes of 0x99)
+        "0340034003400340034003400340034003400340034003400340034003400340",
+        "778caa53b4393ac467774d09497a87224bf9fab6f6e68b23086497324d6fd117",
+        "0000000000000000000000000000000000000000000000000000000000000000",
+        "9999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999"
+        "9999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999",
+        "403b12b0d8555a344175ea7ec746566303321e5dbfa8be6f091635163eca79a8"
+        "585ed3e3170807e7c03b720fc54c7b23897fcba0e9d0b4a06894cfd249f22367"
+    }
+};
+
+struct SchnorrVerifyTestCase
+{
+    char const * pubKey;
+    char const * message;
+    char const * signature;
+    bool valid;
+};
+
+SchnorrVerifyTestCase const SCHNORR_VERIFY_CASES[] =
+{
+    {   // Vector 4
+        "d69c3509bb99e412e68b0fe8544e72837dfa30746d8be2aa65975f29d22dc7b9",
+        "4df3c3f68fcc83b27e9d42c90431a72499f17875c81a599b566c9889b9696703",
+        "00000000000000000000003b78ce563f89a0ed9414f5aa28ad0d96d6795f9c63"
+        "76afb1548af603b3eb45c9f8207dee1060cb71c04e80f593060b07d28308d7f4",
+        true
+    },
+    {   // Vector 5 (the public key is not on the curve)
+        "eefdea4cdb677750a420fee807eacf21eb9898ae79b9768766e4faa04a2d4a34",
+        "243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89",
+        "6cff5c3ba86c69ea4b7376f31a9bcb4f74c1976089b2d9963da2e5543e177769"
+        "69e89b4c5564d00349106b8497785dd7d1d713a8ae82b32fa79d5f7fc407d39b",
+        false
+    },
+    {   // R has an odd y-coordinate
+        "dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659",
+        "243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89",
+        "fff97bd5755eeea420453a14355235d382f6472f8568a18b2f057a1460297556"
+        "3cc27944640ac607cd107ae10923d9ef7a73c643e166be5ebeafa34b1ac553e2",
+        false
+    },
+    {   // Wrong message
+        "dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659",
+        "243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c88",
+        "6896bd60eeae296db48a229ff71dfe071bde413e6d43f917dc8dcf8c78de3341"
+        "8906d11ac976abccb20b091292bff4ea897efcb639ea871cfa95f6de339e4b0a",
+        false
+    },
+    {   // Negated s
+        "dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659",
+        "243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89",
+        "6896bd60eeae296db48a229ff71dfe071bde413e6d43f917dc8dcf8c78de3341"
+        "76f92ee5368954334df4f6ed6d400b14312fe030755e191ec53c67ae9c97f637",
+        false
+    },
+    {   // There is no point with x = r
+        "dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659",
+        "243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89",
+        "0000000000000000000000000000000000000000000000000000000000000005"
+        "8906d11ac976abccb20b091292bff4ea897efcb639ea871cfa95f6de339e4b0a",
+        false
+    },
+    {   // r = p
+        "dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659",
+        "243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89",
+        "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f"
+        "8906d11ac976abccb20b091292bff4ea897efcb639ea871cfa95f6de339e4b0a",
+        false
+    },
+    {   // s = n
+        "dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659",
+        "243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89",
+        "6896bd60eeae296db48a229ff71dfe071bde413e6d43f917dc8dcf8c78de3341"
+        "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141",
+        false
+    },
+    {   // The public key is not less than p
+        "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc30",
+        "243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89",
+        "6896bd60eeae296db48a229ff71dfe071bde413e6d43f917dc8dcf8c78de3341"
+        "8906d11ac976abccb20b091292bff4ea897efcb639ea871cfa95f6de339e4b0a",
+        false
+    }
+};
+} // anonymous namespace
+
+TEST(CryptoSecp256k1Test, Field)
+{
+    Field x = fieldFromHex(X);
+    Field y = fieldFromHex(Y);
+
+    EXPECT_EQ(toHex(x), X);
+    EXPECT_EQ(toHex(x * y), "eb11451f16bd3912be1e7ad300902ab78a32c0250fb8531ad6f2843c13596d51");
+    EXPECT_EQ(toHex(x - y), "94bed09bd39956455ca605678bf4775480eb61dde10f870579e294c4cc0dd371");
+    EXPECT_EQ(toHex(x + y - y), X);
+    EXPECT_EQ(toHex(sqr(x)), toHex(x * x));
+    EXPECT_EQ(toHex(mulInt(x, 3)), toHex(x + x + x));
+    EXPECT_EQ(toHex(inverse(x)), "c6ac92470172185ac4b37ba657f1ab793b42e147e51cc50ea029e01bd438fd2d");
+    EXPECT_EQ(toHex(-x + x), ZERO);
+    EXPECT_TRUE(isZero(x - x));
+    EXPECT_FALSE(isZero(x));
+    EXPECT_TRUE(equals(x * inverse(x), fieldFromInt(1)));
+
+    // sqrt returns one of the two roots
+    Field root;
+    EXPECT_TRUE(sqrt(sqr(x), root));
+    EXPECT_EQ(toHex(root), X);
+
+    // 7 has no square root (so there is no point with x = 0)
+    EXPECT_FALSE(sqrt(fieldFromInt(7), root));
+
+    // p - 1 is -1, and values not less than p are rejected
+    Field pMinus1 = -fieldFromInt(1);
+    EXPECT_EQ(toHex(pMinus1), "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2e");
+    EXPECT_EQ(toHex(pMinus1 + fieldFromInt(1)), ZERO);
+    Field a;
+    EXPECT_FALSE(fieldSetBytes(a, Utility::fromHex(P).data()));
+}
+
+TEST(CryptoSecp256k1Test, Scalar)
+{
+    Scalar a = scalarFromHex(A);
+    Scalar b = scalarFromHex(B);
+
+    EXPECT_EQ(toHex(a), A);
+    EXPECT_EQ(toHex(mul(a, b)), "174720cea7d45b3fe1bb2d3494671ffc8a628b6a348bd4d1b68ef32e460f508c");
+    EXPECT_EQ(toHex(add(a, b)), "c407e49a992046cf267e74b820bb1005003eecf8cca131522e198b6b92c8e103");
+    EXPECT_EQ(toHex(negate(a)), "c9098a337e18b10a171da26bf126fb89257d448951aad643a7b9767b4706b116");
+    EXPECT_EQ(toHex(inverse(a)), "9007928b2844fc3f76f09542bbf0cf5e0f52721d71484d88b68f7ebd0f54512e");
+    EXPECT_EQ(toHex(add(a, negate(a))), ZERO);
+    EXPECT_EQ(toHex(negate(scalarFromHex(ZERO))), ZERO);
+    EXPECT_FALSE(isHigh(a));
+    EXPECT_TRUE(isHigh(negate(a)));
+
+    // n - 1 squared is 1
+    Scalar nMinus1 = negate(Scalar{ { 1, 0, 0, 0 } });
+    EXPECT_EQ(toHex(mul(nMinus1, nMinus1)), "0000000000000000000000000000000000000000000000000000000000000001");
+
+    // Values not less than n are reduced
+    Scalar n;
+    EXPECT_TRUE(scalarSetBytes(n, Utility::fromHex(N).data()));
+    EXPECT_TRUE(isZero(n));
+}
+
+TEST(CryptoSecp256k1Test, splitLambda)
+{
+    // lambda is a cube root of 1
+    Scalar lambda = scalarFromHex("5363ad4cc05c30e0a5261c028812645a122e22ea20816678df02967c1b23bd72");
+    EXPECT_EQ(toHex(mul(mul(lambda, lambda), lambda)), "0000000000000000000000000000000000000000000000000000000000000001");
+
+    for (char const * x : { A, B, "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140",
+                            "0000000000000000000000000000000000000000000000000000000000000001" })
+    {
+        Scalar k = scalarFromHex(x);
+        Scalar k1, k2;
+        splitLambda(k, k1, k2);
+        EXPECT_EQ(toHex(add(k1, mul(k2, lambda))), x);
+
+        // The halves (or their negations) are less than 2^128
+        Scalar h1 = isHigh(k1) ? negate(k1) : k1;
+        Scalar h2 = isHigh(k2) ? negate(k2) : k2;
+        EXPECT_EQ(h1.d[2] | h1.d[3] | h2.d[2] | h2.d[3], 0u) << x;
+    }
+}
+
+TEST(CryptoSecp256k1Test, points)
+{
+    AffinePoint const & g = generator();
+    EXPECT_TRUE(isOnCurve(g));
+
+    JacobianPoint g1 = toJacobian(g);
+    JacobianPoint g2 = dbl(g1);
+    JacobianPoint g3 = add(g2, g);
+
+    EXPECT_EQ(toHex(toAffine(g2), true), DERIVE_CASES[1].compressed);
+    EXPECT_EQ(toHex(toAffine(g3), true), DERIVE_CASES[2].compressed);
+    EXPECT_EQ(toHex(toAffine(add(g1, g2)), true), DERIVE_CASES[2].compressed);
+
+    // Special cases of addition
+    EXPECT_EQ(toHex(toAffine(add(g1, g)), true), DERIVE_CASES[1].compressed);
+    EXPECT_EQ(toHex(toAffine(add(g1, g1)), true), DERIVE_CASES[1].compressed);
+    EXPECT_TRUE(add(g1, negate(g1)).infinity);
+    EXPECT_TRUE(add(negate(g1), g).infinity);
+    EXPECT_EQ(toHex(toAffine(add(toJacobian(toAffine(add(g1, negate(g1)))), g2)), true), DERIVE_CASES[1].compressed);
+
+    // Batch inversion skips zeros
+    Field values[4] = { fieldFromHex(X), fieldFromInt(0), fieldFromHex(Y), fieldFromInt(1) };
+    Field scratch[4];
+    batchInverse(values, 4, scratch);
+    EXPECT_TRUE(equals(values[0], inverse(fieldFromHex(X))));
+    EXPECT_TRUE(isZero(values[1]));
+    EXPECT_TRUE(equals(values[2], inverse(fieldFromHex(Y))));
+    EXPECT_TRUE(equals(values[3], fieldFromInt(1)));
+}
+
+TEST(CryptoSecp256k1Test, mulGenerator)
+{
+    for (auto const & c : DERIVE_CASES)
+    {
+        AffinePoint p = toAffine(mulGenerator(scalarFromHex(c.privateKey)));
+        EXPECT_EQ(toHex(p, true), c.compressed);
+        EXPECT_EQ(toHex(p, false), c.uncompressed);
+    }
+}
+
+TEST(CryptoSecp256k1Test, mulGenerator_comb)
+{
+    // Each row of the table, each digit, and runs of zero digits, checked against the variable-time multiplication
+    Scalar zero = scalarFromHex(ZERO);
+    for (int i = 0; i < 64; ++i)
+    {
+        Scalar k = zero;
+        k.d[i / 16] = (uint64_t)(i % 15 + 1) << (4 * (i % 16));
+        if (i > 0)
+            k.d[0] |= 1;
+        EXPECT_EQ(toHex(toAffine(mulGenerator(k)), true), toHex(toAffine(mulDouble(k, zero, generator())), true)) << i;
+    }
+
+    // All digits 15 (the largest scalar)
+    Scalar nMinus1 = negate(Scalar{ { 1, 0, 0, 0 } });
+    EXPECT_EQ(toHex(toAffine(mulGenerator(nMinus1)), true), DERIVE_CASES[3].compressed);
+}
+
+TEST(CryptoSecp256k1Test, toAffine_batch)
+{
+    JacobianPoint points[4];
+    points[0] = dbl(toJacobian(generator()));
+    points[1] = add(points[0], generator());
+    points[2] = add(points[0], negate(points[0]));
+    points[3] = toJacobian(generator());
+
+    AffinePoint affine[4];
+    toAffine(points, affine, 4);
+    EXPECT_EQ(toHex(affine[0], true), DERIVE_CASES[1].compressed);
+    EXPECT_EQ(toHex(affine[1], true), DERIVE_CASES[2].compressed);
+    EXPECT_TRUE(affine[2].infinity);
+    EXPECT_EQ(toHex(affine[3], true), DERIVE_CASES[0].compressed);
+}
+
+TEST(CryptoSecp256k1Test, mulDouble)
+{
+    std::vector<uint8_t> q = Utility::fromHex(
+        "04f759ea6aeac2b4ed0fbf81e71c16ef2731887be3ec037ceb1d8f24b76ac0d1f4"
+        "395590d9b18fee90de6c858e1864b143587e53174d0847da780f5622d5bb4b50");
+    AffinePoint qPoint;
+    ASSERT_TRUE(parsePublicKey(q.data(), q.size(), qPoint));
+
+    Scalar u1 = scalarFromHex("6b4cb2424a23d5962217beaddbc496cb8e81973e0becd7b03898d190f9ebdacc");
+    Scalar u2 = scalarFromHex("ae97ba94d0eda82f8f6d05584ef8aa38922766581e27a1c08a6a63ec24ede6a4");
+    EXPECT_EQ(toHex(toAffine(mulDouble(u1, u2, qPoint)), false),
+              "0430d590de7f6b09b65066cf136f7f9d3f6c5833a8631a97b5d92b35042cb8eacd"
+              "c55cdcc8583c0d559403c7e25e54391798535c22994a3454913049ab59bdca09");
+
+    // Either multiplier may be 0, and the result may be the point at infinity
+    Scalar zero = scalarFromHex(ZERO);
+    for (auto const & c : DERIVE_CASES)
+    {
+        Scalar k = scalarFromHex(c.privateKey);
+        EXPECT_EQ(toHex(toAffine(mulDouble(k, zero, qPoint)), true), c.compressed);
+        EXPECT_EQ(toHex(toAffine(mulDouble(zero, k, generator())), true), c.compressed);
+        EXPECT_TRUE(mulDouble(k, negate(k), generator()).infinity);
+    }
+}
+
+TEST(CryptoSecp256k1Test, buildKeyTables)
+{
+    std::vector<AffinePoint> points;
+    for (auto const & c : DERIVE_CASES)
+    {
+        points.push_back(toAffine(mulGenerator(scalarFromHex(c.privateKey))));
+    }
+
+    // Building the tables together gives the same tables as building them one at a time
+    std::vector<KeyTable> tables(points.size());
+    buildKeyTables(points.data(), tables.data(), points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        KeyTable single;
+        buildKeyTables(&points[i], &single, 1);
+        JacobianPoint multiple = toJacobian(points[i]);
+        JacobianPoint twice    = dbl(multiple);
+        for (int j = 0; j < KEY_TABLE_SIZE; ++j)
+        {
+            // The table holds the odd multiples
+            EXPECT_EQ(toHex(tables[i].odd[j], false), toHex(toAffine(multiple), false)) << i << ", " << j;
+            EXPECT_EQ(toHex(single.odd[j], false), toHex(tables[i].odd[j], false)) << i << ", " << j;
+            multiple = add(multiple, twice);
+        }
+    }
+
+    // mulDouble gives the same result with a point and with its table
+    Scalar u1 = scalarFromHex("6b4cb2424a23d5962217beaddbc496cb8e81973e0becd7b03898d190f9ebdacc");
+    Scalar u2 = scalarFromHex("ae97ba94d0eda82f8f6d05584ef8aa38922766581e27a1c08a6a63ec24ede6a4");
+    Scalar zero = scalarFromHex(ZERO);
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        EXPECT_EQ(toHex(toAffine(mulDouble(u1, u2, tables[i])), true),
+                  toHex(toAffine(mulDouble(u1, u2, points[i])), true));
+        EXPECT_EQ(toHex(toAffine(mulDouble(zero, u2, tables[i])), true),
+                  toHex(toAffine(mulDouble(zero, u2, points[i])), true));
+    }
+
+    buildKeyTables(nullptr, nullptr, 0);
+}
+
+TEST(CryptoSecp256k1Test, parsePublicKey)
+{
+    for (auto const & c : DERIVE_CASES)
+    {
+        std::vector<uint8_t> compressed   = Utility::fromHex(c.compressed);
+        std::vector<uint8_t> uncompressed = Utility::fromHex(c.uncompressed);
+        AffinePoint p;
+        ASSERT_TRUE(parsePublicKey(compressed.data(), compressed.size(), p));
+        EXPECT_EQ(toHex(p, false), c.uncompressed);
+        ASSERT_TRUE(parsePublicKey(uncompressed.data(), uncompressed.size(), p));
+        EXPECT_EQ(toHex(p, true), c.compressed);
+
+        // Wrong prefix, wrong size, and a point not on the curve
+        compressed[0] = 0x04;
+        EXPECT_FALSE(parsePublicKey(compressed.data(), compressed.size(), p));
+        EXPECT_FALSE(parsePublicKey(uncompressed.data(), uncompressed.size() - 1, p));
+        uncompressed.back() ^= 1;
+        EXPECT_FALSE(parsePublicKey(uncompressed.data(), uncompressed.size(), p));
+    }
+
+    // x = 0 is not on the curve, and x = p is not a field element
+    std::vector<uint8_t> key = Utility::fromHex(std::string("02") + ZERO);
+    AffinePoint p;
+    EXPECT_FALSE(parsePublicKey(key.data(), key.size(), p));
+    key = Utility::fromHex(std::string("02") + P);
+    EXPECT_FALSE(parsePublicKey(key.data(), key.size(), p));
+}
+
+TEST(CryptoSecp256k1Test, sign)
+{
+    // Deterministic signatures (RFC 6979) with low s, computed with a Python implementation of RFC 6979
+    struct SignTestCase
+    {
+        char const * key;
+        char const * hash;
+        char const * signature;
+    };
+    SignTestCase const cases[] =
+    {
+        {   // SHA-256("Satoshi Nakamoto")
+            "0000000000000000000000000000000000000000000000000000000000000001",
+            "a0dc65ffca799873cbea0ac274015b9526505daaaed385155425f7337704883e",
+            "934b1ea10a4b3c1757e2b0c017d0b6143ce3c9a7e6a4a49860d7a6ab210ee3d8"
+            "2442ce9d2b916064108014783e923ec36b49743e2ffa1c4496f01a512aafd9e5"
+        },
+        {
+            "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140",
+            "a0dc65ffca799873cbea0ac274015b9526505daaaed385155425f7337704883e",
+            "fd567d121db66e382991534ada77a6bd3106f0a1098c231e47993447cd6af2d0"
+            "6b39cd0eb1bc8603e159ef5c20a5c8ad685a45b06ce9bebed3f153d10d93bed5"
+        },
+        {   // SHA-256("message 1")
+            "1234567890abcdef1234567890abcdef1234567890abcdef1234567890abcdef",
+            "b526aef1a341cfe6e5c377ed4c222888eeb81f913a107110a867e009c1758f24",
+            "417e5dc0fb2ce038425d87093335281822bdbf31086931c5de2503a91bb24b68"
+            "6560048b872631d4ea06dfe9ab19e85d412b76a877fbb65d9c1b38e584ab945d"
+        }
+    };
+
+    for (auto const & c : cases)
+    {
+        Scalar key = scalarFromHex(c.key);
+        std::vector<uint8_t> hash = Utility::fromHex(c.hash);
+        uint8_t signature[64];
+        sign(hash.data(), key, signature);
+        EXPECT_EQ(Utility::toHex(signature, sizeof(signature)), c.signature);
+
+        // The signature verifies and s is low
+        AffinePoint q = toAffine(mulGenerator(key));
+        EXPECT_TRUE(verify(hash.data(), q, signature));
+        Scalar s;
+        scalarSetBytes(s, signature + 32);
+        EXPECT_FALSE(isHigh(s));
+    }
+}
+
+TEST(CryptoSecp256k1Test, verify)
+{
+    // Signature of SHA-256("message 1") by the key 1, generated with Python's cryptography package
+    std::vector<uint8_t> hash      = Utility::fromHex("b526aef1a341cfe6e5c377ed4c222888eeb81f913a107110a867e009c1758f24");
+    std::vector<uint8_t> key       = Utility::fromHex(DERIVE_CASES[0].compressed);
+    std::vector<uint8_t> signature = Utility::fromHex(
+        "0d8b6e987bc4828126a32ddd07c4e86ac7d2540f8622c995df60568508a6ee97"
+        "bc8668b91cd745c99d35d95bba6922ef5e6bc886c79cae2f508d6677f015e725");
+    AffinePoint q;
+    ASSERT_TRUE(parsePublicKey(key.data(), key.size(), q));
+    EXPECT_TRUE(verify(hash.data(), q, signature.data()));
+    KeyTable table;
+    buildKeyTables(&q, &table, 1);
+    EXPECT_TRUE(verify(hash.data(), table, signature.data()));
+
+    // Wrong hash, wrong key, and altered signature
+    std::vector<uint8_t> wrongHash = hash;
+    wrongHash[31] ^= 1;
+    EXPECT_FALSE(verify(wrongHash.data(), q, signature.data()));
+    EXPECT_FALSE(verify(wrongHash.data(), table, signature.data()));
+    AffinePoint wrongKey = toAffine(dbl(toJacobian(q)));
+    EXPECT_FALSE(verify(hash.data(), wrongKey, signature.data()));
+    std::vector<uint8_t> altered = signature;
+    altered[63] ^= 1;
+    EXPECT_FALSE(verify(hash.data(), q, altered.data()));
+
+    // The high-s form of the signature is also valid
+    Scalar s;
+    scalarSetBytes(s, signature.data() + 32);
+    std::vector<uint8_t> highS = signature;
+    scalarGetBytes(negate(s), highS.data() + 32);
+    EXPECT_TRUE(verify(hash.data(), q, highS.data()));
+
+    // r and s must be in [1, n-1]
+    std::vector<uint8_t> n = Utility::fromHex(N);
+    std::vector<uint8_t> outOfRange = signature;
+    std::fill(outOfRange.begin(), outOfRange.begin() + 32, 0);
+    EXPECT_FALSE(verify(hash.data(), q, outOfRange.data()));
+    outOfRange = signature;
+    std::fill(outOfRange.begin() + 32, outOfRange.end(), 0);
+    EXPECT_FALSE(verify(hash.data(), q, outOfRange.data()));
+    outOfRange = signature;
+    std::copy(n.begin(), n.end(), outOfRange.begin() + 32);
+    EXPECT_FALSE(verify(hash.data(), q, outOfRange.data()));
+}
+
+TEST(CryptoSecp256k1Test, verify_rPlusN)
+{
+    // A signature where x(R) = r + n, constructed by choosing R and then the key
+    std::vector<uint8_t> hash = Utility::fromHex("470041d283562aa0a2953dac1bb58b3cce881e0b842d90eb8798ef81704cbe76");
+    std::vector<uint8_t> key  = Utility::fromHex(
+        "04cbf22c2273cdc689ab9eec3d99611e2569c27a9d970c6e996bd8ffa3d63487be"
+        "d532030c73c4f191696abdbf9df8994c8b364574c19efa4f78840f5124ea756c");
+    std::vector<uint8_t> signature = Utility::fromHex(
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "7c2cd6cc3f97f15f0a6fc9f5e943565043e3e69edfa1e4f70a337a2a3789169d");
+    AffinePoint q;
+    ASSERT_TRUE(parsePublicKey(key.data(), key.size(), q));
+    EXPECT_TRUE(verify(hash.data(), q, signature.data()));
+    KeyTable table;
+    buildKeyTables(&q, &table, 1);
+    EXPECT_TRUE(verify(hash.data(), table, signature.data()));
+}
+
+TEST(CryptoSecp256k1Test, liftX)
+{
+    // The point with the generator's x-coordinate and an even y-coordinate is the generator
+    std::vector<uint8_t> x = Utility::fromHex(DERIVE_CASES[0].compressed + 2);
+    AffinePoint p;
+    ASSERT_TRUE(liftX(x.data(), p));
+    EXPECT_EQ(toHex(p, false), DERIVE_CASES[0].uncompressed);
+
+    // The point with 2G's x-coordinate and an even y-coordinate is 2G
+    x = Utility::fromHex(DERIVE_CASES[1].compressed + 2);
+    ASSERT_TRUE(liftX(x.data(), p));
+    EXPECT_EQ(toHex(p, false), DERIVE_CASES[1].uncompressed);
+
+    // -G has an odd y-coordinate, so its x-coordinate gives G
+    x = Utility::fromHex(DERIVE_CASES[3].compressed + 2);
+    ASSERT_TRUE(liftX(x.data(), p));
+    EXPECT_EQ(toHex(p, false), DERIVE_CASES[0].uncompressed);
+
+    // There is no point with x = 5, and x must be less than p
+    x = Utility::fromHex("0000000000000000000000000000000000000000000000000000000000000005");
+    EXPECT_FALSE(liftX(x.data(), p));
+    x = Utility::fromHex(P);
+    EXPECT_FALSE(liftX(x.data(), p));
+}
+
+TEST(CryptoSecp256k1Test, mulMulti)
+{
+    std::vector<AffinePoint> points;
+    std::vector<Scalar>      multipliers;
+    for (auto const & c : DERIVE_CASES)
+    {
+        points.push_back(toAffine(mulGenerator(scalarFromHex(c.privateKey))));
+        multipliers.push_back(scalarFromHex(c.privateKey));
+    }
+    multipliers[0] = scalarFromHex(A);
+    multipliers[1] = scalarFromHex(B);
+
+    // The result is the same as the sum of the terms computed separately
+    Scalar g = scalarFromHex("6b4cb2424a23d5962217beaddbc496cb8e81973e0becd7b03898d190f9ebdacc");
+    Scalar zero = scalarFromHex(ZERO);
+    for (size_t n = 0; n <= points.size(); ++n)
+    {
+        JacobianPoint expected = mulGenerator(g);
+        for (size_t i = 0; i < n; ++i)
+        {
+            expected = add(expected, mulDouble(zero, multipliers[i], points[i]));
+        }
+        EXPECT_EQ(toHex(toAffine(mulMulti(g, multipliers.data(), points.data(), n)), true),
+                  toHex(toAffine(expected), true)) << n;
+    }
+
+    // The terms may cancel
+    Scalar k = scalarFromHex(A);
+    Scalar negated = negate(k);
+    AffinePoint twice[2] = { points[0], points[0] };
+    Scalar cancel[2] = { k, negated };
+    EXPECT_TRUE(mulMulti(zero, cancel, twice, 2).infinity);
+    EXPECT_TRUE(mulMulti(negated, &k, &points[0], 1).infinity);
+}
+
+TEST(CryptoSecp256k1Test, schnorrSign)
+{
+    for (auto const & c : SCHNORR_SIGN_CASES)
+    {
+        Scalar key = scalarFromHex(c.key);
+        std::vector<uint8_t> aux     = Utility::fromHex(c.aux);
+        std::vector<uint8_t> message = Utility::fromHex(c.message);
+        uint8_t signature[64];
+        ASSERT_TRUE(schnorrSign(message.data(), message.size(), key, aux.data(), signature));
+        EXPECT_EQ(Utility::toHex(signature, sizeof(signature)), c.signature);
+
+        std::vector<uint8_t> pubKey = Utility::fromHex(c.pubKey);
+        EXPECT_TRUE(schnorrVerify(message.data(), message.size(), pubKey.data(), signature));
+    }
+}
+
+TEST(CryptoSecp256k1Test, schnorrVerify)
+{
+    for (auto const & c : SCHNORR_SIGN_CASES)
+    {
+        std::vector<uint8_t> pubKey    = Utility::fromHex(c.pubKey);
+        std::vector<uint8_t> message   = Utility::fromHex(c.message);
+        std::vector<uint8_t> signature = Utility::fromHex(c.signature);
+        EXPECT_TRUE(schnorrVerify(message.data(), message.size(), pubKey.data(), signature.data())) << c.signature;
+    }
+    for (auto const & c : SCHNORR_VERIFY_CASES)
+    {
+        std::vector<uint8_t> pubKey    = Utility::fromHex(c.pubKey);
+        std::vector<uint8_t> message   = Utility::fromHex(c.message);
+        std::vector<uint8_t> signature = Utility::fromHex(c.signature);
+        EXPECT_EQ(schnorrVerify(message.data(), message.size(), pubKey.data(), signature.data()), c.valid)
+            << c.signature;
+    }
+}
+
+TEST(CryptoSecp256k1Test, schnorrVerifyBatch)
+{
+    struct Decoded
+    {
+        std::vector<uint8_t> pubKey;
+        std::vector<uint8_t> message;
+        std::vector<uint8_t> signature;
+    };
+    std::vector<Decoded> valid;
+    for (auto const & c : SCHNORR_SIGN_CASES)
+    {
+        valid.push_back({ Utility::fromHex(c.pubKey), Utility::fromHex(c.message), Utility::fromHex(c.signature) });
+    }
+    auto const & v4 = SCHNORR_VERIFY_CASES[0];
+    valid.push_back({ Utility::fromHex(v4.pubKey), Utility::fromHex(v4.message), Utility::fromHex(v4.signature) });
+
+    std::vector<SchnorrItem> items;
+    for (auto const & d : valid)
+    {
+        items.push_back({ d.message.data(), d.message.size(), d.pubKey.data(), d.signature.data() });
+    }
+
+    // Every prefix of the valid signatures is valid, including the empty batch
+    for (size_t n = 0; n <= items.size(); ++n)
+    {
+        EXPECT_TRUE(schnorrVerifyBatch(items.data(), n)) << n;
+    }
+
+    // Adding any invalid signature makes the batch invalid
+    for (size_t i = 1; i < sizeof(SCHNORR_VERIFY_CASES) / sizeof(SCHNORR_VERIFY_CASES[0]); ++i)
+    {
+        auto const & c = SCHNORR_VERIFY_CASES[i];
+        Decoded invalid = { Utility::fromHex(c.pubKey), Utility::fromHex(c.message), Utility::fromHex(c.signature) };
+        std::vector<SchnorrItem> batch = items;
+        batch.insert(batch.begin() + i % batch.size(),
+                     SchnorrItem{ invalid.message.data(), invalid.message.size(), invalid.pubKey.data(),
+                                  invalid.signature.data() });
+        EXPECT_FALSE(schnorrVerifyBatch(batch.data(), batch.size())) << c.signature;
+    }
+
+    // Two invalid signatures whose errors cancel in a sum without random multipliers are detected
+    std::vector<uint8_t> s1 = valid[1].signature;
+    std::vector<uint8_t> s2 = valid[1].signature;
+    Scalar s;
+    scalarSetBytes(s, s1.data() + 32);
+    Scalar one = scalarFromHex("0000000000000000000000000000000000000000000000000000000000000001");
+    scalarGetBytes(add(s, one), s1.data() + 32);
+    scalarGetBytes(add(s, negate(one)), s2.data() + 32);
+    SchnorrItem pair[2] =
+    {
+        { valid[1].message.data(), valid[1].message.size(), valid[1].pubKey.data(), s1.data() },
+        { valid[1].message.data(), valid[1].message.size(), valid[1].pubKey.data(), s2.data() }
+    };
+    EXPECT_FALSE(schnorrVerifyBatch(pair, 2));
+}
+
+#endif // defined(CRYPTO_SECP256K1_NATIVE)
@@ -82,6 +82,67 @@ TEST(CryptoSha1Test, sha1_array)
     EXPECT_TRUE(std::equal(result.begin(), result.end(), expected));
 }
 
+TEST(CryptoSha1Test, sha1_million_a)
+{
+    std::vector<uint8_t> input(1000000, 'a');
+    EXPECT_EQ(toHex(Crypto::sha1(input)), "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+}
+
+TEST(CryptoSha1Test, selectSha1Backend)
+{
+    Sha1Backend original = sha1Backend();
+    EXPECT_TRUE(sha1BackendIsAvailable(original));
+    EXPECT_TRUE(sha1BackendIsAvailable(SHA1_PORTABLE));
+
+    EXPECT_TRUE(selectSha1Backend(SHA1_PORTABLE));
+    EXPECT_EQ(sha1Backend(), SHA1_PORTABLE);
+
+    for (int b = 0; b < NUM_SHA1_BACKENDS; ++b)
+    {
+        Sha1Backend backend = (Sha1Backend)b;
+        EXPECT_EQ(selectSha1Backend(backend), sha1BackendIsAvailable(backend)) << sha1BackendName(backend);
+    }
+
+    selectSha1Backend(original);
+}
+
+TEST(CryptoSha1Test, backends)
+{
+    Sha1Backend original = sha1Backend();
+
+    // Every length from 0 to 3 blocks exercises all the padding cases
+    std::vector<uint8_t> data(3 * 64 + 1);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = (uint8_t)(i * 167 + 13);
+    }
+    std::vector<Sha1Hash> expected;
+    selectSha1Backend(SHA1_PORTABLE);
+    for (size_t length = 0; length <= data.size(); ++length)
+    {
+        expected.push_back(Crypto::sha1(data.data(), length));
+    }
+
+    for (int b = 0; b < NUM_SHA1_BACKENDS; ++b)
+    {
+        Sha1Backend backend = (Sha1Backend)b;
+        if (!selectSha1Backend(backend))
+            continue;
+
+        for (auto const & c : SHA1_CASES)
+        {
+            Sha1Hash result = Crypto::sha1((uint8_t const *)c.input, strlen(c.input));
+            EXPECT_TRUE(std::equal(result.begin(), result.end(), c.expected)) << sha1BackendName(backend);
+        }
+        for (size_t length = 0; length <= data.size(); ++length)
+        {
+            EXPECT_EQ(Crypto::sha1(data.data(), length), expected[length]) << sha1BackendName(backend) << ", " << length;
+        }
+    }
+
+    selectSha1Backend(original);
+}
+
 int main(int argc, char ** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -155,6 +155,253 @@ TEST(CryptoSha256Test, checksum_vector)
     }
 }
 
+TEST(CryptoSha256Test, sha256_million_a)
+{
+    std::vector<uint8_t> input(1000000, 'a');
+    uint8_t expected[SHA256_HASH_SIZE] =
+    {
+        0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92, 0x81, 0xa1, 0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67,
+        0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e, 0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0
+    };
+
+    Sha256Hash result = Crypto::sha256(input);
+    EXPECT_TRUE(std::equal(result.begin(), result.end(), expected));
+}
+
+TEST(CryptoSha256Test, selectSha256Backend)
+{
+    Sha256Backend original = sha256Backend();
+    EXPECT_TRUE(sha256BackendIsAvailable(original));
+    EXPECT_TRUE(sha256BackendIsAvailable(SHA256_PORTABLE));
+
+    EXPECT_TRUE(selectSha256Backend(SHA256_PORTABLE));
+    EXPECT_EQ(sha256Backend(), SHA256_PORTABLE);
+
+    for (int b = 0; b < NUM_SHA256_BACKENDS; ++b)
+    {
+        Sha256Backend backend = (Sha256Backend)b;
+        EXPECT_EQ(selectSha256Backend(backend), sha256BackendIsAvailable(backend)) << sha256BackendName(backend);
+    }
+
+    selectSha256Backend(original);
+}
+
+TEST(CryptoSha256Test, backends)
+{
+    Sha256Backend original = sha256Backend();
+
+    // Every length from 0 to 3 blocks exercises all the padding cases and the odd/even block paths
+    std::vector<uint8_t> data(3 * 64 + 1);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = (uint8_t)(i * 167 + 13);
+    }
+    std::vector<Sha256Hash> expected;
+    selectSha256Backend(SHA256_PORTABLE);
+    for (size_t length = 0; length <= data.size(); ++length)
+    {
+        expected.push_back(Crypto::sha256(data.data(), length));
+    }
+
+    for (int b = 0; b < NUM_SHA256_BACKENDS; ++b)
+    {
+        Sha256Backend backend = (Sha256Backend)b;
+        if (!selectSha256Backend(backend))
+            continue;
+
+        for (auto const & c : SHA256_CASES)
+        {
+            Sha256Hash result = Crypto::sha256((uint8_t const *)c.input, strlen(c.input));
+            EXPECT_TRUE(std::equal(result.begin(), result.end(), c.expected)) << sha256BackendName(backend);
+        }
+        for (auto const & c : DOUBLE_SHA256_CASES)
+        {
+            Sha256Hash result = Crypto::doubleSha256((uint8_t const *)c.input, strlen(c.input));
+            EXPECT_TRUE(std::equal(result.begin(), result.end(), c.expected)) << sha256BackendName(backend);
+        }
+        for (size_t length = 0; length <= data.size(); ++length)
+        {
+            EXPECT_EQ(Crypto::sha256(data.data(), length), expected[length]) << sha256BackendName(backend) << ", " << length;
+        }
+    }
+
+    selectSha256Backend(original);
+}
+
+TEST(CryptoSha256Test, Sha256Hasher)
+{
+    for (auto const & c : SHA256_CASES)
+    {
+        Sha256Hasher hasher;
+        hasher.update((uint8_t const *)c.input, strlen(c.input));
+        Sha256Hash result = hasher.finalize();
+        EXPECT_TRUE(std::equal(result.begin(), result.end(), c.expected));
+        EXPECT_EQ(hasher.length(), strlen(c.input));
+    }
+
+    // Adding the data in pieces of any size gives the same result
+    std::vector<uint8_t> data(3 * 64 + 1);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = (uint8_t)(i * 167 + 13);
+    }
+    Sha256Hash expected = Crypto::sha256(data);
+    for (size_t piece = 1; piece <= data.size(); ++piece)
+    {
+        Sha256Hasher hasher;
+        for (size_t i = 0; i < data.size(); i += piece)
+        {
+            hasher.update(data.data() + i, std::min(piece, data.size() - i));
+        }
+        EXPECT_EQ(hasher.finalize(), expected) << piece;
+    }
+
+    // init() starts over
+    Sha256Hasher hasher;
+    hasher.update(data);
+    hasher.init();
+    EXPECT_EQ(hasher.finalize(), Crypto::sha256(nullptr, 0));
+}
+
+TEST(CryptoSha256Test, Sha256Hasher_midstate)
+{
+    std::vector<uint8_t> data(200);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    // A copy continues from the same state, and finalize() does not change the hasher
+    Sha256Hasher prefix;
+    prefix.update(data.data(), 70);
+    EXPECT_EQ(prefix.finalize(), Crypto::sha256(data.data(), 70));
+
+    Sha256Hasher a = prefix;
+    Sha256Hasher b = prefix;
+    a.update(data.data() + 70, 130);
+    b.update(data.data() + 70, 10);
+    EXPECT_EQ(a.finalize(), Crypto::sha256(data.data(), 200));
+    EXPECT_EQ(b.finalize(), Crypto::sha256(data.data(), 80));
+    EXPECT_EQ(prefix.finalize(), Crypto::sha256(data.data(), 70));
+}
+
+TEST(CryptoSha256Test, sha256Batch)
+{
+    Sha256Backend original = sha256BatchBackend();
+
+    std::vector<std::vector<uint8_t>> inputs;
+    for (auto const & c : SHA256_CASES)
+    {
+        inputs.emplace_back((uint8_t const *)c.input, (uint8_t const *)c.input + strlen(c.input));
+    }
+
+    for (int b = 0; b < NUM_SHA256_BACKENDS; ++b)
+    {
+        Sha256Backend backend = (Sha256Backend)b;
+        if (!selectSha256BatchBackend(backend))
+            continue;
+        EXPECT_EQ(sha256BatchBackend(), backend);
+
+        Sha256HashList results = sha256Batch(inputs);
+        ASSERT_EQ(results.size(), inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            EXPECT_TRUE(std::equal(results[i].begin(), results[i].end(), SHA256_CASES[i].expected)) << sha256BackendName(backend);
+        }
+
+        EXPECT_TRUE(sha256Batch(std::vector<std::vector<uint8_t>>()).empty());
+    }
+
+    selectSha256BatchBackend(original);
+}
+
+TEST(CryptoSha256Test, doubleSha256Batch)
+{
+    Sha256Backend original = sha256BatchBackend();
+
+    // Messages of varying lengths (so that the lanes finish at different times) and more of them than there are lanes
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = (uint8_t)(i * 167 + 13);
+    }
+    std::vector<uint8_t const *> inputs;
+    std::vector<size_t> lengths;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        size_t length = (i * 37) % 300;
+        inputs.push_back(data.data() + i);
+        lengths.push_back(length);
+    }
+    lengths[7] = 900;   // One long message
+
+    for (int b = 0; b < NUM_SHA256_BACKENDS; ++b)
+    {
+        Sha256Backend backend = (Sha256Backend)b;
+        if (!selectSha256BatchBackend(backend))
+            continue;
+
+        for (size_t n : { 0, 1, 3, 9, 17, 100 })
+        {
+            Sha256HashList singles(n);
+            Sha256HashList doubles(n);
+            sha256Batch(inputs.data(), lengths.data(), n, singles.data());
+            doubleSha256Batch(inputs.data(), lengths.data(), n, doubles.data());
+            for (size_t i = 0; i < n; ++i)
+            {
+                EXPECT_EQ(singles[i], Crypto::sha256(inputs[i], lengths[i])) << sha256BackendName(backend) << ", " << i;
+                EXPECT_EQ(doubles[i], Crypto::doubleSha256(inputs[i], lengths[i])) << sha256BackendName(backend) << ", " << i;
+            }
+        }
+    }
+
+    selectSha256BatchBackend(original);
+}
+
+TEST(CryptoSha256Test, doubleSha256_64)
+{
+    Sha256Backend original      = sha256Backend();
+    Sha256Backend originalBatch = sha256BatchBackend();
+
+    Sha256HashList children(2 * 37);
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        for (size_t j = 0; j < SHA256_HASH_SIZE; ++j)
+        {
+            children[i][j] = (uint8_t)(i * 31 + j * 7);
+        }
+    }
+    Sha256HashList expected;
+    for (size_t i = 0; i < children.size(); i += 2)
+    {
+        std::vector<uint8_t> concatenated(children[i].begin(), children[i].end());
+        concatenated.insert(concatenated.end(), children[i + 1].begin(), children[i + 1].end());
+        expected.push_back(Crypto::doubleSha256(concatenated));
+    }
+
+    for (int b = 0; b < NUM_SHA256_BACKENDS; ++b)
+    {
+        Sha256Backend backend = (Sha256Backend)b;
+        if (!selectSha256Backend(backend) || !selectSha256BatchBackend(backend))
+            continue;
+
+        EXPECT_EQ(doubleSha256_64(children[0], children[1]), expected[0]) << sha256BackendName(backend);
+
+        for (size_t n : { 0, 1, 5, 16, 37 })
+        {
+            Sha256HashList parents(n);
+            doubleSha256_64(children.data(), n, parents.data());
+            for (size_t i = 0; i < n; ++i)
+            {
+                EXPECT_EQ(parents[i], expected[i]) << sha256BackendName(backend) << ", " << i;
+            }
+        }
+    }
+
+    selectSha256Backend(original);
+    selectSha256BatchBackend(originalBatch);
+}
+
 int main(int argc, char ** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
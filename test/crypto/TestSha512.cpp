@@ -89,6 +89,109 @@ TEST(CryptoSha512Test, sha512_array)
     EXPECT_TRUE(std::equal(result.begin(), result.end(), expected));
 }
 
+TEST(CryptoSha512Test, sha512_million_a)
+{
+    std::vector<uint8_t> input(1000000, 'a');
+    EXPECT_EQ(toHex(Crypto::sha512(input)),
+              "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973ebde0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b");
+}
+
+TEST(CryptoSha512Test, selectSha512Backend)
+{
+    Sha512Backend original = sha512Backend();
+    EXPECT_TRUE(sha512BackendIsAvailable(original));
+    EXPECT_TRUE(sha512BackendIsAvailable(SHA512_PORTABLE));
+
+    EXPECT_TRUE(selectSha512Backend(SHA512_PORTABLE));
+    EXPECT_EQ(sha512Backend(), SHA512_PORTABLE);
+
+    for (int b = 0; b < NUM_SHA512_BACKENDS; ++b)
+    {
+        Sha512Backend backend = (Sha512Backend)b;
+        EXPECT_EQ(selectSha512Backend(backend), sha512BackendIsAvailable(backend)) << sha512BackendName(backend);
+    }
+
+    selectSha512Backend(original);
+}
+
+TEST(CryptoSha512Test, backends)
+{
+    Sha512Backend original = sha512Backend();
+
+    // Every length from 0 to 3 blocks exercises all the padding cases
+    std::vector<uint8_t> data(3 * 128 + 1);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = (uint8_t)(i * 167 + 13);
+    }
+    std::vector<Sha512Hash> expected;
+    selectSha512Backend(SHA512_PORTABLE);
+    for (size_t length = 0; length <= data.size(); ++length)
+    {
+        expected.push_back(Crypto::sha512(data.data(), length));
+    }
+
+    for (int b = 0; b < NUM_SHA512_BACKENDS; ++b)
+    {
+        Sha512Backend backend = (Sha512Backend)b;
+        if (!selectSha512Backend(backend))
+            continue;
+
+        for (auto const & c : SHA512_CASES)
+        {
+            Sha512Hash result = Crypto::sha512((uint8_t const *)c.input, strlen(c.input));
+            EXPECT_TRUE(std::equal(result.begin(), result.end(), c.expected)) << sha512BackendName(backend);
+        }
+        for (size_t length = 0; length <= data.size(); ++length)
+        {
+            EXPECT_EQ(Crypto::sha512(data.data(), length), expected[length]) << sha512BackendName(backend) << ", " << length;
+        }
+    }
+
+    selectSha512Backend(original);
+}
+
+TEST(CryptoSha512Test, Sha512Hasher)
+{
+    for (auto const & c : SHA512_CASES)
+    {
+        Sha512Hasher hasher;
+        hasher.update((uint8_t const *)c.input, strlen(c.input));
+        Sha512Hash result = hasher.finalize();
+        EXPECT_TRUE(std::equal(result.begin(), result.end(), c.expected));
+    }
+
+    // Data added in pieces of every size hashes the same as all at once
+    std::vector<uint8_t> data(3 * 128 + 7);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = (uint8_t)(i * 59 + 1);
+    }
+    Sha512Hash expected = Crypto::sha512(data);
+    for (size_t piece = 1; piece <= 130; ++piece)
+    {
+        Sha512Hasher hasher;
+        for (size_t i = 0; i < data.size(); i += piece)
+        {
+            hasher.update(data.data() + i, std::min(piece, data.size() - i));
+        }
+        EXPECT_EQ(hasher.length(), data.size());
+        EXPECT_EQ(hasher.finalize(), expected) << piece;
+    }
+
+    // finalize() does not change the hasher
+    Sha512Hasher hasher;
+    hasher.update(data.data(), 100);
+    Sha512Hash partial = hasher.finalize();
+    EXPECT_EQ(partial, Crypto::sha512(data.data(), 100));
+    hasher.update(data.data() + 100, data.size() - 100);
+    EXPECT_EQ(hasher.finalize(), expected);
+
+    hasher.init();
+    EXPECT_EQ(hasher.length(), 0);
+    EXPECT_EQ(hasher.finalize(), Crypto::sha512(nullptr, 0));
+}
+
 int main(int argc, char ** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
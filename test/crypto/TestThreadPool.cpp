@@ -0,0 +1,79 @@
+#include "crypto/ThreadPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(CryptoThreadPoolTest, threads)
+{
+    EXPECT_EQ(Crypto::ThreadPool(1).threads(), 1u);
+    EXPECT_EQ(Crypto::ThreadPool(4).threads(), 4u);
+    EXPECT_GE(Crypto::ThreadPool().threads(), 1u);
+    EXPECT_GE(Crypto::ThreadPool::shared().threads(), 1u);
+}
+
+TEST(CryptoThreadPoolTest, run)
+{
+    for (unsigned threads : { 1u, 2u, 5u })
+    {
+        Crypto::ThreadPool pool(threads);
+
+        // Every call is made exactly once, and the pool can be reused
+        for (size_t n : { 0, 1, 2, 7, 1000 })
+        {
+            std::vector<std::atomic<int>> calls(n);
+            for (auto & c : calls)
+            {
+                c = 0;
+            }
+            pool.run(n, [&calls] (size_t i) { ++calls[i]; });
+            for (size_t i = 0; i < n; ++i)
+            {
+                EXPECT_EQ(calls[i], 1) << threads << ", " << n << ", " << i;
+            }
+        }
+    }
+}
+
+TEST(CryptoThreadPoolTest, run_singleThreadIsOrdered)
+{
+    Crypto::ThreadPool pool(1);
+    std::vector<size_t> order;
+    pool.run(10, [&order] (size_t i) { order.push_back(i); });
+    ASSERT_EQ(order.size(), 10u);
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+TEST(CryptoThreadPoolTest, run_exception)
+{
+    for (unsigned threads : { 1u, 3u })
+    {
+        Crypto::ThreadPool pool(threads);
+        std::atomic<int> calls(0);
+        EXPECT_THROW(pool.run(100, [&calls] (size_t i) {
+                                   ++calls;
+                                   if (i == 50)
+                                       throw std::runtime_error("failed");
+                               }),
+                     std::runtime_error);
+
+        // The remaining calls are still made
+        EXPECT_EQ(calls, 100);
+
+        // The pool is still usable
+        calls = 0;
+        pool.run(10, [&calls] (size_t) { ++calls; });
+        EXPECT_EQ(calls, 10);
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
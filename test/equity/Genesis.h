@@ -0,0 +1,34 @@
+#pragma once
+
+// Serialized parts of the genesis block, shared by the tests
+
+#include <cstdint>
+#include <string>
+
+namespace
+{
+// The coinbase transaction of the genesis block
+char const GENESIS_COINBASE[] =
+    "01000000010000000000000000000000000000000000000000000000000000000000000000ffffffff4d04ffff001d010445"
+    "5468652054696d65732030332f4a616e2f32303039204368616e63656c6c6f72206f6e206272696e6b206f66207365636f6e"
+    "64206261696c6f757420666f722062616e6b73ffffffff0100f2052a01000000434104678afdb0fe5548271967f1a67130b7"
+    "105cd6a828e03909a67962e0ea1f61deb649f6bc3f4cef38c4f35504e51ec112de5c384df7ba0b8d578a4c702b6bf11d5fac"
+    "00000000";
+
+// The header of the genesis block
+char const GENESIS_HEADER[] =
+    "0100000000000000000000000000000000000000000000000000000000000000000000003ba3edfd7a7b12b27ac72c3e67768f617fc81bc3"
+    "888a51323a9fb8aa4b1e5e4a29ab5f49ffff001d1dac2b7c";
+
+// The nonce of the genesis block
+uint32_t const GENESIS_NONCE = 0x7c2bac1d;
+
+// The hash of the genesis block as it is displayed
+char const GENESIS_HASH[] = "000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f";
+
+// Returns the genesis block: the header, the number of transactions, and the coinbase transaction
+inline std::string genesisBlock()
+{
+    return std::string(GENESIS_HEADER) + "01" + GENESIS_COINBASE;
+}
+} // anonymous namespace
@@ -1,9 +1,61 @@
 #include "include/equity/Block.h"
 
+#include "Genesis.h"
+#include "utility/Utility.h"
+
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <sstream>
+
 using namespace Equity;
 
+// Every allocation made by the tests is counted, so that a test can check that an operation does not copy containers
+static std::atomic<size_t> allocationCount(0);
+
+void * operator new(size_t size)
+{
+    ++allocationCount;
+    void * p = std::malloc(size > 0 ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void * p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void * p, size_t) noexcept
+{
+    std::free(p);
+}
+
+// The default memory resource of the polymorphic allocators uses the aligned forms
+void * operator new(size_t size, std::align_val_t alignment)
+{
+    ++allocationCount;
+    size_t a = (size_t)alignment;
+    void * p = std::aligned_alloc(a, (size + a - 1) / a * a + (size > 0 ? 0 : a));
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void * p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void * p, size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
 TEST(EquityBlockTest, constuctor)
 {
     GTEST_SKIP();
@@ -39,6 +91,272 @@ TEST(EquityBlockTest, transactions)
     GTEST_SKIP();
 }
 
+TEST(EquityBlockTest, transactionHashes)
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(GENESIS_COINBASE);
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    Transaction coinbase(in, size);
+
+    // Enough transactions of different sizes to fill several batches
+    TransactionList transactions;
+    for (int i = 0; i < 40; ++i)
+    {
+        Transaction::OutputList outputs = coinbase.outputs();
+        outputs[0].value = (uint64_t)i;
+        outputs[0].script.resize(outputs[0].script.size() + 13 * i, 0x6a);
+        transactions.emplace_back(coinbase.version(), coinbase.inputs(), outputs, coinbase.lockTime());
+    }
+    Block block(Block::Header(), transactions);
+
+    Crypto::Sha256HashList hashes = block.transactionHashes();
+    ASSERT_EQ(hashes.size(), transactions.size());
+    for (size_t i = 0; i < transactions.size(); ++i)
+    {
+        EXPECT_EQ(hashes[i], transactions[i].hash());
+    }
+
+    EXPECT_TRUE(Block(Block::Header(), TransactionList()).transactionHashes().empty());
+}
+
+TEST(EquityBlockTest, Header_hash)
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(GENESIS_HEADER);
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    Block::Header header(in, size);
+
+    EXPECT_EQ(Utility::toHexR(header.hash()), GENESIS_HASH);
+    EXPECT_EQ(header.hash(), Crypto::doubleSha256(serialized));
+
+    // Hashing with a different nonce from the midstate gives the same result as changing the nonce
+    Block::Header::Midstate midstate = header.midstate();
+    EXPECT_EQ(Block::Header::hashWith(midstate, header.nonce), header.hash());
+    for (uint32_t nonce : { 0u, 1u, 0xffffffffu })
+    {
+        Block::Header modified = header;
+        modified.nonce = nonce;
+        std::vector<uint8_t> serializedModified;
+        modified.serialize(serializedModified);
+        EXPECT_EQ(Block::Header::hashWith(midstate, nonce), Crypto::doubleSha256(serializedModified));
+        EXPECT_EQ(modified.hash(), Crypto::doubleSha256(serializedModified));
+    }
+}
+
+TEST(EquityBlockTest, serializedSize)
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(GENESIS_HEADER);
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    Block::Header header(in, size);
+    EXPECT_EQ(header.serializedSize(), Block::Header::SIZE);
+
+    serialized = Utility::fromHex(GENESIS_COINBASE);
+    in = serialized.data();
+    size = serialized.size();
+    Transaction coinbase(in, size);
+
+    Block block(header, TransactionList(260, coinbase));
+    std::vector<uint8_t> out;
+    block.serialize(out);
+    EXPECT_EQ(block.serializedSize(), out.size());
+    EXPECT_EQ(block.serializedSize(), Block::Header::SIZE + 3 + 260 * coinbase.serializedSize());
+}
+
+TEST(EquityBlockTest, serialize_sinks)
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(GENESIS_HEADER);
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    Block::Header header(in, size);
+
+    serialized = Utility::fromHex(GENESIS_COINBASE);
+    in = serialized.data();
+    size = serialized.size();
+    Transaction coinbase(in, size);
+
+    Block block(header, TransactionList(10, coinbase));
+    std::vector<uint8_t> expected;
+    block.serialize(expected);
+
+    // The same serializer writes the block to every kind of destination
+
+    P2p::SizeSink sizeSink;
+    block.serialize(sizeSink);
+    EXPECT_EQ(sizeSink.size(), expected.size());
+
+    std::ostringstream stream;
+    P2p::StreamSink streamSink(stream);
+    block.serialize(streamSink);
+    std::string streamed = stream.str();
+    EXPECT_EQ(std::vector<uint8_t>(streamed.begin(), streamed.end()), expected);
+
+    Crypto::Sha256Hasher hasher;
+    P2p::Sha256Sink hashSink(hasher);
+    block.serialize(hashSink);
+    EXPECT_EQ(hasher.finalize(), Crypto::sha256(expected));
+
+    // Segments of sizes that split the fields
+    std::vector<uint8_t> scattered(expected.size());
+    std::vector<P2p::ScatterSink::Segment> segments;
+    for (size_t offset = 0, n = 1; offset < scattered.size(); offset += n, n = n * 2 + 1)
+    {
+        segments.push_back({ scattered.data() + offset, std::min(n, scattered.size() - offset) });
+    }
+    P2p::ScatterSink scatterSink(segments.data(), segments.size());
+    block.serialize(scatterSink);
+    EXPECT_EQ(scatterSink.size(), expected.size());
+    EXPECT_EQ(scattered, expected);
+
+    // Too small
+    P2p::ScatterSink tooSmall(segments.data(), segments.size() - 1);
+    EXPECT_THROW(block.serialize(tooSmall), std::length_error);
+}
+
+TEST(EquityBlockTest, allocations)
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(GENESIS_HEADER);
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    Block::Header header(in, size);
+
+    serialized = Utility::fromHex(GENESIS_COINBASE);
+    in = serialized.data();
+    size = serialized.size();
+    Transaction coinbase(in, size);
+
+    size_t const COUNT = 20;
+    serialized.clear();
+    Block(header, TransactionList(COUNT, coinbase)).serialize(serialized);
+
+    // Parsing allocates only the containers themselves: the list of transactions and, for each transaction, its
+    // lists of inputs and outputs and their scripts. Nothing is copied.
+    size_t before = allocationCount;
+    in   = serialized.data();
+    size = serialized.size();
+    Block block(in, size);
+    size_t parsing = allocationCount - before;
+    EXPECT_EQ(parsing, 1 + COUNT * (1 + 1 + 1 + 1));
+
+    // Walking the block allocates nothing
+    before = allocationCount;
+    size_t scriptBytes = 0;
+    uint32_t nonce = block.header().nonce;
+    for (auto const & transaction : block.transactions())
+    {
+        for (auto const & input : transaction.inputs())
+        {
+            scriptBytes += input.script.size();
+        }
+        for (auto const & output : transaction.outputs())
+        {
+            scriptBytes += output.script.size();
+        }
+    }
+    size_t walking = allocationCount - before;
+    EXPECT_EQ(walking, 0);
+    EXPECT_EQ(scriptBytes, COUNT * (0x4d + 0x43));
+    EXPECT_EQ(nonce, header.nonce);
+
+    // Moving a list of transactions into a block does not copy them
+    TransactionList transactions(COUNT, coinbase);
+    before = allocationCount;
+    Block moved(header, std::move(transactions));
+    size_t moving = allocationCount - before;
+    EXPECT_EQ(moving, 0);
+    EXPECT_EQ(moved.transactions().size(), COUNT);
+}
+
+TEST(EquityBlockTest, arena)
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(GENESIS_HEADER);
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    Block::Header header(in, size);
+
+    serialized = Utility::fromHex(GENESIS_COINBASE);
+    in = serialized.data();
+    size = serialized.size();
+    Transaction coinbase(in, size);
+
+    size_t const COUNT = 20;
+    serialized.clear();
+    Block(header, TransactionList(COUNT, coinbase)).serialize(serialized);
+
+    // An arena of the given size holds the whole block, so nothing is allocated from the heap. Running out would
+    // throw, since the arena has no upstream resource.
+    std::vector<uint8_t> buffer(Block::arenaSize(serialized.size()));
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    size_t before = allocationCount;
+    in   = serialized.data();
+    size = serialized.size();
+    Block block(in, size, &arena);
+    size_t parsing = allocationCount - before;
+    EXPECT_EQ(parsing, 0);
+    EXPECT_EQ(size, 0);
+    EXPECT_EQ(block.transactions().size(), COUNT);
+
+    std::vector<uint8_t> reserialized;
+    block.serialize(reserialized);
+    EXPECT_EQ(reserialized, serialized);
+
+    // A copy is allocated from the heap, so it can outlive the arena
+    Transaction copy = block.transactions().front();
+    EXPECT_EQ(copy.inputs().get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(copy.outputs().front().script.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(copy.hash(), coinbase.hash());
+}
+
+TEST(EquityBlockTest, arenaSize)
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(GENESIS_HEADER);
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    Block::Header header(in, size);
+
+    serialized = Utility::fromHex(GENESIS_COINBASE);
+    in = serialized.data();
+    size = serialized.size();
+    Transaction coinbase(in, size);
+
+    // Transactions whose fixed parts take much more memory than their serialized bytes
+    Transaction::Output p2pkh;
+    p2pkh.value = 1000;
+    p2pkh.script.assign(25, 0x76);
+    Transaction payout(1, coinbase.inputs(), Transaction::OutputList(20, p2pkh), 0);
+
+    Transaction::Output empty;
+    empty.value = 0;
+    Transaction emptyOutputs(1, coinbase.inputs(), Transaction::OutputList(1000, empty), 0);
+
+    Transaction::Input emptyInput = coinbase.inputs().front();
+    emptyInput.script.clear();
+    Transaction emptyInputs(1, Transaction::InputList(1000, emptyInput), Transaction::OutputList(), 0);
+
+    Transaction nothing(1, Transaction::InputList(), Transaction::OutputList(), 0);
+
+    // A block of each deserializes into an arena of the given size with no upstream resource
+    for (Transaction const & transaction : { payout, emptyOutputs, emptyInputs, nothing })
+    {
+        for (size_t count : { 1, 100 })
+        {
+            serialized.clear();
+            Block(header, TransactionList(count, transaction)).serialize(serialized);
+
+            std::vector<uint8_t> buffer(Block::arenaSize(serialized.size()));
+            std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+            in   = serialized.data();
+            size = serialized.size();
+            Block block(in, size, &arena);
+
+            std::vector<uint8_t> reserialized;
+            block.serialize(reserialized);
+            EXPECT_EQ(reserialized, serialized);
+        }
+    }
+}
+
 int main(int argc, char ** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
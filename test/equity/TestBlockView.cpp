@@ -0,0 +1,102 @@
+#include "include/equity/BlockView.h"
+
+#include "Genesis.h"
+#include "utility/Utility.h"
+
+#include <gtest/gtest.h>
+
+using namespace Equity;
+
+namespace
+{
+// Returns a block with many transactions of different sizes, serialized
+std::vector<uint8_t> manyTransactions()
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(genesisBlock());
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    Block genesis(in, size);
+    Transaction coinbase = genesis.transactions()[0];
+
+    TransactionList transactions;
+    for (int i = 0; i < 40; ++i)
+    {
+        Transaction::OutputList outputs = coinbase.outputs();
+        outputs[0].value = (uint64_t)i;
+        outputs[0].script.resize(outputs[0].script.size() + 13 * i, 0x6a);
+        transactions.emplace_back(coinbase.version(), coinbase.inputs(), outputs, coinbase.lockTime());
+    }
+
+    std::vector<uint8_t> out;
+    Block(genesis.header(), transactions).serialize(out);
+    return out;
+}
+} // anonymous namespace
+
+TEST(EquityBlockViewTest, constructor_deserialization)
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(genesisBlock());
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    BlockView view(in, size);
+
+    EXPECT_EQ(size, 0);
+    EXPECT_EQ(view.serialized().data, serialized.data());
+    EXPECT_EQ(view.serialized().size, serialized.size());
+    EXPECT_EQ(Utility::toHexR(view.header().hash()), GENESIS_HASH);
+    ASSERT_EQ(view.transactions().size(), 1);
+    EXPECT_EQ(view.transactions()[0].serialized().data, serialized.data() + Block::Header::SIZE + 1);
+    EXPECT_EQ(view.transactions()[0].hash(), view.header().merkleRoot);
+}
+
+TEST(EquityBlockViewTest, constructor_deserialization_invalid)
+{
+    std::vector<uint8_t> serialized = manyTransactions();
+
+    // Every truncation is detected
+    for (size_t n = 0; n < serialized.size(); ++n)
+    {
+        uint8_t const * in = serialized.data();
+        size_t size = n;
+        EXPECT_THROW(BlockView(in, size), P2p::DeserializationError) << "size = " << n;
+    }
+
+    // A transaction count larger than the data
+    std::vector<uint8_t> huge(serialized.begin(), serialized.begin() + Block::Header::SIZE);
+    huge.insert(huge.end(), 9, 0xff);
+    uint8_t const * in = huge.data();
+    size_t size = huge.size();
+    EXPECT_THROW(BlockView(in, size), P2p::DeserializationError);
+}
+
+TEST(EquityBlockViewTest, transactionHashes)
+{
+    std::vector<uint8_t> serialized = manyTransactions();
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    Block block(in, size);
+
+    in   = serialized.data();
+    size = serialized.size();
+    BlockView view(in, size);
+
+    EXPECT_EQ(view.transactionHashes(), block.transactionHashes());
+}
+
+TEST(EquityBlockViewTest, toBlock)
+{
+    std::vector<uint8_t> serialized = manyTransactions();
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    BlockView view(in, size);
+
+    std::vector<uint8_t> out;
+    view.toBlock().serialize(out);
+    EXPECT_EQ(out, serialized);
+}
+
+int main(int argc, char ** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,84 @@
+#include "include/equity/Miner.h"
+
+#include "equity/Target.h"
+#include "Genesis.h"
+#include "utility/Utility.h"
+
+#include <gtest/gtest.h>
+
+using namespace Equity;
+
+namespace
+{
+Block::Header genesisHeader()
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(GENESIS_HEADER);
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    return Block::Header(in, size);
+}
+} // anonymous namespace
+
+TEST(EquityMinerTest, constructor)
+{
+    EXPECT_EQ(Miner(3).threads(), 3);
+    EXPECT_GE(Miner().threads(), 1);
+}
+
+TEST(EquityMinerTest, mine)
+{
+    Block::Header header = genesisHeader();
+    header.nonce = 0;
+
+    for (unsigned threads : { 1, 4 })
+    {
+        Miner miner(threads);
+        Miner::Result result = miner.mine(header, GENESIS_NONCE & 0xffff0000, GENESIS_NONCE | 0xffff);
+        ASSERT_TRUE(result.found);
+        EXPECT_EQ(result.nonce, GENESIS_NONCE);
+        EXPECT_EQ(Utility::toHexR(result.hash), "000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+        EXPECT_GE(result.hashes, 1);
+    }
+
+    // A single thread returns the first nonce that meets the target
+    header.target = 0x207fffff;
+    Miner::Result result = Miner(1).mine(header);
+    ASSERT_TRUE(result.found);
+    for (uint32_t nonce = 0; nonce < result.nonce; ++nonce)
+    {
+        header.nonce = nonce;
+        EXPECT_FALSE(hashMeetsTarget(header.hash(), Target(header.target)));
+    }
+    header.nonce = result.nonce;
+    EXPECT_EQ(header.hash(), result.hash);
+    EXPECT_EQ(result.hashes, result.nonce + 1);
+}
+
+TEST(EquityMinerTest, mine_notFound)
+{
+    Block::Header header = genesisHeader();
+    Miner miner(2);
+    Miner::Result result = miner.mine(header, 0, 99999);
+    EXPECT_FALSE(result.found);
+    EXPECT_EQ(result.hashes, 100000);
+}
+
+TEST(EquityMinerTest, stop)
+{
+    // A stop made before the search starts ends it immediately, and only that search
+    Block::Header header = genesisHeader();
+    Miner miner(2);
+    miner.stop();
+    Miner::Result result = miner.mine(header, 0, 99999);
+    EXPECT_FALSE(result.found);
+    EXPECT_EQ(result.hashes, 0);
+
+    result = miner.mine(header, 0, 99999);
+    EXPECT_EQ(result.hashes, 100000);
+}
+
+int main(int argc, char ** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
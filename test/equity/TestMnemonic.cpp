@@ -254,6 +254,37 @@ TEST(EquityMnemonicTest, seed)
     }
 }
 
+TEST(EquityMnemonicTest, seeds)
+{
+    std::vector<Equity::Mnemonic> mnemonics;
+    std::vector<std::string> passwords;
+    std::vector<std::vector<uint8_t>> expected;
+    for (auto const & c : MNEMONIC_TEST_CASES)
+    {
+        mnemonics.emplace_back(fromHex(c.entropy, strlen(c.entropy)));
+        passwords.push_back("TREZOR");
+        expected.push_back(fromHex(c.seed, strlen(c.seed)));
+    }
+
+    // An invalid mnemonic gets an empty seed
+    mnemonics.emplace_back(createWordList("zoo zoo notaword"));
+    passwords.push_back("TREZOR");
+    expected.push_back(std::vector<uint8_t>());
+
+    // A different password gives a different seed
+    mnemonics.push_back(mnemonics.front());
+    passwords.push_back("");
+    expected.push_back(mnemonics.front().seed());
+
+    std::vector<std::vector<uint8_t>> result = Equity::Mnemonic::seeds(mnemonics, passwords);
+    ASSERT_EQ(result.size(), expected.size());
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        EXPECT_TRUE(result[i] == expected[i]) << i;
+    }
+    EXPECT_NE(expected.back(), expected.front());
+}
+
 TEST(EquityMnemonicTest, entropy)
 {
     for (auto const & c : MNEMONIC_TEST_CASES)
@@ -1,42 +1,176 @@
 #include "include/equity/Target.h"
 
+#include "utility/Utility.h"
+
 #include <gtest/gtest.h>
 
+#include <vector>
+
 using namespace Equity;
 
+namespace
+{
+// Compact forms and the values they represent, from Bitcoin Core's arith_uint256 tests and the main chain
+struct TargetTestCase
+{
+    uint32_t compact;
+    char const * hash;
+};
+
+TargetTestCase const TARGET_CASES[] =
+{
+    { 0x1d00ffff, "00000000ffff0000000000000000000000000000000000000000000000000000" },     // Difficulty 1
+    { 0x1b0404cb, "00000000000404cb000000000000000000000000000000000000000000000000" },     // Block 100000
+    { 0x05009234, "0000000000000000000000000000000000000000000000000000000092340000" },
+    { 0x04123456, "0000000000000000000000000000000000000000000000000000000012345600" },
+    { 0x03123456, "0000000000000000000000000000000000000000000000000000000000123456" },
+    { 0x02123400, "0000000000000000000000000000000000000000000000000000000000001234" },
+    { 0x01120000, "0000000000000000000000000000000000000000000000000000000000000012" }
+};
+} // anonymous namespace
+
 TEST(EquityTargetTest, constructor_hash)
 {
-    GTEST_SKIP();
+    for (auto const & c : TARGET_CASES)
+    {
+        std::vector<uint8_t> v = Utility::fromHex(c.hash);
+        Crypto::Sha256Hash hash;
+        std::copy(v.begin(), v.end(), hash.begin());
+        Target target(hash);
+        EXPECT_EQ(uint32_t(target), c.compact);
+        EXPECT_EQ(Crypto::Sha256Hash(target), hash);
+    }
 }
 
 TEST(EquityTargetTest, constructor_compact)
 {
-    GTEST_SKIP();
+    for (auto const & c : TARGET_CASES)
+    {
+        Target target(c.compact);
+        EXPECT_EQ(uint32_t(target), c.compact);
+        EXPECT_EQ(Utility::toHex(Crypto::Sha256Hash(target)), c.hash);
+    }
+}
+
+TEST(EquityTargetTest, constructor_Uint256)
+{
+    for (auto const & c : TARGET_CASES)
+    {
+        std::vector<uint8_t> v = Utility::fromHex(c.hash);
+        Utility::Uint256 value = Utility::Uint256::fromBigEndian(v.data());
+        Target target(value);
+        EXPECT_EQ(uint32_t(target), c.compact);
+        EXPECT_EQ(target.value(), value);
+    }
 }
 
 TEST(EquityTargetTest, operator_Sha256Hash)
 {
-    GTEST_SKIP();
+    EXPECT_EQ(Crypto::Sha256Hash(Target(Target::DIFFICULTY_1_COMPACT)), Target::DIFFICULTY_1);
 }
 
 TEST(EquityTargetTest, operator_uint32_t)
 {
-    GTEST_SKIP();
+    EXPECT_EQ(uint32_t(Target(Target::DIFFICULTY_1)), Target::DIFFICULTY_1_COMPACT);
+}
+
+TEST(EquityTargetTest, operator_less)
+{
+    // The values are compared, not the compact forms
+    EXPECT_TRUE(Target(0x1b0404cb) < Target(0x1d00ffff));
+    EXPECT_TRUE(Target(0x04123456) < Target(0x05009234));
+    EXPECT_FALSE(Target(0x05009234) < Target(0x05009234));
+    EXPECT_TRUE(Target(0x05009234) <= Target(0x05009234));
 }
 
 TEST(EquityTargetTest, difficulty)
 {
-    GTEST_SKIP();
+    EXPECT_DOUBLE_EQ(Target(Target::DIFFICULTY_1_COMPACT).difficulty(), 1.0);
+    EXPECT_DOUBLE_EQ(Target(0x1b0404cb).difficulty(), 16307.420938523983);
 }
 
 TEST(EquityTargetTest, convertToHash)
 {
-    GTEST_SKIP();
+    for (auto const & c : TARGET_CASES)
+    {
+        EXPECT_EQ(Utility::toHex(Target::convertToHash(c.compact)), c.hash);
+    }
+
+    // Mantissas that are not normalized
+    EXPECT_EQ(Utility::toHex(Target::convertToHash(0x1e0000ff)),
+              "00000000ff000000000000000000000000000000000000000000000000000000");
+    EXPECT_EQ(Utility::toHex(Target::convertToHash(0x02003456)),
+              "0000000000000000000000000000000000000000000000000000000000000034");
+    EXPECT_EQ(Utility::toHex(Target::convertToHash(0x01003456)),
+              "0000000000000000000000000000000000000000000000000000000000000000");
 }
 
 TEST(EquityTargetTest, convertToCompact)
 {
-    GTEST_SKIP();
+    for (auto const & c : TARGET_CASES)
+    {
+        std::vector<uint8_t> v = Utility::fromHex(c.hash);
+        Crypto::Sha256Hash hash;
+        std::copy(v.begin(), v.end(), hash.begin());
+        EXPECT_EQ(Target::convertToCompact(hash), c.compact);
+        EXPECT_EQ(Target::convertToCompact(Utility::Uint256::fromBigEndian(v.data())), c.compact);
+        EXPECT_EQ(Target::convertToValue(c.compact), Utility::Uint256::fromBigEndian(v.data()));
+    }
+    EXPECT_EQ(Target::convertToCompact(Utility::Uint256()), Target::TARGET_0_COMPACT);
+
+    // The mantissa is signed, so a value whose most significant byte is 0x80 or more gets another byte
+    EXPECT_EQ(Target::convertToCompact(Utility::Uint256(0x80)), 0x02008000u);
+}
+
+TEST(EquityTargetTest, workFromTarget)
+{
+    // The work of a block at difficulty 1 is 2^256 / (0xffff * 2^208 + 1)
+    EXPECT_EQ(workFromTarget(Target(Target::DIFFICULTY_1_COMPACT)), Utility::Uint256(0x100010001));
+    EXPECT_EQ(workFromTarget(Target(0x1b0404cb)), Utility::Uint256(0x3fb3ab764c00));
+
+    // Extremes
+    EXPECT_EQ(workFromTarget(Target(Utility::Uint256(1))), Utility::Uint256(1) << 255);
+    EXPECT_EQ(workFromTarget(Target(~Utility::Uint256())), Utility::Uint256(1));
+    EXPECT_TRUE(workFromTarget(Target(Utility::Uint256())).isZero());
+
+    // Chainwork is the sum of the work of the blocks
+    Utility::Uint256 chainwork;
+    for (int i = 0; i < 1000; ++i)
+    {
+        chainwork += workFromTarget(Target(Target::DIFFICULTY_1_COMPACT));
+    }
+    EXPECT_EQ(chainwork, Utility::Uint256(0x100010001) * 1000);
+}
+
+TEST(EquityTargetTest, hashMeetsTarget)
+{
+    Target target(Target::DIFFICULTY_1_COMPACT);
+
+    // Hashes are in internal byte order, so they are written reversed
+    auto hash = [] (char const * hex) {
+        Crypto::Sha256Hash h;
+        std::vector<uint8_t> v = Utility::fromHexR(hex);
+        std::copy(v.begin(), v.end(), h.begin());
+        return h;
+    };
+
+    // Genesis block
+    EXPECT_TRUE(hashMeetsTarget(hash("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f"), target));
+
+    // Equal to the target
+    EXPECT_TRUE(hashMeetsTarget(hash("00000000ffff0000000000000000000000000000000000000000000000000000"), target));
+
+    // Differs only in the least significant byte
+    EXPECT_FALSE(hashMeetsTarget(hash("00000000ffff0000000000000000000000000000000000000000000000000001"), target));
+
+    // Differs in each 64-bit limb
+    EXPECT_FALSE(hashMeetsTarget(hash("0000000100000000000000000000000000000000000000000000000000000000"), target));
+    EXPECT_FALSE(hashMeetsTarget(hash("00000000ffff0000000000010000000000000000000000000000000000000000"), target));
+    EXPECT_FALSE(hashMeetsTarget(hash("00000000ffff0000000000000000000000000001000000000000000000000000"), target));
+    EXPECT_TRUE(hashMeetsTarget(hash("00000000fffeffffffffffffffffffffffffffffffffffffffffffffffffffff"), target));
+
+    EXPECT_TRUE(hashMeetsTarget(Crypto::Sha256Hash(), target));
+    EXPECT_FALSE(hashMeetsTarget(hash("ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"), target));
 }
 
 int main(int argc, char ** argv)
@@ -1,5 +1,8 @@
 #include "include/equity/Transaction.h"
 
+#include "Genesis.h"
+#include "utility/Utility.h"
+
 #include <gtest/gtest.h>
 
 using namespace Equity;
@@ -59,6 +62,50 @@ TEST(EquityTransactionTest, valid)
     GTEST_SKIP();
 }
 
+TEST(EquityTransactionTest, hash)
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(GENESIS_COINBASE);
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    Transaction transaction(in, size);
+
+    // Hashes are displayed in reverse order
+    EXPECT_EQ(Utility::toHexR(transaction.hash()), "4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b");
+}
+
+TEST(EquityTransactionTest, serialize_sink)
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(GENESIS_COINBASE);
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    Transaction transaction(in, size);
+
+    std::vector<uint8_t> out;
+    P2p::VectorSink sink(out);
+    transaction.serialize(sink);
+    EXPECT_EQ(out, serialized);
+}
+
+TEST(EquityTransactionTest, serializedSize)
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(GENESIS_COINBASE);
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    Transaction transaction(in, size);
+    EXPECT_EQ(transaction.serializedSize(), serialized.size());
+
+    // Scripts and lists large enough to need longer counts
+    Transaction::InputList inputs(300, transaction.inputs()[0]);
+    Transaction::OutputList outputs = transaction.outputs();
+    outputs[0].script.resize(70000, 0x6a);
+    Transaction large(1, inputs, outputs, 0);
+    std::vector<uint8_t> out;
+    large.serialize(out);
+    EXPECT_EQ(large.serializedSize(), out.size());
+    EXPECT_EQ(inputs[0].serializedSize(), 32 + 4 + 1 + 0x4d + 4);
+    EXPECT_EQ(outputs[0].serializedSize(), 8 + 5 + 70000);
+}
+
 int main(int argc, char ** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,171 @@
+#include "include/equity/TransactionView.h"
+
+#include "Genesis.h"
+#include "utility/Utility.h"
+
+#include <gtest/gtest.h>
+
+using namespace Equity;
+
+namespace
+{
+// Returns a transaction with several inputs and outputs, serialized
+std::vector<uint8_t> multipleInputsAndOutputs()
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(GENESIS_COINBASE);
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    Transaction coinbase(in, size);
+
+    Transaction::InputList inputs;
+    Transaction::OutputList outputs;
+    for (int i = 0; i < 3; ++i)
+    {
+        Transaction::Input input = coinbase.inputs()[0];
+        input.outputIndex = i;
+        input.script.resize(input.script.size() + 7 * i, 0x51);
+        input.sequence = 0x10 + i;
+        inputs.push_back(input);
+
+        Transaction::Output output = coinbase.outputs()[0];
+        output.value = 1000 * i;
+        output.script.resize(300 * i, 0x6a);  // The first script is empty, and the others need 3-byte sizes
+        outputs.push_back(output);
+    }
+
+    std::vector<uint8_t> out;
+    Transaction(1, inputs, outputs, 12345).serialize(out);
+    return out;
+}
+} // anonymous namespace
+
+TEST(EquityTransactionViewTest, constructor_deserialization)
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(GENESIS_COINBASE);
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    TransactionView view(in, size);
+
+    EXPECT_EQ(in, serialized.data() + serialized.size());
+    EXPECT_EQ(size, 0);
+    EXPECT_EQ(view.version(), 1);
+    EXPECT_EQ(view.lockTime(), 0);
+    EXPECT_EQ(view.serialized().data, serialized.data());
+    EXPECT_EQ(view.serialized().size, serialized.size());
+
+    ASSERT_EQ(view.inputs().size(), 1);
+    TransactionView::Input const & input = *view.inputs().begin();
+    EXPECT_EQ(input.txid, serialized.data() + 5);
+    EXPECT_EQ(input.outputIndex, 0xffffffff);
+    EXPECT_EQ(input.script.size, 0x4d);
+    EXPECT_EQ(input.sequence, 0xffffffff);
+
+    ASSERT_EQ(view.outputs().size(), 1);
+    TransactionView::Output const & output = *view.outputs().begin();
+    EXPECT_EQ(output.value, 5000000000);
+    EXPECT_EQ(output.script.size, 0x43);
+    EXPECT_EQ(output.script.end(), serialized.data() + serialized.size() - 4);
+
+    // Trailing data is left alone
+    serialized.push_back(0);
+    in   = serialized.data();
+    size = serialized.size();
+    TransactionView(in, size);
+    EXPECT_EQ(size, 1);
+}
+
+TEST(EquityTransactionViewTest, constructor_deserialization_invalid)
+{
+    std::vector<uint8_t> serialized = multipleInputsAndOutputs();
+
+    // Every truncation is detected
+    for (size_t n = 0; n < serialized.size(); ++n)
+    {
+        uint8_t const * in = serialized.data();
+        size_t size = n;
+        EXPECT_THROW(TransactionView(in, size), P2p::DeserializationError) << "size = " << n;
+    }
+
+    // Only version 1 is valid
+    serialized[0] = 2;
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    EXPECT_THROW(TransactionView(in, size), P2p::DeserializationError);
+
+    // A count larger than the data
+    std::vector<uint8_t> huge = Utility::fromHex("01000000ffffffffffffffffff");
+    in   = huge.data();
+    size = huge.size();
+    EXPECT_THROW(TransactionView(in, size), P2p::DeserializationError);
+}
+
+TEST(EquityTransactionViewTest, inputs_outputs)
+{
+    std::vector<uint8_t> serialized = multipleInputsAndOutputs();
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    Transaction transaction(in, size);
+
+    in   = serialized.data();
+    size = serialized.size();
+    TransactionView view(in, size);
+
+    Transaction::InputList inputs = transaction.inputs();
+    ASSERT_EQ(view.inputs().size(), inputs.size());
+    size_t i = 0;
+    for (auto const & input : view.inputs())
+    {
+        Transaction::Input copy = input.toInput();
+        std::vector<uint8_t> expected;
+        std::vector<uint8_t> actual;
+        inputs[i].serialize(expected);
+        copy.serialize(actual);
+        EXPECT_EQ(actual, expected);
+        EXPECT_EQ(input.script.toVector(), std::vector<uint8_t>(inputs[i].script.begin(), inputs[i].script.end()));
+        ++i;
+    }
+
+    Transaction::OutputList outputs = transaction.outputs();
+    ASSERT_EQ(view.outputs().size(), outputs.size());
+    i = 0;
+    for (auto it = view.outputs().begin(); it != view.outputs().end(); it++)
+    {
+        EXPECT_EQ(it->value, outputs[i].value);
+        EXPECT_EQ(it->script.toVector(), std::vector<uint8_t>(outputs[i].script.begin(), outputs[i].script.end()));
+        ++i;
+    }
+    EXPECT_TRUE(view.outputs().begin()->script.empty());
+}
+
+TEST(EquityTransactionViewTest, hash)
+{
+    std::vector<uint8_t> serialized = Utility::fromHex(GENESIS_COINBASE);
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    TransactionView view(in, size);
+
+    EXPECT_EQ(Utility::toHexR(view.hash()), "4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b");
+}
+
+TEST(EquityTransactionViewTest, toTransaction)
+{
+    std::vector<uint8_t> serialized = multipleInputsAndOutputs();
+    uint8_t const * in = serialized.data();
+    size_t size = serialized.size();
+    TransactionView view(in, size);
+
+    Transaction transaction = view.toTransaction();
+    EXPECT_EQ(transaction.version(), view.version());
+    EXPECT_EQ(transaction.lockTime(), 12345);
+    EXPECT_EQ(transaction.hash(), view.hash());
+
+    std::vector<uint8_t> out;
+    transaction.serialize(out);
+    EXPECT_EQ(out, serialized);
+}
+
+int main(int argc, char ** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
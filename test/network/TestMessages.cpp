@@ -276,6 +276,53 @@ TEST(NetworkMessagesVersionMessageTest, constructor_serialized)
     GTEST_SKIP();
 }
 
+namespace
+{
+// Returns the number of bytes that the message actually serializes to
+size_t actualSize(P2p::Serializable const & message)
+{
+    std::vector<uint8_t> out;
+    message.serialize(out);
+    return out.size();
+}
+} // anonymous namespace
+
+TEST(NetworkMessagesTest, serializedSize)
+{
+    using namespace Network;
+
+    std::array<uint8_t, 16> ip = {};
+    Address address(1, 2, ip, 8333);
+    Crypto::Sha256Hash hash = {};
+    Crypto::Sha256HashList hashes(300, hash);   // Enough for a 3-byte count
+    InventoryList inventory(3, InventoryId(InventoryId::TYPE_TX, hash));
+    Equity::Block::Header header;
+    header.version = 1;
+    header.previousBlock = hash;
+    header.merkleRoot = hash;
+    header.timestamp = header.target = header.nonce = 0;
+
+    AddressMessage addresses(std::vector<Address>(2, address));
+    GetBlocksMessage getBlocks(70001, hashes, hash);
+    GetDataMessage getData(inventory);
+    FilterLoadMessage filterLoad(std::vector<uint8_t>(300, 0x55), 11, 12, 1);
+    MerkleBlockMessage merkleBlock(header, 7, hashes, P2p::BitArray(20));
+    VersionMessage version(70001, 1, 2, address, address, 3, "/Equity:0.1/", 4, true);
+    GetAddrMessage getAddr;
+
+    P2p::Serializable const * messages[] =
+    {
+        &addresses, &getBlocks, &getData, &filterLoad, &merkleBlock, &version, &getAddr
+    };
+    for (auto message : messages)
+    {
+        EXPECT_EQ(message->serializedSize(), actualSize(*message));
+    }
+    EXPECT_EQ(address.serializedSize(), Address::SIZE);
+    EXPECT_EQ(actualSize(address), Address::SIZE);
+    EXPECT_EQ(actualSize(inventory[0]), InventoryId::SIZE);
+}
+
 int main(int argc, char ** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,56 @@
+#include "utility/Endian.h"
+
+#include <gtest/gtest.h>
+
+using namespace Utility;
+
+TEST(UtilityEndianTest, swap)
+{
+    EXPECT_EQ(Endian::swap((uint16_t)0x0123), 0x2301);
+    EXPECT_EQ(Endian::swap((uint32_t)0x01234567), 0x67452301);
+    EXPECT_EQ(Endian::swap((uint64_t)0x0123456789abcdef), 0xefcdab8967452301);
+    EXPECT_EQ(Endian::swap(Endian::swap((uint64_t)0x0123456789abcdef)), 0x0123456789abcdef);
+}
+
+TEST(UtilityEndianTest, little_big)
+{
+    uint32_t x = 0x01234567;
+    uint8_t bytes[sizeof(x)];
+    std::memcpy(bytes, &x, sizeof(x));
+    bool hostIsLittle = (bytes[0] == 0x67);
+
+    EXPECT_EQ(Endian::little(x), hostIsLittle ? x : Endian::swap(x));
+    EXPECT_EQ(Endian::big(x), hostIsLittle ? Endian::swap(x) : x);
+    EXPECT_EQ(Endian::little((uint8_t)0xab), 0xab);
+    EXPECT_EQ(Endian::big((uint8_t)0xab), 0xab);
+}
+
+TEST(UtilityEndianTest, storeLittle_loadLittle)
+{
+    // The values are stored at odd addresses to check unaligned access
+    uint8_t buffer[1 + 8];
+
+    Endian::storeLittle(buffer + 1, (uint16_t)0x0123);
+    EXPECT_EQ(buffer[1], 0x23);
+    EXPECT_EQ(buffer[2], 0x01);
+    EXPECT_EQ(Endian::loadLittle<uint16_t>(buffer + 1), 0x0123);
+
+    Endian::storeLittle(buffer + 1, (uint32_t)0x01234567);
+    EXPECT_EQ(buffer[1], 0x67);
+    EXPECT_EQ(buffer[4], 0x01);
+    EXPECT_EQ(Endian::loadLittle<uint32_t>(buffer + 1), 0x01234567);
+
+    Endian::storeLittle(buffer + 1, (uint64_t)0x0123456789abcdef);
+    uint8_t const expected[] = { 0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01 };
+    for (size_t i = 0; i < sizeof(expected); ++i)
+    {
+        EXPECT_EQ(buffer[1 + i], expected[i]);
+    }
+    EXPECT_EQ(Endian::loadLittle<uint64_t>(buffer + 1), 0x0123456789abcdef);
+}
+
+int main(int argc, char ** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
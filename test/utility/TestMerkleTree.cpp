@@ -1,4 +1,5 @@
 #include "utility/MerkleTree.h"
+#include "utility/Utility.h"
 
 #include <gtest/gtest.h>
 
@@ -2281,7 +2282,46 @@ TestMerkleTreeCase const MERKLETREE_CONSTRUCTOR_CASES[] =
 
 TEST(UtilityMerkleTreeTest, constructor)
 {
-    GTEST_SKIP();
+    for (auto const & c : MERKLETREE_CONSTRUCTOR_CASES)
+    {
+        Crypto::Sha256HashList hashes;
+        for (auto const & d : c.data)
+        {
+            std::vector<uint8_t> hash = fromHexR(d);
+            hashes.emplace_back();
+            std::copy(hash.begin(), hash.end(), hashes.back().begin());
+        }
+
+        MerkleTree tree(hashes);
+        EXPECT_EQ(toHexR(tree.root()), c.expected);
+        for (size_t i = 0; i < hashes.size(); ++i)
+        {
+            EXPECT_EQ(tree.hashAt(i), hashes[i]);
+        }
+    }
+}
+
+TEST(UtilityMerkleTreeTest, verify)
+{
+    for (auto const & c : MERKLETREE_CONSTRUCTOR_CASES)
+    {
+        Crypto::Sha256HashList hashes;
+        for (auto const & d : c.data)
+        {
+            std::vector<uint8_t> hash = fromHexR(d);
+            hashes.emplace_back();
+            std::copy(hash.begin(), hash.end(), hashes.back().begin());
+        }
+
+        MerkleTree tree(hashes);
+        for (size_t i = 0; i < hashes.size(); ++i)
+        {
+            EXPECT_TRUE(MerkleTree::verify(hashes[i], i, tree.proof(i), tree.root()));
+            Crypto::Sha256Hash wrong = hashes[i];
+            wrong[0] ^= 1;
+            EXPECT_FALSE(MerkleTree::verify(wrong, i, tree.proof(i), tree.root()));
+        }
+    }
 }
 
 int main(int argc, char ** argv)
@@ -0,0 +1,155 @@
+#include "utility/Uint256.h"
+#include "utility/Utility.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace Utility;
+
+namespace
+{
+// Expected values were computed with Python's arbitrary-precision integers
+
+Uint256 fromHex(char const * x)
+{
+    std::vector<uint8_t> bytes = Utility::fromHex(x);
+    EXPECT_EQ(bytes.size(), 32);
+    return Uint256::fromBigEndian(bytes.data());
+}
+
+std::string toHex(Uint256 const & a)
+{
+    uint8_t bytes[32];
+    a.toBigEndian(bytes);
+    return Utility::toHex(bytes, sizeof(bytes));
+}
+
+char const A[]    = "36f675cc81e74ef5e8e25d940ed904759531985d5d9dc9f81818e811892f902b";
+char const B[]    = "8d116ece1738f7d93d9c172411e20b8f6b0d549b6f03675a1600a35a099950d8";
+char const ZERO[] = "0000000000000000000000000000000000000000000000000000000000000000";
+char const ONE[]  = "0000000000000000000000000000000000000000000000000000000000000001";
+char const MAX[]  = "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff";
+} // anonymous namespace
+
+TEST(UtilityUint256Test, constructor)
+{
+    EXPECT_EQ(toHex(Uint256()), ZERO);
+    EXPECT_EQ(toHex(Uint256(1)), ONE);
+    EXPECT_EQ(toHex(Uint256(0x0123456789abcdef)), "0000000000000000000000000000000000000000000000000123456789abcdef");
+}
+
+TEST(UtilityUint256Test, bytes)
+{
+    std::vector<uint8_t> bytes = Utility::fromHex(A);
+    Uint256 a = Uint256::fromBigEndian(bytes.data());
+    EXPECT_EQ(a.limb(0), 0x1818e811892f902b);
+    EXPECT_EQ(a.limb(3), 0x36f675cc81e74ef5);
+    EXPECT_EQ(toHex(a), A);
+
+    // Little-endian bytes are the big-endian bytes reversed
+    std::vector<uint8_t> reversed(bytes.rbegin(), bytes.rend());
+    EXPECT_EQ(Uint256::fromLittleEndian(reversed.data()), a);
+    uint8_t little[32];
+    a.toLittleEndian(little);
+    EXPECT_EQ(std::vector<uint8_t>(little, little + 32), reversed);
+}
+
+TEST(UtilityUint256Test, compare)
+{
+    Uint256 a = fromHex(A);
+    Uint256 b = fromHex(B);
+    EXPECT_TRUE(a < b);
+    EXPECT_TRUE(a <= b);
+    EXPECT_TRUE(b > a);
+    EXPECT_TRUE(b >= a);
+    EXPECT_TRUE(a != b);
+    EXPECT_TRUE(a == fromHex(A));
+    EXPECT_TRUE(a <= a);
+    EXPECT_FALSE(a < a);
+
+    // Only the least significant limb differs
+    EXPECT_TRUE(Uint256(1) < Uint256(2));
+    EXPECT_TRUE(Uint256() < fromHex(MAX));
+}
+
+TEST(UtilityUint256Test, bits)
+{
+    EXPECT_EQ(Uint256().bits(), 0);
+    EXPECT_EQ(Uint256(1).bits(), 1);
+    EXPECT_EQ(Uint256(0x8000000000000000).bits(), 64);
+    EXPECT_EQ((Uint256(1) << 64).bits(), 65);
+    EXPECT_EQ(fromHex(A).bits(), 254);
+    EXPECT_EQ(fromHex(MAX).bits(), 256);
+    EXPECT_TRUE(Uint256().isZero());
+    EXPECT_FALSE((Uint256(1) << 255).isZero());
+}
+
+TEST(UtilityUint256Test, add_subtract)
+{
+    Uint256 a = fromHex(A);
+    Uint256 b = fromHex(B);
+    EXPECT_EQ(toHex(a + b), "c407e49a992046cf267e74b820bb1005003eecf8cca131522e198b6b92c8e103");
+    EXPECT_EQ(toHex(b - a), "561af9019551a8e354b9b99003090719d5dbbc3e11659d61fde7bb488069c0ad");
+    EXPECT_EQ(a + b - b, a);
+
+    // Carries and borrows propagate through every limb, and the result wraps around
+    EXPECT_EQ(toHex(fromHex(MAX) + Uint256(1)), ZERO);
+    EXPECT_EQ(toHex(Uint256() - Uint256(1)), MAX);
+    EXPECT_EQ(toHex(a - b), "a9e506fe6aae571cab46466ffcf6f8e62a2443c1ee9a629e021844b77f963f53");
+}
+
+TEST(UtilityUint256Test, multiply)
+{
+    Uint256 a = fromHex(A);
+    EXPECT_EQ(toHex(a * 1000), "b2bc26db6f8c7095b43d8a59ffb96b4ec9bb2cb5b05cf11e214a847fe1cb27f8");
+    EXPECT_EQ(toHex(a * 0xffffffff), "4af0d92966fb0e9e25f6a6e1865893e7c86c319aba7b1e197116a81976d06fd5");
+    EXPECT_EQ(a * 1, a);
+    EXPECT_TRUE((a * 0).isZero());
+}
+
+TEST(UtilityUint256Test, divide)
+{
+    Uint256 a = fromHex(A);
+    Uint256 b = fromHex(B);
+    EXPECT_EQ(toHex(b / a), "0000000000000000000000000000000000000000000000000000000000000002");
+    EXPECT_EQ(toHex(a / b), ZERO);
+    EXPECT_EQ(toHex(a / a), ONE);
+    EXPECT_EQ(toHex(a / Uint256(3)), "125227442b4d1a51f84b7486af9dac2731bb32c9c9df4352b2b2f805d865300e");
+    EXPECT_EQ(toHex(a / Uint256(1000)), "000e1209ad2f975ffd6ab8ecf2b3edd415e8c0eb9d0588a6646047e97d52393b");
+    EXPECT_EQ(toHex(fromHex(MAX) / a), "0000000000000000000000000000000000000000000000000000000000000004");
+    EXPECT_EQ(toHex(fromHex(MAX) / (Uint256(1) << 200)),
+              "00000000000000000000000000000000000000000000000000ffffffffffffff");
+}
+
+TEST(UtilityUint256Test, shift)
+{
+    Uint256 a = fromHex(A);
+    EXPECT_EQ(toHex(a << 4), "6f675cc81e74ef5e8e25d940ed904759531985d5d9dc9f81818e811892f902b0");
+    EXPECT_EQ(toHex(a >> 4), "036f675cc81e74ef5e8e25d940ed904759531985d5d9dc9f81818e811892f902");
+    EXPECT_EQ(toHex(a << 64), "e8e25d940ed904759531985d5d9dc9f81818e811892f902b0000000000000000");
+    EXPECT_EQ(toHex(a >> 64), "000000000000000036f675cc81e74ef5e8e25d940ed904759531985d5d9dc9f8");
+    EXPECT_EQ(toHex(a << 100), "ed904759531985d5d9dc9f81818e811892f902b0000000000000000000000000");
+    EXPECT_EQ(toHex(a >> 100), "000000000000000000000000036f675cc81e74ef5e8e25d940ed904759531985");
+    EXPECT_EQ(toHex(a << 0), A);
+    EXPECT_EQ(toHex(a >> 0), A);
+    EXPECT_EQ(toHex(a << 256), ZERO);
+    EXPECT_EQ(toHex(a >> 256), ZERO);
+    EXPECT_EQ(toHex(Uint256(1) << 255), "8000000000000000000000000000000000000000000000000000000000000000");
+    EXPECT_EQ(toHex((Uint256(1) << 255) >> 255), ONE);
+}
+
+TEST(UtilityUint256Test, toDouble)
+{
+    EXPECT_EQ(Uint256().toDouble(), 0.0);
+    EXPECT_EQ(Uint256(12345).toDouble(), 12345.0);
+    EXPECT_EQ((Uint256(3) << 200).toDouble(), std::ldexp(3.0, 200));
+}
+
+int main(int argc, char ** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#if defined(_MSC_VER)
+#include <cstdlib>
+#endif
 
 #define TARGET_LITTLE_ENDIAN
 
@@ -12,25 +16,45 @@ namespace Utility
 //! Conversions between endian formats
 namespace Endian
 {
+// The swaps use the compiler's byte-swap intrinsics, which compile to a single instruction, where they are available.
+
 inline uint16_t swap(uint16_t x)
 {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap16(x);
+#elif defined(_MSC_VER)
+    return _byteswap_ushort(x);
+#else
     uint8_t high = (uint8_t)(x & 0xff);
     uint8_t low  = (uint8_t)((x >> 8) & 0xff);
     return ((uint16_t)high << 8) | (uint16_t)low;
+#endif
 }
 
 inline uint32_t swap(uint32_t x)
 {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap32(x);
+#elif defined(_MSC_VER)
+    return _byteswap_ulong(x);
+#else
     uint16_t high = swap((uint16_t)(x & 0xffff));
     uint16_t low  = swap((uint16_t)((x >> 16) & 0xffff));
     return ((uint32_t)high << 16) | (uint32_t)low;
+#endif
 }
 
 inline uint64_t swap(uint64_t x)
 {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(x);
+#elif defined(_MSC_VER)
+    return _byteswap_uint64(x);
+#else
     uint32_t high = swap((uint32_t)(x & 0xffffffff));
     uint32_t low  = swap((uint32_t)((x >> 32) & 0xffffffff));
     return ((uint64_t)high << 32) | (uint64_t)low;
+#endif
 }
 
 // Note: Conversions in each direction are identical, so the same function is used for both.
@@ -62,6 +86,28 @@ inline uint64_t big(uint64_t x) { return x; }
 #else   // if defined(TARGET_LITTLE_ENDIAN) && !defined(TARGET_BIG_ENDIAN)
 #error TARGET_BIG_ENDIAN or TARGET_LITTLE_ENDIAN (but not both) must be defined
 #endif  // if defined(TARGET_LITTLE_ENDIAN) && !defined(TARGET_BIG_ENDIAN)
+
+//! Stores a value in little-endian order at an address that need not be aligned.
+//!
+//! @param  p   destination (sizeof(x) bytes)
+//! @param  x   value
+template <typename T>
+inline void storeLittle(uint8_t * p, T x)
+{
+    x = little(x);
+    std::memcpy(p, &x, sizeof(x));
+}
+
+//! Loads a value in little-endian order from an address that need not be aligned.
+//!
+//! @param  p   source (sizeof(T) bytes)
+template <typename T>
+inline T loadLittle(uint8_t const * p)
+{
+    T x;
+    std::memcpy(&x, p, sizeof(x));
+    return little(x);
+}
 }   // namespace Endian
 
 //!@}
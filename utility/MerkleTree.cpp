@@ -24,16 +24,6 @@ bool even(size_t x)
 size_t parentOf(size_t i) { return i / 2; }
 size_t siblingOf(size_t i) { return i ^ 1; }
 size_t leftChildOf(size_t i) { return i * 2; }
-size_t rightChildOf(size_t i) { return i * 2 + 1; }
-
-std::vector<uint8_t> concatenate(Crypto::Sha256Hash const & left, Crypto::Sha256Hash const & right)
-{
-    std::vector<uint8_t> concatenated;
-    concatenated.reserve(2 * Crypto::SHA256_HASH_SIZE);
-    concatenated.assign(left.begin(), left.end());
-    concatenated.insert(concatenated.end(), right.begin(), right.end());
-    return concatenated;
-}
 
 } // anonymous namespace
 
@@ -68,10 +58,9 @@ MerkleTree::MerkleTree(Crypto::Sha256HashList const & hashes)
         size_t first = parentOf(offset_);
         while (n > 0)
         {
-            for (size_t i = first; i < first + n; ++i)
-            {
-                tree_[i] = Crypto::doubleSha256(concatenate(tree_[leftChildOf(i)], tree_[rightChildOf(i)]));
-            }
+            // The children of each node are adjacent, so a whole level is hashed at once
+            Crypto::doubleSha256_64(&tree_[leftChildOf(first)], n, &tree_[first]);
+
             // Duplicate the last one if there is an odd number (except for the root!)
             if (!even(n) && first > ROOT)
             {
@@ -135,11 +124,11 @@ bool MerkleTree::verify(Crypto::Sha256Hash const &     hash,
     {
         if (even(i))
         {
-            result = Crypto::doubleSha256(concatenate(result, p));
+            result = Crypto::doubleSha256_64(result, p);
         }
         else
         {
-            result = Crypto::doubleSha256(concatenate(p, result));
+            result = Crypto::doubleSha256_64(p, result);
         }
         i /= 2;
     }
@@ -0,0 +1,167 @@
+#include "Uint256.h"
+
+#include <cassert>
+#include <cmath>
+
+using namespace Utility;
+
+Uint256 Uint256::fromBigEndian(uint8_t const * bytes)
+{
+    Uint256 r;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t x = 0;
+        for (int j = 0; j < 8; ++j)
+        {
+            x = (x << 8) | bytes[(3 - i) * 8 + j];
+        }
+        r.d_[i] = x;
+    }
+    return r;
+}
+
+Uint256 Uint256::fromLittleEndian(uint8_t const * bytes)
+{
+    Uint256 r;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t x = 0;
+        for (int j = 7; j >= 0; --j)
+        {
+            x = (x << 8) | bytes[i * 8 + j];
+        }
+        r.d_[i] = x;
+    }
+    return r;
+}
+
+void Uint256::toBigEndian(uint8_t * bytes) const
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = 0; j < 8; ++j)
+        {
+            bytes[(3 - i) * 8 + j] = (uint8_t)(d_[i] >> (56 - 8 * j));
+        }
+    }
+}
+
+void Uint256::toLittleEndian(uint8_t * bytes) const
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = 0; j < 8; ++j)
+        {
+            bytes[i * 8 + j] = (uint8_t)(d_[i] >> (8 * j));
+        }
+    }
+}
+
+int Uint256::bits() const
+{
+    for (int i = 3; i >= 0; --i)
+    {
+        if (d_[i] != 0)
+        {
+            int n = 64;
+            while ((d_[i] >> (n - 1)) == 0)
+            {
+                --n;
+            }
+            return i * 64 + n;
+        }
+    }
+    return 0;
+}
+
+double Uint256::toDouble() const
+{
+    double r = 0.0;
+    for (int i = 3; i >= 0; --i)
+    {
+        r = std::ldexp(r, 64) + (double)d_[i];
+    }
+    return r;
+}
+
+Uint256 & Uint256::operator *=(uint32_t b)
+{
+    // Each limb is multiplied 32 bits at a time so that the products fit in 64 bits
+    uint64_t carry = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t low  = (d_[i] & 0xffffffff) * b + carry;
+        uint64_t high = (d_[i] >> 32) * b + (low >> 32);
+        d_[i] = (high << 32) | (low & 0xffffffff);
+        carry = high >> 32;
+    }
+    return *this;
+}
+
+Uint256 & Uint256::operator /=(Uint256 const & b)
+{
+    assert(!b.isZero());
+
+    // Shift-and-subtract, starting with the divisor aligned with the most significant bit of the dividend, so the
+    // number of steps is the difference in their sizes rather than 256.
+    Uint256 remainder = *this;
+    Uint256 quotient;
+    int     shift     = remainder.bits() - b.bits();
+    if (shift >= 0)
+    {
+        Uint256 divisor = b << (unsigned)shift;
+        for (; shift >= 0; --shift)
+        {
+            if (remainder >= divisor)
+            {
+                remainder -= divisor;
+                quotient.d_[shift / 64] |= (uint64_t)1 << (shift % 64);
+            }
+            divisor >>= 1;
+        }
+    }
+    *this = quotient;
+    return *this;
+}
+
+Uint256 & Uint256::operator <<=(unsigned n)
+{
+    if (n >= 256)
+        return *this = Uint256();
+
+    unsigned limbs = n / 64;
+    unsigned bits  = n % 64;
+    for (int i = 3; i >= 0; --i)
+    {
+        uint64_t x = 0;
+        if (i >= (int)limbs)
+        {
+            x = d_[i - limbs] << bits;
+            if (bits > 0 && i > (int)limbs)
+                x |= d_[i - limbs - 1] >> (64 - bits);
+        }
+        d_[i] = x;
+    }
+    return *this;
+}
+
+Uint256 & Uint256::operator >>=(unsigned n)
+{
+    if (n >= 256)
+        return *this = Uint256();
+
+    unsigned limbs = n / 64;
+    unsigned bits  = n % 64;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t x = 0;
+        if (i + limbs < 4)
+        {
+            x = d_[i + limbs] >> bits;
+            if (bits > 0 && i + limbs + 1 < 4)
+                x |= d_[i + limbs + 1] << (64 - bits);
+        }
+        d_[i] = x;
+    }
+    return *this;
+}
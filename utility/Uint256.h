@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Utility
+{
+//! @addtogroup UtilityGroup
+//!@{
+
+//! A 256-bit unsigned integer.
+//!
+//! The value is stored as four 64-bit limbs, least significant first. Arithmetic is modulo 2^256, except that division
+//! by 0 is not allowed.
+class Uint256
+{
+public:
+
+    // Constructor
+    Uint256()
+        : d_{ 0, 0, 0, 0 }
+    {
+    }
+
+    // Constructor
+    //!
+    //! @param  x   initial value
+    Uint256(uint64_t x)
+        : d_{ x, 0, 0, 0 }
+    {
+    }
+
+    //! Returns a value loaded from 32 big-endian bytes
+    static Uint256 fromBigEndian(uint8_t const * bytes);
+
+    //! Returns a value loaded from 32 little-endian bytes (the byte order of a hash in internal order)
+    static Uint256 fromLittleEndian(uint8_t const * bytes);
+
+    //! Stores the value as 32 big-endian bytes
+    void toBigEndian(uint8_t * bytes) const;
+
+    //! Stores the value as 32 little-endian bytes
+    void toLittleEndian(uint8_t * bytes) const;
+
+    //! Returns a limb (0 is the least significant)
+    uint64_t limb(int i) const { return d_[i]; }
+
+    //! Returns true if the value is 0
+    bool isZero() const { return (d_[0] | d_[1] | d_[2] | d_[3]) == 0; }
+
+    //! Returns the number of significant bits (0 if the value is 0)
+    int bits() const;
+
+    //! Returns the value as a double (approximately, if it has more than 53 significant bits)
+    double toDouble() const;
+
+    //! Returns -1, 0, or 1 if the value is less than, equal to, or greater than b
+    int compare(Uint256 const & b) const
+    {
+        for (int i = 3; i >= 0; --i)
+        {
+            if (d_[i] != b.d_[i])
+                return (d_[i] < b.d_[i]) ? -1 : 1;
+        }
+        return 0;
+    }
+
+    //! Adds b (mod 2^256)
+    Uint256 & operator +=(Uint256 const & b)
+    {
+        uint64_t carry = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            uint64_t t = d_[i] + carry;
+            carry = (t < carry);
+            d_[i] = t + b.d_[i];
+            carry += (d_[i] < t);
+        }
+        return *this;
+    }
+
+    //! Subtracts b (mod 2^256)
+    Uint256 & operator -=(Uint256 const & b)
+    {
+        uint64_t borrow = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            uint64_t t = d_[i] - borrow;
+            borrow = (d_[i] < borrow);
+            borrow += (t < b.d_[i]);
+            d_[i] = t - b.d_[i];
+        }
+        return *this;
+    }
+
+    //! Multiplies by a small value (mod 2^256)
+    Uint256 & operator *=(uint32_t b);
+
+    //! Divides by b, discarding the remainder. b must not be 0.
+    Uint256 & operator /=(Uint256 const & b);
+
+    //! Shifts left by n bits
+    Uint256 & operator <<=(unsigned n);
+
+    //! Shifts right by n bits
+    Uint256 & operator >>=(unsigned n);
+
+    //! Returns the one's complement
+    Uint256 operator ~() const
+    {
+        Uint256 r;
+        for (int i = 0; i < 4; ++i)
+        {
+            r.d_[i] = ~d_[i];
+        }
+        return r;
+    }
+
+private:
+
+    uint64_t d_[4];
+};
+
+inline Uint256 operator +(Uint256 a, Uint256 const & b) { return a += b; }
+inline Uint256 operator -(Uint256 a, Uint256 const & b) { return a -= b; }
+inline Uint256 operator *(Uint256 a, uint32_t b) { return a *= b; }
+inline Uint256 operator /(Uint256 a, Uint256 const & b) { return a /= b; }
+inline Uint256 operator <<(Uint256 a, unsigned n) { return a <<= n; }
+inline Uint256 operator >>(Uint256 a, unsigned n) { return a >>= n; }
+
+inline bool operator ==(Uint256 const & a, Uint256 const & b) { return a.compare(b) == 0; }
+inline bool operator !=(Uint256 const & a, Uint256 const & b) { return a.compare(b) != 0; }
+inline bool operator <(Uint256 const & a, Uint256 const & b) { return a.compare(b) < 0; }
+inline bool operator <=(Uint256 const & a, Uint256 const & b) { return a.compare(b) <= 0; }
+inline bool operator >(Uint256 const & a, Uint256 const & b) { return a.compare(b) > 0; }
+inline bool operator >=(Uint256 const & a, Uint256 const & b) { return a.compare(b) >= 0; }
+
+//!@}
+} // namespace Utility